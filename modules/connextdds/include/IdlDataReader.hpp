@@ -18,6 +18,14 @@
 
 namespace pyrti {
 
+template<>
+struct PyDataReaderHelpers<rti::topic::cdr::CSampleWrapper> {
+    static long reader_references(
+            dds::sub::DataReader<rti::topic::cdr::CSampleWrapper>& reader);
+    static void close(
+            dds::sub::DataReader<rti::topic::cdr::CSampleWrapper>& reader);
+};
+
 using PyIdlDataReader = PyDataReader<rti::topic::cdr::CSampleWrapper>;
 
 using IdlDataReaderPyClass = py::class_<
@@ -0,0 +1,105 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include "IdlDataReader.hpp"
+#include "IdlSampleProgram.hpp"
+
+#include <unordered_map>
+
+namespace pyrti {
+
+// Returns the loan of a collection of IDL samples. The loan is shared by
+// PyIdlLoanedViews and the buffers it exports, so it may be destroyed with or
+// without the GIL.
+struct PYRTI_SYMBOL_HIDDEN IdlLoanDeleter {
+    void operator()(
+            dds::sub::LoanedSamples<rti::topic::cdr::CSampleWrapper>* ptr);
+};
+
+using IdlLoanPtr = std::shared_ptr<
+        dds::sub::LoanedSamples<rti::topic::cdr::CSampleWrapper>>;
+
+// Exports the memory of a member of a loaned sample through the Python
+// buffer protocol (read-only). It keeps the loan alive while any memoryview
+// or object created from it (e.g. a NumPy array) uses its memory.
+struct PYRTI_SYMBOL_HIDDEN IdlLoanedMemberBuffer {
+    IdlLoanPtr loan;
+    const char* data;
+    NativePrimitiveKind kind;
+    size_t length;
+    bool is_scalar;
+};
+
+// A collection of loaned IDL samples (DataReader.take_loaned_views) that
+// provides zero-copy access to their primitive members, and arrays and
+// sequences of primitives, as read-only memoryviews.
+//
+// return_loan() releases the memoryviews created by view(). If a buffer
+// obtained from one of them is still in use (for example by a NumPy array),
+// the samples are returned to the reader when that buffer is released.
+//
+// @pre All operations except construction require the GIL
+class PYRTI_SYMBOL_HIDDEN PyIdlLoanedViews {
+public:
+    PyIdlLoanedViews(
+            const PyIdlDataReader& reader,
+            dds::sub::LoanedSamples<rti::topic::cdr::CSampleWrapper>&&
+                    samples);
+
+    ~PyIdlLoanedViews();
+
+    // Disable copies
+    PyIdlLoanedViews(const PyIdlLoanedViews&) = delete;
+    PyIdlLoanedViews& operator=(const PyIdlLoanedViews&) = delete;
+    // Default move
+    PyIdlLoanedViews(PyIdlLoanedViews&&) = default;
+    PyIdlLoanedViews& operator=(PyIdlLoanedViews&&) = default;
+
+    size_t length() const;
+
+    dds::sub::SampleInfo info(size_t index) const;
+
+    // Creates a copy of a sample as a Python object
+    py::object data(size_t index) const;
+
+    // Creates a read-only memoryview of a member of a sample. It's
+    // zero-dimensional for a primitive member and one-dimensional for an
+    // array or a sequence.
+    py::object view(size_t index, const std::string& member_path);
+
+    void return_loan();
+
+    bool is_loan_returned() const
+    {
+        return !loan_;
+    }
+
+private:
+    // Gets a sample, checking that it has valid data
+    rti::sub::LoanedSample<rti::topic::cdr::CSampleWrapper> valid_sample(
+            size_t index) const;
+
+    const NativeMemberLocation& find_member(const std::string& member_path);
+
+    void release_views();
+
+    PyIdlDataReader reader_;
+    IdlLoanPtr loan_;
+    std::vector<py::object> views_;
+    std::unordered_map<std::string, NativeMemberLocation> locations_;
+};
+
+void init_idl_loaned_views(IdlDataReaderPyClass& cls);
+
+}  // namespace pyrti
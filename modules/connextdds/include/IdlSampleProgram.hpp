@@ -0,0 +1,421 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include <rti/topic/cdr/GenericTypePluginFactory.hpp>
+#include <dds/core/xtypes/DynamicData.hpp>
+
+namespace pyrti {
+
+// Primitive member representations in the C sample. Enums are INT32, and
+// bool and char are INT8, matching the ctypes types used in type_plugin.py.
+enum class NativePrimitiveKind {
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    FLOAT32,
+    FLOAT64
+};
+
+size_t native_primitive_size(NativePrimitiveKind kind);
+
+// Python buffer protocol (struct module) format of a primitive kind
+const char* native_primitive_format(NativePrimitiveKind kind);
+
+// Memory layout of a C DDS sequence. This must match the definition of
+// rti.idl_impl.csequence.Sequence.
+struct CSequenceLayout {
+    void* _contiguous_buffer;
+    void* _discontiguous_buffer;
+    void* _read_token1;
+    void* _read_token2;
+    uint32_t _maximum;
+    uint32_t _length;
+    int32_t _sequence_init;
+    int8_t _owned;
+    int8_t _element_alloc_params[3];
+    uint32_t _absolute_maximum;
+    int8_t _element_dealloc_params[2];
+};
+
+// Location in a C sample of a primitive member or of an array or sequence of
+// primitives (see NativeCToPySampleProgram::find_member)
+struct NativeMemberLocation {
+    enum class Kind { PRIMITIVE, ARRAY, SEQUENCE };
+
+    Kind kind = Kind::PRIMITIVE;
+    size_t offset = 0;
+    NativePrimitiveKind primitive_kind = NativePrimitiveKind::INT32;
+    // Array length
+    uint32_t length = 0;
+};
+
+// A compiled version of a Python-to-C rti.idl_impl.sample_interpreter
+// SampleProgram.
+//
+// Instead of running one Python instruction per member on a ctypes object,
+// this program reads the attributes of the dataclass instance through the
+// CPython C API and writes the values directly into the memory of the C sample
+// at the offsets that the GenericTypePluginFactory uses for the type.
+//
+// Members that can't be converted natively (e.g. optionals, unions, or
+// sequences of strings) are converted by a fallback Python SampleProgram
+// that runs only that member's instruction on the ctypes sample. A program
+// without fallbacks is "complete" and can be nested in other programs.
+//
+// @pre All operations require the GIL
+class PYRTI_SYMBOL_HIDDEN NativeSampleProgram {
+public:
+    enum class InstructionKind {
+        PRIMITIVE,
+        STRING,
+        WSTRING,
+        STRUCT,
+        PRIMITIVE_ARRAY,
+        PRIMITIVE_SEQUENCE,
+        STRUCT_ARRAY,
+        STRUCT_SEQUENCE,
+        PYTHON_FALLBACK
+    };
+
+    struct Instruction {
+        InstructionKind kind;
+        py::str field_name;
+        // The same name, used to access the DynamicData member
+        std::string member_name;
+        size_t offset = 0;
+        NativePrimitiveKind primitive_kind = NativePrimitiveKind::INT32;
+        // String bound, array length or sequence member index in the plugin
+        uint32_t length = 0;
+        // Element size for arrays and sequences
+        size_t element_size = 0;
+        // Primitive arrays and sequences that only accept buffer objects
+        bool require_buffer = false;
+        std::shared_ptr<NativeSampleProgram> element_program;
+        // Bound SampleProgram.execute for PYTHON_FALLBACK
+        py::object fallback;
+    };
+
+    // type is the DynamicType of the type plugin, used to decide whether the
+    // program can copy DynamicData samples (see can_copy_dynamic_data)
+    NativeSampleProgram(
+            rti::topic::cdr::CTypePlugin* type_plugin,
+            const rti::core::xtypes::DynamicTypeImpl* type)
+            : type_plugin_(type_plugin), type_(type)
+    {
+    }
+
+    void add_primitive(
+            const std::string& field_name,
+            size_t offset,
+            NativePrimitiveKind kind);
+
+    void add_string(
+            const std::string& field_name,
+            size_t offset,
+            uint32_t bound,
+            bool is_wide);
+
+    void add_struct(
+            const std::string& field_name,
+            size_t offset,
+            std::shared_ptr<NativeSampleProgram> program);
+
+    void add_primitive_array(
+            const std::string& field_name,
+            size_t offset,
+            NativePrimitiveKind kind,
+            uint32_t length,
+            bool require_buffer);
+
+    void add_primitive_sequence(
+            const std::string& field_name,
+            size_t offset,
+            NativePrimitiveKind kind,
+            uint32_t member_index,
+            bool require_buffer);
+
+    void add_struct_array(
+            const std::string& field_name,
+            size_t offset,
+            std::shared_ptr<NativeSampleProgram> element_program,
+            size_t element_size,
+            uint32_t length);
+
+    void add_struct_sequence(
+            const std::string& field_name,
+            size_t offset,
+            std::shared_ptr<NativeSampleProgram> element_program,
+            size_t element_size,
+            uint32_t member_index);
+
+    void add_fallback(const std::string& field_name, py::object program);
+
+    // Copies the Python sample into the C sample.
+    //
+    // c_sample is the memory of the C sample and c_sample_object is the ctypes
+    // object that owns it, used only by the fallback instructions.
+    //
+    // @throw py::error_already_set with a FieldSerializationError
+    void execute(
+            char* c_sample,
+            py::handle py_sample,
+            py::handle c_sample_object) const;
+
+    // Copies a DynamicData sample of the same type into the C sample, member
+    // by member, without serializing it.
+    //
+    // @throw dds::core::UnsupportedError if !can_copy_dynamic_data()
+    void copy_from_dynamic_data(
+            dds::core::xtypes::DynamicData& data,
+            char* c_sample) const;
+
+    bool is_complete() const
+    {
+        return fallback_count_ == 0;
+    }
+
+    // True if the program is complete and all the members of the type can be
+    // copied directly from a DynamicData sample. This is decided when the
+    // instructions are added: wstrings and primitive kinds that the
+    // DynamicData primitive accessors don't support (e.g. wchar) aren't.
+    bool can_copy_dynamic_data() const
+    {
+        return is_complete() && dynamic_data_copyable_;
+    }
+
+    size_t fallback_count() const
+    {
+        return fallback_count_;
+    }
+
+    size_t instruction_count() const
+    {
+        return instructions_.size();
+    }
+
+private:
+    void execute_instruction(
+            const Instruction& instruction,
+            char* c_sample,
+            PyObject* py_member) const;
+
+    void resize_sequence(
+            const Instruction& instruction,
+            char* c_sample,
+            CSequenceLayout& sequence,
+            uint32_t new_size) const;
+
+    rti::topic::cdr::CTypePlugin* type_plugin_;
+    const rti::core::xtypes::DynamicTypeImpl* type_;
+    std::vector<Instruction> instructions_;
+    size_t fallback_count_ = 0;
+    bool dynamic_data_copyable_ = true;
+};
+
+// A compiled version of a C-to-Python rti.idl_impl.sample_interpreter
+// SampleProgram.
+//
+// It creates the dataclass instance and its members directly from the memory
+// of a C sample, without casting it into a ctypes object. When the program is
+// complete and the type allows it, the instance is created without calling
+// its __init__ and the members are stored directly in its __dict__.
+//
+// Members that can't be converted natively run their Python instruction
+// on a ctypes object created from the C sample only when needed.
+//
+// @pre All operations require the GIL
+class PYRTI_SYMBOL_HIDDEN NativeCToPySampleProgram {
+public:
+    enum class InstructionKind {
+        PRIMITIVE,
+        ENUM,
+        STRING,
+        WSTRING,
+        STRUCT,
+        PRIMITIVE_ARRAY,
+        PRIMITIVE_SEQUENCE,
+        STRUCT_ARRAY,
+        STRUCT_SEQUENCE,
+        PYTHON_FALLBACK
+    };
+
+    // How the Python collection for a primitive array or sequence is created;
+    // these correspond to the different Python C-to-Py instructions.
+    enum class CollectionKind {
+        LIST,               // A list of int or float
+        FIXED_SIZE_BUFFER,  // factory() creates a buffer of the array size
+        RESIZABLE_BUFFER,   // factory().resize(length)
+        EXTENDABLE_BUFFER,  // factory().extend([0] * length)
+        SIZED_BUFFER        // factory(length)
+    };
+
+    struct Instruction {
+        InstructionKind kind;
+        py::str field_name;
+        // The same name, used to access the DynamicData member
+        std::string member_name;
+        size_t offset = 0;
+        NativePrimitiveKind primitive_kind = NativePrimitiveKind::INT32;
+        // Array length
+        uint32_t length = 0;
+        // Element size for arrays and sequences
+        size_t element_size = 0;
+        CollectionKind collection_kind = CollectionKind::LIST;
+        std::shared_ptr<NativeCToPySampleProgram> element_program;
+        // Enum type or collection factory
+        py::object factory;
+        // Enum value-to-member map or value of a null string
+        py::object value;
+        // Bound SampleProgram.execute for PYTHON_FALLBACK
+        py::object fallback;
+    };
+
+    // type is the DynamicType of the type plugin (see
+    // can_copy_dynamic_data), py_type is the dataclass (or its default
+    // factory), cast_c_sample converts a pointer to a C sample into a ctypes
+    // object for the fallback instructions, and if construct_empty is true
+    // the dataclass instances may be created without calling __init__.
+    NativeCToPySampleProgram(
+            const rti::core::xtypes::DynamicTypeImpl* type,
+            py::object py_type,
+            py::object cast_c_sample,
+            bool construct_empty)
+            : type_(type),
+              py_type_(std::move(py_type)),
+              cast_c_sample_(std::move(cast_c_sample)),
+              construct_empty_(construct_empty)
+    {
+    }
+
+    void add_primitive(
+            const std::string& field_name,
+            size_t offset,
+            NativePrimitiveKind kind);
+
+    void add_enum(
+            const std::string& field_name,
+            size_t offset,
+            py::object enum_type);
+
+    void add_string(
+            const std::string& field_name,
+            size_t offset,
+            bool is_wide,
+            py::object null_value);
+
+    void add_struct(
+            const std::string& field_name,
+            size_t offset,
+            std::shared_ptr<NativeCToPySampleProgram> program);
+
+    void add_primitive_array(
+            const std::string& field_name,
+            size_t offset,
+            NativePrimitiveKind kind,
+            uint32_t length,
+            CollectionKind collection_kind,
+            py::object factory);
+
+    void add_primitive_sequence(
+            const std::string& field_name,
+            size_t offset,
+            NativePrimitiveKind kind,
+            CollectionKind collection_kind,
+            py::object factory);
+
+    void add_struct_array(
+            const std::string& field_name,
+            size_t offset,
+            std::shared_ptr<NativeCToPySampleProgram> element_program,
+            size_t element_size,
+            uint32_t length);
+
+    void add_struct_sequence(
+            const std::string& field_name,
+            size_t offset,
+            std::shared_ptr<NativeCToPySampleProgram> element_program,
+            size_t element_size);
+
+    void add_fallback(const std::string& field_name, py::object program);
+
+    // Creates a Python sample from the memory of a C sample
+    //
+    // @throw py::error_already_set with a FieldSerializationError
+    py::object create_sample(const char* c_sample) const;
+
+    // Finds a primitive member, or an array or sequence of primitives, by
+    // name. Members of nested structs are separated by a '.', for example
+    // "position.x". Enums are INT32 primitives.
+    //
+    // @return false if the member doesn't exist or it's not primitive
+    bool find_member(
+            const std::string& member_path,
+            NativeMemberLocation& location) const;
+
+    // Copies the C sample into a DynamicData sample of the same type, member
+    // by member, without serializing it.
+    //
+    // @throw dds::core::UnsupportedError if !can_copy_dynamic_data()
+    void copy_to_dynamic_data(
+            const char* c_sample,
+            dds::core::xtypes::DynamicData& data) const;
+
+    bool is_complete() const
+    {
+        return fallback_count_ == 0;
+    }
+
+    // True if the program is complete and all the members of the type can be
+    // copied directly into a DynamicData sample (see
+    // NativeSampleProgram::can_copy_dynamic_data)
+    bool can_copy_dynamic_data() const
+    {
+        return is_complete() && dynamic_data_copyable_;
+    }
+
+    size_t fallback_count() const
+    {
+        return fallback_count_;
+    }
+
+    size_t instruction_count() const
+    {
+        return instructions_.size();
+    }
+
+private:
+    py::object execute_instruction(
+            const Instruction& instruction,
+            const char* c_sample) const;
+
+    py::object create_primitive_collection(
+            const Instruction& instruction,
+            const char* elements,
+            size_t length) const;
+
+    const rti::core::xtypes::DynamicTypeImpl* type_;
+    py::object py_type_;
+    py::object cast_c_sample_;
+    bool construct_empty_;
+    std::vector<Instruction> instructions_;
+    size_t fallback_count_ = 0;
+    bool dynamic_data_copyable_ = true;
+};
+
+}  // namespace pyrti
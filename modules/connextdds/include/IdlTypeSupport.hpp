@@ -12,8 +12,11 @@
 #pragma once
 
 #include "PyConnext.hpp"
+#include <mutex>
 #include <rti/core/xtypes/DynamicTypeImpl.hpp>
 #include <rti/topic/cdr/GenericTypePluginFactory.hpp>
+#include "IdlSampleProgram.hpp"
+#include "PyPerfStats.hpp"
 
 namespace pyrti {
 
@@ -26,6 +29,27 @@ struct TypePlugin {
     rti::topic::cdr::CTypePlugin* type_plugin;
 };
 
+// Copies a C sample into a DynamicData sample of the same type. The members
+// are copied directly when native_program allows it; otherwise the sample
+// is serialized into a native CDR buffer that the DynamicData deserializes.
+//
+// @pre The GIL must be held
+void copy_c_sample_to_dynamic_data(
+        const TypePlugin& plugin,
+        rti::topic::cdr::CSampleWrapper& c_sample,
+        dds::core::xtypes::DynamicData& data,
+        const NativeCToPySampleProgram* native_program);
+
+// Copies a DynamicData sample into a C sample of the same type, the same way
+// as copy_c_sample_to_dynamic_data
+//
+// @pre The GIL must be held
+void copy_dynamic_data_to_c_sample(
+        const TypePlugin& plugin,
+        dds::core::xtypes::DynamicData& data,
+        rti::topic::cdr::CSampleWrapper& c_sample,
+        const NativeSampleProgram* native_program);
+
 //
 // Methods to get the type support for a given type
 //
@@ -144,46 +168,80 @@ struct PyCTypesBuffer {
                 py_buffer.buf);
     }
 };
-// Gets the python TypeSupport from a C++ Topic object, which is stored in its
-// user data.
-inline static py::handle get_py_type_support_from_topic(
-        const dds::topic::TopicDescription<rti::topic::cdr::CSampleWrapper>&
-                topic)
+// Validates the python TypeSupport stored as the user data of a Topic. This
+// doesn't require the GIL (the Topic keeps the TypeSupport alive).
+inline static py::handle get_py_type_support_from_user_data(void* user_data)
 {
-    // TODO PY-17: The type support must be cached in the writer and reader
-    // instead of looked up every time
-    using namespace dds::topic;
-    using namespace rti::topic::cdr;
-    PyObject* user_data = static_cast<PyObject*>(topic->get_user_data_());
-    if (user_data == nullptr) {
-        // If it's null it means that it's of type cft
-        try {
-            user_data = static_cast<PyObject*>(
-                    dds::core::polymorphic_cast<
-                            ContentFilteredTopic<CSampleWrapper>,
-                            TopicDescription<CSampleWrapper>>(topic)
-                            ->topic()
-                            ->get_user_data_());
-        } catch (const dds::core::InvalidDowncastError&) {
-            user_data = nullptr;
-        }
-    }
-
     if (user_data == nullptr) {
         throw dds::core::IllegalOperationError("Not a valid Python Topic");
     }
 
-    auto type_support = py::handle(user_data);
+    auto type_support = py::handle(static_cast<PyObject*>(user_data));
 
 #ifndef NDEBUG
     // this shouldn't fail; for performance reasons, check this only in debug
     // mode
+    py::gil_scoped_acquire acquire;
     assert_valid_type_support(type_support);
 #endif
 
     return type_support;
 }
 
+// Gets the python TypeSupport from a C++ Topic object, which is stored in its
+// user data.
+inline static py::handle get_py_type_support_from_topic(
+        const dds::topic::Topic<rti::topic::cdr::CSampleWrapper>& topic)
+{
+    return get_py_type_support_from_user_data(topic->get_user_data_());
+}
+
+// Gets the python TypeSupport from a Topic or a ContentFilteredTopic. A CFT
+// doesn't have user data, so the TypeSupport is obtained from its related
+// Topic.
+//
+// Endpoints resolve their TypeSupport only once, when they're created (see
+// CPySampleConverter::cache_idl_entity_py_objects), and then use the one in
+// their CPySampleConverter.
+inline static py::handle get_py_type_support_from_topic(
+        const dds::topic::TopicDescription<rti::topic::cdr::CSampleWrapper>&
+                topic)
+{
+    using namespace rti::topic::cdr;
+    using CftDelegate =
+            dds::topic::ContentFilteredTopic<CSampleWrapper>::DELEGATE_T;
+
+    void* user_data = topic->get_user_data_();
+    if (user_data == nullptr) {
+        // Unlike dds::core::polymorphic_cast, a dynamic_pointer_cast doesn't
+        // throw when the description is not a CFT
+        auto cft = std::dynamic_pointer_cast<CftDelegate>(topic.delegate());
+        if (cft) {
+            user_data = cft->topic()->get_user_data_();
+        }
+    }
+
+    return get_py_type_support_from_user_data(user_data);
+}
+
+// Delivers the samples of an IDL DataReader to a Python callback in batches
+// (see DataReader.set_batch_callback in IdlDataReader.cpp)
+class PYRTI_SYMBOL_HIDDEN PyIdlBatchDispatcher {
+public:
+    virtual ~PyIdlBatchDispatcher() = default;
+
+    // Stops delivering batches and waits for the current one to finish,
+    // unless it's called from the callback itself. With flush, the samples
+    // already taken are delivered to the callback before it stops;
+    // otherwise they're discarded.
+    virtual void close(bool flush) = 0;
+
+    // The number of references to the reader that the dispatcher holds
+    // (through its ReadCondition). When no one else references the reader,
+    // it's closed so that the reader can be finalized.
+    virtual long reader_references() const = 0;
+};
+
 // Here we change the visibility because the py::objects have lower visibility
 // and without this we will get compiler warnings
 struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
@@ -194,12 +252,41 @@ struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
     py::handle create_py_sample_func;
     py::handle create_c_sample_func;
     py::handle convert_to_c_sample_func;
-    py::object c_sample;  // Reusable ctypes sample used to temporarily convert
-                          // a python object into its C representation
+    // Compiled versions of convert_to_c_sample_func and create_py_sample_func;
+    // null if the type doesn't have them (e.g. unions)
+    NativeSampleProgram* native_py_to_c_program;
+    NativeCToPySampleProgram* native_c_to_py_program;
+    // Reusable ctypes sample used to temporarily convert a python object
+    // into its C representation (e.g. for lookup_instance). Like the pool
+    // below, it's only used while holding the entity lock (EntityLock), not
+    // just the GIL.
+    py::object c_sample;
     PyCTypesBuffer c_sample_buffer;  // This buffer points to the memory of
                                      // c_sample
-
-    CPySampleConverter(py::handle the_type_support)
+    // Additional reusable ctypes samples (and their buffers) used to convert
+    // several python objects before writing them (see
+    // IdlWriteImpl::py_write_range). The pool grows on demand up to
+    // c_sample_pool_max_size.
+    std::vector<py::object> c_sample_pool;
+    std::vector<PyCTypesBuffer> c_sample_pool_buffers;
+    size_t c_sample_pool_max_size = 128;
+    // Pre-initialized ctypes samples used by individual writes (see
+    // IdlWriteImpl::py_write). Each thread converts into a slot it acquires
+    // from this pool, so several threads can convert samples for the same
+    // DataWriter at the same time. The size is configured with the
+    // DataWriter property "python.data_writer.c_sample_pool_size".
+    std::vector<py::object> write_slots;
+    std::vector<PyCTypesBuffer> write_slot_buffers;
+    std::vector<size_t> free_write_slots;
+    std::mutex write_slots_mutex;
+    // The dispatcher installed by DataReader.set_batch_callback, if any.
+    // Use exchange_batch_dispatcher() to access it.
+    std::shared_ptr<PyIdlBatchDispatcher> batch_dispatcher;
+    std::mutex batch_dispatcher_mutex;
+    // The perf stats of the entity (see PyPerfStatsSlot)
+    PyPerfStatsSlot perf_stats;
+
+    CPySampleConverter(py::handle the_type_support, size_t write_slot_count = 0)
             : type_support(the_type_support),
               type_plugin(py::cast<TypePlugin>(
                                   type_support.attr("_plugin_dynamic_type"))
@@ -211,21 +298,138 @@ struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
                                            .attr("_create_empty_c_sample")),
               convert_to_c_sample_func(
                       py::type::of(type_support).attr("_convert_to_c_sample")),
+              native_py_to_c_program(get_native_program<NativeSampleProgram>(
+                      type_support,
+                      "_native_py_to_c_program")),
+              native_c_to_py_program(
+                      get_native_program<NativeCToPySampleProgram>(
+                              type_support,
+                              "_native_c_to_py_program")),
               c_sample(create_c_sample_func(type_support)),
               c_sample_buffer(c_sample)
     {
+        write_slots.reserve(write_slot_count);
+        write_slot_buffers.reserve(write_slot_count);
+        free_write_slots.reserve(write_slot_count);
+        for (size_t i = 0; i < write_slot_count; i++) {
+            write_slots.push_back(create_c_sample_func(type_support));
+            write_slot_buffers.emplace_back(write_slots.back());
+            free_write_slots.push_back(i);
+        }
     }
 
-    // Disable copies
+    // Disable copies and moves (the write slots are shared by several
+    // threads)
     CPySampleConverter(const CPySampleConverter&) = delete;
     CPySampleConverter& operator=(const CPySampleConverter&) = delete;
-    // Default move
-    CPySampleConverter(CPySampleConverter&&) = default;
-    CPySampleConverter& operator=(CPySampleConverter&&) = default;
+    CPySampleConverter(CPySampleConverter&&) = delete;
+    CPySampleConverter& operator=(CPySampleConverter&&) = delete;
+
+    // Acquires a write slot if one is available. It never waits, because a
+    // thread that already holds the writer EA (e.g. in a listener callback)
+    // would deadlock with a thread that holds a slot and waits for the EA.
+    bool try_acquire_write_slot(size_t& index)
+    {
+        std::lock_guard<std::mutex> lock(write_slots_mutex);
+        if (free_write_slots.empty()) {
+            return false;
+        }
+        index = free_write_slots.back();
+        free_write_slots.pop_back();
+        return true;
+    }
+
+    void release_write_slot(size_t index)
+    {
+        std::lock_guard<std::mutex> lock(write_slots_mutex);
+        free_write_slots.push_back(index);
+    }
+
+    // Converts a python object into an acquired write slot and returns its
+    // buffer
+    PyCTypesBuffer& convert_to_write_slot(
+            size_t index,
+            const py::object& py_sample)
+    {
+        convert_to_c_sample(
+                py_sample,
+                write_slots[index],
+                write_slot_buffers[index]);
+        return write_slot_buffers[index];
+    }
+
+    // Replaces the batch dispatcher and returns the previous one, which the
+    // caller must close after this returns (closing it waits for its thread,
+    // which must not happen while holding the lock)
+    std::shared_ptr<PyIdlBatchDispatcher> exchange_batch_dispatcher(
+            std::shared_ptr<PyIdlBatchDispatcher> dispatcher)
+    {
+        std::lock_guard<std::mutex> lock(batch_dispatcher_mutex);
+        batch_dispatcher.swap(dispatcher);
+        return dispatcher;
+    }
+
+    long batch_dispatcher_reader_references()
+    {
+        std::lock_guard<std::mutex> lock(batch_dispatcher_mutex);
+        return batch_dispatcher != nullptr
+                ? batch_dispatcher->reader_references()
+                : 0;
+    }
 
     void convert_to_c_sample(const py::object& py_sample)
     {
-        convert_to_c_sample_func(type_support, c_sample, py_sample);
+        convert_to_c_sample(py_sample, c_sample, c_sample_buffer);
+    }
+
+    // Converts a python object into the C sample at position index of the
+    // pool, creating it if needed, and returns its buffer
+    PyCTypesBuffer& convert_to_pool_c_sample(
+            size_t index,
+            const py::object& py_sample)
+    {
+        RTI_CHECK_PRECONDITION(index < c_sample_pool_max_size);
+        if (index >= c_sample_pool.size()) {
+            c_sample_pool.push_back(create_c_sample_func(type_support));
+            c_sample_pool_buffers.emplace_back(c_sample_pool.back());
+        }
+
+        convert_to_c_sample(
+                py_sample,
+                c_sample_pool[index],
+                c_sample_pool_buffers[index]);
+        return c_sample_pool_buffers[index];
+    }
+
+    void convert_to_c_sample(
+            const py::object& py_sample,
+            const py::object& target,
+            PyCTypesBuffer& target_buffer)
+    {
+        if (native_py_to_c_program != nullptr) {
+            type_plugin->finalize_optional_members(target_buffer);
+            native_py_to_c_program->execute(
+                    static_cast<char*>(target_buffer.py_buffer.buf),
+                    py_sample,
+                    target);
+            return;
+        }
+
+        convert_to_c_sample_func(type_support, target, py_sample);
+    }
+
+    template<typename ProgramType>
+    static ProgramType* get_native_program(
+            py::handle type_support,
+            const char* attr_name)
+    {
+        py::object program = type_support.attr(attr_name);
+        if (program.is_none()) {
+            return nullptr;
+        }
+
+        // The TypeSupport keeps the program alive
+        return py::cast<ProgramType*>(program);
     }
 
     ~CPySampleConverter()
@@ -242,15 +446,42 @@ struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
         if (type_plugin != nullptr && c_sample) {
             type_plugin->finalize_sample(c_sample_buffer);
         }
+
+        if (type_plugin != nullptr) {
+            for (auto& buffer : c_sample_pool_buffers) {
+                type_plugin->finalize_sample(buffer);
+            }
+        }
+        c_sample_pool_buffers.clear();
+        c_sample_pool.clear();
+
+        if (type_plugin != nullptr) {
+            for (auto& buffer : write_slot_buffers) {
+                type_plugin->finalize_sample(buffer);
+            }
+        }
+        free_write_slots.clear();
+        write_slot_buffers.clear();
+        write_slots.clear();
     }
 
     py::object create_py_sample()
     {
+        return create_py_sample(
+                static_cast<rti::topic::cdr::CSampleWrapper&>(c_sample_buffer));
+    }
+
+    // Creates a Python sample from a C sample (e.g. a loaned sample)
+    py::object create_py_sample(const rti::topic::cdr::CSampleWrapper& sample)
+    {
+        if (native_c_to_py_program != nullptr) {
+            return native_c_to_py_program->create_sample(
+                    static_cast<const char*>(sample.sample()));
+        }
+
         // We pass the pointer to the python function as an integer,
         // because that's what ctypes.cast expects.
-        size_t sample_ptr = reinterpret_cast<size_t>(
-                (static_cast<rti::topic::cdr::CSampleWrapper&>(c_sample_buffer))
-                        .sample());
+        size_t sample_ptr = reinterpret_cast<size_t>(sample.sample());
         return create_py_sample_func(type_support, sample_ptr);
     }
 
@@ -261,10 +492,24 @@ struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
         return sample_tuple_type(py_data, py::cast(info));
     }
 
+    py::object create_py_data_info_sample(
+        py::object& py_data,
+        py::object&& py_info)
+    {
+        return sample_tuple_type(py_data, py_info);
+    }
+
+    // Creates the CPySampleConverter for an IDL DataWriter or DataReader and
+    // stores it as the entity's user data, where get_py_sample_converter()
+    // finds it.
+    //
+    // type_support must be the one of the entity's topic; the creation
+    // functions resolve it once and also use it to configure the entity Qos.
+    // DataWriters also specify the number of write slots they need.
     static void cache_idl_entity_py_objects(
             dds::core::Entity entity,
-            const dds::topic::TopicDescription<
-                    rti::topic::cdr::CSampleWrapper>& topic)
+            py::handle type_support,
+            size_t write_slot_count = 0)
     {
         using rti::core::memory::ObjectAllocator; 
 
@@ -273,13 +518,19 @@ struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
             py::gil_scoped_acquire acquire;
 
             // Obtain all the cached objects
-            auto type_support =
-                    get_py_type_support_from_topic(topic);
             auto obj_cache =
-                    ObjectAllocator<CPySampleConverter>::create(type_support);
+                    ObjectAllocator<CPySampleConverter>::create(
+                            type_support,
+                            write_slot_count);
             entity->set_user_data_(obj_cache, [](void* ptr) {
                 py::gil_scoped_acquire acquire;
                 auto obj_cache = static_cast<CPySampleConverter*>(ptr);
+                // The batch dispatcher uses the converter, so it must stop
+                // first
+                auto dispatcher = obj_cache->exchange_batch_dispatcher(nullptr);
+                if (dispatcher != nullptr) {
+                    dispatcher->close(false);
+                }
                 obj_cache->finalize_c_sample();
                 ObjectAllocator<CPySampleConverter>::destroy(
                         static_cast<CPySampleConverter*>(ptr));
@@ -288,6 +539,60 @@ struct PYRTI_SYMBOL_HIDDEN CPySampleConverter {
     }
 };
 
+// Holds one of the write slots of a CPySampleConverter while it's in scope,
+// if one was available
+class PYRTI_SYMBOL_HIDDEN CPySampleWriteSlot {
+public:
+    explicit CPySampleWriteSlot(CPySampleConverter& converter)
+            : converter_(converter),
+              index_(0),
+              acquired_(converter.try_acquire_write_slot(index_))
+    {
+    }
+
+    ~CPySampleWriteSlot()
+    {
+        if (acquired_) {
+            converter_.release_write_slot(index_);
+        }
+    }
+
+    bool acquired() const
+    {
+        return acquired_;
+    }
+
+    CPySampleWriteSlot(const CPySampleWriteSlot&) = delete;
+    CPySampleWriteSlot& operator=(const CPySampleWriteSlot&) = delete;
+
+    // @pre The GIL must be held
+    PyCTypesBuffer& convert(const py::object& py_sample)
+    {
+        return converter_.convert_to_write_slot(index_, py_sample);
+    }
+
+    PyCTypesBuffer& buffer()
+    {
+        return converter_.write_slot_buffers[index_];
+    }
+
+private:
+    CPySampleConverter& converter_;
+    size_t index_;
+    bool acquired_;
+};
+
+// Gets the CPySampleConverter of an IDL DataWriter or DataReader, cached when
+// the entity was created
+template<typename EntityType>
+inline CPySampleConverter* get_py_sample_converter(EntityType& entity)
+{
+    auto converter =
+            static_cast<CPySampleConverter*>(entity->get_user_data_());
+    RTI_CHECK_PRECONDITION(converter != nullptr);
+    return converter;
+}
+
 // Implements the creation of IDL endpoints for XML App Creation
 class OMG_DDS_API PyFactoryIdlPluginSupport 
     : private rti::domain::FactoryPluginSupport {
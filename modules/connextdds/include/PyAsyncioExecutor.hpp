@@ -13,7 +13,6 @@
 
 #include "PyConnext.hpp"
 #include <functional>
-#include <mutex>
 
 namespace pyrti {
 
@@ -22,8 +21,7 @@ public:
     template<typename T>
     static py::object run(std::function<T()> func)
     {
-        auto instance = PyAsyncioExecutor::get_instance();
-        py::object loop = instance.get_running_loop();
+        py::object loop = get_running_loop();
         py::object run_in_executor = loop.attr("run_in_executor");
         return run_in_executor(nullptr, std::function<T()>([func]() -> T {
                                    py::gil_scoped_release release;
@@ -32,13 +30,8 @@ public:
     }
 
 private:
-    static std::unique_ptr<PyAsyncioExecutor> instance;
-    static std::recursive_mutex lock;
-    py::object asyncio;
-    py::object get_running_loop;
-
-    PyAsyncioExecutor();
-    static PyAsyncioExecutor& get_instance();
+    // @pre The GIL must be held
+    static py::object get_running_loop();
 };
 
 }  // namespace pyrti
@@ -12,6 +12,7 @@
 #pragma once
 #include "PyConnext.hpp"
 #include <pybind11/stl_bind.h>
+#include <cstring>
 
 
 namespace pyrti {
@@ -129,12 +130,139 @@ std::vector<T> create_vector_from_py_bytes(py::bytes bytes)
             reinterpret_cast<const T*>(buffer) + (length / sizeof(T)));
 }
 
+// Whether the elements of a buffer have the same representation as T
+template<typename T>
+static bool is_compatible_buffer(const py::buffer_info& info)
+{
+    return info.ndim == 1
+            && py::detail::compare_buffer_info<T>::compare(info);
+}
+
+template<typename T>
+void vector_extend_from_buffer(std::vector<T>& v, const py::buffer& buffer)
+{
+    auto info = buffer.request();
+    if (!is_compatible_buffer<T>(info)) {
+        // Other element types are converted one by one
+        for (auto item : buffer) {
+            v.push_back(item.cast<T>());
+        }
+        return;
+    }
+
+    auto src = static_cast<const char*>(info.ptr);
+    auto count = static_cast<size_t>(info.shape[0]);
+    auto stride = info.strides[0];
+    if (!v.empty() && src >= reinterpret_cast<const char*>(v.data())
+        && src < reinterpret_cast<const char*>(v.data() + v.size())) {
+        // The buffer is this vector, which resizing may reallocate
+        std::vector<T> values;
+        vector_extend_from_buffer(values, buffer);
+        v.insert(v.end(), values.begin(), values.end());
+        return;
+    }
+
+    size_t offset = v.size();
+    vector_resize_no_init(v, offset + count);
+    if (stride == static_cast<py::ssize_t>(sizeof(T))) {
+        std::memcpy(v.data() + offset, src, count * sizeof(T));
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            std::memcpy(
+                    &v[offset + i],
+                    src + static_cast<py::ssize_t>(i) * stride,
+                    sizeof(T));
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> create_vector_from_buffer(const py::buffer& buffer)
+{
+    std::vector<T> v;
+    vector_extend_from_buffer(v, buffer);
+    return v;
+}
+
+template<typename T>
+std::vector<T> vector_get_slice(const std::vector<T>& v, const py::slice& slice)
+{
+    size_t start = 0, stop = 0, step = 0, length = 0;
+    if (!slice.compute(v.size(), &start, &stop, &step, &length)) {
+        throw py::error_already_set();
+    }
+
+    if (step == 1) {
+        return std::vector<T>(v.begin() + start, v.begin() + start + length);
+    }
+    std::vector<T> retval;
+    retval.reserve(length);
+    for (size_t i = 0; i < length; ++i, start += step) {
+        retval.push_back(v[start]);
+    }
+    return retval;
+}
+
+template<typename T>
+void vector_set_slice(
+        std::vector<T>& v,
+        const py::slice& slice,
+        const py::buffer& buffer)
+{
+    size_t start = 0, stop = 0, step = 0, length = 0;
+    if (!slice.compute(v.size(), &start, &stop, &step, &length)) {
+        throw py::error_already_set();
+    }
+
+    auto values = create_vector_from_buffer<T>(buffer);
+    if (values.size() != length) {
+        throw py::value_error(
+                "Left and right hand size of slice assignment have "
+                "different sizes!");
+    }
+    if (step == 1) {
+        std::copy(values.begin(), values.end(), v.begin() + start);
+        return;
+    }
+    for (size_t i = 0; i < length; ++i, start += step) {
+        v[start] = values[i];
+    }
+}
+
 
 template<typename T>
 void bind_buffer_vector(const py::object& m, const char* name, const char* alias = nullptr)
 {
     auto cls = py::bind_vector<std::vector<T>>(m, name, py::buffer_protocol());
     cls.def(py::init<typename std::vector<T>::size_type>());
+
+    // These overloads take precedence over the ones of stl_bind, which
+    // convert the elements one by one
+    cls.def(py::init(&pyrti::create_vector_from_buffer<T>),
+            py::arg("buffer"),
+            py::prepend(),
+            "Copy the elements of a buffer (e.g. a NumPy array, an "
+            "array.array or bytes). A buffer with the same element type "
+            "is copied at once.");
+    cls.def("extend",
+            &pyrti::vector_extend_from_buffer<T>,
+            py::arg("buffer"),
+            py::prepend(),
+            "Append the elements of a buffer. A buffer with the same "
+            "element type is copied at once.");
+    cls.def("__getitem__",
+            &pyrti::vector_get_slice<T>,
+            py::arg("slice"),
+            py::prepend(),
+            py::return_value_policy::move,
+            "Copy the elements of a slice into a new sequence.");
+    cls.def("__setitem__",
+            &pyrti::vector_set_slice<T>,
+            py::arg("slice"),
+            py::arg("buffer"),
+            py::prepend(),
+            "Assign the elements of a buffer to a slice of the same "
+            "length.");
     cls.def("__mul__",
             &pyrti::vector_replicate<T>,
             py::return_value_policy::move);
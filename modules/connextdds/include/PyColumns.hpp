@@ -0,0 +1,65 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include "IdlSampleProgram.hpp"
+
+namespace pyrti {
+
+// A column of DataReader.take_columns(): the values of one primitive member
+// of all the samples, stored contiguously.
+//
+// Columns are filled without the GIL and then moved into the dds.<Type>Seq
+// (e.g. dds.Float64Seq) that corresponds to their type, which supports the
+// buffer protocol (numpy.asarray doesn't copy it).
+class PYRTI_SYMBOL_HIDDEN PyColumn {
+public:
+    static std::unique_ptr<PyColumn> create(
+            NativePrimitiveKind kind,
+            size_t capacity);
+
+    virtual ~PyColumn() = default;
+
+    // Appends one value from memory (e.g. a member of a C sample), which
+    // must contain a value of this column's kind
+    virtual void append(const char* value) = 0;
+
+    // @pre The GIL must be held
+    virtual py::object to_python() = 0;
+};
+
+// The SampleInfo columns of take_columns(). Timestamps are in nanoseconds.
+class PYRTI_SYMBOL_HIDDEN PySampleInfoColumns {
+public:
+    // with_valid adds an "info.valid" column (1 or 0), for columns that
+    // include samples without valid data
+    explicit PySampleInfoColumns(size_t capacity, bool with_valid = false);
+
+    void append(const dds::sub::SampleInfo& info);
+
+    // Adds the columns as "info.source_timestamp",
+    // "info.reception_timestamp", "info.instance_handle" and, if enabled,
+    // "info.valid"
+    //
+    // @pre The GIL must be held
+    void add_to(py::dict& columns);
+
+private:
+    bool with_valid_;
+    std::vector<uint8_t> valid_;
+    std::vector<rti::core::int64> source_timestamps_;
+    std::vector<rti::core::int64> reception_timestamps_;
+    std::vector<dds::core::InstanceHandle> instance_handles_;
+};
+
+}  // namespace pyrti
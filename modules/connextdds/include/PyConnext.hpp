@@ -61,10 +61,13 @@
 #include "PyOpaqueTypes.hpp"
 #include <pybind11/operators.h>
 #include <list>
+#include <type_traits>
+#include <typeindex>
 #include <dds/core/External.hpp>
 #include <dds/core/Optional.hpp>
 #include <rti/core/OptionalValue.hpp>
 #include <dds/core/xtypes/DynamicType.hpp>
+#include <rti/core/EntityLock.hpp>
 
 #ifdef _MSC_VER
     #undef PLATFORM
@@ -78,9 +81,56 @@ namespace pyrti {
 
 using DefInitFunc = std::function<void()>;
 using ClassInitFunc = std::function<DefInitFunc()>;
-using ClassInitList = std::list<ClassInitFunc>;
 using DefInitVector = std::vector<DefInitFunc>;
 
+// Registers one or more classes and returns the def init that adds their
+// members. run_class_inits() runs it once the base classes it declares are
+// registered, so a class init must declare the bases it doesn't register
+// itself, and the classes it registers that other class inits derive from.
+// A plain function declares neither.
+struct ClassInit {
+    template<
+            typename F,
+            typename = typename std::enable_if<
+                    std::is_convertible<F, ClassInitFunc>::value>::type>
+    ClassInit(
+            F func,
+            std::vector<std::type_index> types = {},
+            std::vector<std::type_index> bases = {})
+            : func(std::move(func)),
+              types(std::move(types)),
+              bases(std::move(bases))
+    {
+    }
+
+    ClassInitFunc func;
+    std::vector<std::type_index> types;
+    std::vector<std::type_index> bases;
+};
+
+using ClassInitList = std::list<ClassInit>;
+
+template<typename... Types>
+std::vector<std::type_index> class_types()
+{
+    return { std::type_index(typeid(Types))... };
+}
+
+// The base classes among the options of py::class_<T, Options...>. Like
+// pybind11, the options that T derives from are its bases; the others are
+// its holder and trampoline.
+template<typename T, typename... Options>
+std::vector<std::type_index> class_bases()
+{
+    std::vector<std::type_index> bases;
+    int expand[] = { 0,
+                     (py::detail::is_strict_base_of<Options, T>::value
+                              ? (bases.emplace_back(typeid(Options)), 0)
+                              : 0)... };
+    (void) expand;
+    return bases;
+}
+
 template<typename T>
 void process_inits(py::module&, ClassInitList&);
 
@@ -95,6 +145,18 @@ DefInitFunc init_class(py::object& parent, const std::string& cls_name)
     return ([cls]() mutable { init_class_defs<T>(cls); });
 }
 
+// The class init that registers py::class_<T, Bases...> in parent
+template<typename T, typename... Bases>
+ClassInit class_init(py::object parent, const std::string& cls_name)
+{
+    return ClassInit(
+            [parent, cls_name]() mutable {
+                return init_class<T, Bases...>(parent, cls_name);
+            },
+            class_types<T>(),
+            class_bases<T, Bases...>());
+}
+
 template<typename from_class, typename to_class, typename py_to_class>
 void add_conversion(
         py_to_class& cls,
@@ -200,6 +262,32 @@ TPtr downcast_listener_ptr(TBasePtr p) {
 }
 #endif
 
+// Replaces the listener of an entity and returns the previous one, whose
+// Python reference the caller must release. The listener is read and replaced
+// while holding the entity lock, so when several threads replace it at the
+// same time each previous listener is returned (and released) only once.
+//
+// @pre The GIL must not be held, since listener callbacks hold the entity
+// lock while they wait for the GIL
+template<typename TEntity, typename TBaseListenerPtr, typename TListenerPtr>
+TBaseListenerPtr exchange_listener(
+        TEntity& entity,
+        TListenerPtr listener,
+        const dds::core::status::StatusMask& mask) {
+    rti::core::EntityLock lock(entity);
+    auto old_listener = get_listener<TEntity, TBaseListenerPtr>(entity);
+    set_listener<TEntity, TListenerPtr>(entity, listener, mask);
+    return old_listener;
+}
+
+template<typename TEntity, typename TBaseListenerPtr, typename TListenerPtr>
+TBaseListenerPtr exchange_listener(TEntity& entity, TListenerPtr listener) {
+    rti::core::EntityLock lock(entity);
+    auto old_listener = get_listener<TEntity, TBaseListenerPtr>(entity);
+    set_listener<TEntity, TListenerPtr>(entity, listener);
+    return old_listener;
+}
+
 py::object py_cast_type(
         dds::core::xtypes::DynamicType&,
         bool resolve_alias = true);
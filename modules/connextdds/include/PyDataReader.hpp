@@ -28,6 +28,8 @@
 #include "PyDataReaderListener.hpp"
 #include "PyContentFilteredTopic.hpp"
 #include "PyAsyncioExecutor.hpp"
+#include "PyPerfStats.hpp"
+#include "PyModuleInit.hpp"
 
 namespace pyrti {
 
@@ -65,6 +67,27 @@ inline void set_dr_listener(
     set_listener<dds::sub::DataReader<T>, PyDataReaderListenerPtr<T>>(dr, l, m);
 }
 
+template<typename T>
+inline DataReaderListenerPtr<T> exchange_dr_listener(
+        dds::sub::DataReader<T>& dr,
+        PyDataReaderListenerPtr<T> l) {
+    return exchange_listener<
+            dds::sub::DataReader<T>,
+            DataReaderListenerPtr<T>,
+            PyDataReaderListenerPtr<T>>(dr, l);
+}
+
+template<typename T>
+inline DataReaderListenerPtr<T> exchange_dr_listener(
+        dds::sub::DataReader<T>& dr,
+        PyDataReaderListenerPtr<T> l,
+        const dds::core::status::StatusMask& m) {
+    return exchange_listener<
+            dds::sub::DataReader<T>,
+            DataReaderListenerPtr<T>,
+            PyDataReaderListenerPtr<T>>(dr, l, m);
+}
+
 template<typename T>
 inline PyDataReaderListenerPtr<T> downcast_dr_listener_ptr(DataReaderListenerPtr<T> l) {
     return downcast_listener_ptr<PyDataReaderListenerPtr<T>, DataReaderListenerPtr<T>>(l);
@@ -77,26 +100,40 @@ public:
     virtual dds::sub::Query create_query(
             const std::string&,
             const std::vector<std::string>&) = 0;
+
+    // Counts (and marks as read) up to max_samples samples that match the
+    // condition, without converting them to Python
+    virtual int32_t py_count_samples(
+            const dds::sub::cond::ReadCondition& condition,
+            int32_t max_samples) = 0;
 };
 
+// The timer, if active, records the GIL acquisition and the conversion in
+// the perf stats of the DataReader
 template<typename T>
 py::list copy_data_to_py_list(
-    dds::sub::LoanedSamples<T>&& samples)
+    dds::sub::LoanedSamples<T>&& samples,
+    PyPerfTimer timer = PyPerfTimer())
 {
     py::gil_scoped_acquire acquire;
+    timer.lap(PyPerfPhase::GIL_WAIT);
     py::list data;
     for (auto sample : samples) {
         if (sample.info().valid()) {
             data.append(T(sample.data()));
         }
     }
+    timer.lap(PyPerfPhase::CONVERSION);
     return data;
 }
 
 template<typename T>
-py::list copy_data_w_info_to_py_list(dds::sub::LoanedSamples<T>&& samples)
+py::list copy_data_w_info_to_py_list(
+    dds::sub::LoanedSamples<T>&& samples,
+    PyPerfTimer timer = PyPerfTimer())
 {
     py::gil_scoped_acquire acquire;
+    timer.lap(PyPerfPhase::GIL_WAIT);
     if (samples.length() == 0) {
         return py::list();
     }
@@ -110,9 +147,28 @@ py::list copy_data_w_info_to_py_list(dds::sub::LoanedSamples<T>&& samples)
                 info.valid() ? py::cast(T(sample.data())) : py::none(),
                 info));
     }
+    timer.lap(PyPerfPhase::CONVERSION);
     return data;
 }
 
+// The helper objects that a reader of type T owns and that hold references
+// to it, which don't count as users of the reader. Specialized for IDL
+// readers, whose batch dispatcher holds a ReadCondition (see
+// IdlDataReader.hpp).
+template<typename T>
+struct PyDataReaderHelpers {
+    // The number of references to the reader held by its helpers
+    static long reader_references(dds::sub::DataReader<T>&)
+    {
+        return 0;
+    }
+
+    // Stops the helpers, which release their references
+    static void close(dds::sub::DataReader<T>&)
+    {
+    }
+};
+
 template<typename T>
 class PyDataReader : public dds::sub::DataReader<T>, public PyIDataReader {
 public:
@@ -171,11 +227,24 @@ public:
     virtual ~PyDataReader()
     {
         if (*this != dds::core::null) {
+            // When only the helpers reference the reader, stop them so that
+            // it can be finalized
+            auto helper_references =
+                    PyDataReaderHelpers<T>::reader_references(*this);
+            if (helper_references > 0
+                    && this->delegate().use_count()
+                            <= LISTENER_USE_COUNT_MIN + helper_references
+                    && !this->delegate()->closed()) {
+                PyDataReaderHelpers<T>::close(*this);
+            }
+
             if (this->delegate().use_count() <= LISTENER_USE_COUNT_MIN && !this->delegate()->closed()) {
-                auto listener_ptr = get_dr_listener(*this);
+                PyDataReaderListenerPtr<T> null_listener = nullptr;
+                auto listener_ptr = exchange_dr_listener(
+                        *this,
+                        null_listener,
+                        dds::core::status::StatusMask::none());
                 if (nullptr != listener_ptr) {
-                    PyDataReaderListenerPtr<T> null_listener = nullptr;
-                    set_dr_listener(*this, null_listener, dds::core::status::StatusMask::none());
                     {
                         py::gil_scoped_acquire acquire;
                         py::cast(listener_ptr).dec_ref();
@@ -238,15 +307,19 @@ public:
 
     void py_close() override
     {
-        auto listener_ptr = get_dr_listener(*this);
+        PyDataReaderListenerPtr<T> null_listener = nullptr;
+        auto listener_ptr = exchange_dr_listener(
+                *this,
+                null_listener,
+                dds::core::status::StatusMask::none());
         if (nullptr != listener_ptr) {
-            PyDataReaderListenerPtr<T> null_listener = nullptr;
-            set_dr_listener(*this, null_listener, dds::core::status::StatusMask::none());
             {
                 py::gil_scoped_acquire acquire;
                 py::cast(listener_ptr).dec_ref();
             }
         }
+        PyDataReaderHelpers<T>::close(*this);
+        PyPerfStats::release(*this);
         this->close();
     }
 
@@ -287,25 +360,55 @@ public:
         return dds::sub::Query(*this, expression, params);
     }
 
+    int32_t py_count_samples(
+            const dds::sub::cond::ReadCondition& condition,
+            int32_t max_samples) override
+    {
+        return static_cast<int32_t>(this->select()
+                                            .max_samples(max_samples)
+                                            .condition(condition)
+                                            .read()
+                                            .length());
+    }
+
     py::list py_take_data()
     {
-        return copy_data_to_py_list(this->take());
+        PyPerfTimer timer(*this);
+        auto samples = this->take();
+        timer.lap(PyPerfPhase::NATIVE_CALL);
+        return copy_data_to_py_list(std::move(samples), std::move(timer));
     }
 
     py::list py_read_data()
     {
-        return copy_data_to_py_list(this->read());
+        PyPerfTimer timer(*this);
+        auto samples = this->read();
+        timer.lap(PyPerfPhase::NATIVE_CALL);
+        return copy_data_to_py_list(std::move(samples), std::move(timer));
     }
 
     py::list py_take()
     {
-        return copy_data_w_info_to_py_list(this->take());
+        PyPerfTimer timer(*this);
+        auto samples = this->take();
+        timer.lap(PyPerfPhase::NATIVE_CALL);
+        return copy_data_w_info_to_py_list(
+                std::move(samples),
+                std::move(timer));
     }
 
     py::list py_read()
     {
-        return copy_data_w_info_to_py_list(this->read());
+        PyPerfTimer timer(*this);
+        auto samples = this->read();
+        timer.lap(PyPerfPhase::NATIVE_CALL);
+        return copy_data_w_info_to_py_list(
+                std::move(samples),
+                std::move(timer));
     }
+
+private:
+    PyPerfStatsAttachment perf_stats_attachment_ { *this };
 };
 
 template<typename T>
@@ -413,6 +516,15 @@ void init_dds_typed_datareader_base_template(PyDataReaderClass<T>& cls)
                         return dr;
                     },
                     "Returns the filter state for the read/take operations.")
+            .def_property_readonly(
+                    "perf_stats",
+                    [](const PyDataReader<T>& dr) {
+                        py::gil_scoped_release guard;
+                        return PyPerfStats::get(dr);
+                    },
+                    "The latency histograms of the phases of the read and "
+                    "take operations of this DataReader. They're recorded "
+                    "only while PerfStats.enabled is True.")
             .def(py::self == py::self,
                  py::call_guard<py::gil_scoped_release>(),
                  "Test for equality.")
@@ -447,8 +559,7 @@ void init_dds_typed_datareader_base_template(PyDataReaderClass<T>& cls)
                             py::gil_scoped_acquire acquire;
                             py::cast(listener).inc_ref();
                         }
-                        auto old_listener = get_dr_listener(dr);
-                        set_dr_listener(dr, listener);
+                        auto old_listener = exchange_dr_listener(dr, listener);
                         if (nullptr != old_listener) {
                             py::gil_scoped_acquire acquire;
                             py::cast(old_listener).dec_ref();
@@ -464,8 +575,7 @@ void init_dds_typed_datareader_base_template(PyDataReaderClass<T>& cls)
                             py::gil_scoped_acquire acquire;
                             py::cast(listener).inc_ref();
                         }
-                        auto old_listener = get_dr_listener(dr);
-                        set_dr_listener(dr, listener, m);
+                        auto old_listener = exchange_dr_listener(dr, listener, m);
                         if (nullptr != old_listener) {
                             py::gil_scoped_acquire acquire;
                             py::cast(old_listener).dec_ref();
@@ -683,6 +793,7 @@ void init_dds_typed_datareader_base_template(PyDataReaderClass<T>& cls)
                     "matched_publication_data",
                     [](const PyDataReader<T>& dr,
                        const dds::core::InstanceHandle& h) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         return dds::sub::matched_publication_data<T>(dr, h);
                     },
                     py::arg("handle"),
@@ -693,6 +804,7 @@ void init_dds_typed_datareader_base_template(PyDataReaderClass<T>& cls)
                     "matched_publication_participant_data",
                     [](const PyDataReader<T>& dr,
                        const dds::core::InstanceHandle& h) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         return rti::sub::matched_publication_participant_data<T>(dr, h);
                     },
                     py::arg("handle"),
@@ -22,6 +22,8 @@
 #include "PyTopic.hpp"
 #include "PyDataWriterListener.hpp"
 #include "PyAsyncioExecutor.hpp"
+#include "PyPerfStats.hpp"
+#include "PyModuleInit.hpp"
 
 
 namespace pyrti {
@@ -60,6 +62,27 @@ inline void set_dw_listener(
     set_listener<dds::pub::DataWriter<T>, PyDataWriterListenerPtr<T>>(dw, l, m);
 }
 
+template<typename T>
+inline DataWriterListenerPtr<T> exchange_dw_listener(
+        dds::pub::DataWriter<T>& dw,
+        PyDataWriterListenerPtr<T> l) {
+    return exchange_listener<
+            dds::pub::DataWriter<T>,
+            DataWriterListenerPtr<T>,
+            PyDataWriterListenerPtr<T>>(dw, l);
+}
+
+template<typename T>
+inline DataWriterListenerPtr<T> exchange_dw_listener(
+        dds::pub::DataWriter<T>& dw,
+        PyDataWriterListenerPtr<T> l,
+        const dds::core::status::StatusMask& m) {
+    return exchange_listener<
+            dds::pub::DataWriter<T>,
+            DataWriterListenerPtr<T>,
+            PyDataWriterListenerPtr<T>>(dw, l, m);
+}
+
 template<typename T>
 inline PyDataWriterListenerPtr<T> downcast_dw_listener_ptr(DataWriterListenerPtr<T> l) {
     return downcast_listener_ptr<PyDataWriterListenerPtr<T>, DataWriterListenerPtr<T>>(l);
@@ -90,10 +113,12 @@ public:
     {
         if (*this != dds::core::null) {
             if (this->delegate().use_count() <= LISTENER_USE_COUNT_MIN && !this->delegate()->closed()) {
-                auto listener_ptr = get_dw_listener(*this);
+                PyDataWriterListenerPtr<T> null_listener = nullptr;
+                auto listener_ptr = exchange_dw_listener(
+                        *this,
+                        null_listener,
+                        dds::core::status::StatusMask::none());
                 if (nullptr != listener_ptr) {
-                    PyDataWriterListenerPtr<T> null_listener = nullptr;
-                    set_dw_listener(*this, null_listener, dds::core::status::StatusMask::none());
                     {
                         py::gil_scoped_acquire acquire;
                         py::cast(listener_ptr).dec_ref();
@@ -161,15 +186,18 @@ public:
 
     void py_close() override
     {
-        auto listener_ptr = get_dw_listener(*this);
+        PyDataWriterListenerPtr<T> null_listener = nullptr;
+        auto listener_ptr = exchange_dw_listener(
+                *this,
+                null_listener,
+                dds::core::status::StatusMask::none());
         if (nullptr != listener_ptr) {
-            PyDataWriterListenerPtr<T> null_listener = nullptr;
-            set_dw_listener(*this, null_listener, dds::core::status::StatusMask::none());
             {
                 py::gil_scoped_acquire acquire;
                 py::cast(listener_ptr).dec_ref();
             }
         }
+        PyPerfStats::release(*this);
         this->close();
     }
 
@@ -197,6 +225,9 @@ public:
     {
         this->delegate()->unretain();
     }
+
+private:
+    PyPerfStatsAttachment perf_stats_attachment_ { *this };
 };
 
 template<typename T>
@@ -287,6 +318,16 @@ void init_dds_datawriter_untyped_methods(PyDataWriterClass<T>& cls)
             "The DataWriterQos for this DataWriter."
             "This property's getter returns a deep copy.");
 
+    cls.def_property_readonly(
+            "perf_stats",
+            [](const PyDataWriter& dw) {
+                py::gil_scoped_release guard;
+                return PyPerfStats::get(dw);
+            },
+            "The latency histograms of the phases of the write operations "
+            "of this DataWriter. They're recorded only while "
+            "PerfStats.enabled is True.");
+
     cls.def(
             "__lshift__",
             [](PyDataWriter& dw,
@@ -362,8 +403,7 @@ void init_dds_datawriter_untyped_methods(PyDataWriterClass<T>& cls)
                     py::gil_scoped_acquire acquire;
                     py::cast(listener).inc_ref();
                 }
-                auto old_listener = get_dw_listener(dw);
-                set_dw_listener(dw, listener);
+                auto old_listener = exchange_dw_listener(dw, listener);
                 if (nullptr != old_listener) {
                     py::gil_scoped_acquire acquire;
                     py::cast(old_listener).dec_ref();
@@ -381,8 +421,7 @@ void init_dds_datawriter_untyped_methods(PyDataWriterClass<T>& cls)
                     py::gil_scoped_acquire acquire;
                     py::cast(listener).inc_ref();
                 }
-                auto old_listener = get_dw_listener(dw);
-                set_dw_listener(dw, listener, m);
+                auto old_listener = exchange_dw_listener(dw, listener, m);
                 if (nullptr != old_listener) {
                     py::gil_scoped_acquire acquire;
                     py::cast(old_listener).dec_ref();
@@ -662,6 +701,7 @@ void init_dds_datawriter_untyped_methods(PyDataWriterClass<T>& cls)
     cls.def(
             "matched_subscription_data",
             [](const PyDataWriter& dw, const dds::core::InstanceHandle& h) {
+                ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                 return dds::pub::matched_subscription_data<T>(dw, h);
             },
             py::arg("handle"),
@@ -672,6 +712,7 @@ void init_dds_datawriter_untyped_methods(PyDataWriterClass<T>& cls)
     cls.def(
             "matched_subscription_participant_data",
             [](const PyDataWriter& dw, const dds::core::InstanceHandle& h) {
+                ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                 return rti::pub::matched_subscription_participant_data<T>(
                         dw,
                         h);
@@ -872,6 +913,22 @@ void init_dds_datawriter_write_methods(PyDataWriterClass<T>& cls)
             py::call_guard<GilPolicy>(),
             "Write a sequence of samples with a timestamp.");
 
+    cls.def("write_many",
+            &WriteImpl::template py_write_range<>,
+            py::arg("samples"),
+            py::call_guard<GilPolicy>(),
+            "Write a sequence of samples. For IDL types, the samples are "
+            "converted and written in batches, taking the GIL and the "
+            "DataWriter's lock once per batch instead of once per sample.");
+
+    cls.def("write_many",
+            &WriteImpl::template py_write_range<const dds::core::Time&>,
+            py::arg("samples"),
+            py::arg("timestamp"),
+            py::call_guard<GilPolicy>(),
+            "Write a sequence of samples with a timestamp. For IDL types, "
+            "the samples are converted and written in batches.");
+
     cls.def(
             "__lshift__",
             [](PyDataWriter& writer,
@@ -1351,9 +1408,13 @@ struct DefaultWriteImpl {
             const py_sample& sample,
             ExtraArgs&&... extra_args)
     {
+        // pybind11 converts the sample before the GIL is released, so only
+        // the native call is recorded in the perf stats
+        PyPerfTimer timer(writer);
         writer.extensions().write(
                 sample,
                 std::forward<ExtraArgs>(extra_args)...);
+        timer.lap(PyPerfPhase::NATIVE_CALL);
     }
 
     template<typename... ExtraArgs>
@@ -0,0 +1,54 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include <dds/core/xtypes/DynamicData.hpp>
+
+namespace pyrti {
+
+// Copies primitive members of a DynamicData sample from and to raw memory in
+// the native representation of their type kind (booleans use one byte and
+// enums are 32-bit integers). Defined in DynamicData.cpp.
+
+// True if the functions below support members (or collection elements) of a
+// type kind. They throw InvalidArgumentError for any other kind.
+bool is_primitive_member_kind(dds::core::xtypes::TypeKind::inner_enum kind);
+
+void read_primitive_member(
+        const dds::core::xtypes::DynamicData& dd,
+        dds::core::xtypes::TypeKind::inner_enum kind,
+        uint32_t member_index,
+        char* dest);
+
+void write_primitive_member(
+        dds::core::xtypes::DynamicData& dd,
+        dds::core::xtypes::TypeKind::inner_enum kind,
+        uint32_t member_index,
+        const char* src);
+
+// Same for count elements of an array or sequence member of primitives
+void get_primitive_buffer(
+        const dds::core::xtypes::DynamicData& dd,
+        dds::core::xtypes::TypeKind::inner_enum kind,
+        const std::string& name,
+        char* dest,
+        uint32_t count);
+
+void set_primitive_buffer(
+        dds::core::xtypes::DynamicData& dd,
+        dds::core::xtypes::TypeKind::inner_enum kind,
+        const std::string& name,
+        const char* src,
+        uint32_t count);
+
+}  // namespace pyrti
@@ -0,0 +1,102 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include "PyTypeFactoryReference.hpp"
+#include <dds/core/xtypes/DynamicData.hpp>
+
+namespace pyrti {
+
+// A primitive, enum or string member value read without the GIL (see
+// PyFieldAccessor::get_value). Booleans, chars and enums are integers.
+struct PyFieldValue {
+    enum class Kind { INTEGER, FLOAT, STRING };
+
+    Kind kind = Kind::INTEGER;
+    int64_t integer = 0;
+    double floating = 0.0;
+    std::string string;
+};
+
+// A member path (e.g. "a.b[3].c") of a DynamicType resolved into the member
+// indexes that DynamicData uses, so that accessing the member doesn't need to
+// parse the path or look up the members by name.
+//
+// Created by DynamicType.compile_path(), which caches a bounded number of
+// accessors per interpreter, by type and path. get() and set() are
+// implemented in DynamicData.cpp.
+class PYRTI_SYMBOL_HIDDEN PyFieldAccessor {
+public:
+    // Gets the accessor for a path of a type, compiling it the first time
+    static std::shared_ptr<PyFieldAccessor> compile(
+            const dds::core::xtypes::DynamicType& type,
+            const std::string& path);
+
+    PyFieldAccessor(
+            const dds::core::xtypes::DynamicType& type,
+            const std::string& path);
+
+    // Equivalent to data[path]
+    py::object get(dds::core::xtypes::DynamicData& data) const;
+
+    // Equivalent to data[path] = value
+    void set(dds::core::xtypes::DynamicData& data, py::object& value) const;
+
+    // Reads the value of a primitive, enum or string member. It doesn't use
+    // the GIL or check the type of the data.
+    //
+    // @pre data is of type()
+    // @return false if the member or any member in its path is an unset
+    // optional
+    // @throw dds::core::InvalidArgumentError if the member is not a primitive,
+    // enum or string
+    bool get_value(
+            dds::core::xtypes::DynamicData& data,
+            PyFieldValue& value) const;
+
+    // The kind of the member at the end of the path, with aliases resolved
+    dds::core::xtypes::TypeKind::inner_enum kind() const
+    {
+        return steps_.back().kind;
+    }
+
+    const std::string& path() const
+    {
+        return path_;
+    }
+
+    const dds::core::xtypes::DynamicType& type() const
+    {
+        return type_;
+    }
+
+private:
+    struct Step {
+        // The (1-based) member index of a struct member or collection element
+        uint32_t member_index;
+        // The kind of the member, with aliases resolved
+        dds::core::xtypes::TypeKind::inner_enum kind;
+        // Whether this step accesses an element of an array or sequence
+        bool is_element;
+    };
+
+    void check_type(const dds::core::xtypes::DynamicData& data) const;
+
+    // Declared first so that type_ is destroyed before it
+    PyTypeFactoryReference type_factory_;
+    dds::core::xtypes::DynamicType type_;
+    std::string path_;
+    std::vector<Step> steps_;
+};
+
+}  // namespace pyrti
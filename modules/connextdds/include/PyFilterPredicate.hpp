@@ -0,0 +1,178 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include <rti/topic/ContentFilter.hpp>
+#include <dds/core/xtypes/DynamicData.hpp>
+#include "PyFieldAccessor.hpp"
+
+namespace pyrti {
+
+// An immutable predicate over the members of a DynamicData sample, built in
+// Python with dds.FilterField and evaluated natively, without the GIL.
+//
+// A predicate is created unbound (with member paths only) and bound to a
+// DynamicType, which resolves each path into a PyFieldAccessor. Only bound
+// predicates can be evaluated.
+class PYRTI_SYMBOL_HIDDEN PyFilterPredicate {
+public:
+    enum class Kind {
+        COMPARISON,
+        RANGE,
+        MEMBERSHIP,
+        AND,
+        OR,
+        NOT,
+        CONSTANT
+    };
+
+    enum class Operator { EQ, NE, LT, LE, GT, GE };
+
+    using Ptr = std::shared_ptr<PyFilterPredicate>;
+
+    // path <op> value
+    static Ptr comparison(
+            const std::string& path,
+            Operator op,
+            const PyFieldValue& value);
+
+    // low <= path <= high
+    static Ptr range(
+            const std::string& path,
+            const PyFieldValue& low,
+            const PyFieldValue& high);
+
+    // path in values
+    static Ptr membership(
+            const std::string& path,
+            std::vector<PyFieldValue> values);
+
+    static Ptr logical_and(const Ptr& left, const Ptr& right);
+
+    static Ptr logical_or(const Ptr& left, const Ptr& right);
+
+    static Ptr logical_not(const Ptr& operand);
+
+    static Ptr constant(bool value);
+
+    // Creates a copy of this predicate with all its member paths resolved
+    // for a type.
+    //
+    // @throw dds::core::InvalidArgumentError if a path doesn't exist in the
+    // type, its member is not a primitive, enum or string, or it is compared
+    // to a value of the wrong kind (a string vs. a number)
+    Ptr bind(const dds::core::xtypes::DynamicType& type) const;
+
+    // Evaluates the predicate. It doesn't use the GIL.
+    //
+    // A comparison, range or membership test on an optional member that is
+    // not set is false.
+    //
+    // @pre is_bound() and data is of the type this predicate is bound to
+    bool evaluate(dds::core::xtypes::DynamicData& data) const;
+
+    bool is_bound() const;
+
+    // The type this predicate is bound to
+    //
+    // @pre is_bound()
+    const dds::core::xtypes::DynamicType& type() const;
+
+    std::string to_string() const;
+
+private:
+    explicit PyFilterPredicate(Kind kind) : kind_(kind)
+    {
+    }
+
+    bool evaluate_leaf(dds::core::xtypes::DynamicData& data) const;
+
+    Kind kind_;
+    Operator op_ = Operator::EQ;
+    bool constant_ = false;
+    std::string path_;
+    // The operand of a comparison, the bounds of a range or the sorted values
+    // of a membership test
+    std::vector<PyFieldValue> values_;
+    std::vector<Ptr> operands_;
+    std::shared_ptr<PyFieldAccessor> accessor_;
+    dds::core::optional<dds::core::xtypes::DynamicType> type_;
+};
+
+// A member path used to build FilterPredicates (dds.FilterField)
+struct PYRTI_SYMBOL_HIDDEN PyFilterField {
+    std::string path;
+};
+
+using PyPredicateCompileData = std::shared_ptr<PyFilterPredicate>;
+
+// A custom content filter for DynamicData topics whose compile() is
+// implemented in Python and returns a FilterPredicate. The predicate is bound
+// to the topic type and evaluated natively on the receive thread, so unlike
+// dds.DynamicData.ContentFilter, evaluating a sample doesn't take the GIL.
+class PYRTI_SYMBOL_HIDDEN PyPredicateContentFilter
+        : public rti::topic::ContentFilter<
+                  dds::core::xtypes::DynamicData,
+                  PyPredicateCompileData> {
+public:
+    virtual ~PyPredicateContentFilter() = default;
+
+    // Creates the (unbound) predicate for an expression and its parameters
+    virtual PyFilterPredicate::Ptr compile_predicate(
+            const std::string& expression,
+            const std::vector<std::string>& parameters,
+            const dds::core::optional<dds::core::xtypes::DynamicType>&
+                    type_code,
+            const std::string& type_class_name) = 0;
+
+    PyPredicateCompileData& compile(
+            const std::string& expression,
+            const std::vector<std::string>& parameters,
+            const dds::core::optional<dds::core::xtypes::DynamicType>&
+                    type_code,
+            const std::string& type_class_name,
+            PyPredicateCompileData* old_compile_data) override;
+
+    bool evaluate(
+            PyPredicateCompileData& compile_data,
+            const dds::core::xtypes::DynamicData& sample,
+            const rti::topic::FilterSampleInfo& meta_data) override;
+
+    void finalize(PyPredicateCompileData& compile_data) override;
+};
+
+class PYRTI_SYMBOL_HIDDEN PyPredicateContentFilterTrampoline
+        : public PyPredicateContentFilter {
+public:
+    using PyPredicateContentFilter::PyPredicateContentFilter;
+
+    PyFilterPredicate::Ptr compile_predicate(
+            const std::string& expression,
+            const std::vector<std::string>& parameters,
+            const dds::core::optional<dds::core::xtypes::DynamicType>&
+                    type_code,
+            const std::string& type_class_name) override
+    {
+        PYBIND11_OVERLOAD_PURE_NAME(
+                PyFilterPredicate::Ptr,
+                PyPredicateContentFilter,
+                "compile",
+                compile_predicate,
+                expression,
+                parameters,
+                type_code,
+                type_class_name);
+    }
+};
+
+}  // namespace pyrti
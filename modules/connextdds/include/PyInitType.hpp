@@ -101,7 +101,7 @@ DefInitFunc init_type_class(
         return ([tl, notl]() mutable { init_topic_listener<T>(tl, notl); });
     });
 
-    l.push_back([cls] {
+    l.push_back(ClassInit([cls] {
         py::class_<
             PyITopicDescription<T>,
             PyIEntity,
@@ -125,7 +125,12 @@ DefInitFunc init_type_class(
         py::implicitly_convertible<py::iterable, std::vector<PyTopic<T>>>();
 
         return ([itd, td, t]() mutable { init_topic<T>(itd, td, t); });
-    });
+    },
+            class_types<
+                    PyITopicDescription<T>,
+                    PyTopicDescription<T>,
+                    PyTopic<T>>(),
+            class_types<PyIEntity, PyIAnyTopic>()));
 
     l.push_back([cls] {
         py::class_<dds::sub::Sample<T>> s(cls, "Sample");
@@ -171,7 +176,7 @@ DefInitFunc init_type_class(
         return ([ls]() mutable { init_loaned_sample<T>(ls); });
     });
 
-    l.push_back([cls] {
+    l.push_back(ClassInit([cls] {
         py::class_<
                 PyContentFilteredTopic<T>,
                 PyITopicDescription<T>,
@@ -186,9 +191,11 @@ DefInitFunc init_type_class(
                 std::vector<PyContentFilteredTopic<T>>>();
 
         return ([cft]() mutable { init_content_filtered_topic<T>(cft); });
-    });
+    },
+            class_types<PyContentFilteredTopic<T>>(),
+            class_types<PyITopicDescription<T>, PyIAnyTopic>()));
 
-    l.push_back([cls] {
+    l.push_back(ClassInit([cls] {
         py::class_<
                 rti::topic::ContentFilter<T, dds::core::optional<py::object>>,
                 rti::topic::ContentFilterBase,
@@ -196,9 +203,12 @@ DefInitFunc init_type_class(
                 cf(cls, "ContentFilter");
 
         return ([cf]() mutable { init_content_filter<T>(cf); });
-    });
+    },
+            class_types<
+                    rti::topic::ContentFilter<T, dds::core::optional<py::object>>>(),
+            class_types<rti::topic::ContentFilterBase>()));
 
-    l.push_back([cls] {
+    l.push_back(ClassInit([cls] {
         py::class_<
                 rti::topic::WriterContentFilter<
                         T,
@@ -209,9 +219,15 @@ DefInitFunc init_type_class(
                 wcf(cls, "WriterContentFilter");
 
         return ([wcf]() mutable { init_writer_content_filter<T>(wcf); });
-    });
-
-    l.push_back([cls] {
+    },
+            class_types<rti::topic::WriterContentFilter<
+                    T,
+                    dds::core::optional<py::object>,
+                    dds::core::optional<py::object>>>(),
+            class_types<
+                    rti::topic::ContentFilter<T, dds::core::optional<py::object>>>()));
+
+    l.push_back(ClassInit([cls] {
         py::class_<
                 rti::topic::WriterContentFilterHelper<
                         T,
@@ -227,9 +243,17 @@ DefInitFunc init_type_class(
         return ([wcfh]() mutable {
             init_writer_content_filter_helper<T>(wcfh);
         });
-    });
-
-    l.push_back([cls] {
+    },
+            class_types<rti::topic::WriterContentFilterHelper<
+                    T,
+                    dds::core::optional<py::object>,
+                    dds::core::optional<py::object>>>(),
+            class_types<rti::topic::WriterContentFilter<
+                    T,
+                    dds::core::optional<py::object>,
+                    dds::core::optional<py::object>>>()));
+
+    l.push_back(ClassInit([cls] {
         py::class_<
             PyDataReader<T>,
             PyIDataReader,
@@ -242,9 +266,11 @@ DefInitFunc init_type_class(
                 std::vector<PyDataReader<T>>>();
 
         return ([dr]() mutable { init_datareader<T>(dr); });
-    });
+    },
+            class_types<PyDataReader<T>>(),
+            class_types<PyIDataReader>()));
 
-    l.push_back([cls] {
+    l.push_back(ClassInit([cls] {
         py::class_<
             PyDataWriter<T>,
             PyIEntity,
@@ -258,7 +284,9 @@ DefInitFunc init_type_class(
                 std::vector<PyDataWriter<T>>>();
 
         return ([dw]() mutable { init_datawriter(dw); });
-    });
+    },
+            class_types<PyDataWriter<T>>(),
+            class_types<PyIEntity, PyIAnyDataWriter>()));
 
     return ([cls, cls_name, parent]() mutable {
         pyrti::bind_vector<std::pair<T, dds::core::Time>>(
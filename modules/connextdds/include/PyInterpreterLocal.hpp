@@ -0,0 +1,100 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <cstdint>
+#include <mutex>
+
+namespace pyrti {
+
+namespace py = pybind11;
+
+// @pre The GIL must be held
+inline PyInterpreterState* current_interpreter()
+{
+#if PY_VERSION_HEX >= 0x03090000
+    return PyInterpreterState_Get();
+#else
+    return PyThreadState_Get()->interp;
+#endif
+}
+
+// A unique id of the current Python interpreter. Ids are never reused, even
+// after a subinterpreter is finalized.
+//
+// @pre The GIL must be held
+inline int64_t current_interpreter_id()
+{
+#if PY_VERSION_HEX >= 0x03070000
+    return PyInterpreterState_GetID(current_interpreter());
+#else
+    return 0;
+#endif
+}
+
+namespace detail {
+
+inline std::mutex& interpreter_local_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+}  // namespace detail
+
+// Gets the object of type T that belongs to the current Python interpreter,
+// creating it the first time. Each subinterpreter gets its own object, which
+// is stored in the interpreter's state dict under key and destroyed when the
+// interpreter is finalized. T must be default-constructible and its
+// constructor must not run Python code.
+//
+// Use it for state that holds Python objects or that is specific to one
+// interpreter; native state shared by all the interpreters can still be
+// process-wide (with its own synchronization).
+//
+// @pre The GIL must be held
+template<typename T>
+T& interpreter_local(const char* key)
+{
+#if PY_VERSION_HEX >= 0x03080000
+    // The lock is only needed without the GIL (free-threaded builds); the
+    // dict operations below don't run Python code.
+    std::lock_guard<std::mutex> lock(detail::interpreter_local_mutex());
+    PyObject* dict = PyInterpreterState_GetDict(current_interpreter());
+    if (dict == nullptr) {
+        throw py::error_already_set();
+    }
+
+    PyObject* existing = PyDict_GetItemString(dict, key);  // borrowed
+    if (existing != nullptr) {
+        return *static_cast<T*>(PyCapsule_GetPointer(existing, key));
+    }
+
+    auto value = new T();
+    py::capsule capsule(value, key, [](PyObject* object) {
+        delete static_cast<T*>(
+                PyCapsule_GetPointer(object, PyCapsule_GetName(object)));
+    });
+    if (PyDict_SetItemString(dict, key, capsule.ptr()) != 0) {
+        throw py::error_already_set();
+    }
+    return *value;
+#else
+    // Without PyInterpreterState_GetDict (Python 3.8) all the interpreters
+    // share the same object, which is never destroyed
+    static auto value = new T();
+    return *value;
+#endif
+}
+
+}  // namespace pyrti
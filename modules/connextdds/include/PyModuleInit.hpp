@@ -0,0 +1,57 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+
+namespace pyrti {
+
+// Runs the class inits in l, which may add more class inits to l, and appends
+// the def init that each one returns to v.
+//
+// The class inits run in dependency order: one that declares base classes
+// that are not registered yet waits until the class inits that declare them
+// run, and otherwise they run in the order they were added (see ClassInit).
+//
+// @throw py::import_error if some class inits can't run because their base
+// classes are never registered
+void run_class_inits(ClassInitList& l, DefInitVector& v);
+
+// Registers the classes and functions of a rarely used part of the module
+// the first time they're needed.
+using LazyInitFunc = std::function<void(ClassInitList&, DefInitVector&)>;
+
+// Names of the lazy init groups
+namespace lazy_init {
+constexpr const char* BUILTIN_TOPIC_DATA = "builtin_topic_data";
+constexpr const char* NETWORK_CAPTURE = "network_capture";
+}  // namespace lazy_init
+
+// Registers a lazy init group in m: init runs the first time one of the
+// attributes is accessed in m, or ensure_lazy_init(group) is called.
+void register_lazy_init(
+        py::module& m,
+        const std::string& group,
+        const std::vector<std::string>& attributes,
+        LazyInitFunc init);
+
+// Runs the lazy init of a group if it hasn't run yet. Functions that return
+// types registered by a lazy init group must call this first, since pybind11
+// can't convert an object whose type is not registered. It can be called with
+// or without the GIL.
+void ensure_lazy_init(const std::string& group);
+
+// Adds the module __getattr__ and __dir__ (PEP 562) that run the lazy init of
+// the attributes registered with register_lazy_init.
+void init_lazy_getattr(py::module& m);
+
+}  // namespace pyrti
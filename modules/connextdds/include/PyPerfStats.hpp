@@ -0,0 +1,309 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <rti/topic/cdr/GenericTypePluginFactory.hpp>
+
+namespace pyrti {
+
+// The phases of a write, read or take operation measured by PyPerfStats
+enum class PyPerfPhase {
+    // Waiting for the DataWriter's lock or a write slot
+    LOCK_WAIT,
+    // Waiting to acquire the GIL
+    GIL_WAIT,
+    // Converting the samples between Python and C
+    CONVERSION,
+    // The native write, read or take call
+    NATIVE_CALL
+};
+
+constexpr size_t PY_PERF_PHASE_COUNT = 4;
+
+// A copy of the values of a PyLatencyHistogram (dds.LatencyHistogram). All
+// the values are in nanoseconds.
+class PYRTI_SYMBOL_HIDDEN PyLatencyHistogramSnapshot {
+public:
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> counts;
+
+    double mean() const;
+
+    // The highest value that is equivalent (in the same bucket) to the value
+    // at the given percentile (0-100)
+    uint64_t percentile(double percentile) const;
+
+    // The (exclusive upper bound, count) of the non-empty buckets
+    std::vector<std::pair<uint64_t, uint64_t>> buckets() const;
+};
+
+// A latency histogram with logarithmic buckets, where each power of two is
+// split into 16 linear sub-buckets, like an HdrHistogram. The relative error
+// of a value is at most 1/16, values below 16 ns are exact and values above
+// 2^40 ns (about 18 minutes) are recorded in the last bucket.
+//
+// Recording a value doesn't use locks or the GIL, so a histogram can be
+// updated concurrently by several threads.
+class PYRTI_SYMBOL_HIDDEN PyLatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_EXPONENT = 40;
+    static constexpr size_t BUCKET_COUNT =
+            (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+    PyLatencyHistogram();
+
+    void record(uint64_t nanoseconds)
+    {
+        counts_[bucket_index(nanoseconds)].fetch_add(
+                1,
+                std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+        uint64_t current = min_.load(std::memory_order_relaxed);
+        while (nanoseconds < current
+               && !min_.compare_exchange_weak(
+                       current,
+                       nanoseconds,
+                       std::memory_order_relaxed)) {
+        }
+        current = max_.load(std::memory_order_relaxed);
+        while (nanoseconds > current
+               && !max_.compare_exchange_weak(
+                       current,
+                       nanoseconds,
+                       std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset();
+
+    PyLatencyHistogramSnapshot snapshot() const;
+
+    static size_t bucket_index(uint64_t value)
+    {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        unsigned exponent = most_significant_bit(value);
+        if (exponent > MAX_EXPONENT) {
+            return BUCKET_COUNT - 1;
+        }
+        uint64_t sub_bucket = (value >> (exponent - SUB_BUCKET_BITS))
+                & (SUB_BUCKET_COUNT - 1);
+        return static_cast<size_t>(
+                (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT
+                + sub_bucket);
+    }
+
+    // The exclusive upper bound of the values of a bucket
+    static uint64_t bucket_upper_bound(size_t index);
+
+private:
+    static unsigned most_significant_bit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+// The latency histograms of each PyPerfPhase of the operations on an entity
+// (dds.PerfStats).
+//
+// Perf stats are disabled by default. When they're disabled, the instrumented
+// operations only check enabled() (see PyPerfTimer).
+class PYRTI_SYMBOL_HIDDEN PyPerfStats {
+public:
+    void record(PyPerfPhase phase, uint64_t nanoseconds)
+    {
+        histograms_[static_cast<size_t>(phase)].record(nanoseconds);
+    }
+
+    const PyLatencyHistogram& histogram(PyPerfPhase phase) const
+    {
+        return histograms_[static_cast<size_t>(phase)];
+    }
+
+    void reset();
+
+    static bool enabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    static void enabled(bool value);
+
+    // Gets the stats of a DataWriter or DataReader, creating them the first
+    // time
+    template<typename EntityType>
+    static std::shared_ptr<PyPerfStats> get(const EntityType& entity);
+
+    // Releases the stats of a DataWriter or DataReader that is being closed
+    template<typename EntityType>
+    static void release(const EntityType& entity);
+
+private:
+    std::array<PyLatencyHistogram, PY_PERF_PHASE_COUNT> histograms_;
+
+    static std::atomic<bool> enabled_;
+};
+
+// Holds the PyPerfStats of an entity, so that its operations find them
+// without a lookup. The stats are created the first time they're used.
+//
+// IDL entities keep it in their CPySampleConverter; other DataWriters and
+// DataReaders keep it as their user data, attached when their PyDataWriter
+// or PyDataReader is created (see PyPerfStatsAttachment). Either way, it's
+// destroyed when the entity is finalized.
+class PYRTI_SYMBOL_HIDDEN PyPerfStatsSlot {
+public:
+    std::shared_ptr<PyPerfStats> get();
+
+    void release();
+
+private:
+    std::shared_ptr<PyPerfStats> stats_;
+};
+
+// Attaches a PyPerfStatsSlot as the user data of the entity, unless it has
+// one already
+void attach_perf_stats_slot(dds::core::Entity entity);
+
+template<typename T>
+PyPerfStatsSlot& perf_stats_slot(const dds::pub::DataWriter<T>& writer)
+{
+    return *static_cast<PyPerfStatsSlot*>(writer->get_user_data_());
+}
+
+template<typename T>
+PyPerfStatsSlot& perf_stats_slot(const dds::sub::DataReader<T>& reader)
+{
+    return *static_cast<PyPerfStatsSlot*>(reader->get_user_data_());
+}
+
+// The user data of IDL entities is their CPySampleConverter (see
+// IdlTypeSupport.cpp)
+PyPerfStatsSlot& perf_stats_slot(
+        const dds::pub::DataWriter<rti::topic::cdr::CSampleWrapper>& writer);
+
+PyPerfStatsSlot& perf_stats_slot(
+        const dds::sub::DataReader<rti::topic::cdr::CSampleWrapper>& reader);
+
+template<typename EntityType>
+std::shared_ptr<PyPerfStats> PyPerfStats::get(const EntityType& entity)
+{
+    return perf_stats_slot(entity).get();
+}
+
+template<typename EntityType>
+void PyPerfStats::release(const EntityType& entity)
+{
+    perf_stats_slot(entity).release();
+}
+
+// A member of PyDataWriter and PyDataReader that attaches the
+// PyPerfStatsSlot of their entity when they're created. IDL entities are
+// skipped, since their CPySampleConverter is attached when they're created
+// instead.
+class PYRTI_SYMBOL_HIDDEN PyPerfStatsAttachment {
+public:
+    template<typename T>
+    explicit PyPerfStatsAttachment(const dds::pub::DataWriter<T>& writer)
+    {
+        if (writer != dds::core::null) {
+            attach_perf_stats_slot(writer);
+        }
+    }
+
+    template<typename T>
+    explicit PyPerfStatsAttachment(const dds::sub::DataReader<T>& reader)
+    {
+        if (reader != dds::core::null) {
+            attach_perf_stats_slot(reader);
+        }
+    }
+
+    explicit PyPerfStatsAttachment(
+            const dds::pub::DataWriter<rti::topic::cdr::CSampleWrapper>&)
+    {
+    }
+
+    explicit PyPerfStatsAttachment(
+            const dds::sub::DataReader<rti::topic::cdr::CSampleWrapper>&)
+    {
+    }
+};
+
+// Measures the phases of an operation on an entity: each lap() records the
+// time since the timer was created or the previous lap() in a phase.
+//
+// When perf stats are disabled the timer is inactive, and creating it and
+// each lap() only check a flag.
+class PYRTI_SYMBOL_HIDDEN PyPerfTimer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Creates an inactive timer
+    PyPerfTimer() = default;
+
+    template<typename EntityType>
+    explicit PyPerfTimer(const EntityType& entity)
+    {
+        if (PyPerfStats::enabled()) {
+            stats_ = PyPerfStats::get(entity);
+            start_ = clock::now();
+        }
+    }
+
+    void lap(PyPerfPhase phase)
+    {
+        if (stats_ != nullptr) {
+            auto now = clock::now();
+            stats_->record(
+                    phase,
+                    static_cast<uint64_t>(
+                            std::chrono::duration_cast<
+                                    std::chrono::nanoseconds>(now - start_)
+                                    .count()));
+            start_ = now;
+        }
+    }
+
+private:
+    std::shared_ptr<PyPerfStats> stats_;
+    clock::time_point start_;
+};
+
+}  // namespace pyrti
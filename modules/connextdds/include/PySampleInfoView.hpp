@@ -0,0 +1,69 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include <dds/sub/SampleInfo.hpp>
+
+namespace pyrti {
+
+// The SampleInfos of all the samples returned by one read or take operation,
+// copied from the LoanedSamples into a single block (without the GIL).
+class PYRTI_SYMBOL_HIDDEN PySampleInfoBlock {
+public:
+    explicit PySampleInfoBlock(size_t capacity)
+    {
+        infos_.reserve(capacity);
+    }
+
+    void append(const dds::sub::SampleInfo& info)
+    {
+        infos_.push_back(info);
+    }
+
+    const dds::sub::SampleInfo& operator[](size_t index) const
+    {
+        return infos_[index];
+    }
+
+    size_t size() const
+    {
+        return infos_.size();
+    }
+
+private:
+    std::vector<dds::sub::SampleInfo> infos_;
+};
+
+// A dds.SampleInfoView: a SampleInfo of a PySampleInfoBlock. It provides the
+// same properties as dds.SampleInfo, which are converted into Python objects
+// only when they're accessed.
+class PYRTI_SYMBOL_HIDDEN PySampleInfoView {
+public:
+    PySampleInfoView(
+            std::shared_ptr<const PySampleInfoBlock> block,
+            size_t index)
+            : block_(std::move(block)), index_(index)
+    {
+    }
+
+    const dds::sub::SampleInfo& get() const
+    {
+        return (*block_)[index_];
+    }
+
+private:
+    std::shared_ptr<const PySampleInfoBlock> block_;
+    size_t index_;
+};
+
+}  // namespace pyrti
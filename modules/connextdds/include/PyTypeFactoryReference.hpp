@@ -0,0 +1,32 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+
+namespace pyrti {
+
+// Keeps the TypeCode factory and the GenericTypePluginFactory alive while it
+// exists. A cache that holds DynamicTypes owns one, so that its types are
+// destroyed before the factories even if the interpreter released them first
+// (see GenericTypePluginFactory.delete_instance); in that case the last
+// reference deletes them.
+class PYRTI_SYMBOL_HIDDEN PyTypeFactoryReference {
+public:
+    PyTypeFactoryReference();
+    ~PyTypeFactoryReference();
+
+    PyTypeFactoryReference(const PyTypeFactoryReference&) = delete;
+    PyTypeFactoryReference& operator=(const PyTypeFactoryReference&) = delete;
+};
+
+}  // namespace pyrti
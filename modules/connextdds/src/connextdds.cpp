@@ -12,9 +12,25 @@
 #include "PyConnext.hpp"
 #include "PyNamespaces.hpp"
 #include "PyCoreUtils.hpp"
-
-
+#include "PyModuleInit.hpp"
+
+
+// The module doesn't rely on the GIL to protect its own state: the shared
+// converter state, registries and listener references use their own locks, so
+// it can be loaded without enabling the GIL in free-threaded Python builds.
+#if PYBIND11_VERSION_HEX >= 0x03000000
+// The module state is per interpreter (see PyInterpreterLocal.hpp), so it can
+// be imported by subinterpreters that have their own GIL
+PYBIND11_MODULE(
+        connextdds,
+        m,
+        py::mod_gil_not_used(),
+        py::multiple_interpreters::per_interpreter_gil())
+#elif PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(connextdds, m, py::mod_gil_not_used())
+#else
 PYBIND11_MODULE(connextdds, m)
+#endif
 {
     pyrti::ClassInitList cls_init_funcs;
     pyrti::DefInitVector def_init_funcs;
@@ -23,26 +39,7 @@ PYBIND11_MODULE(connextdds, m)
     init_namespace_dds(m, cls_init_funcs, late_init_funcs);
     init_namespace_rti(m, cls_init_funcs, late_init_funcs);
 
-    bool stuck = false;
-    while (!cls_init_funcs.empty()) {
-        auto starting_size = cls_init_funcs.size();
-        for (auto it = cls_init_funcs.begin(); it != cls_init_funcs.end();) {
-            try {
-                auto def_init = (*it)();
-                def_init_funcs.push_back(def_init);
-                it = cls_init_funcs.erase(it);
-            } catch (...) {
-                if (stuck)
-                    throw;
-                ++it;
-            }
-        }
-        if (cls_init_funcs.size() == starting_size) {
-            /* We did not make any progress on class initialization
-               which means we are stuck */
-            stuck = true;
-        }
-    }
+    pyrti::run_class_inits(cls_init_funcs, def_init_funcs);
 
     init_misc_late(m);
 
@@ -58,4 +55,6 @@ PYBIND11_MODULE(connextdds, m)
             "core_utils",
             "Utilities from the RTI Connext DDS C implementation");
     init_core_utils(core_utils_module);
+
+    pyrti::init_lazy_getattr(m);
 }
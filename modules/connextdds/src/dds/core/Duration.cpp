@@ -141,7 +141,7 @@ void init_class_defs(py::class_<Duration>& cls)
 template<>
 void process_inits<Duration>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Duration>(m, "Duration"); });
+    l.push_back(class_init<Duration>(m, "Duration"));
 }
 
 }  // namespace pyrti
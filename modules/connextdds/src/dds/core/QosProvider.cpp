@@ -311,9 +311,7 @@ void init_class_defs(py::class_<QosProvider>& cls)
 template<>
 void process_inits<QosProvider>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<QosProvider>(m, "QosProvider");
-    });
+    l.push_back(class_init<QosProvider>(m, "QosProvider"));
 }
 
 }  // namespace pyrti
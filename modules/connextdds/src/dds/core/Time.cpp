@@ -146,7 +146,7 @@ void init_class_defs(py::class_<Time>& cls)
 template<>
 void process_inits<Time>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Time>(m, "Time"); });
+    l.push_back(class_init<Time>(m, "Time"));
 }
 
 }  // namespace pyrti
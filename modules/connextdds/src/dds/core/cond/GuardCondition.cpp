@@ -83,12 +83,12 @@ void process_inits<dds::core::cond::GuardCondition>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
+    l.push_back(class_init<
             PyGuardCondition,
             PyICondition,
-            std::unique_ptr<PyGuardCondition, no_gil_delete<PyGuardCondition>>>(m, "GuardCondition");
-    });
+            std::unique_ptr<PyGuardCondition, no_gil_delete<PyGuardCondition>>>(
+            m,
+            "GuardCondition"));
 }
 
 }  // namespace pyrti
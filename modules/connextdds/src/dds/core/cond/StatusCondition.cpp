@@ -95,14 +95,12 @@ void process_inits<dds::core::cond::StatusCondition>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
+    l.push_back(class_init<
             PyStatusCondition,
             PyICondition,
             std::unique_ptr<PyStatusCondition, no_gil_delete<PyStatusCondition>>>(
-                m,
-                "StatusCondition");
-    });
+            m,
+            "StatusCondition"));
 }
 
 }  // namespace pyrti
@@ -12,8 +12,19 @@
 #include "PyConnext.hpp"
 #include <dds/core/cond/WaitSet.hpp>
 #include <rti/core/cond/WaitSetImpl.hpp>
+#include <algorithm>
+#include <atomic>
 #include <future>
+#include <mutex>
+#include <thread>
 #include <pybind11/functional.h>
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #if defined(__linux__)
+        #include <sys/eventfd.h>
+    #endif
+#endif
 #include "PyCondition.hpp"
 #include "PyAsyncioExecutor.hpp"
 
@@ -364,28 +375,233 @@ void init_class_defs(
             "Get the underlying WaitSet object.");
 }
 
+#ifndef _WIN32
+//
+// WaitSetFdNotifier is the event-driven alternative to FastWaitSet used by
+// rti.asyncio when the event loop supports loop.add_reader().
+//
+// Instead of blocking an executor thread in wait_async() for every wake-up,
+// a single native thread waits on the WaitSet. When conditions trigger, it
+// detaches them (as FastWaitSet::wait_and_remove does) and signals a file
+// descriptor (an eventfd on Linux, a pipe elsewhere). The event loop monitors
+// that descriptor and calls dispatch() in the loop thread, which runs the
+// condition handlers.
+//
+class WaitSetFdNotifier {
+public:
+    WaitSetFdNotifier()
+    {
+#if defined(__linux__)
+        read_fd = write_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (read_fd < 0) {
+            throw dds::core::Error("Failed to create eventfd");
+        }
+#else
+        int fds[2];
+        if (pipe(fds) != 0) {
+            throw dds::core::Error("Failed to create pipe");
+        }
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        read_fd = fds[0];
+        write_fd = fds[1];
+#endif
+        waitset.attach_condition(stop_condition);
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~WaitSetFdNotifier()
+    {
+        close();
+    }
+
+    int fileno() const
+    {
+        return read_fd;
+    }
+
+    void attach_condition(const Condition& condition)
+    {
+        waitset.attach_condition(condition);
+    }
+
+    bool detach_condition(const Condition& condition)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find(ready.begin(), ready.end(), condition);
+        if (it != ready.end()) {
+            ready.erase(it);
+            return true;
+        }
+        return waitset.detach_condition(condition);
+    }
+
+    // Consumes the notification and dispatches the conditions that have
+    // triggered since the last call
+    void dispatch()
+    {
+        clear_notification();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(ready, dispatching);
+        }
+        for (auto& condition : dispatching) {
+            condition.dispatch();
+        }
+        dispatching.clear();
+    }
+
+    void close()
+    {
+        if (closed.exchange(true)) {
+            return;
+        }
+        stop_condition.trigger_value(true);
+        if (thread.joinable()) {
+            thread.join();
+        }
+        ::close(read_fd);
+        if (write_fd != read_fd) {
+            ::close(write_fd);
+        }
+    }
+
+private:
+    void run()
+    {
+        WaitSet::ConditionSeq active_conditions;
+        const Condition stop(stop_condition);
+        bool stopped = false;
+        while (!stopped) {
+            try {
+                waitset.wait(active_conditions);
+            } catch (const std::exception&) {
+                stopped = true;
+                active_conditions.clear();
+            }
+
+            bool notify_loop = false;
+            for (auto& c : active_conditions) {
+                if (c == stop) {
+                    stopped = true;
+                    continue;
+                }
+                // detach_condition() may have detached it after the wait
+                // returned; in that case it must not be dispatched
+                std::lock_guard<std::mutex> lock(mutex);
+                if (waitset.detach_condition(c)) {
+                    ready.push_back(c);
+                    notify_loop = true;
+                }
+            }
+
+            if (notify_loop) {
+                notify();
+            }
+        }
+    }
+
+    void notify()
+    {
+#if defined(__linux__)
+        uint64_t value = 1;
+#else
+        uint8_t value = 1;
+#endif
+        // If the write fails because the counter or the pipe is full, the
+        // event loop has a pending notification already
+        ssize_t result = ::write(write_fd, &value, sizeof(value));
+        (void) result;
+    }
+
+    void clear_notification()
+    {
+        uint64_t buffer[8];
+        while (::read(read_fd, buffer, sizeof(buffer)) > 0) {
+        }
+    }
+
+    dds::core::cond::WaitSet waitset;
+    dds::core::cond::GuardCondition stop_condition;
+    std::vector<Condition> ready;
+    std::vector<Condition> dispatching;
+    std::mutex mutex;
+    std::thread thread;
+    int read_fd = -1;
+    int write_fd = -1;
+    std::atomic<bool> closed { false };
+};
+
+template<>
+void init_class_defs(
+        py::class_<WaitSetFdNotifier, unique_ptr_no_gil<WaitSetFdNotifier>>&
+                cls)
+{
+    cls.def(py::init<>(),
+            py::call_guard<py::gil_scoped_release>(),
+            "Create a WaitSetFdNotifier and start its notification thread.");
+
+    cls.def("fileno",
+            &WaitSetFdNotifier::fileno,
+            "The file descriptor that becomes readable when attached "
+            "conditions trigger.");
+
+    cls.def("dispatch",
+            &WaitSetFdNotifier::dispatch,
+            py::call_guard<py::gil_scoped_release>(),
+            "Dispatch the conditions that have triggered. Call it when "
+            "fileno() becomes readable.");
+
+    cls.def(
+            "attach_condition",
+            [](WaitSetFdNotifier& ws, PyICondition& c) {
+                ws.attach_condition(c.get_condition());
+            },
+            py::arg("condition"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Attach a condition; it is detached automatically when it "
+            "triggers.");
+
+    cls.def(
+            "detach_condition",
+            [](WaitSetFdNotifier& ws, PyICondition& c) {
+                return ws.detach_condition(c.get_condition());
+            },
+            py::arg("condition"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Detach a condition that has not been dispatched yet.");
+
+    cls.def("close",
+            &WaitSetFdNotifier::close,
+            py::call_guard<py::gil_scoped_release>(),
+            "Stop the notification thread and close the file descriptor.");
+}
+#endif
+
 template<>
 void process_inits<WaitSet>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<WaitSet, unique_ptr_no_gil<WaitSet>>(m, "WaitSet");
-    });
-
-    l.push_back([m]() mutable {
-        return init_class<FastWaitSet, unique_ptr_no_gil<FastWaitSet>>(
-                m,
-                "_FastWaitSet");
-    });
-
-    l.push_back([m]() mutable {
-        return init_class<PyTriggeredConditions>(m, "TriggeredConditions");
-    });
-
-    l.push_back([m]() mutable {
-        return init_class<PyTriggeredConditionsIterator>(
-                m,
-                "TriggeredConditionsIterator");
-    });
+    l.push_back(class_init<WaitSet, unique_ptr_no_gil<WaitSet>>(m, "WaitSet"));
+
+    l.push_back(class_init<FastWaitSet, unique_ptr_no_gil<FastWaitSet>>(
+            m,
+            "_FastWaitSet"));
+
+#ifndef _WIN32
+    l.push_back(class_init<
+            WaitSetFdNotifier,
+            unique_ptr_no_gil<WaitSetFdNotifier>>(
+            m,
+            "_WaitSetFdNotifier"));
+#endif
+
+    l.push_back(class_init<PyTriggeredConditions>(m, "TriggeredConditions"));
+
+    l.push_back(class_init<PyTriggeredConditionsIterator>(
+            m,
+            "TriggeredConditionsIterator"));
 }
 
 }  // namespace pyrti
@@ -76,9 +76,7 @@ void init_class_defs(py::class_<DataRepresentation>& cls)
 template<>
 void process_inits<DataRepresentation>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataRepresentation>(m, "DataRepresentation");
-    });
+    l.push_back(class_init<DataRepresentation>(m, "DataRepresentation"));
 }
 
 }  // namespace pyrti
@@ -114,7 +114,7 @@ void init_class_defs(py::class_<DataTag>& cls)
 template<>
 void process_inits<DataTag>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<DataTag>(m, "DataTag"); });
+    l.push_back(class_init<DataTag>(m, "DataTag"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
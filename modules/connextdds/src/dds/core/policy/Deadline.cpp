@@ -44,7 +44,7 @@ void init_class_defs(py::class_<Deadline>& cls)
 template<>
 void process_inits<Deadline>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Deadline>(m, "Deadline"); });
+    l.push_back(class_init<Deadline>(m, "Deadline"));
 }
 
 }  // namespace pyrti
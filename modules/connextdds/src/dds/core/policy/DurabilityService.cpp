@@ -96,9 +96,7 @@ void init_class_defs(py::class_<DurabilityService>& cls)
 template<>
 void process_inits<DurabilityService>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DurabilityService>(m, "DurabilityService");
-    });
+    l.push_back(class_init<DurabilityService>(m, "DurabilityService"));
 }
 
 }  // namespace pyrti
@@ -53,9 +53,7 @@ void init_class_defs(py::class_<EntityFactory>& cls)
 template<>
 void process_inits<EntityFactory>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<EntityFactory>(m, "EntityFactory");
-    });
+    l.push_back(class_init<EntityFactory>(m, "EntityFactory"));
 }
 
 }  // namespace pyrti
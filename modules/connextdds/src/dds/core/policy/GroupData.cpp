@@ -46,8 +46,7 @@ void init_class_defs(py::class_<GroupData>& cls)
 template<>
 void process_inits<GroupData>(py::module& m, ClassInitList& l)
 {
-    l.push_back(
-            [m]() mutable { return init_class<GroupData>(m, "GroupData"); });
+    l.push_back(class_init<GroupData>(m, "GroupData"));
 }
 
 }  // namespace pyrti
@@ -40,9 +40,7 @@ void init_class_defs(py::class_<LatencyBudget>& cls)
 template<>
 void process_inits<LatencyBudget>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<LatencyBudget>(m, "LatencyBudget");
-    });
+    l.push_back(class_init<LatencyBudget>(m, "LatencyBudget"));
 }
 
 }  // namespace pyrti
@@ -40,7 +40,7 @@ void init_class_defs(py::class_<Lifespan>& cls)
 template<>
 void process_inits<Lifespan>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Lifespan>(m, "Lifespan"); });
+    l.push_back(class_init<Lifespan>(m, "Lifespan"));
 }
 
 }  // namespace pyrti
@@ -37,9 +37,7 @@ void init_class_defs(py::class_<OwnershipStrength>& cls)
 template<>
 void process_inits<OwnershipStrength>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<OwnershipStrength>(m, "OwnershipStrength");
-    });
+    l.push_back(class_init<OwnershipStrength>(m, "OwnershipStrength"));
 }
 
 }  // namespace pyrti
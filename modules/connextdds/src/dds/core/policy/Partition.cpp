@@ -43,8 +43,7 @@ void init_class_defs<Partition>(py::class_<Partition>& cls)
 template<>
 void process_inits<Partition>(py::module& m, ClassInitList& l)
 {
-    l.push_back(
-            [m]() mutable { return init_class<Partition>(m, "Partition"); });
+    l.push_back(class_init<Partition>(m, "Partition"));
 }
 
 }  // namespace pyrti
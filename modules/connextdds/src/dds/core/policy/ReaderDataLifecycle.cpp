@@ -110,9 +110,7 @@ void init_class_defs(py::class_<ReaderDataLifecycle>& cls)
 template<>
 void process_inits<ReaderDataLifecycle>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ReaderDataLifecycle>(m, "ReaderDataLifecycle");
-    });
+    l.push_back(class_init<ReaderDataLifecycle>(m, "ReaderDataLifecycle"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
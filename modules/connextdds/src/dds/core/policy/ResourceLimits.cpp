@@ -91,9 +91,7 @@ void init_class_defs(py::class_<ResourceLimits>& cls)
 template<>
 void process_inits<ResourceLimits>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ResourceLimits>(m, "ResourceLimits");
-    });
+    l.push_back(class_init<ResourceLimits>(m, "ResourceLimits"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
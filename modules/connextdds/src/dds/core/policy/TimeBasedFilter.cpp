@@ -38,9 +38,7 @@ void init_class_defs(py::class_<TimeBasedFilter>& cls)
 template<>
 void process_inits<TimeBasedFilter>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<TimeBasedFilter>(m, "TimeBasedFilter");
-    });
+    l.push_back(class_init<TimeBasedFilter>(m, "TimeBasedFilter"));
 }
 
 }  // namespace pyrti
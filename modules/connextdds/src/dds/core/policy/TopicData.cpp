@@ -44,8 +44,7 @@ void init_class_defs(py::class_<TopicData>& cls)
 template<>
 void process_inits<TopicData>(py::module& m, ClassInitList& l)
 {
-    l.push_back(
-            [m]() mutable { return init_class<TopicData>(m, "TopicData"); });
+    l.push_back(class_init<TopicData>(m, "TopicData"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
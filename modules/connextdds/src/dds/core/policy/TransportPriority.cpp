@@ -37,9 +37,7 @@ void init_class_defs(py::class_<TransportPriority>& cls)
 template<>
 void process_inits<TransportPriority>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<TransportPriority>(m, "TransportPriority");
-    });
+    l.push_back(class_init<TransportPriority>(m, "TransportPriority"));
 }
 
 }  // namespace pyrti
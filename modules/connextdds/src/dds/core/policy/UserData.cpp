@@ -45,7 +45,7 @@ void init_class_defs(py::class_<UserData>& cls)
 template<>
 void process_inits<UserData>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<UserData>(m, "UserData"); });
+    l.push_back(class_init<UserData>(m, "UserData"));
 }
 
 }  // namespace pyrti
@@ -71,9 +71,7 @@ void init_class_defs(py::class_<WriterDataLifecycle>& cls)
 template<>
 void process_inits<WriterDataLifecycle>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<WriterDataLifecycle>(m, "WriterDataLifecycle");
-    });
+    l.push_back(class_init<WriterDataLifecycle>(m, "WriterDataLifecycle"));
 }
 
 }  // namespace pyrti
@@ -38,11 +38,9 @@ void init_class_defs(py::class_<InconsistentTopicStatus>& cls)
 template<>
 void process_inits<InconsistentTopicStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<InconsistentTopicStatus>(
-                m,
-                "InconsistentTopicStatus");
-    });
+    l.push_back(class_init<InconsistentTopicStatus>(
+            m,
+            "InconsistentTopicStatus"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
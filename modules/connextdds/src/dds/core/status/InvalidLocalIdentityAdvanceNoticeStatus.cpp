@@ -30,11 +30,9 @@ void process_inits<InvalidLocalIdentityAdvanceNoticeStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<InvalidLocalIdentityAdvanceNoticeStatus>(
-                m,
-                "InvalidLocalIdentityAdvanceNoticeStatus");
-    });
+    l.push_back(class_init<InvalidLocalIdentityAdvanceNoticeStatus>(
+            m,
+            "InvalidLocalIdentityAdvanceNoticeStatus"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
@@ -52,11 +52,9 @@ void init_class_defs(py::class_<LivelinessChangedStatus>& cls)
 template<>
 void process_inits<LivelinessChangedStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<LivelinessChangedStatus>(
-                m,
-                "LivelinessChangedStatus");
-    });
+    l.push_back(class_init<LivelinessChangedStatus>(
+            m,
+            "LivelinessChangedStatus"));
 }
 
 }  // namespace pyrti
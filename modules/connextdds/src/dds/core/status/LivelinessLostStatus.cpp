@@ -37,9 +37,7 @@ void init_class_defs(py::class_<LivelinessLostStatus>& cls)
 template<>
 void process_inits<LivelinessLostStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<LivelinessLostStatus>(m, "LivelinessLostStatus");
-    });
+    l.push_back(class_init<LivelinessLostStatus>(m, "LivelinessLostStatus"));
 }
 
 }  // namespace pyrti
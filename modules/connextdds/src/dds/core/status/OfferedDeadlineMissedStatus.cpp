@@ -38,11 +38,9 @@ void init_class_defs(py::class_<OfferedDeadlineMissedStatus>& cls)
 template<>
 void process_inits<OfferedDeadlineMissedStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<OfferedDeadlineMissedStatus>(
-                m,
-                "OfferedDeadlineMissedStatus");
-    });
+    l.push_back(class_init<OfferedDeadlineMissedStatus>(
+            m,
+            "OfferedDeadlineMissedStatus"));
 }
 
 }  // namespace pyrti
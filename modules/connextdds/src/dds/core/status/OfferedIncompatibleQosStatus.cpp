@@ -56,11 +56,9 @@ void process_inits<OfferedIncompatibleQosStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<OfferedIncompatibleQosStatus>(
-                m,
-                "OfferedIncompatibleQosStatus");
-    });
+    l.push_back(class_init<OfferedIncompatibleQosStatus>(
+            m,
+            "OfferedIncompatibleQosStatus"));
 }
 
 }  // namespace pyrti
@@ -58,11 +58,9 @@ void init_class_defs(py::class_<PublicationMatchedStatus>& cls)
 template<>
 void process_inits<PublicationMatchedStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<PublicationMatchedStatus>(
-                m,
-                "PublicationMatchedStatus");
-    });
+    l.push_back(class_init<PublicationMatchedStatus>(
+            m,
+            "PublicationMatchedStatus"));
 }
 
 }  // namespace pyrti
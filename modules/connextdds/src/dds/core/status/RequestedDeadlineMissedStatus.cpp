@@ -41,11 +41,9 @@ void process_inits<RequestedDeadlineMissedStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<RequestedDeadlineMissedStatus>(
-                m,
-                "RequestedDeadlineMissedStatus");
-    });
+    l.push_back(class_init<RequestedDeadlineMissedStatus>(
+            m,
+            "RequestedDeadlineMissedStatus"));
 }
 
 }  // namespace pyrti
@@ -51,11 +51,9 @@ void process_inits<RequestedIncompatibleQosStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<RequestedIncompatibleQosStatus>(
-                m,
-                "RequestedIncompatibleQosStatus");
-    });
+    l.push_back(class_init<RequestedIncompatibleQosStatus>(
+            m,
+            "RequestedIncompatibleQosStatus"));
 }
 
 }  // namespace pyrti
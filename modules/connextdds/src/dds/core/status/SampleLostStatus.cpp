@@ -40,9 +40,7 @@ void init_class_defs(py::class_<SampleLostStatus>& cls)
 template<>
 void process_inits<SampleLostStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SampleLostStatus>(m, "SampleLostStatus");
-    });
+    l.push_back(class_init<SampleLostStatus>(m, "SampleLostStatus"));
 }
 
 }  // namespace pyrti
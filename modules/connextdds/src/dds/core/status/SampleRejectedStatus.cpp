@@ -44,9 +44,7 @@ void init_class_defs(py::class_<SampleRejectedStatus>& cls)
 template<>
 void process_inits<SampleRejectedStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SampleRejectedStatus>(m, "SampleRejectedStatus");
-    });
+    l.push_back(class_init<SampleRejectedStatus>(m, "SampleRejectedStatus"));
 }
 
 }  // namespace pyrti
@@ -58,11 +58,9 @@ void init_class_defs(py::class_<SubscriptionMatchedStatus>& cls)
 template<>
 void process_inits<SubscriptionMatchedStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SubscriptionMatchedStatus>(
-                m,
-                "SubscriptionMatchedStatus");
-    });
+    l.push_back(class_init<SubscriptionMatchedStatus>(
+            m,
+            "SubscriptionMatchedStatus"));
 }
 
 }  // namespace pyrti
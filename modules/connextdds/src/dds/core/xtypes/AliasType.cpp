@@ -51,9 +51,7 @@ void init_class_defs(py::class_<AliasType, DynamicType>& cls)
 template<>
 void process_inits<AliasType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AliasType, DynamicType>(m, "AliasType");
-    });
+    l.push_back(class_init<AliasType, DynamicType>(m, "AliasType"));
 }
 
 }  // namespace pyrti
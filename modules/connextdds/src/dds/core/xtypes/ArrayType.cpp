@@ -54,9 +54,7 @@ void init_class_defs(py::class_<ArrayType, CollectionType>& cls)
 template<>
 void process_inits<ArrayType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ArrayType, CollectionType>(m, "ArrayType");
-    });
+    l.push_back(class_init<ArrayType, CollectionType>(m, "ArrayType"));
 }
 
 }  // namespace pyrti
@@ -33,9 +33,7 @@ void init_class_defs(py::class_<CollectionType, DynamicType>& cls)
 template<>
 void process_inits<CollectionType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<CollectionType, DynamicType>(m, "CollectionType");
-    });
+    l.push_back(class_init<CollectionType, DynamicType>(m, "CollectionType"));
 }
 
 }  // namespace pyrti
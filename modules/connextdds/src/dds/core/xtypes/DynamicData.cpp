@@ -12,10 +12,23 @@
 #include "PyConnext.hpp"
 #include "PySeq.hpp"
 #include <pybind11/numpy.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include <dds/core/xtypes/DynamicData.hpp>
 #include <dds/core/QosProvider.hpp>
 #include "PyInitType.hpp"
 #include "PyInitOpaqueTypeContainers.hpp"
+#include "PyColumns.hpp"
+#include "PyFieldAccessor.hpp"
+#include "PyInterpreterLocal.hpp"
+#include "PyTypeFactoryReference.hpp"
+#include "PyDynamicDataPrimitives.hpp"
 
 using namespace dds::core::xtypes;
 using namespace dds::topic;
@@ -1085,6 +1098,1222 @@ static DynamicData create_data(dds::sub::DataReader<DynamicData>& reader)
             reader.topic_description().type_name()));
 }
 
+// Appends the value of a DynamicData member to a take_columns() column.
+// The member is accessed by its index, which is resolved once per call.
+template<typename ValueType, typename ColumnType = ValueType>
+static void append_member_value(
+        const DynamicData& data,
+        uint32_t member_index,
+        PyColumn& column)
+{
+    ColumnType value =
+            static_cast<ColumnType>(data.value<ValueType>(member_index));
+    column.append(reinterpret_cast<const char*>(&value));
+}
+
+struct DynamicDataColumn {
+    using AppendFunction = void (*)(const DynamicData&, uint32_t, PyColumn&);
+
+    std::string member;
+    uint32_t member_index;
+    NativePrimitiveKind kind;
+    AppendFunction append;
+    std::unique_ptr<PyColumn> column;
+};
+
+static DynamicDataColumn create_column(
+        DynamicData& data,
+        const std::string& member)
+{
+    if (member.find('.') != std::string::npos) {
+        throw dds::core::InvalidArgumentError(
+                "take_columns only supports top-level members in DynamicData");
+    }
+
+    auto mi = get_member_info(data, member);
+    auto member_index = data.member_index(member);
+    auto kind = resolve_member_type_kind(
+            data,
+            mi.member_kind().underlying(),
+            member);
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::INT8,
+                 append_member_value<bool, int8_t>,
+                 nullptr };
+    case TypeKind::CHAR_8_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::INT8,
+                 append_member_value<char, int8_t>,
+                 nullptr };
+    case TypeKind::UINT_8_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::UINT8,
+                 append_member_value<uint8_t>,
+                 nullptr };
+    case TypeKind::INT_16_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::INT16,
+                 append_member_value<int16_t>,
+                 nullptr };
+    case TypeKind::UINT_16_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::UINT16,
+                 append_member_value<uint16_t>,
+                 nullptr };
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::INT32,
+                 append_member_value<int32_t>,
+                 nullptr };
+    case TypeKind::UINT_32_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::UINT32,
+                 append_member_value<uint32_t>,
+                 nullptr };
+    case TypeKind::INT_64_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::INT64,
+                 append_member_value<rti::core::int64>,
+                 nullptr };
+    case TypeKind::UINT_64_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::UINT64,
+                 append_member_value<rti::core::uint64>,
+                 nullptr };
+    case TypeKind::FLOAT_32_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::FLOAT32,
+                 append_member_value<float>,
+                 nullptr };
+    case TypeKind::FLOAT_64_TYPE:
+        return { member,
+                 member_index,
+                 NativePrimitiveKind::FLOAT64,
+                 append_member_value<double>,
+                 nullptr };
+    default:
+        throw dds::core::InvalidArgumentError(
+                "'" + member + "' is not a primitive member");
+    }
+}
+
+// Takes the valid data as columns of the given primitive members. This
+// doesn't require the GIL until the Python columns are created.
+static py::dict take_columns(
+        PyDataReader<DynamicData>& reader,
+        const std::vector<std::string>& fields)
+{
+    // Obtain the member kinds from an empty sample
+    auto type_data = create_data(reader);
+    std::vector<DynamicDataColumn> columns;
+    for (const auto& field : fields) {
+        columns.push_back(create_column(type_data, field));
+    }
+
+    auto samples = reader.take();
+    for (auto& column : columns) {
+        column.column = PyColumn::create(column.kind, samples.length());
+    }
+    PySampleInfoColumns info_columns(samples.length());
+
+    for (const auto& sample : samples) {
+        if (!sample.info().valid()) {
+            continue;
+        }
+
+        for (auto& column : columns) {
+            column.append(
+                    sample.data(),
+                    column.member_index,
+                    *column.column);
+        }
+        info_columns.append(sample.info());
+    }
+
+    py::gil_scoped_acquire acquire;
+    py::dict py_columns;
+    for (auto& column : columns) {
+        py_columns[py::str(column.member)] = column.column->to_python();
+    }
+    info_columns.add_to(py_columns);
+
+    return py_columns;
+}
+
+// A bounded cache of values computed from a DynamicType and a key (such as a
+// member path). Equal types share their values, so a type is looked up by
+// name and then compared with the types that have that name. When the cache
+// is full, the oldest value is evicted.
+//
+// Not thread-safe.
+template<typename T>
+class DynamicTypeCache {
+public:
+    explicit DynamicTypeCache(size_t max_size) : max_size_(max_size)
+    {
+    }
+
+    std::shared_ptr<T> find(const DynamicType& type, const std::string& key)
+    {
+        auto name_it = by_name_.find(std::make_pair(type.name(), key));
+        if (name_it == by_name_.end()) {
+            return nullptr;
+        }
+        for (auto& entry : name_it->second) {
+            if (&entry->type.native() == &type.native()
+                || entry->type == type) {
+                return entry->value;
+            }
+        }
+        return nullptr;
+    }
+
+    void insert(
+            const DynamicType& type,
+            const std::string& key,
+            std::shared_ptr<T> value)
+    {
+        if (entries_.size() >= max_size_) {
+            evict_oldest();
+        }
+
+        entries_.push_back(Entry { type, type.name(), key, std::move(value) });
+        auto entry = std::prev(entries_.end());
+        by_name_[std::make_pair(entry->name, key)].push_back(entry);
+    }
+
+private:
+    struct Entry {
+        // The cache holds the type, so its TypeCode can't be destroyed and
+        // its address reused while the entry exists
+        DynamicType type;
+        std::string name;
+        std::string key;
+        std::shared_ptr<T> value;
+    };
+
+    using EntryIterator = typename std::list<Entry>::iterator;
+
+    void evict_oldest()
+    {
+        auto entry = entries_.begin();
+        auto name_it = by_name_.find(std::make_pair(entry->name, entry->key));
+        auto& same_name = name_it->second;
+        same_name.erase(std::find(same_name.begin(), same_name.end(), entry));
+        if (same_name.empty()) {
+            by_name_.erase(name_it);
+        }
+        entries_.erase(entry);
+    }
+
+    size_t max_size_;
+    // Oldest first
+    std::list<Entry> entries_;
+    // (type name, key) -> entries
+    std::map<std::pair<std::string, std::string>, std::vector<EntryIterator>>
+            by_name_;
+};
+
+// Parses the indices of a subscript such as "[3]" or "[1, 2]" starting at
+// pos, and moves pos past it
+static std::vector<int> parse_subscript(const std::string& token, size_t& pos)
+{
+    size_t close = token.find(']', pos);
+    if (token[pos] != '[' || close == std::string::npos) {
+        throw dds::core::InvalidArgumentError(
+                "index parse error in '" + token + "'");
+    }
+
+    std::vector<int> indices;
+    std::stringstream ss(token.substr(pos + 1, close - pos - 1));
+    std::string index;
+    while (std::getline(ss, index, ',')) {
+        size_t parsed = 0;
+        int value = -1;
+        try {
+            value = std::stoi(index, &parsed);
+        } catch (const std::exception&) {
+            parsed = 0;
+        }
+        if (parsed == 0 || value < 0
+                || index.find_first_not_of(" \t", parsed)
+                        != std::string::npos) {
+            throw dds::core::InvalidArgumentError(
+                    "index parse error in '" + token + "'");
+        }
+        indices.push_back(value);
+    }
+
+    if (indices.empty()) {
+        throw dds::core::InvalidArgumentError(
+                "index parse error in '" + token + "'");
+    }
+
+    pos = close + 1;
+    return indices;
+}
+
+PyFieldAccessor::PyFieldAccessor(
+        const DynamicType& type,
+        const std::string& path)
+        : type_(type), path_(path)
+{
+    DynamicType current = rti::core::xtypes::resolve_alias(type);
+    std::stringstream ss(path);
+    std::string token;
+    while (std::getline(ss, token, '.')) {
+        size_t pos = token.find('[');
+        std::string member_name = token.substr(0, pos);
+        if (current.kind() != TypeKind::STRUCTURE_TYPE) {
+            throw dds::core::InvalidArgumentError(
+                    "'" + path + "': compiled paths can only access members "
+                    "of structs");
+        }
+
+        // DynamicData resolves the member index (including inherited
+        // members) and the member type
+        DynamicData type_data(current);
+        if (!type_data.member_exists_in_type(member_name)) {
+            throw dds::core::InvalidArgumentError(
+                    "member name " + member_name + " does not exist in type");
+        }
+        current = rti::core::xtypes::resolve_alias(
+                type_data.member_type(member_name));
+        steps_.push_back({ type_data.member_index(member_name),
+                           current.kind().underlying(),
+                           false });
+
+        while (pos != std::string::npos && pos < token.size()) {
+            std::vector<int> indices = parse_subscript(token, pos);
+            int offset = indices[0];
+            if (current.kind() == TypeKind::ARRAY_TYPE) {
+                offset = calculate_multidimensional_offset(current, indices);
+            } else if (current.kind() != TypeKind::SEQUENCE_TYPE) {
+                throw dds::core::InvalidArgumentError(
+                        "type does not support subscript");
+            } else if (indices.size() != 1) {
+                throw py::index_error(
+                        "Invalid dimensions specified for index access.");
+            }
+
+            current = rti::core::xtypes::resolve_alias(
+                    static_cast<const CollectionType&>(current)
+                            .content_type());
+            steps_.push_back({ static_cast<uint32_t>(offset + 1),
+                               current.kind().underlying(),
+                               true });
+        }
+    }
+
+    if (steps_.empty()) {
+        throw dds::core::InvalidArgumentError("empty member path");
+    }
+}
+
+// The accessors are cached per interpreter, like the NumPy layouts. The cache
+// keeps the TypeCode factory alive until its DynamicTypes are destroyed.
+struct FieldAccessorCache {
+    static const size_t MAX_SIZE = 1024;
+
+    PyTypeFactoryReference type_factory;
+    std::mutex mutex;
+    DynamicTypeCache<PyFieldAccessor> accessors { MAX_SIZE };
+};
+
+std::shared_ptr<PyFieldAccessor> PyFieldAccessor::compile(
+        const DynamicType& type,
+        const std::string& path)
+{
+    auto& cache = interpreter_local<FieldAccessorCache>(
+            "rti.connextdds.field_accessors");
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto accessor = cache.accessors.find(type, path);
+    if (accessor == nullptr) {
+        accessor = std::make_shared<PyFieldAccessor>(type, path);
+        cache.accessors.insert(type, path, accessor);
+    }
+    return accessor;
+}
+
+void PyFieldAccessor::check_type(const DynamicData& data) const
+{
+    if (&data.type().native() != &type_.native() && data.type() != type_) {
+        throw dds::core::InvalidArgumentError(
+                "The DynamicData type is not the type of the path '" + path_
+                + "'");
+    }
+}
+
+py::object PyFieldAccessor::get(DynamicData& data) const
+{
+    check_type(data);
+
+    DynamicDataNestedIndex loans;
+    DynamicData* current = &data;
+    for (size_t i = 0; i < steps_.size() - 1; i++) {
+        loans.loan_list.push_back(current->loan_value(steps_[i].member_index));
+        current = &loans.loan_list.back().get();
+    }
+
+    // Like data[path], a member collection is returned as a list, but a
+    // collection element as a DynamicData
+    const Step& last = steps_.back();
+    return get_member(*current, last.kind, last.member_index, !last.is_element);
+}
+
+void PyFieldAccessor::set(DynamicData& data, py::object& value) const
+{
+    check_type(data);
+
+    DynamicDataNestedIndex loans;
+    DynamicData* current = &data;
+    for (size_t i = 0; i < steps_.size() - 1; i++) {
+        loans.loan_list.push_back(current->loan_value(steps_[i].member_index));
+        current = &loans.loan_list.back().get();
+    }
+
+    const Step& last = steps_.back();
+    set_member(*current, last.kind, last.member_index, value);
+}
+
+bool PyFieldAccessor::get_value(DynamicData& data, PyFieldValue& value) const
+{
+    DynamicDataNestedIndex loans;
+    DynamicData* current = &data;
+    for (size_t i = 0; i < steps_.size() - 1; i++) {
+        if (!steps_[i].is_element
+            && !current->member_exists(steps_[i].member_index)) {
+            return false;
+        }
+        loans.loan_list.push_back(current->loan_value(steps_[i].member_index));
+        current = &loans.loan_list.back().get();
+    }
+
+    const Step& last = steps_.back();
+    if (!last.is_element && !current->member_exists(last.member_index)) {
+        return false;
+    }
+
+    value.kind = PyFieldValue::Kind::INTEGER;
+    switch (last.kind) {
+    case TypeKind::BOOLEAN_TYPE:
+        value.integer = current->value<bool>(last.member_index) ? 1 : 0;
+        break;
+    case TypeKind::CHAR_8_TYPE:
+        value.integer = current->value<char>(last.member_index);
+        break;
+    case TypeKind::UINT_8_TYPE:
+        value.integer = current->value<uint8_t>(last.member_index);
+        break;
+    case TypeKind::INT_16_TYPE:
+        value.integer = current->value<int16_t>(last.member_index);
+        break;
+    case TypeKind::UINT_16_TYPE:
+        value.integer = current->value<uint16_t>(last.member_index);
+        break;
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        value.integer = current->value<int32_t>(last.member_index);
+        break;
+    case TypeKind::UINT_32_TYPE:
+        value.integer = current->value<uint32_t>(last.member_index);
+        break;
+    case TypeKind::INT_64_TYPE:
+        value.integer = current->value<rti::core::int64>(last.member_index);
+        break;
+    case TypeKind::UINT_64_TYPE: {
+        auto unsigned_value =
+                current->value<rti::core::uint64>(last.member_index);
+        if (unsigned_value
+            > static_cast<rti::core::uint64>(
+                    std::numeric_limits<int64_t>::max())) {
+            value.kind = PyFieldValue::Kind::FLOAT;
+            value.floating = static_cast<double>(unsigned_value);
+        } else {
+            value.integer = static_cast<int64_t>(unsigned_value);
+        }
+        break;
+    }
+    case TypeKind::FLOAT_32_TYPE:
+        value.kind = PyFieldValue::Kind::FLOAT;
+        value.floating = current->value<float>(last.member_index);
+        break;
+    case TypeKind::FLOAT_64_TYPE:
+        value.kind = PyFieldValue::Kind::FLOAT;
+        value.floating = current->value<double>(last.member_index);
+        break;
+    case TypeKind::STRING_TYPE:
+        value.kind = PyFieldValue::Kind::STRING;
+        value.string = current->value<std::string>(last.member_index);
+        break;
+    default:
+        throw dds::core::InvalidArgumentError(
+                "'" + path_ + "' is not a primitive, enum or string member");
+    }
+
+    return true;
+}
+
+//
+// Conversion between DynamicData and NumPy structured arrays
+//
+
+// The NumPy format of a primitive type, or nullptr if it has none
+static const char* numpy_primitive_format(TypeKind::inner_enum kind)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+        return "?";
+    case TypeKind::CHAR_8_TYPE:
+        return "S1";
+    case TypeKind::UINT_8_TYPE:
+        return "u1";
+    case TypeKind::INT_16_TYPE:
+        return "i2";
+    case TypeKind::UINT_16_TYPE:
+        return "u2";
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        return "i4";
+    case TypeKind::UINT_32_TYPE:
+        return "u4";
+    case TypeKind::INT_64_TYPE:
+        return "i8";
+    case TypeKind::UINT_64_TYPE:
+        return "u8";
+    case TypeKind::FLOAT_32_TYPE:
+        return "f4";
+    case TypeKind::FLOAT_64_TYPE:
+        return "f8";
+    default:
+        return nullptr;
+    }
+}
+
+struct NumpyStructLayout;
+
+// How a member of a struct is stored in a NumPy record
+struct NumpyMemberLayout {
+    enum class Kind {
+        PRIMITIVE,           // a scalar field
+        PRIMITIVE_ARRAY,     // a sub-array field
+        STRUCT,              // a nested structured field
+        STRUCT_ARRAY,        // a sub-array of a nested structured field
+        PRIMITIVE_SEQUENCE,  // an object field that contains a NumPy array
+        STRING               // an object field that contains a str
+    };
+
+    Kind kind;
+    std::string name;
+    uint32_t member_index;
+    // The kind of the member, or of its elements for arrays and sequences
+    TypeKind::inner_enum primitive_kind;
+    // The total number of elements of an array
+    uint32_t element_count;
+    // The offset of the field in the record
+    size_t offset;
+    std::shared_ptr<NumpyStructLayout> nested;
+};
+
+// A struct DynamicType mapped onto a NumPy structured dtype
+struct NumpyStructLayout {
+    py::dtype dtype;
+    size_t itemsize;
+    std::vector<NumpyMemberLayout> members;
+};
+
+static std::shared_ptr<NumpyStructLayout> create_numpy_layout(
+        const DynamicType& type);
+
+// The layouts are cached per interpreter, since they contain a NumPy dtype of
+// the interpreter, and destroyed with it. The cache keeps the TypeCode
+// factory alive until its DynamicTypes are destroyed.
+struct NumpyLayoutCache {
+    static const size_t MAX_SIZE = 256;
+
+    PyTypeFactoryReference type_factory;
+    std::mutex mutex;
+    DynamicTypeCache<NumpyStructLayout> layouts { MAX_SIZE };
+};
+
+// @pre The GIL must be held
+static std::shared_ptr<NumpyStructLayout> get_numpy_layout(
+        const DynamicType& type)
+{
+    auto& cache = interpreter_local<NumpyLayoutCache>(
+            "rti.connextdds.numpy_layouts");
+    auto& cache_mutex = cache.mutex;
+
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto layout = cache.layouts.find(type, std::string());
+        if (layout != nullptr) {
+            return layout;
+        }
+    }
+
+    // The layout is created without the lock, since creating it runs Python
+    // code. If another thread created the same layout meanwhile, that one is
+    // kept.
+    auto layout = create_numpy_layout(type);
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto existing_layout = cache.layouts.find(type, std::string());
+    if (existing_layout != nullptr) {
+        return existing_layout;
+    }
+    cache.layouts.insert(type, std::string(), layout);
+    return layout;
+}
+
+static std::shared_ptr<NumpyStructLayout> create_numpy_layout(
+        const DynamicType& type)
+{
+    DynamicType struct_type = rti::core::xtypes::resolve_alias(type);
+    if (struct_type.kind() != TypeKind::STRUCTURE_TYPE) {
+        throw dds::core::InvalidArgumentError(
+                "Only struct types can be converted to NumPy");
+    }
+
+    auto layout = std::make_shared<NumpyStructLayout>();
+    DynamicData type_data(struct_type);
+    py::list fields;
+    for (uint32_t i = 1; i <= type_data.member_count(); i++) {
+        auto mi = get_member_info(type_data, i);
+        NumpyMemberLayout member { NumpyMemberLayout::Kind::PRIMITIVE,
+                                   mi.member_name(),
+                                   i,
+                                   TypeKind::NO_TYPE,
+                                   1,
+                                   0,
+                                   nullptr };
+        DynamicType member_type = rti::core::xtypes::resolve_alias(
+                type_data.member_type(member.name));
+        auto kind = member_type.kind().underlying();
+
+        if (numpy_primitive_format(kind) != nullptr) {
+            member.primitive_kind = kind;
+            fields.append(py::make_tuple(
+                    member.name,
+                    numpy_primitive_format(kind)));
+        } else if (kind == TypeKind::STRING_TYPE) {
+            member.kind = NumpyMemberLayout::Kind::STRING;
+            fields.append(py::make_tuple(member.name, "O"));
+        } else if (kind == TypeKind::STRUCTURE_TYPE) {
+            member.kind = NumpyMemberLayout::Kind::STRUCT;
+            member.nested = get_numpy_layout(member_type);
+            fields.append(py::make_tuple(member.name, member.nested->dtype));
+        } else if (kind == TypeKind::ARRAY_TYPE) {
+            auto& array_type = static_cast<const ArrayType&>(member_type);
+            DynamicType element_type = rti::core::xtypes::resolve_alias(
+                    array_type.content_type());
+            auto element_kind = element_type.kind().underlying();
+            py::list shape;
+            for (uint32_t dim = 0; dim < array_type.dimension_count(); dim++) {
+                shape.append(array_type.dimension(dim));
+                member.element_count *= array_type.dimension(dim);
+            }
+
+            if (numpy_primitive_format(element_kind) != nullptr) {
+                member.kind = NumpyMemberLayout::Kind::PRIMITIVE_ARRAY;
+                member.primitive_kind = element_kind;
+                fields.append(py::make_tuple(
+                        member.name,
+                        numpy_primitive_format(element_kind),
+                        py::tuple(shape)));
+            } else if (element_kind == TypeKind::STRUCTURE_TYPE) {
+                member.kind = NumpyMemberLayout::Kind::STRUCT_ARRAY;
+                member.nested = get_numpy_layout(element_type);
+                fields.append(py::make_tuple(
+                        member.name,
+                        member.nested->dtype,
+                        py::tuple(shape)));
+            } else {
+                throw dds::core::InvalidArgumentError(
+                        "member '" + member.name
+                        + "' can't be converted to NumPy");
+            }
+        } else if (kind == TypeKind::SEQUENCE_TYPE) {
+            auto& sequence_type = static_cast<const SequenceType&>(member_type);
+            auto element_kind = rti::core::xtypes::resolve_alias(
+                                        sequence_type.content_type())
+                                        .kind()
+                                        .underlying();
+            if (numpy_primitive_format(element_kind) == nullptr) {
+                throw dds::core::InvalidArgumentError(
+                        "member '" + member.name
+                        + "' can't be converted to NumPy");
+            }
+            member.kind = NumpyMemberLayout::Kind::PRIMITIVE_SEQUENCE;
+            member.primitive_kind = element_kind;
+            fields.append(py::make_tuple(member.name, "O"));
+        } else {
+            throw dds::core::InvalidArgumentError(
+                    "member '" + member.name + "' can't be converted to NumPy");
+        }
+
+        layout->members.push_back(std::move(member));
+    }
+
+    layout->dtype = py::dtype::from_args(fields);
+    layout->itemsize = static_cast<size_t>(layout->dtype.itemsize());
+    py::dict dtype_fields = layout->dtype.attr("fields");
+    for (auto& member : layout->members) {
+        member.offset = py::cast<size_t>(
+                dtype_fields[py::str(member.name)].cast<py::tuple>()[1]);
+    }
+
+    return layout;
+}
+
+template<typename T>
+static void read_primitive_value(
+        const DynamicData& dd,
+        uint32_t member_index,
+        char* dest)
+{
+    T value = dd.value<T>(member_index);
+    std::memcpy(dest, &value, sizeof(T));
+}
+
+template<typename T>
+static void write_primitive_value(
+        DynamicData& dd,
+        uint32_t member_index,
+        const char* src)
+{
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    dd.value<T>(member_index, value);
+}
+
+bool is_primitive_member_kind(TypeKind::inner_enum kind)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+    case TypeKind::CHAR_8_TYPE:
+    case TypeKind::UINT_8_TYPE:
+    case TypeKind::INT_16_TYPE:
+    case TypeKind::UINT_16_TYPE:
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+    case TypeKind::UINT_32_TYPE:
+    case TypeKind::INT_64_TYPE:
+    case TypeKind::UINT_64_TYPE:
+    case TypeKind::FLOAT_32_TYPE:
+    case TypeKind::FLOAT_64_TYPE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void read_primitive_member(
+        const DynamicData& dd,
+        TypeKind::inner_enum kind,
+        uint32_t member_index,
+        char* dest)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE: {
+        *dest = dd.value<bool>(member_index) ? 1 : 0;
+        break;
+    }
+    case TypeKind::CHAR_8_TYPE:
+        read_primitive_value<char>(dd, member_index, dest);
+        break;
+    case TypeKind::UINT_8_TYPE:
+        read_primitive_value<uint8_t>(dd, member_index, dest);
+        break;
+    case TypeKind::INT_16_TYPE:
+        read_primitive_value<int16_t>(dd, member_index, dest);
+        break;
+    case TypeKind::UINT_16_TYPE:
+        read_primitive_value<uint16_t>(dd, member_index, dest);
+        break;
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        read_primitive_value<int32_t>(dd, member_index, dest);
+        break;
+    case TypeKind::UINT_32_TYPE:
+        read_primitive_value<uint32_t>(dd, member_index, dest);
+        break;
+    case TypeKind::INT_64_TYPE:
+        read_primitive_value<rti::core::int64>(dd, member_index, dest);
+        break;
+    case TypeKind::UINT_64_TYPE:
+        read_primitive_value<rti::core::uint64>(dd, member_index, dest);
+        break;
+    case TypeKind::FLOAT_32_TYPE:
+        read_primitive_value<float>(dd, member_index, dest);
+        break;
+    case TypeKind::FLOAT_64_TYPE:
+        read_primitive_value<double>(dd, member_index, dest);
+        break;
+    default:
+        throw dds::core::InvalidArgumentError("Not a valid primitive type");
+    }
+}
+
+void write_primitive_member(
+        DynamicData& dd,
+        TypeKind::inner_enum kind,
+        uint32_t member_index,
+        const char* src)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+        dd.value<bool>(member_index, *src != 0);
+        break;
+    case TypeKind::CHAR_8_TYPE:
+        write_primitive_value<char>(dd, member_index, src);
+        break;
+    case TypeKind::UINT_8_TYPE:
+        write_primitive_value<uint8_t>(dd, member_index, src);
+        break;
+    case TypeKind::INT_16_TYPE:
+        write_primitive_value<int16_t>(dd, member_index, src);
+        break;
+    case TypeKind::UINT_16_TYPE:
+        write_primitive_value<uint16_t>(dd, member_index, src);
+        break;
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        write_primitive_value<int32_t>(dd, member_index, src);
+        break;
+    case TypeKind::UINT_32_TYPE:
+        write_primitive_value<uint32_t>(dd, member_index, src);
+        break;
+    case TypeKind::INT_64_TYPE:
+        write_primitive_value<rti::core::int64>(dd, member_index, src);
+        break;
+    case TypeKind::UINT_64_TYPE:
+        write_primitive_value<rti::core::uint64>(dd, member_index, src);
+        break;
+    case TypeKind::FLOAT_32_TYPE:
+        write_primitive_value<float>(dd, member_index, src);
+        break;
+    case TypeKind::FLOAT_64_TYPE:
+        write_primitive_value<double>(dd, member_index, src);
+        break;
+    default:
+        throw dds::core::InvalidArgumentError("Not a valid primitive type");
+    }
+}
+
+// Copies the elements of an array or sequence member directly into dest
+template<typename T, typename F>
+static void get_record_buffer_values(
+        const DynamicData& dd,
+        const std::string& name,
+        char* dest,
+        uint32_t count,
+        F func)
+{
+    DDS_UnsignedLong length = count;
+    if (func(const_cast<DDS_DynamicData*>(&dd.native()),
+             reinterpret_cast<T*>(dest),
+             &length,
+             name.c_str(),
+             DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED)
+        != DDS_RETCODE_OK) {
+        throw dds::core::IllegalOperationError(
+                "Failed to get buffer collection member");
+    }
+}
+
+template<typename T, typename F>
+static void set_record_buffer_values(
+        DynamicData& dd,
+        const std::string& name,
+        const char* src,
+        uint32_t count,
+        F func)
+{
+    if (func(&dd.native(),
+             name.c_str(),
+             DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+             count,
+             reinterpret_cast<const T*>(src))
+        != DDS_RETCODE_OK) {
+        throw dds::core::IllegalOperationError(
+                "Failed to set buffer collection member");
+    }
+}
+
+void get_primitive_buffer(
+        const DynamicData& dd,
+        TypeKind::inner_enum kind,
+        const std::string& name,
+        char* dest,
+        uint32_t count)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+        return get_record_buffer_values<DDS_Boolean>(dd, name, dest, count, DDS_DynamicData_get_boolean_array);
+    case TypeKind::CHAR_8_TYPE:
+        return get_record_buffer_values<DDS_Char>(dd, name, dest, count, DDS_DynamicData_get_char_array);
+    case TypeKind::UINT_8_TYPE:
+        return get_record_buffer_values<DDS_Octet>(dd, name, dest, count, DDS_DynamicData_get_octet_array);
+    case TypeKind::INT_16_TYPE:
+        return get_record_buffer_values<DDS_Short>(dd, name, dest, count, DDS_DynamicData_get_short_array);
+    case TypeKind::UINT_16_TYPE:
+        return get_record_buffer_values<DDS_UnsignedShort>(dd, name, dest, count, DDS_DynamicData_get_ushort_array);
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        return get_record_buffer_values<DDS_Long>(dd, name, dest, count, DDS_DynamicData_get_long_array);
+    case TypeKind::UINT_32_TYPE:
+        return get_record_buffer_values<DDS_UnsignedLong>(dd, name, dest, count, DDS_DynamicData_get_ulong_array);
+    case TypeKind::INT_64_TYPE:
+        return get_record_buffer_values<DDS_LongLong>(dd, name, dest, count, DDS_DynamicData_get_longlong_array);
+    case TypeKind::UINT_64_TYPE:
+        return get_record_buffer_values<DDS_UnsignedLongLong>(dd, name, dest, count, DDS_DynamicData_get_ulonglong_array);
+    case TypeKind::FLOAT_32_TYPE:
+        return get_record_buffer_values<DDS_Float>(dd, name, dest, count, DDS_DynamicData_get_float_array);
+    case TypeKind::FLOAT_64_TYPE:
+        return get_record_buffer_values<DDS_Double>(dd, name, dest, count, DDS_DynamicData_get_double_array);
+    default:
+        throw dds::core::InvalidArgumentError("Not a valid buffer type");
+    }
+}
+
+void set_primitive_buffer(
+        DynamicData& dd,
+        TypeKind::inner_enum kind,
+        const std::string& name,
+        const char* src,
+        uint32_t count)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+        return set_record_buffer_values<DDS_Boolean>(dd, name, src, count, DDS_DynamicData_set_boolean_array);
+    case TypeKind::CHAR_8_TYPE:
+        return set_record_buffer_values<DDS_Char>(dd, name, src, count, DDS_DynamicData_set_char_array);
+    case TypeKind::UINT_8_TYPE:
+        return set_record_buffer_values<DDS_Octet>(dd, name, src, count, DDS_DynamicData_set_octet_array);
+    case TypeKind::INT_16_TYPE:
+        return set_record_buffer_values<DDS_Short>(dd, name, src, count, DDS_DynamicData_set_short_array);
+    case TypeKind::UINT_16_TYPE:
+        return set_record_buffer_values<DDS_UnsignedShort>(dd, name, src, count, DDS_DynamicData_set_ushort_array);
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        return set_record_buffer_values<DDS_Long>(dd, name, src, count, DDS_DynamicData_set_long_array);
+    case TypeKind::UINT_32_TYPE:
+        return set_record_buffer_values<DDS_UnsignedLong>(dd, name, src, count, DDS_DynamicData_set_ulong_array);
+    case TypeKind::INT_64_TYPE:
+        return set_record_buffer_values<DDS_LongLong>(dd, name, src, count, DDS_DynamicData_set_longlong_array);
+    case TypeKind::UINT_64_TYPE:
+        return set_record_buffer_values<DDS_UnsignedLongLong>(dd, name, src, count, DDS_DynamicData_set_ulonglong_array);
+    case TypeKind::FLOAT_32_TYPE:
+        return set_record_buffer_values<DDS_Float>(dd, name, src, count, DDS_DynamicData_set_float_array);
+    case TypeKind::FLOAT_64_TYPE:
+        return set_record_buffer_values<DDS_Double>(dd, name, src, count, DDS_DynamicData_set_double_array);
+    default:
+        throw dds::core::InvalidArgumentError("Not a valid buffer type");
+    }
+}
+
+// Replaces the object in an object field of a record
+static void set_record_object(char* field, py::object value)
+{
+    PyObject* old_value = nullptr;
+    std::memcpy(&old_value, field, sizeof(PyObject*));
+    PyObject* new_value = value.release().ptr();
+    std::memcpy(field, &new_value, sizeof(PyObject*));
+    Py_XDECREF(old_value);
+}
+
+static py::handle get_record_object(const char* field)
+{
+    PyObject* value = nullptr;
+    std::memcpy(&value, field, sizeof(PyObject*));
+    return value != nullptr ? py::handle(value) : py::handle(Py_None);
+}
+
+// Fills a NumPy record with the values of a DynamicData sample
+//
+// @pre The GIL must be held
+static void dynamic_data_to_record(
+        const DynamicData& dd,
+        const NumpyStructLayout& layout,
+        char* record)
+{
+    for (const auto& member : layout.members) {
+        char* field = record + member.offset;
+        switch (member.kind) {
+        case NumpyMemberLayout::Kind::PRIMITIVE:
+            read_primitive_member(
+                    dd,
+                    member.primitive_kind,
+                    member.member_index,
+                    field);
+            break;
+        case NumpyMemberLayout::Kind::PRIMITIVE_ARRAY:
+            get_primitive_buffer(
+                    dd,
+                    member.primitive_kind,
+                    member.name,
+                    field,
+                    member.element_count);
+            break;
+        case NumpyMemberLayout::Kind::STRUCT: {
+            auto loan = const_cast<DynamicData&>(dd).loan_value(
+                    member.member_index);
+            dynamic_data_to_record(loan.get(), *member.nested, field);
+            break;
+        }
+        case NumpyMemberLayout::Kind::STRUCT_ARRAY: {
+            auto array_loan = const_cast<DynamicData&>(dd).loan_value(
+                    member.member_index);
+            for (uint32_t i = 0; i < member.element_count; i++) {
+                auto element_loan = array_loan.get().loan_value(i + 1);
+                dynamic_data_to_record(
+                        element_loan.get(),
+                        *member.nested,
+                        field + i * member.nested->itemsize);
+            }
+            break;
+        }
+        case NumpyMemberLayout::Kind::PRIMITIVE_SEQUENCE: {
+            uint32_t length =
+                    get_member_info(dd, member.name).element_count();
+            py::array values(
+                    py::dtype(numpy_primitive_format(member.primitive_kind)),
+                    { static_cast<py::ssize_t>(length) });
+            if (length > 0) {
+                get_primitive_buffer(
+                        dd,
+                        member.primitive_kind,
+                        member.name,
+                        static_cast<char*>(values.mutable_data()),
+                        length);
+            }
+            set_record_object(field, std::move(values));
+            break;
+        }
+        case NumpyMemberLayout::Kind::STRING:
+            set_record_object(
+                    field,
+                    py::str(dd.value<std::string>(member.member_index)));
+            break;
+        }
+    }
+}
+
+// Sets the values of a DynamicData sample from a NumPy record
+//
+// @pre The GIL must be held
+static void record_to_dynamic_data(
+        const char* record,
+        const NumpyStructLayout& layout,
+        DynamicData& dd)
+{
+    for (const auto& member : layout.members) {
+        const char* field = record + member.offset;
+        switch (member.kind) {
+        case NumpyMemberLayout::Kind::PRIMITIVE:
+            write_primitive_member(
+                    dd,
+                    member.primitive_kind,
+                    member.member_index,
+                    field);
+            break;
+        case NumpyMemberLayout::Kind::PRIMITIVE_ARRAY:
+            set_primitive_buffer(
+                    dd,
+                    member.primitive_kind,
+                    member.name,
+                    field,
+                    member.element_count);
+            break;
+        case NumpyMemberLayout::Kind::STRUCT: {
+            auto loan = dd.loan_value(member.member_index);
+            record_to_dynamic_data(field, *member.nested, loan.get());
+            break;
+        }
+        case NumpyMemberLayout::Kind::STRUCT_ARRAY: {
+            auto array_loan = dd.loan_value(member.member_index);
+            for (uint32_t i = 0; i < member.element_count; i++) {
+                auto element_loan = array_loan.get().loan_value(i + 1);
+                record_to_dynamic_data(
+                        field + i * member.nested->itemsize,
+                        *member.nested,
+                        element_loan.get());
+            }
+            break;
+        }
+        case NumpyMemberLayout::Kind::PRIMITIVE_SEQUENCE: {
+            if (get_record_object(field).is_none()) {
+                // None is an empty sequence
+                static const char no_values[sizeof(rti::core::uint64)] = {};
+                set_primitive_buffer(
+                        dd,
+                        member.primitive_kind,
+                        member.name,
+                        no_values,
+                        0);
+                break;
+            }
+
+            // Any object that supports the buffer protocol with a compatible
+            // type is copied with a single memcpy
+            auto values = py::array::ensure(
+                    py::module::import("numpy").attr("ascontiguousarray")(
+                            get_record_object(field),
+                            py::dtype(numpy_primitive_format(
+                                    member.primitive_kind))));
+            if (!values) {
+                throw py::error_already_set();
+            }
+            set_primitive_buffer(
+                    dd,
+                    member.primitive_kind,
+                    member.name,
+                    static_cast<const char*>(values.data()),
+                    static_cast<uint32_t>(values.size()));
+            break;
+        }
+        case NumpyMemberLayout::Kind::STRING: {
+            py::handle value = get_record_object(field);
+            dd.value<std::string>(
+                    member.member_index,
+                    value.is_none() ? std::string()
+                                    : py::cast<std::string>(value));
+            break;
+        }
+        }
+    }
+}
+
+static py::array create_numpy_records(
+        const NumpyStructLayout& layout,
+        py::object shape)
+{
+    // The object fields are initialized to None and the rest of fields are
+    // overwritten by dynamic_data_to_record
+    return py::module::import("numpy").attr("empty")(shape, layout.dtype);
+}
+
+// Gets the records of an array with the dtype of a layout
+static py::array get_numpy_records(
+        const NumpyStructLayout& layout,
+        const py::object& records)
+{
+    auto array = py::array::ensure(records, py::array::c_style);
+    if (!array) {
+        throw py::error_already_set();
+    }
+    if (!py::object(array.dtype()).equal(layout.dtype)) {
+        throw py::type_error(
+                "The array dtype doesn't match the DynamicType's NumPy dtype");
+    }
+    return array;
+}
+
+static py::array to_numpy(const DynamicData& dd)
+{
+    auto layout = get_numpy_layout(dd.type());
+    py::array record = create_numpy_records(*layout, py::tuple());
+    dynamic_data_to_record(
+            dd,
+            *layout,
+            static_cast<char*>(record.mutable_data()));
+    return record;
+}
+
+static void from_numpy(DynamicData& dd, const py::object& record)
+{
+    auto layout = get_numpy_layout(dd.type());
+    py::array array = get_numpy_records(*layout, record);
+    if (array.size() != 1) {
+        throw py::value_error("Expected a single NumPy record");
+    }
+    record_to_dynamic_data(
+            static_cast<const char*>(array.data()),
+            *layout,
+            dd);
+}
+
+static std::vector<DynamicData> from_numpy_array(
+        const DynamicType& type,
+        const py::object& records)
+{
+    auto layout = get_numpy_layout(type);
+    py::array array = get_numpy_records(*layout, records);
+    auto data = static_cast<const char*>(array.data());
+
+    std::vector<DynamicData> samples;
+    samples.reserve(array.size());
+    for (py::ssize_t i = 0; i < array.size(); i++) {
+        samples.emplace_back(type);
+        record_to_dynamic_data(
+                data + i * layout->itemsize,
+                *layout,
+                samples.back());
+    }
+    return samples;
+}
+
+// Takes or reads the valid data into a NumPy structured array
+static py::array loaned_samples_to_numpy(
+        PyDataReader<DynamicData>& reader,
+        bool take)
+{
+    dds::sub::LoanedSamples<DynamicData> samples;
+    // The loan is returned without the GIL, also if the conversion fails
+    auto return_loan = [&samples]() {
+        py::gil_scoped_release release;
+        samples.return_loan();
+    };
+
+    py::object records;
+    try {
+        DynamicData type_data = [&reader, &samples, take]() {
+            py::gil_scoped_release release;
+            samples = take ? reader.take() : reader.read();
+            return create_data(reader);
+        }();
+
+        auto layout = get_numpy_layout(type_data.type());
+        py::ssize_t valid_count = 0;
+        for (const auto& sample : samples) {
+            if (sample.info().valid()) {
+                valid_count++;
+            }
+        }
+
+        py::array array =
+                create_numpy_records(*layout, py::make_tuple(valid_count));
+        auto data = static_cast<char*>(array.mutable_data());
+        for (const auto& sample : samples) {
+            if (sample.info().valid()) {
+                dynamic_data_to_record(sample.data(), *layout, data);
+                data += layout->itemsize;
+            }
+        }
+        records = std::move(array);
+    } catch (...) {
+        return_loan();
+        throw;
+    }
+
+    return_loan();
+    return py::reinterpret_borrow<py::array>(records);
+}
+
 class PyDynamicDataFieldsIterator {
 public:
     PyDynamicDataFieldsIterator(DynamicData& dd, bool reversed) : _dd(dd)
@@ -1444,6 +2673,34 @@ void init_dds_typed_datareader_template(PyDataReaderClass<DynamicData>& cls)
                py::call_guard<py::gil_scoped_release>(),
                "Retrieve the instance key that corresponds to an instance "
                "handle.");
+
+    cls.def(
+            "take_numpy",
+            [](PyDataReader<DynamicData>& reader) {
+                return loaned_samples_to_numpy(reader, true);
+            },
+            "Take all available valid data into a NumPy structured array "
+            "(see DynamicData.numpy_dtype).");
+
+    cls.def(
+            "read_numpy",
+            [](PyDataReader<DynamicData>& reader) {
+                return loaned_samples_to_numpy(reader, false);
+            },
+            "Read all available valid data into a NumPy structured array "
+            "(see DynamicData.numpy_dtype).");
+
+    cls.def("take_columns",
+            &take_columns,
+            py::arg("fields"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Take all available valid data as columns: returns a dictionary "
+            "that maps each of the given top-level primitive members to a "
+            "sequence of its values in all the samples (e.g. a "
+            "``Float64Seq``). The dictionary also contains the columns "
+            "``\"info.source_timestamp\"`` and "
+            "``\"info.reception_timestamp\"`` (in nanoseconds) and "
+            "``\"info.instance_handle\"``.");
 }
 
 template<>
@@ -1621,6 +2878,34 @@ void init_class_defs(py::class_<DynamicData>& dd_class)
                     },
                     py::is_operator());
 
+    dd_class.def_static(
+                    "numpy_dtype",
+                    [](const DynamicType& type) {
+                        return get_numpy_layout(type)->dtype;
+                    },
+                    py::arg("dynamic_type"),
+                    "Get the NumPy structured dtype of a struct type. "
+                    "Primitive members and arrays map to NumPy types and "
+                    "sub-arrays, nested structs to nested dtypes, and strings "
+                    "and sequences of primitives to object fields that "
+                    "contain a str or a NumPy array.")
+            .def("to_numpy",
+                 &to_numpy,
+                 "Convert this sample into a NumPy record (a 0-dimensional "
+                 "array with the dtype given by numpy_dtype).")
+            .def("from_numpy",
+                 &from_numpy,
+                 py::arg("record"),
+                 "Set the members of this sample from a NumPy record with the "
+                 "dtype given by numpy_dtype.")
+            .def_static(
+                    "from_numpy_array",
+                    &from_numpy_array,
+                    py::arg("dynamic_type"),
+                    py::arg("records"),
+                    "Create a sequence of DynamicData samples from a NumPy "
+                    "array of records with the dtype given by numpy_dtype.");
+
     py::class_<PyDynamicDataFieldsView> fields_view(dd_class, "FieldsView");
     py::class_<PyDynamicDataFieldsIterator> fields_iterator(
             dd_class,
@@ -2139,6 +3424,32 @@ void init_class_defs(py::class_<DynamicData>& dd_class)
                         return output;
                     },
                     "Serializes a DynamicData sample to CDR format")
+            .def(
+                    "from_cdr_buffer",
+                    [](dds::core::xtypes::DynamicData& sample,
+                       py::buffer buffer) -> dds::core::xtypes::DynamicData {
+                        auto info = buffer.request();
+                        if (info.ndim != 1 || info.itemsize != 1
+                            || info.strides[0] != 1) {
+                            throw py::type_error(
+                                    "Bad buffer type: only contiguous 1D byte "
+                                    "buffers are allowed");
+                        }
+
+                        py::gil_scoped_release release;
+                        auto retcode = DDS_DynamicData_from_cdr_buffer(
+                                &sample.native(),
+                                static_cast<const char*>(info.ptr),
+                                static_cast<unsigned int>(info.size));
+                        rti::core::check_return_code(
+                                retcode,
+                                "Failed to deserialize DynamicData");
+                        return sample;
+                    },
+                    py::arg("buffer"),
+                    "Populates a DynamicData sample by deserializing a CDR "
+                    "buffer (bytes, bytearray or any contiguous byte "
+                    "buffer).")
             .def(
                     "from_cdr_buffer",
                     [](dds::core::xtypes::DynamicData& sample,
@@ -15,6 +15,7 @@
 #include <dds/core/xtypes/CollectionTypes.hpp>
 #include <dds/core/xtypes/EnumType.hpp>
 #include <dds/core/xtypes/StructType.hpp>
+#include "PyFieldAccessor.hpp"
 
 using namespace dds::core::xtypes;
 
@@ -96,6 +97,35 @@ py::object py_cast_type(dds::core::xtypes::DynamicType& dt, bool resolve_alias)
 template<>
 void init_class_defs(py::class_<DynamicType>& cls)
 {
+    py::class_<PyFieldAccessor, std::shared_ptr<PyFieldAccessor>>(
+            cls,
+            "FieldAccessor",
+            "A member path of a DynamicType with its member indexes "
+            "resolved in advance, to quickly access the member in "
+            "DynamicData samples of that type.")
+            .def("get",
+                 &PyFieldAccessor::get,
+                 py::arg("data"),
+                 "Get the value of the member; equivalent to "
+                 "``data[path]``.")
+            .def("set",
+                 &PyFieldAccessor::set,
+                 py::arg("data"),
+                 py::arg("value"),
+                 "Set the value of the member; equivalent to "
+                 "``data[path] = value``.")
+            .def_property_readonly(
+                    "path",
+                    &PyFieldAccessor::path,
+                    "The member path.");
+
+    cls.def("compile_path",
+            &PyFieldAccessor::compile,
+            py::arg("path"),
+            "Resolves a member path (e.g. ``\"a.b[3].c\"``) of this struct "
+            "type into a FieldAccessor. The accessors are cached per type "
+            "and path.");
+
     cls.def_property_readonly("kind", &DynamicType::kind, "Get the type kind.")
             .def_property_readonly("name", &DynamicType::name, "Gets the name.")
             .def(
@@ -177,9 +207,7 @@ void init_class_defs(py::class_<DynamicType>& cls)
 template<>
 void process_inits<DynamicType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DynamicType>(m, "DynamicType");
-    });
+    l.push_back(class_init<DynamicType>(m, "DynamicType"));
 }
 
 }  // namespace pyrti
@@ -60,11 +60,9 @@ void init_class_defs(
 template<>
 void process_inits<EnumType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<EnumType, AbstractConstructedType<EnumMember>>(
-                m,
-                "EnumType");
-    });
+    l.push_back(class_init<EnumType, AbstractConstructedType<EnumMember>>(
+            m,
+            "EnumType"));
 }
 
 }  // namespace pyrti
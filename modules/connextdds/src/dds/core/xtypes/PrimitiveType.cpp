@@ -34,15 +34,18 @@ void init_dds_dynamic_primitive(
         ClassInitList& l,
         const char* alias = nullptr)
 {
-    l.push_back([m, name, alias]() mutable {
-        py::class_<PrimitiveType<T>, DynamicType> cls(m, name.c_str());
-        if (nullptr != alias) {
-            m.attr(alias) = cls;
-        }
-        return ([cls, name]() mutable {
-            init_dds_dynamic_primitive_defs<T>(cls, name);
-        });
-    });
+    l.push_back(ClassInit(
+            [m, name, alias]() mutable {
+                py::class_<PrimitiveType<T>, DynamicType> cls(m, name.c_str());
+                if (nullptr != alias) {
+                    m.attr(alias) = cls;
+                }
+                return ([cls, name]() mutable {
+                    init_dds_dynamic_primitive_defs<T>(cls, name);
+                });
+            },
+            class_types<PrimitiveType<T>>(),
+            class_types<DynamicType>()));
 }
 
 template<>
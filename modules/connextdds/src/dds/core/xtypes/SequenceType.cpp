@@ -35,11 +35,9 @@ void init_class_defs(
 template<>
 void process_inits<SequenceType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SequenceType, UnidimensionalCollectionTypeImpl>(
-                m,
-                "SequenceType");
-    });
+    l.push_back(class_init<SequenceType, UnidimensionalCollectionTypeImpl>(
+            m,
+            "SequenceType"));
 }
 
 }  // namespace pyrti
@@ -35,11 +35,9 @@ void init_class_defs(
 template<>
 void process_inits<StringType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<StringType, UnidimensionalCollectionTypeImpl>(
-                m,
-                "StringType");
-    });
+    l.push_back(class_init<StringType, UnidimensionalCollectionTypeImpl>(
+            m,
+            "StringType"));
 }
 
 }  // namespace pyrti
@@ -129,11 +129,9 @@ void init_class_defs(
 template<>
 void process_inits<StructType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<StructType, AbstractConstructedType<Member>>(
-                m,
-                "StructType");
-    });
+    l.push_back(class_init<StructType, AbstractConstructedType<Member>>(
+            m,
+            "StructType"));
 }
 
 }  // namespace pyrti
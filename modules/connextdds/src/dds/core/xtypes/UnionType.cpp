@@ -72,11 +72,9 @@ void init_class_defs(
 template<>
 void process_inits<UnionType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<UnionType, AbstractConstructedType<UnionMember>>(
-                m,
-                "UnionType");
-    });
+    l.push_back(class_init<UnionType, AbstractConstructedType<UnionMember>>(
+            m,
+            "UnionType"));
 }
 
 }  // namespace pyrti
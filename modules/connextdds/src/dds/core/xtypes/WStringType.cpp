@@ -35,11 +35,9 @@ void init_class_defs(
 template<>
 void process_inits<WStringType>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<WStringType, UnidimensionalCollectionTypeImpl>(
-                m,
-                "WStringType");
-    });
+    l.push_back(class_init<WStringType, UnidimensionalCollectionTypeImpl>(
+            m,
+            "WStringType"));
 }
 
 }  // namespace pyrti
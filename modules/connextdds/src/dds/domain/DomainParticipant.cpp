@@ -17,6 +17,7 @@
 #include "PyDataReader.hpp"
 #include "PyDomainParticipantListener.hpp"
 #include "IdlTypeSupport.hpp"
+#include "PyModuleInit.hpp"
 #include <rti/rti.hpp>
 
 using namespace dds::domain;
@@ -836,6 +837,7 @@ void init_class_defs(
             .def(
                     "discovered_topic_data",
                     [](const PyDomainParticipant& dp, const PyIEntity& topic) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         return dds::topic::discover_topic_data(
                                 dp,
                                 topic.py_instance_handle());
@@ -847,6 +849,7 @@ void init_class_defs(
                     "discovered_topic_data",
                     [](const PyDomainParticipant& dp,
                        const std::vector<dds::core::InstanceHandle>& handles) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         std::vector<dds::topic::TopicBuiltinTopicData> v;
                         for (auto& h : handles) {
                             v.push_back(dds::topic::discover_topic_data(dp, h));
@@ -860,6 +863,7 @@ void init_class_defs(
             .def(
                     "discovered_topic_data",
                     [](const PyDomainParticipant& dp) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         std::vector<dds::topic::TopicBuiltinTopicData> v;
                         dds::topic::discover_topic_data(
                                 dp,
@@ -912,6 +916,7 @@ void init_class_defs(
                     [](PyDomainParticipant& dp)
                             -> PyDataReader<
                                     dds::topic::ParticipantBuiltinTopicData>& {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         py::gil_scoped_release guard;
                         return dp.py_builtin_reader<dds::topic::ParticipantBuiltinTopicData>(
                             PyDomainParticipant::Property::PARTICIPANT_READER,
@@ -923,6 +928,7 @@ void init_class_defs(
                     [](PyDomainParticipant& dp)
                             -> PyDataReader<
                                     dds::topic::PublicationBuiltinTopicData>& {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         py::gil_scoped_release guard;
                         return dp.py_builtin_reader<dds::topic::PublicationBuiltinTopicData>(
                             PyDomainParticipant::Property::PUBLICATION_READER,
@@ -934,6 +940,7 @@ void init_class_defs(
                     [](PyDomainParticipant& dp)
                             -> PyDataReader<
                                     dds::topic::SubscriptionBuiltinTopicData>& {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         py::gil_scoped_release guard;
                         return dp.py_builtin_reader<dds::topic::SubscriptionBuiltinTopicData>(
                             PyDomainParticipant::Property::SUBSCRIPTION_READER,
@@ -977,6 +984,7 @@ void init_class_defs(
                     "discovered_participant_data",
                     [](PyDomainParticipant& dp,
                        const dds::core::InstanceHandle& handle) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         return rti::domain::discovered_participant_data(
                                 dp,
                                 handle);
@@ -988,6 +996,7 @@ void init_class_defs(
                     "discovered_participant_data",
                     [](PyDomainParticipant& dp,
                        const std::vector<dds::core::InstanceHandle>& handles) {
+                        ensure_lazy_init(lazy_init::BUILTIN_TOPIC_DATA);
                         std::vector<dds::topic::ParticipantBuiltinTopicData> v;
                         for (auto& h : handles) {
                             v.push_back(
@@ -57,27 +57,23 @@ void process_inits<dds::domain::DomainParticipantListener>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
-                PyDomainParticipantListener,
-                PyPublisherListener,
-                PySubscriberListener,
-                PyAnyTopicListener,
-                PyDomainParticipantListenerTrampoline<>,
-                std::shared_ptr<PyDomainParticipantListener>>(
-                    m,
-                    "DomainParticipantListener");
-    });
+    l.push_back(class_init<
+            PyDomainParticipantListener,
+            PyPublisherListener,
+            PySubscriberListener,
+            PyAnyTopicListener,
+            PyDomainParticipantListenerTrampoline<>,
+            std::shared_ptr<PyDomainParticipantListener>>(
+            m,
+            "DomainParticipantListener"));
 
-    l.push_back([m]() mutable {
-        return init_class<
-                PyNoOpDomainParticipantListener,
-                PyDomainParticipantListener,
-                PyNoOpDomainParticipantListenerTrampoline<>,
-                std::shared_ptr<PyNoOpDomainParticipantListener>>(
-                    m,
-                    "NoOpDomainParticipantListener");
-    });
+    l.push_back(class_init<
+            PyNoOpDomainParticipantListener,
+            PyDomainParticipantListener,
+            PyNoOpDomainParticipantListenerTrampoline<>,
+            std::shared_ptr<PyNoOpDomainParticipantListener>>(
+            m,
+            "NoOpDomainParticipantListener"));
 }
 
 }  // namespace pyrti
@@ -44,11 +44,9 @@ void init_class_defs(py::class_<DomainParticipantFactoryQos>& cls)
 template<>
 void process_inits<DomainParticipantFactoryQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DomainParticipantFactoryQos>(
-                m,
-                "DomainParticipantFactoryQos");
-    });
+    l.push_back(class_init<DomainParticipantFactoryQos>(
+            m,
+            "DomainParticipantFactoryQos"));
 }
 
 }  // namespace pyrti
@@ -105,9 +105,7 @@ void init_class_defs(py::class_<DomainParticipantQos>& cls)
 template<>
 void process_inits<DomainParticipantQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DomainParticipantQos>(m, "DomainParticipantQos");
-    });
+    l.push_back(class_init<DomainParticipantQos>(m, "DomainParticipantQos"));
 }
 
 }  // namespace pyrti
@@ -163,24 +163,20 @@ void process_inits<dds::pub::AnyDataWriterListener>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
-                PyAnyDataWriterListener,
-                PyAnyDataWriterListenerTrampoline<>,
-                std::shared_ptr<PyAnyDataWriterListener>>(
-                m,
-                "AnyDataWriterListener");
-    });
+    l.push_back(class_init<
+            PyAnyDataWriterListener,
+            PyAnyDataWriterListenerTrampoline<>,
+            std::shared_ptr<PyAnyDataWriterListener>>(
+            m,
+            "AnyDataWriterListener"));
 
-    l.push_back([m]() mutable {
-        return init_class<
-                PyNoOpAnyDataWriterListener,
-                PyAnyDataWriterListener,
-                PyNoOpAnyDataWriterListenerTrampoline<>,
-                std::shared_ptr<PyNoOpAnyDataWriterListener>>(
-                m,
-                "NoOpAnyDataWriterListener");
-    });
+    l.push_back(class_init<
+            PyNoOpAnyDataWriterListener,
+            PyAnyDataWriterListener,
+            PyNoOpAnyDataWriterListenerTrampoline<>,
+            std::shared_ptr<PyNoOpAnyDataWriterListener>>(
+            m,
+            "NoOpAnyDataWriterListener"));
 }
 
 }  // namespace pyrti
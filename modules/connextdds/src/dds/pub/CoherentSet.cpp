@@ -42,9 +42,7 @@ void init_class_defs(py::class_<CoherentSet>& cls)
 template<>
 void process_inits<CoherentSet>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<CoherentSet>(m, "CoherentSet");
-    });
+    l.push_back(class_init<CoherentSet>(m, "CoherentSet"));
 }
 
 }  // namespace pyrti
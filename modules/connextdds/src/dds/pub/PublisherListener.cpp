@@ -40,25 +40,21 @@ void init_class_defs(
 template<>
 void process_inits<dds::pub::PublisherListener>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
-                PyPublisherListener,
-                PyAnyDataWriterListener,
-                PyAnyDataWriterListenerTrampoline<PyPublisherListener>,
-                std::shared_ptr<PyPublisherListener>>(
-                    m,
-                    "PublisherListener");
-    });
+    l.push_back(class_init<
+            PyPublisherListener,
+            PyAnyDataWriterListener,
+            PyAnyDataWriterListenerTrampoline<PyPublisherListener>,
+            std::shared_ptr<PyPublisherListener>>(
+            m,
+            "PublisherListener"));
 
-    l.push_back([m]() mutable {
-        return init_class<
-                PyNoOpPublisherListener,
-                PyPublisherListener,
-                PyNoOpAnyDataWriterListenerTrampoline<PyNoOpPublisherListener>,
-                std::shared_ptr<PyNoOpPublisherListener>>(
-                    m,
-                    "NoOpPublisherListener");
-    });
+    l.push_back(class_init<
+            PyNoOpPublisherListener,
+            PyPublisherListener,
+            PyNoOpAnyDataWriterListenerTrampoline<PyNoOpPublisherListener>,
+            std::shared_ptr<PyNoOpPublisherListener>>(
+            m,
+            "NoOpPublisherListener"));
 }
 
 }  // namespace pyrti
@@ -39,9 +39,7 @@ void init_class_defs(py::class_<SuspendedPublication>& cls)
 template<>
 void process_inits<SuspendedPublication>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SuspendedPublication>(m, "SuspendedPublication");
-    });
+    l.push_back(class_init<SuspendedPublication>(m, "SuspendedPublication"));
 }
 
 }  // namespace pyrti
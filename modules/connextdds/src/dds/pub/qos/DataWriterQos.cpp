@@ -142,9 +142,7 @@ void init_class_defs(py::class_<DataWriterQos>& cls)
 template<>
 void process_inits<DataWriterQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataWriterQos>(m, "DataWriterQos");
-    });
+    l.push_back(class_init<DataWriterQos>(m, "DataWriterQos"));
 }
 
 }  // namespace pyrti
@@ -62,9 +62,7 @@ void init_class_defs(py::class_<PublisherQos>& cls)
 template<>
 void process_inits<PublisherQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<PublisherQos>(m, "PublisherQos");
-    });
+    l.push_back(class_init<PublisherQos>(m, "PublisherQos"));
 }
 
 }  // namespace pyrti
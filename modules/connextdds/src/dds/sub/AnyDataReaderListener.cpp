@@ -126,24 +126,20 @@ void process_inits<dds::sub::AnyDataReaderListener>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
-                PyAnyDataReaderListener,
-                PyAnyDataReaderListenerTrampoline<>,
-                std::shared_ptr<PyAnyDataReaderListener>>(
-                        m,
-                        "AnyDataReaderListener");
-    });
+    l.push_back(class_init<
+            PyAnyDataReaderListener,
+            PyAnyDataReaderListenerTrampoline<>,
+            std::shared_ptr<PyAnyDataReaderListener>>(
+            m,
+            "AnyDataReaderListener"));
 
-    l.push_back([m]() mutable {
-        return init_class<
-                PyNoOpAnyDataReaderListener,
-                PyAnyDataReaderListener,
-                PyNoOpAnyDataReaderListenerTrampoline<>,
-                std::shared_ptr<PyNoOpAnyDataReaderListener>>(
-                        m,
-                        "NoOpAnyDataReaderListener");
-    });
+    l.push_back(class_init<
+            PyNoOpAnyDataReaderListener,
+            PyAnyDataReaderListener,
+            PyNoOpAnyDataReaderListenerTrampoline<>,
+            std::shared_ptr<PyNoOpAnyDataReaderListener>>(
+            m,
+            "NoOpAnyDataReaderListener"));
 }
 
 }  // namespace pyrti
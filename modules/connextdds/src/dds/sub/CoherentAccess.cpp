@@ -47,9 +47,7 @@ void init_class_defs(py::class_<CoherentAccess>& cls)
 template<>
 void process_inits<CoherentAccess>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<CoherentAccess>(m, "CoherentAccess");
-    });
+    l.push_back(class_init<CoherentAccess>(m, "CoherentAccess"));
 }
 
 }  // namespace pyrti
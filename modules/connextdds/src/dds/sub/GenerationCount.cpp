@@ -39,9 +39,7 @@ void init_class_defs(py::class_<GenerationCount>& cls)
 template<>
 void process_inits<GenerationCount>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<GenerationCount>(m, "GenerationCount");
-    });
+    l.push_back(class_init<GenerationCount>(m, "GenerationCount"));
 }
 
 }  // namespace pyrti
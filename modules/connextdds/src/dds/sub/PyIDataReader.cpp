@@ -25,11 +25,9 @@ void init_class_defs(
 template<>
 void process_inits<PyIDataReader>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<PyIDataReader, PyIEntity, PyIAnyDataReader>(
-                m,
-                "IDataReader");
-    });
+    l.push_back(class_init<PyIDataReader, PyIEntity, PyIAnyDataReader>(
+            m,
+            "IDataReader"));
 }
 
 }  // namespace pyrti
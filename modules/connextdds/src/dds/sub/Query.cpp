@@ -75,7 +75,7 @@ void init_class_defs(py::class_<Query>& cls)
 template<>
 void process_inits<Query>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Query>(m, "Query"); });
+    l.push_back(class_init<Query>(m, "Query"));
 }
 
 }  // namespace pyrti
@@ -44,7 +44,7 @@ void init_class_defs(py::class_<Rank>& cls)
 template<>
 void process_inits<Rank>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Rank>(m, "Rank"); });
+    l.push_back(class_init<Rank>(m, "Rank"));
 }
 
 }  // namespace pyrti
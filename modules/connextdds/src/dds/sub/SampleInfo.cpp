@@ -13,33 +13,47 @@
 
 #include "PyConnext.hpp"
 #include <dds/sub/SampleInfo.hpp>
+#include "PySampleInfoView.hpp"
 
 using namespace dds::sub;
 
 namespace pyrti {
 
-template<>
-void init_class_defs(py::class_<SampleInfo>& cls)
+static const SampleInfo& info_of(const SampleInfo& info)
+{
+    return info;
+}
+
+static const SampleInfo& info_of(const PySampleInfoView& view)
+{
+    return view.get();
+}
+
+// Defines the properties of SampleInfo and SampleInfoView
+template<typename T>
+static void init_sample_info_properties(py::class_<T>& cls)
 {
     cls.def_property_readonly(
                "source_timestamp",
-               &SampleInfo::source_timestamp,
+               [](const T& self) { return info_of(self).source_timestamp(); },
                "The DataWriter's write timestamp.")
             .def_property_readonly(
                     "state",
-                    &SampleInfo::state,
+                    [](const T& self) { return info_of(self).state(); },
                     "Get the DataState of the sample.")
             .def_property_readonly(
                     "generation_count",
-                    &SampleInfo::generation_count,
+                    [](const T& self) {
+                        return info_of(self).generation_count();
+                    },
                     "The GenerationCount of the sample.")
             .def_property_readonly(
                     "rank",
-                    &SampleInfo::rank,
+                    [](const T& self) { return info_of(self).rank(); },
                     "Get the Rank of the sample.")
             .def_property_readonly(
                     "valid",
-                    &SampleInfo::valid,
+                    [](const T& self) { return info_of(self).valid(); },
                     "Indicates whether the DataSample contains data or else it "
                     "is "
                     "only used to communicate a change in the InstanceState of "
@@ -47,40 +61,44 @@ void init_class_defs(py::class_<SampleInfo>& cls)
                     "instance.")
             .def_property_readonly(
                     "instance_handle",
-                    &SampleInfo::instance_handle,
+                    [](const T& self) {
+                        return info_of(self).instance_handle();
+                    },
                     "Identifies locally the corresponding instance.")
             .def_property_readonly(
                     "publication_handle",
-                    &SampleInfo::publication_handle,
+                    [](const T& self) {
+                        return info_of(self).publication_handle();
+                    },
                     "Identifies locally the DataWriter that modified the "
                     "instance.")
             .def_property_readonly(
                     "reception_timestamp",
-                    [](const SampleInfo& s) {
-                        return s->reception_timestamp();
+                    [](const T& self) {
+                        return info_of(self)->reception_timestamp();
                     },
                     "The timestamp when the sample was committed by a "
                     "DataReader.")
             .def_property_readonly(
                     "publication_sequence_number",
-                    [](const SampleInfo& s) {
-                        return s->publication_sequence_number();
+                    [](const T& self) {
+                        return info_of(self)->publication_sequence_number();
                     },
                     "Publication sequence number assigned when the DDS sample "
                     "was "
                     "written by the DataWriter.")
             .def_property_readonly(
                     "reception_sequence_number",
-                    [](const SampleInfo& s) {
-                        return s->reception_sequence_number();
+                    [](const T& self) {
+                        return info_of(self)->reception_sequence_number();
                     },
                     "Reception sequence number assigned when the DDS sample "
                     "was "
                     "committed by the DataReader.")
             .def_property_readonly(
                     "original_publication_virtual_guid",
-                    [](const SampleInfo& s) {
-                        return s->original_publication_virtual_guid();
+                    [](const T& self) {
+                        return info_of(self)->original_publication_virtual_guid();
                     },
                     "Original publication virtual GUID."
                     "\n\n"
@@ -91,8 +109,8 @@ void init_class_defs(py::class_<SampleInfo>& cls)
                     "group.")
             .def_property_readonly(
                     "original_publication_virtual_sequence_number",
-                    [](const SampleInfo& s) {
-                        return s->original_publication_virtual_sequence_number();
+                    [](const T& self) {
+                        return info_of(self)->original_publication_virtual_sequence_number();
                     },
                     "Original publication virtual sequence number."
                     "\n\n"
@@ -103,8 +121,8 @@ void init_class_defs(py::class_<SampleInfo>& cls)
                     "DDS sample within the DataWriter group.")
             .def_property_readonly(
                     "original_publication_virtual_sample_identity",
-                    [](const SampleInfo& s) {
-                        return s->original_publication_virtual_sample_identity();
+                    [](const T& self) {
+                        return info_of(self)->original_publication_virtual_sample_identity();
                     },
                     "Retrieves the information provided by "
                     "original_publication_virtual_guid and "
@@ -112,23 +130,23 @@ void init_class_defs(py::class_<SampleInfo>& cls)
                     "combined in a SampleIdentity instance.")
             .def_property_readonly(
                     "related_original_publication_virtual_guid",
-                    [](const SampleInfo& s) {
-                        return s->related_original_publication_virtual_guid();
+                    [](const T& self) {
+                        return info_of(self)->related_original_publication_virtual_guid();
                     },
                     "The original publication virtual GUID of a related "
                     "sample.")
             .def_property_readonly(
                     "related_original_publication_virtual_sequence_number",
-                    [](const SampleInfo& s) {
-                        return s->related_original_publication_virtual_sequence_number();
+                    [](const T& self) {
+                        return info_of(self)->related_original_publication_virtual_sequence_number();
                     },
                     "The original publication virtual sequence number of a "
                     "related "
                     "sample.")
             .def_property_readonly(
                     "related_original_publication_virtual_sample_identity",
-                    [](const SampleInfo& s) {
-                        return s->related_original_publication_virtual_sample_identity();
+                    [](const T& self) {
+                        return info_of(self)->related_original_publication_virtual_sample_identity();
                     },
                     "Retrieves the information provided by "
                     "related_original_publication_virtual_guid and "
@@ -137,33 +155,36 @@ void init_class_defs(py::class_<SampleInfo>& cls)
                     "in a SampleIdentity instance.")
             .def_property_readonly(
                     "flag",
-                    [](const SampleInfo& s) { return s->flag(); },
+                    [](const T& self) { return info_of(self)->flag(); },
                     "Flags associated with the sample.")
             .def_property_readonly(
                     "source_guid",
-                    [](const SampleInfo& s) { return s->source_guid(); },
+                    [](const T& self) { return info_of(self)->source_guid(); },
                     "The application logical data source associated with the "
                     "sample.")
             .def_property_readonly(
                     "related_source_guid",
-                    [](const SampleInfo& s) {
-                        return s->related_source_guid();
+                    [](const T& self) {
+                        return info_of(self)->related_source_guid();
                     },
                     "The application logical data source that is related to "
                     "the "
                     "sample.")
             .def_property_readonly(
                     "related_subscription_guid",
-                    [](const SampleInfo& s) {
-                        return s->related_subscription_guid();
+                    [](const T& self) {
+                        return info_of(self)->related_subscription_guid();
                     },
                     "The related_reader_guid associated with the sample.")
             .def_property_readonly(
                     "topic_query_guid",
-                    [](const SampleInfo& s) { return s->topic_query_guid(); },
+                    [](const T& self) {
+                        return info_of(self)->topic_query_guid();
+                    },
                     "The GUID of the TopicQuery that is related to the sample.")
             .def("__repr__",
-                    [](const SampleInfo& s) -> std::string {
+                    [](const T& self) -> std::string {
+                        const SampleInfo& s = info_of(self);
                         std::ostringstream os;
                         os << "SampleInfo(state=" << s.state()
                            << ", source_timestamp="
@@ -173,21 +194,45 @@ void init_class_defs(py::class_<SampleInfo>& cls)
                     })
             .def_property_readonly(
                     "encapsulation_id",
-                    [](const SampleInfo& s) { return s->encapsulation_id(); },
+                    [](const T& self) {
+                        return info_of(self)->encapsulation_id();
+                    },
                     "The encapsulation kind.")
             .def_property_readonly(
                     "coherent_set_info",
-                    [](const SampleInfo& s) { return s->coherent_set_info(); },
+                    [](const T& self) {
+                        return info_of(self)->coherent_set_info();
+                    },
                     py::return_value_policy::copy,
                     "TWhen set, this field provides the information about "
                     "the coherent set associated with the sample.");
 }
 
+template<>
+void init_class_defs(py::class_<SampleInfo>& cls)
+{
+    init_sample_info_properties(cls);
+    cls.def(py::init([](const PySampleInfoView& view) { return view.get(); }),
+            py::arg("view"),
+            "Copy the SampleInfo of a SampleInfoView.");
+}
+
+template<>
+void init_class_defs(py::class_<PySampleInfoView>& cls)
+{
+    init_sample_info_properties(cls);
+    cls.def("to_sample_info",
+            [](const PySampleInfoView& view) { return view.get(); },
+            "Copy this view into a SampleInfo.");
+
+    py::implicitly_convertible<PySampleInfoView, SampleInfo>();
+}
+
 template<>
 void process_inits<SampleInfo>(py::module& m, ClassInitList& l)
 {
-    l.push_back(
-            [m]() mutable { return init_class<SampleInfo>(m, "SampleInfo"); });
+    l.push_back(class_init<SampleInfo>(m, "SampleInfo"));
+    l.push_back(class_init<PySampleInfoView>(m, "SampleInfoView"));
 }
 
 }  // namespace pyrti
@@ -47,25 +47,21 @@ void process_inits<dds::sub::SubscriberListener>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
-                PySubscriberListener,
-                PyAnyDataReaderListener,
-                PySubscriberListenerTrampoline<>,
-                std::shared_ptr<PySubscriberListener>>(
-                        m,
-                        "SubscriberListener");
-    });
+    l.push_back(class_init<
+            PySubscriberListener,
+            PyAnyDataReaderListener,
+            PySubscriberListenerTrampoline<>,
+            std::shared_ptr<PySubscriberListener>>(
+            m,
+            "SubscriberListener"));
 
-    l.push_back([m]() mutable {
-        return init_class<
-                PyNoOpSubscriberListener,
-                PySubscriberListener,
-                PyNoOpSubscriberListenerTrampoline<>,
-                std::shared_ptr<PyNoOpSubscriberListener>>(
-                        m,
-                        "NoOpSubscriberListener");
-    });
+    l.push_back(class_init<
+            PyNoOpSubscriberListener,
+            PySubscriberListener,
+            PyNoOpSubscriberListenerTrampoline<>,
+            std::shared_ptr<PyNoOpSubscriberListener>>(
+            m,
+            "NoOpSubscriberListener"));
 }
 
 }  // namespace pyrti
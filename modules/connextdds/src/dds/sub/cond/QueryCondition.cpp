@@ -160,14 +160,12 @@ void process_inits<dds::sub::cond::QueryCondition>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
+    l.push_back(class_init<
             PyQueryCondition,
             PyIReadCondition,
             std::unique_ptr<PyQueryCondition, no_gil_delete<PyQueryCondition>>>(
-                m,
-                "QueryCondition");
-    });
+            m,
+            "QueryCondition"));
 }
 
 }  // namespace pyrti
@@ -176,23 +176,19 @@ void process_inits<dds::sub::cond::ReadCondition>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
+    l.push_back(class_init<
             PyIReadCondition,
             PyICondition,
             std::unique_ptr<PyIReadCondition, no_gil_delete<PyIReadCondition>>>(
-                m,
-                "IReadCondition");
-    });
+            m,
+            "IReadCondition"));
 
-    l.push_back([m]() mutable {
-        return init_class<
+    l.push_back(class_init<
             PyReadCondition,
             PyIReadCondition,
             std::unique_ptr<PyReadCondition, no_gil_delete<PyReadCondition>>>(
-                m,
-                "ReadCondition");
-    });
+            m,
+            "ReadCondition"));
 }
 
 }  // namespace pyrti
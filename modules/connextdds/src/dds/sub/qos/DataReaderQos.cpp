@@ -126,9 +126,7 @@ void init_class_defs(py::class_<DataReaderQos>& cls)
 template<>
 void process_inits<DataReaderQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataReaderQos>(m, "DataReaderQos");
-    });
+    l.push_back(class_init<DataReaderQos>(m, "DataReaderQos"));
 }
 
 }  // namespace pyrti
@@ -57,9 +57,7 @@ void init_class_defs(py::class_<SubscriberQos>& cls)
 template<>
 void process_inits<SubscriberQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SubscriberQos>(m, "SubscriberQos");
-    });
+    l.push_back(class_init<SubscriberQos>(m, "SubscriberQos"));
 }
 
 }  // namespace pyrti
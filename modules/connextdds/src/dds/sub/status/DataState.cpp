@@ -299,8 +299,7 @@ void process_inits<DataState>(py::module& m, ClassInitList& l)
         return [cls]() mutable { init_class_defs<InstanceState>(cls); };
     });
 
-    l.push_back(
-            [m]() mutable { return init_class<DataState>(m, "DataState"); });
+    l.push_back(class_init<DataState>(m, "DataState"));
 }
 
 }  // namespace pyrti
@@ -48,22 +48,20 @@ void process_inits<dds::topic::AnyTopicListener>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<
-                PyAnyTopicListener,
-                PyAnyTopicListenerTrampoline<>,
-                std::shared_ptr<PyAnyTopicListener>>(
-                    m,"AnyTopicListener");
-    });
+    l.push_back(class_init<
+            PyAnyTopicListener,
+            PyAnyTopicListenerTrampoline<>,
+            std::shared_ptr<PyAnyTopicListener>>(
+            m,
+            "AnyTopicListener"));
 
-    l.push_back([m]() mutable {
-        return init_class<
-                PyNoOpAnyTopicListener,
-                PyAnyTopicListener,
-                PyNoOpAnyTopicListenerTrampoline<>,
-                std::shared_ptr<PyNoOpAnyTopicListener>>(
-                    m, "NoOpAnyTopicListener");
-    });
+    l.push_back(class_init<
+            PyNoOpAnyTopicListener,
+            PyAnyTopicListener,
+            PyNoOpAnyTopicListenerTrampoline<>,
+            std::shared_ptr<PyNoOpAnyTopicListener>>(
+            m,
+            "NoOpAnyTopicListener"));
 }
 
 }  // namespace pyrti
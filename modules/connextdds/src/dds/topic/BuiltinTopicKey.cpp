@@ -48,9 +48,7 @@ void init_class_defs(py::class_<BuiltinTopicKey>& cls)
 template<>
 void process_inits<BuiltinTopicKey>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<BuiltinTopicKey>(m, "BuiltinTopicKey");
-    });
+    l.push_back(class_init<BuiltinTopicKey>(m, "BuiltinTopicKey"));
 }
 
 }  // namespace pyrti
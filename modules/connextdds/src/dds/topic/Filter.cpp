@@ -75,7 +75,7 @@ void init_class_defs(py::class_<Filter>& cls)
 template<>
 void process_inits<Filter>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Filter>(m, "Filter"); });
+    l.push_back(class_init<Filter>(m, "Filter"));
 }
 
 }  // namespace pyrti
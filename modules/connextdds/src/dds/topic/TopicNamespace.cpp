@@ -11,6 +11,7 @@
 
 #include "PyConnext.hpp"
 #include "PyNamespaces.hpp"
+#include "PyModuleInit.hpp"
 #include <dds/dds.hpp>
 
 using namespace dds::topic;
@@ -21,10 +22,26 @@ void init_namespace_dds_topic(py::module& m, pyrti::ClassInitList& l, pyrti::Def
     pyrti::process_inits<AnyTopicListener>(m, l);
     pyrti::process_inits<BuiltinTopicKey>(m, l);
     pyrti::process_inits<Filter>(m, l);
-    pyrti::process_inits<ParticipantBuiltinTopicData>(m, l);
-    pyrti::process_inits<PublicationBuiltinTopicData>(m, l);
-    pyrti::process_inits<SubscriptionBuiltinTopicData>(m, l);
-    pyrti::process_inits<TopicBuiltinTopicData>(m, l);
+
+    // The builtin topic data types and their readers, writers, listeners and
+    // sequences are registered the first time they're used
+    pyrti::register_lazy_init(
+            m,
+            pyrti::lazy_init::BUILTIN_TOPIC_DATA,
+            { "ParticipantBuiltinTopicData",
+              "ParticipantBuiltinTopicDataSeq",
+              "PublicationBuiltinTopicData",
+              "PublicationBuiltinTopicDataSeq",
+              "SubscriptionBuiltinTopicData",
+              "SubscriptionBuiltinTopicDataSeq",
+              "TopicBuiltinTopicData",
+              "TopicBuiltinTopicDataSeq" },
+            [m](pyrti::ClassInitList& l, pyrti::DefInitVector&) mutable {
+                pyrti::process_inits<ParticipantBuiltinTopicData>(m, l);
+                pyrti::process_inits<PublicationBuiltinTopicData>(m, l);
+                pyrti::process_inits<SubscriptionBuiltinTopicData>(m, l);
+                pyrti::process_inits<TopicBuiltinTopicData>(m, l);
+            });
 
     init_namespace_dds_topic_qos(m, l, v);
 }
@@ -74,7 +74,7 @@ void init_class_defs(py::class_<TopicQos>& cls)
 template<>
 void process_inits<TopicQos>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<TopicQos>(m, "TopicQos"); });
+    l.push_back(class_init<TopicQos>(m, "TopicQos"));
 }
 
 }  // namespace pyrti
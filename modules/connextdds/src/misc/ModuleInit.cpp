@@ -0,0 +1,277 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyModuleInit.hpp"
+#include "PyInterpreterLocal.hpp"
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace pyrti {
+
+namespace {
+
+bool is_registered(const std::type_index& type)
+{
+    return py::detail::get_type_info(type) != nullptr;
+}
+
+// A class init waiting for some of its base classes to be registered
+struct PendingClassInit {
+    explicit PendingClassInit(ClassInit&& init)
+            : init(std::move(init)), missing_bases(0)
+    {
+    }
+
+    ClassInit init;
+    size_t missing_bases;
+};
+
+using PendingClassInitPtr = std::shared_ptr<PendingClassInit>;
+
+struct LazyInitGroup {
+    py::module module;
+    LazyInitFunc init;
+    bool done = false;
+};
+
+struct LazyInitRegistry {
+    // Held while a lazy init runs, so that other threads wait until it
+    // finishes. It's recursive because a lazy init can access its own
+    // attributes.
+    std::recursive_mutex mutex;
+    std::map<std::string, LazyInitGroup> groups;
+    // (module, attribute name) -> group name
+    std::map<std::pair<PyObject*, std::string>, std::string> attributes;
+};
+
+// Each interpreter has its own registry, since each subinterpreter that
+// imports the module gets its own module object and classes. It's destroyed
+// with the interpreter. Only accessed with the lock returned by
+// lock_lazy_init_registry().
+LazyInitRegistry& lazy_init_registry()
+{
+    return interpreter_local<LazyInitRegistry>(
+            "rti.connextdds.lazy_init_registry");
+}
+
+// Locks the registry. The GIL doesn't protect it, since the Python code that
+// a lazy init runs can switch to other threads (and there's no GIL in
+// free-threaded builds).
+//
+// @pre The GIL must be held. It is released while waiting for the lock, so
+// that the thread that holds it can acquire the GIL to finish its init.
+std::unique_lock<std::recursive_mutex> lock_lazy_init_registry()
+{
+    std::unique_lock<std::recursive_mutex> lock(
+            lazy_init_registry().mutex,
+            std::try_to_lock);
+    if (!lock.owns_lock()) {
+        py::gil_scoped_release release;
+        lock.lock();
+    }
+    return lock;
+}
+
+// @pre The registry must be locked
+void run_lazy_init(LazyInitGroup& group)
+{
+    if (group.done) {
+        return;
+    }
+    // Set before running the init so that it can access its own attributes
+    group.done = true;
+
+    ClassInitList cls_init_funcs;
+    DefInitVector def_init_funcs;
+    DefInitVector late_init_funcs;
+    group.init(cls_init_funcs, late_init_funcs);
+    run_class_inits(cls_init_funcs, def_init_funcs);
+
+    for (auto& func : def_init_funcs) {
+        func();
+    }
+
+    for (auto& func : late_init_funcs) {
+        func();
+    }
+}
+
+}  // namespace
+
+void run_class_inits(ClassInitList& l, DefInitVector& v)
+{
+    // Class inits whose base classes are registered, in the order they were
+    // added
+    std::deque<ClassInit> ready;
+    // Class inits waiting for base classes, by base class
+    std::unordered_map<std::type_index, std::vector<PendingClassInitPtr>>
+            waiting;
+
+    // Moves the class inits added to l to ready, or to waiting if some of
+    // their base classes are not registered yet
+    auto schedule = [&ready, &waiting, &l]() {
+        for (auto& init : l) {
+            auto pending = std::make_shared<PendingClassInit>(std::move(init));
+            std::unordered_set<std::type_index> bases(
+                    pending->init.bases.begin(),
+                    pending->init.bases.end());
+            for (auto& base : bases) {
+                if (!is_registered(base)) {
+                    waiting[base].push_back(pending);
+                    pending->missing_bases++;
+                }
+            }
+            if (pending->missing_bases == 0) {
+                ready.push_back(std::move(pending->init));
+            }
+        }
+        l.clear();
+    };
+
+    // Called when a base class is registered
+    auto release = [&ready, &waiting](const std::type_index& base) {
+        auto it = waiting.find(base);
+        if (it == waiting.end()) {
+            return;
+        }
+        for (auto& pending : it->second) {
+            if (--pending->missing_bases == 0) {
+                ready.push_back(std::move(pending->init));
+            }
+        }
+        waiting.erase(it);
+    };
+
+    while (true) {
+        // A class init can add more class inits to l
+        schedule();
+
+        if (ready.empty()) {
+            // A base class may have been registered by a class init that
+            // doesn't declare it, or before this call
+            std::vector<std::type_index> registered;
+            for (auto& entry : waiting) {
+                if (is_registered(entry.first)) {
+                    registered.push_back(entry.first);
+                }
+            }
+            if (registered.empty()) {
+                break;
+            }
+            for (auto& base : registered) {
+                release(base);
+            }
+            continue;
+        }
+
+        auto init = std::move(ready.front());
+        ready.pop_front();
+        v.push_back(init.func());
+        for (auto& type : init.types) {
+            release(type);
+        }
+    }
+
+    if (!waiting.empty()) {
+        std::string message = "Could not initialize all the classes:";
+        for (auto& entry : waiting) {
+            std::string name(entry.first.name());
+            py::detail::clean_type_id(name);
+            message += "\n  " + std::to_string(entry.second.size())
+                    + " class init(s) derive from the unregistered type "
+                    + name;
+        }
+        throw py::import_error(message);
+    }
+}
+
+void register_lazy_init(
+        py::module& m,
+        const std::string& group,
+        const std::vector<std::string>& attributes,
+        LazyInitFunc init)
+{
+    auto lock = lock_lazy_init_registry();
+    auto& registry = lazy_init_registry();
+    LazyInitGroup lazy_group;
+    lazy_group.module = m;
+    lazy_group.init = std::move(init);
+    registry.groups[group] = std::move(lazy_group);
+    for (auto& name : attributes) {
+        registry.attributes[std::make_pair(m.ptr(), name)] = group;
+    }
+}
+
+void ensure_lazy_init(const std::string& group)
+{
+    py::gil_scoped_acquire acquire;
+    auto lock = lock_lazy_init_registry();
+    auto& registry = lazy_init_registry();
+    auto it = registry.groups.find(group);
+    if (it != registry.groups.end()) {
+        run_lazy_init(it->second);
+    }
+}
+
+void init_lazy_getattr(py::module& m)
+{
+    // A borrowed reference, so that the module and its functions don't
+    // reference each other
+    py::handle module = m;
+
+    m.def(
+            "__getattr__",
+            [module](const std::string& name) -> py::object {
+                auto lock = lock_lazy_init_registry();
+                auto& registry = lazy_init_registry();
+                auto it = registry.attributes.find(
+                        std::make_pair(module.ptr(), name));
+                if (it != registry.attributes.end()) {
+                    run_lazy_init(registry.groups.at(it->second));
+                    py::dict members = module.attr("__dict__");
+                    if (members.contains(name)) {
+                        return members[name.c_str()];
+                    }
+                }
+                throw py::attribute_error(
+                        "module '"
+                        + module.attr("__name__").cast<std::string>()
+                        + "' has no attribute '" + name + "'");
+            },
+            py::arg("name"),
+            "Get an attribute of this module that is initialized the first "
+            "time it's accessed.");
+
+    m.def(
+            "__dir__",
+            [module]() {
+                py::dict members = module.attr("__dict__");
+                py::list names(members);
+                auto lock = lock_lazy_init_registry();
+                auto& registry = lazy_init_registry();
+                for (auto& entry : registry.attributes) {
+                    if (entry.first.first == module.ptr()
+                        && !members.contains(entry.first.second)) {
+                        names.append(py::str(entry.first.second));
+                    }
+                }
+                return names;
+            },
+            "List the attributes of this module, including the ones that "
+            "are not initialized yet.");
+}
+
+}  // namespace pyrti
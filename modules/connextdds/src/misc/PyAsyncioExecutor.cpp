@@ -13,29 +13,13 @@
 
 namespace pyrti {
 
-std::unique_ptr<PyAsyncioExecutor> PyAsyncioExecutor::instance(nullptr);
-std::recursive_mutex PyAsyncioExecutor::lock;
-
-PyAsyncioExecutor::PyAsyncioExecutor()
-{
-}
-
-PyAsyncioExecutor& PyAsyncioExecutor::get_instance()
+py::object PyAsyncioExecutor::get_running_loop()
 {
-    std::lock_guard<std::recursive_mutex> lock(PyAsyncioExecutor::lock);
-    if (!PyAsyncioExecutor::instance) {
-        auto asyncio_module = py::module::import("asyncio");
-        auto get_running_loop_func =  asyncio_module.attr("get_running_loop");
-        auto atexit = py::module::import("atexit");
-        PyAsyncioExecutor::instance.reset(new PyAsyncioExecutor());
-        PyAsyncioExecutor::instance->asyncio = asyncio_module;
-        PyAsyncioExecutor::instance->get_running_loop = get_running_loop_func;
-        atexit.attr("register")(py::cpp_function([]() {
-            auto ptr = PyAsyncioExecutor::instance.release();
-            delete ptr;
-        }));
-    }
-    return *PyAsyncioExecutor::instance;
+    // The asyncio module is looked up in sys.modules on every call instead of
+    // being cached in a static object, which would need its own
+    // synchronization when Python runs without the GIL, and would have to be
+    // released before the interpreter finalizes.
+    return py::module::import("asyncio").attr("get_running_loop")();
 }
 
-}  // namespace pyrti
\ No newline at end of file
+}  // namespace pyrti
@@ -212,7 +212,7 @@ void process_inits<Logger>(py::module& m, ClassInitList& l)
                 .export_values();
     });
 
-    l.push_back([m]() mutable { return init_class<Logger>(m, "Logger"); });
+    l.push_back(class_init<Logger>(m, "Logger"));
 }
 
 }  // namespace pyrti
@@ -69,9 +69,7 @@ void init_class_defs(py::class_<AllocationSettings>& cls)
 template<>
 void process_inits<AllocationSettings>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AllocationSettings>(m, "AllocationSettings");
-    });
+    l.push_back(class_init<AllocationSettings>(m, "AllocationSettings"));
 }
 
 }  // namespace pyrti
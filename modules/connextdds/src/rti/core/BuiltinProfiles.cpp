@@ -282,9 +282,7 @@ void init_class_defs(py::class_<PyBuiltinProfiles>& cls)
 template<>
 void process_inits<PyBuiltinProfiles>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<PyBuiltinProfiles>(m, "BuiltinProfiles");
-    });
+    l.push_back(class_init<PyBuiltinProfiles>(m, "BuiltinProfiles"));
 }
 
 }  // namespace pyrti
@@ -83,9 +83,7 @@ void init_class_defs(py::class_<CoherentSetInfo>& cls)
 template<>
 void process_inits<CoherentSetInfo>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<CoherentSetInfo>(m, "CoherentSetInfo");
-    });
+    l.push_back(class_init<CoherentSetInfo>(m, "CoherentSetInfo"));
 }
 
 }  // namespace pyrti
@@ -145,9 +145,7 @@ void process_inits<CompressionSettings>(py::module& m, ClassInitList& l)
         };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<CompressionSettings>(m, "CompressionSettings");
-    });
+    l.push_back(class_init<CompressionSettings>(m, "CompressionSettings"));
 }
 
 }  // namespace pyrti
@@ -55,9 +55,7 @@ void init_class_defs(py::class_<ContentFilterProperty>& cls)
 template<>
 void process_inits<ContentFilterProperty>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ContentFilterProperty>(m, "ContentFilterProperty");
-    });
+    l.push_back(class_init<ContentFilterProperty>(m, "ContentFilterProperty"));
 }
 
 }  // namespace pyrti
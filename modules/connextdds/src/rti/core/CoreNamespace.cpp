@@ -12,6 +12,7 @@
 #include "PyConnext.hpp"
 #include "PyNamespaces.hpp"
 #include "PyThreadContext.hpp"
+#include "PyPerfStats.hpp"
 #include <rti/rti.hpp>
 #if rti_connext_version_gte(6, 0, 0, 0)
 #include <rti/core/thread.hpp>
@@ -54,6 +55,7 @@ void init_namespace_rti_core(py::module& m, pyrti::ClassInitList& l, pyrti::DefI
     pyrti::process_inits<TransportMulticastSettings>(m, l);
     pyrti::process_inits<VendorId>(m, l);
     pyrti::process_inits<pyrti::PyThreadContext>(m, l);
+    pyrti::process_inits<pyrti::PyPerfStats>(m, l);
     pyrti::process_inits<DataReaderResourceLimitsInstanceReplacementSettings>(m, l);
     pyrti::process_inits<CompressionSettings>(m, l);
     pyrti::process_inits<CoherentSetInfo>(m, l);
@@ -53,9 +53,9 @@ void init_class_defs(py::class_<DataReaderResourceLimitsInstanceReplacementSetti
 template<>
 void process_inits<DataReaderResourceLimitsInstanceReplacementSettings>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataReaderResourceLimitsInstanceReplacementSettings>(m, "DataReaderResourceLimitsInstanceReplacementSettings");
-    });
+    l.push_back(class_init<DataReaderResourceLimitsInstanceReplacementSettings>(
+            m,
+            "DataReaderResourceLimitsInstanceReplacementSettings"));
 }
 
 }  // namespace pyrti
@@ -60,7 +60,7 @@ void init_class_defs(py::class_<Guid>& cls)
 template<>
 void process_inits<Guid>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Guid>(m, "Guid"); });
+    l.push_back(class_init<Guid>(m, "Guid"));
 }
 
 }  // namespace pyrti
@@ -0,0 +1,279 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyPerfStats.hpp"
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace pyrti {
+
+//
+// PyLatencyHistogramSnapshot
+//
+
+double PyLatencyHistogramSnapshot::mean() const
+{
+    return count == 0 ? 0.0
+                      : static_cast<double>(total) / static_cast<double>(count);
+}
+
+uint64_t PyLatencyHistogramSnapshot::percentile(double percentile) const
+{
+    if (percentile < 0.0 || percentile > 100.0) {
+        throw dds::core::InvalidArgumentError(
+                "percentile must be between 0 and 100");
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    auto target = static_cast<uint64_t>(
+            std::ceil(percentile / 100.0 * static_cast<double>(count)));
+    target = std::max<uint64_t>(target, 1);
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        accumulated += counts[i];
+        if (accumulated >= target) {
+            return std::min(
+                    PyLatencyHistogram::bucket_upper_bound(i) - 1,
+                    max);
+        }
+    }
+    return max;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> PyLatencyHistogramSnapshot::buckets()
+        const
+{
+    std::vector<std::pair<uint64_t, uint64_t>> result;
+    for (size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] > 0) {
+            result.emplace_back(
+                    PyLatencyHistogram::bucket_upper_bound(i),
+                    counts[i]);
+        }
+    }
+    return result;
+}
+
+//
+// PyLatencyHistogram
+//
+
+PyLatencyHistogram::PyLatencyHistogram()
+{
+    reset();
+}
+
+void PyLatencyHistogram::reset()
+{
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    total_.store(0, std::memory_order_relaxed);
+    min_.store(
+            std::numeric_limits<uint64_t>::max(),
+            std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+PyLatencyHistogramSnapshot PyLatencyHistogram::snapshot() const
+{
+    // The values are read individually, so a snapshot taken while values
+    // are being recorded may not be perfectly consistent
+    PyLatencyHistogramSnapshot result;
+    result.counts.reserve(BUCKET_COUNT);
+    for (auto& count : counts_) {
+        result.counts.push_back(count.load(std::memory_order_relaxed));
+    }
+    result.count = count_.load(std::memory_order_relaxed);
+    result.total = total_.load(std::memory_order_relaxed);
+    result.max = max_.load(std::memory_order_relaxed);
+    result.min = result.count == 0 ? 0 : min_.load(std::memory_order_relaxed);
+    return result;
+}
+
+uint64_t PyLatencyHistogram::bucket_upper_bound(size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index + 1;
+    }
+    uint64_t exponent = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+    uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + sub_bucket + 1)
+            << (exponent - SUB_BUCKET_BITS);
+}
+
+//
+// PyPerfStats
+//
+
+std::atomic<bool> PyPerfStats::enabled_(false);
+
+void PyPerfStats::reset()
+{
+    for (auto& histogram : histograms_) {
+        histogram.reset();
+    }
+}
+
+void PyPerfStats::enabled(bool value)
+{
+    enabled_.store(value, std::memory_order_relaxed);
+}
+
+//
+// PyPerfStatsSlot
+//
+
+std::shared_ptr<PyPerfStats> PyPerfStatsSlot::get()
+{
+    // Several threads may use the entity at the same time; only one of them
+    // creates the stats
+    auto stats = std::atomic_load(&stats_);
+    if (stats == nullptr) {
+        auto new_stats = std::make_shared<PyPerfStats>();
+        if (std::atomic_compare_exchange_strong(&stats_, &stats, new_stats)) {
+            stats = std::move(new_stats);
+        }
+    }
+    return stats;
+}
+
+void PyPerfStatsSlot::release()
+{
+    std::atomic_store(&stats_, std::shared_ptr<PyPerfStats>());
+}
+
+void attach_perf_stats_slot(dds::core::Entity entity)
+{
+    // Only serializes the creation of the PyDataWriter and PyDataReader
+    // objects. The slot is attached when the first one of an entity is
+    // created, before any operation uses it, so the operations read it
+    // without a lock.
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entity->get_user_data_() == nullptr) {
+        entity->set_user_data_(new PyPerfStatsSlot(), [](void* ptr) {
+            delete static_cast<PyPerfStatsSlot*>(ptr);
+        });
+    }
+}
+
+template<>
+void init_class_defs(py::class_<PyLatencyHistogramSnapshot>& cls)
+{
+    cls.def_readonly(
+               "count",
+               &PyLatencyHistogramSnapshot::count,
+               "The number of values recorded.")
+            .def_readonly(
+                    "total",
+                    &PyLatencyHistogramSnapshot::total,
+                    "The sum of the values recorded, in nanoseconds.")
+            .def_readonly(
+                    "min",
+                    &PyLatencyHistogramSnapshot::min,
+                    "The minimum value recorded, in nanoseconds.")
+            .def_readonly(
+                    "max",
+                    &PyLatencyHistogramSnapshot::max,
+                    "The maximum value recorded, in nanoseconds.")
+            .def_property_readonly(
+                    "mean",
+                    &PyLatencyHistogramSnapshot::mean,
+                    "The mean of the values recorded, in nanoseconds.")
+            .def_property_readonly(
+                    "buckets",
+                    &PyLatencyHistogramSnapshot::buckets,
+                    "The non-empty buckets as a list of tuples (upper bound "
+                    "in nanoseconds, count). The upper bound is exclusive.")
+            .def("percentile",
+                 &PyLatencyHistogramSnapshot::percentile,
+                 py::arg("percentile"),
+                 "The value at a percentile (0-100), in nanoseconds. The "
+                 "relative error of the result is at most 1/16.")
+            .def("__len__",
+                 [](const PyLatencyHistogramSnapshot& h) { return h.count; })
+            .def("__repr__", [](const PyLatencyHistogramSnapshot& h) {
+                return "LatencyHistogram(count=" + std::to_string(h.count)
+                        + ", min=" + std::to_string(h.min)
+                        + ", p50=" + std::to_string(h.percentile(50))
+                        + ", p99=" + std::to_string(h.percentile(99))
+                        + ", max=" + std::to_string(h.max) + ")";
+            });
+}
+
+static void def_phase_property(
+        py::class_<PyPerfStats, std::shared_ptr<PyPerfStats>>& cls,
+        const char* name,
+        PyPerfPhase phase,
+        const char* doc)
+{
+    cls.def_property_readonly(
+            name,
+            [phase](const PyPerfStats& stats) {
+                return stats.histogram(phase).snapshot();
+            },
+            doc);
+}
+
+template<>
+void init_class_defs(py::class_<PyPerfStats, std::shared_ptr<PyPerfStats>>& cls)
+{
+    def_phase_property(
+            cls,
+            "lock_wait",
+            PyPerfPhase::LOCK_WAIT,
+            "The time waiting for the DataWriter's lock or a free C sample "
+            "before converting the samples to write.");
+    def_phase_property(
+            cls,
+            "gil_wait",
+            PyPerfPhase::GIL_WAIT,
+            "The time waiting to acquire the GIL to convert the samples.");
+    def_phase_property(
+            cls,
+            "conversion",
+            PyPerfPhase::CONVERSION,
+            "The time converting the samples between Python and C.");
+    def_phase_property(
+            cls,
+            "native_call",
+            PyPerfPhase::NATIVE_CALL,
+            "The time in the native write, read or take operation.");
+
+    cls.def("reset",
+            &PyPerfStats::reset,
+            "Clear the histograms of all the phases.")
+            .def_property_static(
+                    "enabled",
+                    [](py::object) { return PyPerfStats::enabled(); },
+                    [](py::object, bool value) { PyPerfStats::enabled(value); },
+                    "Whether the DataWriters and DataReaders record perf "
+                    "stats. Disabled by default.");
+}
+
+template<>
+void process_inits<PyPerfStats>(py::module& m, ClassInitList& l)
+{
+    l.push_back(class_init<PyLatencyHistogramSnapshot>(m, "LatencyHistogram"));
+
+    l.push_back(class_init<PyPerfStats, std::shared_ptr<PyPerfStats>>(
+            m,
+            "PerfStats"));
+}
+
+}  // namespace pyrti
@@ -67,9 +67,7 @@ void init_class_defs(py::class_<ProductVersion>& cls)
 template<>
 void process_inits<ProductVersion>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ProductVersion>(m, "ProductVersion");
-    });
+    l.push_back(class_init<ProductVersion>(m, "ProductVersion"));
 }
 
 }  // namespace pyrti
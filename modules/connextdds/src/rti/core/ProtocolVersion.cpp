@@ -45,9 +45,7 @@ void init_class_defs(py::class_<ProtocolVersion>& cls)
 template<>
 void process_inits<ProtocolVersion>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ProtocolVersion>(m, "ProtocolVersion");
-    });
+    l.push_back(class_init<ProtocolVersion>(m, "ProtocolVersion"));
 }
 
 }  // namespace pyrti
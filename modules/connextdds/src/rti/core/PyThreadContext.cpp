@@ -51,9 +51,7 @@ void init_class_defs(py::class_<PyThreadContext>& cls)
 template<>
 void process_inits<PyThreadContext>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<PyThreadContext>(m, "ThreadContext");
-    });
+    l.push_back(class_init<PyThreadContext>(m, "ThreadContext"));
 }
 
 }  // namespace pyrti
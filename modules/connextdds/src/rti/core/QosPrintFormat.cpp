@@ -50,9 +50,7 @@ void init_class_defs(py::class_<QosPrintFormat>& cls)
 template<>
 void process_inits<QosPrintFormat>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<QosPrintFormat>(m, "QosPrintFormat");
-    });
+    l.push_back(class_init<QosPrintFormat>(m, "QosPrintFormat"));
 }
 
 }  // namespace pyrti
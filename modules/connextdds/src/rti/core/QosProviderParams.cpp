@@ -74,9 +74,7 @@ void init_class_defs(py::class_<QosProviderParams>& cls)
 template<>
 void process_inits<QosProviderParams>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<QosProviderParams>(m, "QosProviderParams");
-    });
+    l.push_back(class_init<QosProviderParams>(m, "QosProviderParams"));
 }
 
 }  // namespace pyrti
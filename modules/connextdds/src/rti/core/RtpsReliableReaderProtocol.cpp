@@ -113,11 +113,9 @@ void init_class_defs(py::class_<RtpsReliableReaderProtocol>& cls)
 template<>
 void process_inits<RtpsReliableReaderProtocol>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<RtpsReliableReaderProtocol>(
-                m,
-                "RtpsReliableReaderProtocol");
-    });
+    l.push_back(class_init<RtpsReliableReaderProtocol>(
+            m,
+            "RtpsReliableReaderProtocol"));
 }
 
 }  // namespace pyrti
@@ -66,9 +66,7 @@ void init_class_defs(py::class_<SampleIdentity>& cls)
 template<>
 void process_inits<SampleIdentity>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SampleIdentity>(m, "SampleIdentity");
-    });
+    l.push_back(class_init<SampleIdentity>(m, "SampleIdentity"));
 }
 
 }  // namespace pyrti
@@ -99,9 +99,7 @@ void init_class_defs(py::class_<SequenceNumber>& cls)
 template<>
 void process_inits<SequenceNumber>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SequenceNumber>(m, "SequenceNumber");
-    });
+    l.push_back(class_init<SequenceNumber>(m, "SequenceNumber"));
 }
 
 }  // namespace pyrti
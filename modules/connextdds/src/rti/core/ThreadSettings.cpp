@@ -173,9 +173,7 @@ void process_inits<ThreadSettings>(py::module& m, ClassInitList& l)
         };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<ThreadSettings>(m, "ThreadSettings");
-    });
+    l.push_back(class_init<ThreadSettings>(m, "ThreadSettings"));
 }
 
 }  // namespace pyrti
@@ -38,7 +38,7 @@ void init_class_defs(py::class_<VendorId>& cls)
 template<>
 void process_inits<VendorId>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<VendorId>(m, "VendorId"); });
+    l.push_back(class_init<VendorId>(m, "VendorId"));
 }
 
 }  // namespace pyrti
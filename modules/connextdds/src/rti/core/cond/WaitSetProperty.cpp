@@ -48,9 +48,7 @@ void init_class_defs(py::class_<WaitSetProperty>& cls)
 template<>
 void process_inits<WaitSetProperty>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<WaitSetProperty>(m, "WaitSetProperty");
-    });
+    l.push_back(class_init<WaitSetProperty>(m, "WaitSetProperty"));
 }
 
 }  // namespace pyrti
@@ -103,9 +103,7 @@ void init_class_defs(py::class_<AsynchronousPublisher>& cls)
 template<>
 void process_inits<AsynchronousPublisher>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AsynchronousPublisher>(m, "AsynchronousPublisher");
-    });
+    l.push_back(class_init<AsynchronousPublisher>(m, "AsynchronousPublisher"));
 }
 
 }  // namespace pyrti
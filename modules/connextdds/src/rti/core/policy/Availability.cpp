@@ -82,9 +82,7 @@ void init_class_defs(py::class_<Availability>& cls)
 template<>
 void process_inits<Availability>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<Availability>(m, "Availability");
-    });
+    l.push_back(class_init<Availability>(m, "Availability"));
 }
 
 }  // namespace pyrti
@@ -99,7 +99,7 @@ void init_class_defs(py::class_<Batch>& cls)
 template<>
 void process_inits<Batch>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Batch>(m, "Batch"); });
+    l.push_back(class_init<Batch>(m, "Batch"));
 }
 
 }  // namespace pyrti
@@ -174,11 +174,9 @@ void process_inits<BuiltinTopicReaderResourceLimits>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<BuiltinTopicReaderResourceLimits>(
-                m,
-                "BuiltinTopicReaderResourceLimits");
-    });
+    l.push_back(class_init<BuiltinTopicReaderResourceLimits>(
+            m,
+            "BuiltinTopicReaderResourceLimits"));
 }
 
 }  // namespace pyrti
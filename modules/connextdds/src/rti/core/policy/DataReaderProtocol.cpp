@@ -92,9 +92,7 @@ void init_class_defs(py::class_<DataReaderProtocol>& cls)
 template<>
 void process_inits<DataReaderProtocol>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataReaderProtocol>(m, "DataReaderProtocol");
-    });
+    l.push_back(class_init<DataReaderProtocol>(m, "DataReaderProtocol"));
 }
 
 }  // namespace pyrti
@@ -360,11 +360,9 @@ void init_class_defs(py::class_<DataReaderResourceLimits>& cls)
 template<>
 void process_inits<DataReaderResourceLimits>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataReaderResourceLimits>(
-                m,
-                "DataReaderResourceLimits");
-    });
+    l.push_back(class_init<DataReaderResourceLimits>(
+            m,
+            "DataReaderResourceLimits"));
 }
 
 }  // namespace pyrti
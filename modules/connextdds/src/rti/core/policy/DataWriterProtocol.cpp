@@ -112,9 +112,7 @@ void init_class_defs(py::class_<DataWriterProtocol>& cls)
 template<>
 void process_inits<DataWriterProtocol>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataWriterProtocol>(m, "DataWriterProtocol");
-    });
+    l.push_back(class_init<DataWriterProtocol>(m, "DataWriterProtocol"));
 }
 
 }  // namespace pyrti
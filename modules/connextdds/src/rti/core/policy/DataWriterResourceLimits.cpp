@@ -315,11 +315,9 @@ void process_inits<DataWriterResourceLimits>(py::module& m, ClassInitList& l)
                         .export_values();
             });
 
-    l.push_back([m]() mutable {
-        return init_class<DataWriterResourceLimits>(
-                m,
-                "DataWriterResourceLimits");
-    });
+    l.push_back(class_init<DataWriterResourceLimits>(
+            m,
+            "DataWriterResourceLimits"));
 }
 
 }  // namespace pyrti
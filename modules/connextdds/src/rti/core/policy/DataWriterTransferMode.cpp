@@ -65,15 +65,13 @@ void init_class_defs(py::class_<DataWriterTransferMode>& cls)
 template<>
 void process_inits<DataWriterTransferMode>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataWriterShmemRefTransferModeSettings>(
-                m,
-                "DataWriterShmemRefTransferModeSettings");
-    });
+    l.push_back(class_init<DataWriterShmemRefTransferModeSettings>(
+            m,
+            "DataWriterShmemRefTransferModeSettings"));
 
-    l.push_back([m]() mutable {
-        return init_class<DataWriterTransferMode>(m, "DataWriterTransferMode");
-    });
+    l.push_back(class_init<DataWriterTransferMode>(
+            m,
+            "DataWriterTransferMode"));
 }
 
 }  // namespace pyrti
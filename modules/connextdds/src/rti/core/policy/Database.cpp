@@ -83,7 +83,7 @@ void init_class_defs(py::class_<Database>& cls)
 template<>
 void process_inits<Database>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Database>(m, "Database"); });
+    l.push_back(class_init<Database>(m, "Database"));
 }
 
 }  // namespace pyrti
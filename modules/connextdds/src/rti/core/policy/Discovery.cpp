@@ -88,8 +88,7 @@ void init_class_defs(py::class_<Discovery>& cls)
 template<>
 void process_inits<Discovery>(py::module& m, ClassInitList& l)
 {
-    l.push_back(
-            [m]() mutable { return init_class<Discovery>(m, "Discovery"); });
+    l.push_back(class_init<Discovery>(m, "Discovery"));
 }
 
 }  // namespace pyrti
@@ -626,9 +626,7 @@ void process_inits<DiscoveryConfig>(py::module& m, ClassInitList& l)
         };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<DiscoveryConfig>(m, "DiscoveryConfig");
-    });
+    l.push_back(class_init<DiscoveryConfig>(m, "DiscoveryConfig"));
 }
 
 }  // namespace pyrti
@@ -816,11 +816,9 @@ void process_inits<DomainParticipantResourceLimits>(
                         .export_values();
             });
 
-    l.push_back([m]() mutable {
-        return init_class<DomainParticipantResourceLimits>(
-                m,
-                "DomainParticipantResourceLimits");
-    });
+    l.push_back(class_init<DomainParticipantResourceLimits>(
+            m,
+            "DomainParticipantResourceLimits"));
 }
 
 }  // namespace pyrti
@@ -62,8 +62,7 @@ void init_class_defs(py::class_<EntityName>& cls)
 template<>
 void process_inits<EntityName>(py::module& m, ClassInitList& l)
 {
-    l.push_back(
-            [m]() mutable { return init_class<EntityName>(m, "EntityName"); });
+    l.push_back(class_init<EntityName>(m, "EntityName"));
 }
 
 }  // namespace pyrti
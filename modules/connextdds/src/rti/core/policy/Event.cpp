@@ -48,7 +48,7 @@ void init_class_defs(py::class_<Event>& cls)
 template<>
 void process_inits<Event>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Event>(m, "Event"); });
+    l.push_back(class_init<Event>(m, "Event"));
 }
 
 }  // namespace pyrti
@@ -53,9 +53,7 @@ void init_class_defs(py::class_<ExclusiveArea>& cls)
 template<>
 void process_inits<ExclusiveArea>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ExclusiveArea>(m, "ExclusiveArea");
-    });
+    l.push_back(class_init<ExclusiveArea>(m, "ExclusiveArea"));
 }
 
 }  // namespace pyrti
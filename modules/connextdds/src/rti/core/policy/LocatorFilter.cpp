@@ -56,9 +56,7 @@ void init_class_defs(py::class_<LocatorFilter>& cls)
 template<>
 void process_inits<LocatorFilter>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<LocatorFilter>(m, "LocatorFilter");
-    });
+    l.push_back(class_init<LocatorFilter>(m, "LocatorFilter"));
 }
 
 }  // namespace pyrti
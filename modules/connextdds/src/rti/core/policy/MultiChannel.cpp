@@ -71,9 +71,7 @@ void init_class_defs(py::class_<MultiChannel>& cls)
 template<>
 void process_inits<MultiChannel>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<MultiChannel>(m, "MultiChannel");
-    });
+    l.push_back(class_init<MultiChannel>(m, "MultiChannel"));
 }
 
 }  // namespace pyrti
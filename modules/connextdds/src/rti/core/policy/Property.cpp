@@ -132,7 +132,7 @@ void init_class_defs(py::class_<Property>& cls)
 template<>
 void process_inits<Property>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable { return init_class<Property>(m, "Property"); });
+    l.push_back(class_init<Property>(m, "Property"));
 }
 
 }  // namespace pyrti
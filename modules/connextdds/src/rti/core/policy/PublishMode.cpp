@@ -124,9 +124,7 @@ void process_inits<PublishMode>(py::module& m, ClassInitList& l)
                 .export_values();
     });
 
-    l.push_back([m]() mutable {
-        return init_class<PublishMode>(m, "PublishMode");
-    });
+    l.push_back(class_init<PublishMode>(m, "PublishMode"));
 }
 
 }  // namespace pyrti
@@ -61,9 +61,7 @@ void init_class_defs(py::class_<ReceiverPool>& cls)
 template<>
 void process_inits<ReceiverPool>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ReceiverPool>(m, "ReceiverPool");
-    });
+    l.push_back(class_init<ReceiverPool>(m, "ReceiverPool"));
 }
 
 }  // namespace pyrti
@@ -363,11 +363,9 @@ void init_class_defs(py::class_<RtpsReliableWriterProtocol>& cls)
 template<>
 void process_inits<RtpsReliableWriterProtocol>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<RtpsReliableWriterProtocol>(
-                m,
-                "RtpsReliableWriterProtocol");
-    });
+    l.push_back(class_init<RtpsReliableWriterProtocol>(
+            m,
+            "RtpsReliableWriterProtocol"));
 }
 
 }  // namespace pyrti
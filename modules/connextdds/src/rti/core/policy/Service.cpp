@@ -67,7 +67,7 @@ void process_inits<Service>(py::module& m, ClassInitList& l)
                 .export_values();
     });
 
-    l.push_back([m]() mutable { return init_class<Service>(m, "Service"); });
+    l.push_back(class_init<Service>(m, "Service"));
 }
 
 }  // namespace pyrti
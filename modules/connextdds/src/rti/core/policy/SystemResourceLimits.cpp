@@ -49,9 +49,7 @@ void init_class_defs(py::class_<SystemResourceLimits>& cls)
 template<>
 void process_inits<SystemResourceLimits>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<SystemResourceLimits>(m, "SystemResourceLimits");
-    });
+    l.push_back(class_init<SystemResourceLimits>(m, "SystemResourceLimits"));
 }
 
 }  // namespace pyrti
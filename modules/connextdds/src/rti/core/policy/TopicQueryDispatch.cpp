@@ -56,9 +56,7 @@ void init_class_defs(py::class_<TopicQueryDispatch>& cls)
 template<>
 void process_inits<TopicQueryDispatch>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<TopicQueryDispatch>(m, "TopicQueryDispatch");
-    });
+    l.push_back(class_init<TopicQueryDispatch>(m, "TopicQueryDispatch"));
 }
 
 }  // namespace pyrti
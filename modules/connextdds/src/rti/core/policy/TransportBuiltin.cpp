@@ -118,9 +118,7 @@ void process_inits<TransportBuiltin>(py::module& m, ClassInitList& l)
         return [cls]() mutable { init_class_defs<TransportBuiltinMask>(cls); };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<TransportBuiltin>(m, "TransportBuiltin");
-    });
+    l.push_back(class_init<TransportBuiltin>(m, "TransportBuiltin"));
 }
 
 }  // namespace pyrti
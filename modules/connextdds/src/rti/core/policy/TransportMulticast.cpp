@@ -173,21 +173,17 @@ void process_inits<TransportMulticast>(py::module& m, ClassInitList& l)
         return init_class_with_seq<TransportMulticast>(m, "TransportMulticast");
     });
 
-    l.push_back([m]() mutable {
-        return init_class<TransportMulticastMappingFunction>(
-                m,
-                "TransportMulticastMappingFunction");
-    });
+    l.push_back(class_init<TransportMulticastMappingFunction>(
+            m,
+            "TransportMulticastMappingFunction"));
 
     l.push_back([m]() mutable {
         return init_class_with_seq<MulticastMapping>(m, "MulticastMapping");
     });
 
-    l.push_back([m]() mutable {
-        return init_class<TransportMulticastMapping>(
-                m,
-                "TransportMulticastMapping");
-    });
+    l.push_back(class_init<TransportMulticastMapping>(
+            m,
+            "TransportMulticastMapping"));
 }
 
 }  // namespace pyrti
@@ -43,9 +43,7 @@ void init_class_defs(py::class_<TransportSelection>& cls)
 template<>
 void process_inits<TransportSelection>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<TransportSelection>(m, "TransportSelection");
-    });
+    l.push_back(class_init<TransportSelection>(m, "TransportSelection"));
 }
 
 }  // namespace pyrti
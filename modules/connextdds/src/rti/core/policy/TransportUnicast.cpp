@@ -85,9 +85,7 @@ void process_inits<TransportUnicast>(py::module& m, ClassInitList& l)
                 "TransportUnicastSettings");
     });
 
-    l.push_back([m]() mutable {
-        return init_class<TransportUnicast>(m, "TransportUnicast");
-    });
+    l.push_back(class_init<TransportUnicast>(m, "TransportUnicast"));
 }
 
 }  // namespace pyrti
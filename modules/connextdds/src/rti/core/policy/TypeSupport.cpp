@@ -59,9 +59,7 @@ void process_inits<TypeSupport>(py::module& m, ClassInitList& l)
                 .export_values();
     });
 
-    l.push_back([m]() mutable {
-        return init_class<TypeSupport>(m, "TypeSupport");
-    });
+    l.push_back(class_init<TypeSupport>(m, "TypeSupport"));
 }
 
 }  // namespace pyrti
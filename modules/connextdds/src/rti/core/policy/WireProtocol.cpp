@@ -284,13 +284,9 @@ void process_inits<WireProtocol>(py::module& m, ClassInitList& l)
         };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<RtpsWellKnownPorts>(m, "RtpsWellKnownPorts");
-    });
+    l.push_back(class_init<RtpsWellKnownPorts>(m, "RtpsWellKnownPorts"));
 
-    l.push_back([m]() mutable {
-        return init_class<WireProtocol>(m, "WireProtocol");
-    });
+    l.push_back(class_init<WireProtocol>(m, "WireProtocol"));
 }
 
 }  // namespace pyrti
@@ -151,9 +151,7 @@ void init_class_defs(py::class_<DataReaderCacheStatus>& cls)
 template<>
 void process_inits<DataReaderCacheStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataReaderCacheStatus>(m, "DataReaderCacheStatus");
-    });
+    l.push_back(class_init<DataReaderCacheStatus>(m, "DataReaderCacheStatus"));
 }
 
 }  // namespace pyrti
@@ -158,11 +158,9 @@ void init_class_defs(py::class_<DataReaderProtocolStatus>& cls)
 template<>
 void process_inits<DataReaderProtocolStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataReaderProtocolStatus>(
-                m,
-                "DataReaderProtocolStatus");
-    });
+    l.push_back(class_init<DataReaderProtocolStatus>(
+            m,
+            "DataReaderProtocolStatus"));
 }
 
 }  // namespace pyrti
@@ -62,9 +62,7 @@ void init_class_defs(py::class_<DataWriterCacheStatus>& cls)
 template<>
 void process_inits<DataWriterCacheStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataWriterCacheStatus>(m, "DataWriterCacheStatus");
-    });
+    l.push_back(class_init<DataWriterCacheStatus>(m, "DataWriterCacheStatus"));
 }
 
 }  // namespace pyrti
@@ -198,11 +198,9 @@ void init_class_defs(py::class_<DataWriterProtocolStatus>& cls)
 template<>
 void process_inits<DataWriterProtocolStatus>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DataWriterProtocolStatus>(
-                m,
-                "DataWriterProtocolStatus");
-    });
+    l.push_back(class_init<DataWriterProtocolStatus>(
+            m,
+            "DataWriterProtocolStatus"));
 }
 
 }  // namespace pyrti
\ No newline at end of file
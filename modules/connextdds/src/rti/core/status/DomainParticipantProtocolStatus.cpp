@@ -45,11 +45,9 @@ void process_inits<DomainParticipantProtocolStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DomainParticipantProtocolStatus>(
-                m,
-                "DomainParticipantProtocolStatus");
-    });
+    l.push_back(class_init<DomainParticipantProtocolStatus>(
+            m,
+            "DomainParticipantProtocolStatus"));
 }
 
 }  // namespace pyrti
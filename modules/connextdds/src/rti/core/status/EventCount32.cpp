@@ -29,9 +29,7 @@ void init_class_defs(py::class_<EventCount32>& cls)
 template<>
 void process_inits<EventCount32>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<EventCount32>(m, "EventCount32");
-    });
+    l.push_back(class_init<EventCount32>(m, "EventCount32"));
 }
 
 }  // namespace pyrti
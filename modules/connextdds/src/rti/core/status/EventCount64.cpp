@@ -29,9 +29,7 @@ void init_class_defs(py::class_<EventCount64>& cls)
 template<>
 void process_inits<EventCount64>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<EventCount64>(m, "EventCount64");
-    });
+    l.push_back(class_init<EventCount64>(m, "EventCount64"));
 }
 
 }  // namespace pyrti
@@ -44,11 +44,9 @@ void process_inits<ReliableReaderActivityChangedStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ReliableReaderActivityChangedStatus>(
-                m,
-                "ReliableReaderActivityChangedStatus");
-    });
+    l.push_back(class_init<ReliableReaderActivityChangedStatus>(
+            m,
+            "ReliableReaderActivityChangedStatus"));
 }
 
 }  // namespace pyrti
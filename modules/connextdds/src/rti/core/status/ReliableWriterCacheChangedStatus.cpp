@@ -73,11 +73,9 @@ void process_inits<ReliableWriterCacheChangedStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ReliableWriterCacheChangedStatus>(
-                m,
-                "ReliableWriterCacheChangedStatus");
-    });
+    l.push_back(class_init<ReliableWriterCacheChangedStatus>(
+            m,
+            "ReliableWriterCacheChangedStatus"));
 }
 
 }  // namespace pyrti
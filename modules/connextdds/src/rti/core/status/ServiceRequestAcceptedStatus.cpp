@@ -58,11 +58,9 @@ void process_inits<ServiceRequestAcceptedStatus>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ServiceRequestAcceptedStatus>(
-                m,
-                "ServiceRequestAcceptedStatus");
-    });
+    l.push_back(class_init<ServiceRequestAcceptedStatus>(
+            m,
+            "ServiceRequestAcceptedStatus"));
 }
 
 }  // namespace pyrti
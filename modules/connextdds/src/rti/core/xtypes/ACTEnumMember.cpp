@@ -85,11 +85,9 @@ void process_inits<AbstractConstructedType<EnumMember>>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AbstractConstructedType<EnumMember>, DynamicType>(
-                m,
-                "AbstractConstructedType");
-    });
+    l.push_back(class_init<AbstractConstructedType<EnumMember>, DynamicType>(
+            m,
+            "AbstractConstructedType"));
 }
 
 }  // namespace pyrti
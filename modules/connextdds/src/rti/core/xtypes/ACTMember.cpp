@@ -78,11 +78,9 @@ void process_inits<AbstractConstructedType<Member>>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AbstractConstructedType<Member>, DynamicType>(
-                m,
-                "ACTMember");
-    });
+    l.push_back(class_init<AbstractConstructedType<Member>, DynamicType>(
+            m,
+            "ACTMember"));
 }
 
 }  // namespace pyrti
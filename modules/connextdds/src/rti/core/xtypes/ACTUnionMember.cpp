@@ -80,11 +80,9 @@ void process_inits<AbstractConstructedType<UnionMember>>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AbstractConstructedType<UnionMember>, DynamicType>(
-                m,
-                "ACTUnionMember");
-    });
+    l.push_back(class_init<AbstractConstructedType<UnionMember>, DynamicType>(
+            m,
+            "ACTUnionMember"));
 }
 
 }  // namespace pyrti
@@ -72,9 +72,7 @@ void process_inits<DynamicDataInfo>(py::module& m, ClassInitList& l)
                         .export_values();
             });
 
-    l.push_back([m]() mutable {
-        return init_class<DynamicDataInfo>(m, "DynamicDataInfo");
-    });
+    l.push_back(class_init<DynamicDataInfo>(m, "DynamicDataInfo"));
 }
 
 }  // namespace pyrti
@@ -79,9 +79,7 @@ void init_class_defs(py::class_<DynamicDataMemberInfo>& cls)
 template<>
 void process_inits<DynamicDataMemberInfo>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DynamicDataMemberInfo>(m, "DynamicDataMemberInfo");
-    });
+    l.push_back(class_init<DynamicDataMemberInfo>(m, "DynamicDataMemberInfo"));
 }
 
 }  // namespace pyrti
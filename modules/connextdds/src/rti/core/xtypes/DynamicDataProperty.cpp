@@ -60,9 +60,7 @@ void init_class_defs(py::class_<DynamicDataProperty>& cls)
 template<>
 void process_inits<DynamicDataProperty>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DynamicDataProperty>(m, "DynamicDataProperty");
-    });
+    l.push_back(class_init<DynamicDataProperty>(m, "DynamicDataProperty"));
 }
 
 }  // namespace pyrti
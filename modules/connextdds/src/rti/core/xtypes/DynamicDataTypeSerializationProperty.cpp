@@ -86,11 +86,9 @@ void process_inits<DynamicDataTypeSerializationProperty>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DynamicDataTypeSerializationProperty>(
-                m,
-                "DynamicDataTypeSerializationProperty");
-    });
+    l.push_back(class_init<DynamicDataTypeSerializationProperty>(
+            m,
+            "DynamicDataTypeSerializationProperty"));
 }
 
 }  // namespace pyrti
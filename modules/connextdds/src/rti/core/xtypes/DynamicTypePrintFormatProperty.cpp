@@ -54,11 +54,9 @@ void process_inits<DynamicTypePrintFormatProperty>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DynamicTypePrintFormatProperty>(
-                m,
-                "DynamicTypePrintFormatProperty");
-    });
+    l.push_back(class_init<DynamicTypePrintFormatProperty>(
+            m,
+            "DynamicTypePrintFormatProperty"));
 }
 
 }  // namespace pyrti
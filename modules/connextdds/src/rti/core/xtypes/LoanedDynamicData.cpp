@@ -48,9 +48,7 @@ void init_class_defs(py::class_<LoanedDynamicData>& cls)
 template<>
 void process_inits<LoanedDynamicData>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<LoanedDynamicData>(m, "LoanedDynamicData");
-    });
+    l.push_back(class_init<LoanedDynamicData>(m, "LoanedDynamicData"));
 }
 
 }  // namespace pyrti
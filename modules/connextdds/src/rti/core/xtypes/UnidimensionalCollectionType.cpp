@@ -38,11 +38,9 @@ void process_inits<UnidimensionalCollectionTypeImpl>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<UnidimensionalCollectionTypeImpl, CollectionType>(
-                m,
-                "UnidimensionalCollectionType");
-    });
+    l.push_back(class_init<UnidimensionalCollectionTypeImpl, CollectionType>(
+            m,
+            "UnidimensionalCollectionType"));
 }
 
 }  // namespace pyrti
@@ -156,11 +156,9 @@ void process_inits<DomainParticipantConfigParams>(
         py::module& m,
         ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<DomainParticipantConfigParams>(
-                m,
-                "DomainParticipantConfigParams");
-    });
+    l.push_back(class_init<DomainParticipantConfigParams>(
+            m,
+            "DomainParticipantConfigParams"));
 }
 
 }  // namespace pyrti
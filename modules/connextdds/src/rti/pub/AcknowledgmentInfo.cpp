@@ -45,9 +45,7 @@ void init_class_defs(py::class_<AcknowledgmentInfo>& cls)
 template<>
 void process_inits<AcknowledgmentInfo>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AcknowledgmentInfo>(m, "AcknowledgmentInfo");
-    });
+    l.push_back(class_init<AcknowledgmentInfo>(m, "AcknowledgmentInfo"));
 }
 
 }  // namespace pyrti
@@ -339,19 +339,15 @@ void process_inits<FlowController>(py::module& m, ClassInitList& l)
                         .export_values();
             });
 
-    l.push_back([m]() mutable {
-        return init_class<FlowControllerTokenBucketProperty>(
-                m,
-                "FlowControllerTokenBucketProperty");
-    });
+    l.push_back(class_init<FlowControllerTokenBucketProperty>(
+            m,
+            "FlowControllerTokenBucketProperty"));
 
-    l.push_back([m]() mutable {
-        return init_class<FlowControllerProperty>(m, "FlowControllerProperty");
-    });
+    l.push_back(class_init<FlowControllerProperty>(
+            m,
+            "FlowControllerProperty"));
 
-    l.push_back([m]() mutable {
-        return init_class<FlowController>(m, "FlowController");
-    });
+    l.push_back(class_init<FlowController>(m, "FlowController"));
 }
 
 }  // namespace pyrti
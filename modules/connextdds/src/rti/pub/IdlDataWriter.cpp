@@ -9,6 +9,9 @@
  * damages arising out of the use or inability to use the software.
  */
 
+#include <algorithm>
+#include <cstdlib>
+
 #include <pybind11/stl_bind.h>
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
@@ -16,6 +19,7 @@
 
 #include "IdlDataWriter.hpp"
 #include "IdlTypeSupport.hpp"
+#include "PyPerfStats.hpp"
 
 #include <rti/core/memory.hpp>
 #include <rti/core/EntityLock.hpp>
@@ -26,21 +30,11 @@ using namespace rti::topic::cdr;
 
 namespace pyrti {
 
-// Gets the Python objects associated to this writer
-static CPySampleConverter* get_py_objects(
-        dds::pub::DataWriter<CSampleWrapper>& writer)
-{
-    auto objects =
-            static_cast<CPySampleConverter*>(writer->get_user_data_());
-    RTI_CHECK_PRECONDITION(objects != nullptr);
-    return objects;
-}
-
 static CPySampleConverter* convert_sample(
         dds::pub::DataWriter<CSampleWrapper>& writer,
         const py::object& sample)
 {
-    CPySampleConverter *obj_cache = get_py_objects(writer);
+    CPySampleConverter *obj_cache = get_py_sample_converter(writer);
 
     // Important: this is a call into Python; the caller must acquire the GIL
     obj_cache->convert_to_c_sample(sample);
@@ -71,37 +65,110 @@ struct IdlWriteImpl {
             const py_sample& sample,
             ExtraArgs&&... extra_args)
     {
-        // Ensure that convert_sample and write are atomic by taking the writer
-        // EA. The writer lock is taken outside the GIL to avoid deadlocks.
-        rti::core::EntityLock lock_writer(writer);
-
-        // Acquire the GIL, since convert_sample runs python code
-        py::gil_scoped_acquire acquire_gil;
+        // Each write converts the sample into its own C sample, a slot
+        // acquired from the writer's pool. Unlike the other operations, the
+        // writer EA is not taken during the conversion; the native write
+        // takes it.
+        PyPerfTimer timer(writer);
+        CPySampleConverter* obj_cache = get_py_sample_converter(writer);
+        CPySampleWriteSlot slot(*obj_cache);
+        if (!slot.acquired()) {
+            // All the slots are in use (or this thread already holds the EA
+            // and another one holds the only slot): convert into the shared
+            // C sample under the writer EA, taken before the GIL like in the
+            // other operations
+            rti::core::EntityLock lock_writer(writer);
+            timer.lap(PyPerfPhase::LOCK_WAIT);
+            {
+                py::gil_scoped_acquire acquire_gil;
+                timer.lap(PyPerfPhase::GIL_WAIT);
+                convert_sample(writer, sample);
+                timer.lap(PyPerfPhase::CONVERSION);
+            }
+
+            // GIL: released; Writer EA: taken
+            writer.extensions().write(
+                    obj_cache->c_sample_buffer,
+                    std::forward<ExtraArgs>(extra_args)...);
+            timer.lap(PyPerfPhase::NATIVE_CALL);
+            return;
+        }
+        timer.lap(PyPerfPhase::LOCK_WAIT);
 
-        // GIL: taken; Writer EA: taken
-        auto obj_cache = convert_sample(writer, sample);
+        {
+            // Acquire the GIL, since the conversion runs python code
+            py::gil_scoped_acquire acquire_gil;
+            timer.lap(PyPerfPhase::GIL_WAIT);
 
-        // The native operation can run without the GIL
-        py::gil_scoped_release release_gil_for_native_operation;
+            // GIL: taken; Slot: taken
+            slot.convert(sample);
+            timer.lap(PyPerfPhase::CONVERSION);
+        }
 
-        // GIL: released; Writer EA: taken
+        // GIL: released; Slot: taken
         writer.extensions().write(
-                obj_cache->c_sample_buffer,
+                slot.buffer(),
                 // call the appropriate overload of write()
                 std::forward<ExtraArgs>(extra_args)...);
+        timer.lap(PyPerfPhase::NATIVE_CALL);
     }
 
+    // Writes a list of samples in batches. Each batch is converted into the
+    // pool of C samples with a single GIL acquisition and then written back
+    // to back without the GIL. The writer EA is held for the whole operation,
+    // so when the Batch QoS is enabled the samples are added consecutively to
+    // the same batch.
     template<typename... ExtraArgs>
     static void py_write_range(
             IdlDataWriter& writer,
             const std::vector<py_sample>& samples,
             ExtraArgs&&... extra_args)
     {
-        // TODO PY-17: Evaluate if this can be optimized (e.g. convert all
-        // first to avoid taking/releasing the GIL in each iteration, or at
-        // least cache get_python_objects first).
-        for (const auto& sample : samples) {
-            py_write(writer, sample, std::forward<ExtraArgs>(extra_args)...);
+        // The perf stats record each batch as one operation
+        PyPerfTimer timer(writer);
+        rti::core::EntityLock lock_writer(writer);
+        timer.lap(PyPerfPhase::LOCK_WAIT);
+        py::gil_scoped_acquire acquire_gil;
+        timer.lap(PyPerfPhase::GIL_WAIT);
+
+        CPySampleConverter* obj_cache = get_py_sample_converter(writer);
+        size_t batch_size = obj_cache->c_sample_pool_max_size;
+        for (size_t first = 0; first < samples.size(); first += batch_size) {
+            size_t last = std::min(first + batch_size, samples.size());
+
+            // GIL: taken; Writer EA: taken
+            size_t converted = 0;
+            try {
+                for (size_t i = first; i < last; i++) {
+                    obj_cache->convert_to_pool_c_sample(converted, samples[i]);
+                    converted++;
+                }
+            } catch (...) {
+                // Like individual writes, write all the samples before the
+                // one that failed to convert
+                write_pool_samples(writer, obj_cache, converted, extra_args...);
+                throw;
+            }
+            timer.lap(PyPerfPhase::CONVERSION);
+
+            write_pool_samples(writer, obj_cache, converted, extra_args...);
+            timer.lap(PyPerfPhase::NATIVE_CALL);
+        }
+    }
+
+    template<typename... ExtraArgs>
+    static void write_pool_samples(
+            IdlDataWriter& writer,
+            CPySampleConverter* obj_cache,
+            size_t count,
+            ExtraArgs&... extra_args)
+    {
+        // GIL: released; Writer EA: taken
+        py::gil_scoped_release release_gil_for_native_operation;
+        for (size_t i = 0; i < count; i++) {
+            writer.extensions().write(
+                    obj_cache->c_sample_pool_buffers[i],
+                    extra_args...);
         }
     }
 
@@ -136,9 +203,34 @@ struct IdlWriteImpl {
     }
 };
 
+// Gets the number of write slots (see CPySampleConverter::write_slots) from
+// the DataWriter Qos
+static size_t get_write_slot_count(const dds::pub::qos::DataWriterQos& qos)
+{
+    using rti::core::policy::Property;
+    static const char* c_sample_pool_size_property_name =
+            "python.data_writer.c_sample_pool_size";
+
+    const Property& property = qos.policy<Property>();
+    if (!property.exists(c_sample_pool_size_property_name)) {
+        return 1;
+    }
+
+    std::string value = property.get(c_sample_pool_size_property_name);
+    char* end = nullptr;
+    unsigned long count = std::strtoul(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || value[0] == '-' || count == 0) {
+        throw dds::core::InvalidArgumentError(
+                std::string(c_sample_pool_size_property_name)
+                + " must be a positive integer");
+    }
+
+    return static_cast<size_t>(count);
+}
+
 static dds::pub::qos::DataWriterQos get_modified_qos(
         const PyPublisher&,
-        const PyTopic<CSampleWrapper>& topic,
+        py::handle type_support,
         const dds::pub::qos::DataWriterQos& qos)
 {
     using rti::core::policy::Property;
@@ -147,7 +239,6 @@ static dds::pub::qos::DataWriterQos get_modified_qos(
 
     py::gil_scoped_acquire acquire;
 
-    auto type_support = get_py_type_support_from_topic(topic);
     auto is_unbounded =
         py::cast<bool>(type_support.attr("is_unbounded"));
     if (!is_unbounded) {
@@ -181,15 +272,21 @@ IdlDataWriter create_idl_py_writer(
     // This function performs a few additional initialization steps compared to
     // the C++ constructor:
     // - Configures support for unbounded types via Qos
-    // - Caches the Python objects required for writing python samples
+    // - Caches the Python objects required for writing python samples,
+    //   including the pool of C samples used by concurrent writes
+    py::handle type_support = get_py_type_support_from_topic(topic);
     dds::pub::qos::DataWriterQos modified_qos = get_modified_qos(
             publisher,
-            topic,
+            type_support,
             qos != nullptr ? *qos : publisher.default_datawriter_qos());
+    size_t write_slot_count = get_write_slot_count(modified_qos);
     auto writer = listener == nullptr
             ? IdlDataWriter(publisher, topic, modified_qos)
             : IdlDataWriter(publisher, topic, modified_qos, *listener, mask);
-    CPySampleConverter::cache_idl_entity_py_objects(writer, writer.topic());
+    CPySampleConverter::cache_idl_entity_py_objects(
+            writer,
+            type_support,
+            write_slot_count);
     return writer;
 }
 
@@ -200,7 +297,7 @@ static py::object py_key_value(
     rti::core::EntityLock lock_writer(writer);
     py::gil_scoped_acquire acquire_gil;
     // Entity lock + gil taken
-    CPySampleConverter* obj_cache = get_py_objects(writer);
+    CPySampleConverter* obj_cache = get_py_sample_converter(writer);
     writer.key_value(obj_cache->c_sample_buffer, handle);
     return obj_cache->create_py_sample();
 }
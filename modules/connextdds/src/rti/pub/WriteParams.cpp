@@ -109,9 +109,7 @@ void init_class_defs(py::class_<WriteParams>& cls)
 template<>
 void process_inits<WriteParams>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<WriteParams>(m, "WriteParams");
-    });
+    l.push_back(class_init<WriteParams>(m, "WriteParams"));
 }
 
 }  // namespace pyrti
@@ -38,9 +38,7 @@ void init_class_defs(py::class_<AckResponseData>& cls)
 template<>
 void process_inits<AckResponseData>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<AckResponseData>(m, "AckResponseData");
-    });
+    l.push_back(class_init<AckResponseData>(m, "AckResponseData"));
 }
 
 }  // namespace pyrti
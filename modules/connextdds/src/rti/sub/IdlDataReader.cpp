@@ -14,10 +14,22 @@
 #include <pybind11/operators.h>
 #include <pybind11/functional.h>
 #include <rti/core/EntityLock.hpp>
+#include <dds/core/cond/WaitSet.hpp>
+#include <dds/core/WeakReference.hpp>
+#include <dds/core/cond/GuardCondition.hpp>
+#include <dds/sub/cond/ReadCondition.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "IdlDataReader.hpp"
 #include "IdlTypeSupport.hpp"
+#include "IdlLoanedViews.hpp"
+#include "PyColumns.hpp"
 #include "PyLoanedSample.hpp"
 #include "PyLoanedSamples.hpp"
+#include "PyPerfStats.hpp"
+#include "PySampleInfoView.hpp"
 
 using namespace dds::core::xtypes;
 using namespace dds::topic;
@@ -25,20 +37,11 @@ using namespace rti::topic::cdr;
 
 namespace pyrti {
 
-// Gets the Python objects associated to this reader
-static CPySampleConverter* get_py_objects(
-        dds::sub::DataReader<CSampleWrapper>& reader)
-{
-    auto objects = static_cast<CPySampleConverter*>(reader->get_user_data_());
-    RTI_CHECK_PRECONDITION(objects != nullptr);
-    return objects;
-}
-
 static CPySampleConverter* convert_sample(
         dds::sub::DataReader<CSampleWrapper>& reader,
         const py::object& sample)
 {
-    CPySampleConverter* obj_cache = get_py_objects(reader);
+    CPySampleConverter* obj_cache = get_py_sample_converter(reader);
 
     // Important: this is a call into Python; the caller must acquire the GIL
     obj_cache->convert_to_c_sample(sample);
@@ -46,17 +49,28 @@ static CPySampleConverter* convert_sample(
     return obj_cache;  // return the obj_cache for convenience
 }
 
+// Calls take() or read() on source (the DataReader or one of its Selectors),
+// recording the native call in the perf stats of the DataReader
+template<typename Source>
+static dds::sub::LoanedSamples<CSampleWrapper> native_take(
+        const PyDataReader<CSampleWrapper>& dr,
+        Source& source)
+{
+    PyPerfTimer timer(dr);
+    auto samples = source.take();
+    timer.lap(PyPerfPhase::NATIVE_CALL);
+    return samples;
+}
 
-template <typename CreateSampleFunc>
-py::object invoke_py_sample_function(
-        CreateSampleFunc&& py_function,
-        py::handle& type_support,
-        const CSampleWrapper &sample)
+template<typename Source>
+static dds::sub::LoanedSamples<CSampleWrapper> native_read(
+        const PyDataReader<CSampleWrapper>& dr,
+        Source& source)
 {
-    // We pass the pointer to the python function as an integer,
-    // because that's what ctypes.cast expects.
-    size_t sample_ptr = reinterpret_cast<size_t>(sample.sample());
-    return py_function(type_support, sample_ptr);
+    PyPerfTimer timer(dr);
+    auto samples = source.read();
+    timer.lap(PyPerfPhase::NATIVE_CALL);
+    return samples;
 }
 
 static py::list convert_data(
@@ -66,16 +80,15 @@ static py::list convert_data(
     size_t max_length = samples.length();
     auto valid_samples = rti::sub::valid_data(std::move(samples));
 
+    PyPerfTimer timer(dr);
     py::gil_scoped_acquire acquire;
+    timer.lap(PyPerfPhase::GIL_WAIT);
     py::list py_samples(max_length);
-    auto obj_cache = get_py_objects(dr);
+    auto obj_cache = get_py_sample_converter(dr);
     size_t i = 0;
     for (auto& sample : valid_samples) {
         // Create a Python sample from the C one
-        py_samples[i++] = invoke_py_sample_function(
-                obj_cache->create_py_sample_func,
-                obj_cache->type_support,
-                sample.data());
+        py_samples[i++] = obj_cache->create_py_sample(sample.data());
     }
 
     if (i < max_length) {
@@ -85,52 +98,480 @@ static py::list convert_data(
             throw py::error_already_set();
         }
     }
+    timer.lap(PyPerfPhase::CONVERSION);
 
     return py_samples;
 }
 
-using DataAndInfoVector =
-        std::vector<std::pair<py::object, dds::sub::SampleInfo>>;
+// Copies the SampleInfos of a LoanedSamples into a single block. With
+// info_views, each info in the result of take() or read() is a SampleInfoView
+// of this block.
+static std::shared_ptr<const PySampleInfoBlock> create_info_block(
+        const dds::sub::LoanedSamples<CSampleWrapper>& samples)
+{
+    auto block = std::make_shared<PySampleInfoBlock>(samples.length());
+    for (const auto& sample : samples) {
+        block->append(sample.info());
+    }
+    return block;
+}
 
+// Returns a list of (data, info) samples. Each info is a SampleInfo, or a
+// SampleInfoView if info_views is set.
 static py::list convert_data_w_info(
         PyDataReader<CSampleWrapper>& dr,
-        dds::sub::LoanedSamples<CSampleWrapper>&& samples)
+        dds::sub::LoanedSamples<CSampleWrapper>&& samples,
+        bool info_views)
 {
     size_t length = samples.length();
+    std::shared_ptr<const PySampleInfoBlock> info_block;
+    if (info_views) {
+        info_block = create_info_block(samples);
+    }
+
+    PyPerfTimer timer(dr);
     py::gil_scoped_acquire acquire;
+    timer.lap(PyPerfPhase::GIL_WAIT);
     py::list py_samples(length);
-    //     py_samples.reserve(max_length);
 
     // This is the type support function that converts from C data
     // to the user-facing python object.
-    auto obj_cache = get_py_objects(dr);
+    auto obj_cache = get_py_sample_converter(dr);
 
     size_t i = 0;
     for (auto& sample : samples) {
-        const auto& info = sample.info();
         py::object py_data;
-        if (info.valid()) {
-            py_data = invoke_py_sample_function(
-                    obj_cache->create_py_sample_func,
-                    obj_cache->type_support,
-                    sample.data());
+        if (sample.info().valid()) {
+            py_data = obj_cache->create_py_sample(sample.data());
         } else {
             py_data = py::none();
         }
-        py_samples[i++] = obj_cache->create_py_data_info_sample(py_data, info);
+        if (info_views) {
+            py_samples[i] = obj_cache->create_py_data_info_sample(
+                    py_data,
+                    py::cast(PySampleInfoView(info_block, i)));
+        } else {
+            py_samples[i] = obj_cache->create_py_data_info_sample(
+                    py_data,
+                    sample.info());
+        }
+        i++;
     }
+    timer.lap(PyPerfPhase::CONVERSION);
 
     return py_samples;
 }
 
+// Returns the data (None for invalid samples) and the SampleInfos as columns:
+// "info.valid", "info.source_timestamp", "info.reception_timestamp" and
+// "info.instance_handle", which are aligned with the data.
+static py::tuple convert_data_w_info_columns(
+        PyDataReader<CSampleWrapper>& dr,
+        dds::sub::LoanedSamples<CSampleWrapper>&& samples)
+{
+    size_t length = samples.length();
+    PySampleInfoColumns info_columns(length, true);
+    for (const auto& sample : samples) {
+        info_columns.append(sample.info());
+    }
+
+    PyPerfTimer timer(dr);
+    py::gil_scoped_acquire acquire;
+    timer.lap(PyPerfPhase::GIL_WAIT);
+    py::list py_samples(length);
+    auto obj_cache = get_py_sample_converter(dr);
+    size_t i = 0;
+    for (auto& sample : samples) {
+        py_samples[i++] = sample.info().valid()
+                ? obj_cache->create_py_sample(sample.data())
+                : py::none();
+    }
+
+    py::dict py_info_columns;
+    info_columns.add_to(py_info_columns);
+    timer.lap(PyPerfPhase::CONVERSION);
+    return py::make_tuple(py_samples, py_info_columns);
+}
+
+// Takes the valid data as columns of the given primitive members. The
+// columns are filled from the loaned C samples without the GIL.
+static py::dict take_columns(
+        PyDataReader<CSampleWrapper>& dr,
+        const std::vector<std::string>& fields)
+{
+    std::vector<NativeMemberLocation> locations(fields.size());
+    {
+        py::gil_scoped_acquire acquire;
+        auto program = get_py_sample_converter(dr)->native_c_to_py_program;
+        if (program == nullptr) {
+            throw dds::core::UnsupportedError(
+                    "take_columns is not supported for this type");
+        }
+
+        for (size_t i = 0; i < fields.size(); i++) {
+            if (!program->find_member(fields[i], locations[i])
+                || locations[i].kind
+                        != NativeMemberLocation::Kind::PRIMITIVE) {
+                throw dds::core::InvalidArgumentError(
+                        "'" + fields[i] + "' is not a primitive member");
+            }
+        }
+    }
+
+    auto samples = dr.take();
+    std::vector<std::unique_ptr<PyColumn>> columns;
+    for (const auto& location : locations) {
+        columns.push_back(
+                PyColumn::create(location.primitive_kind, samples.length()));
+    }
+    PySampleInfoColumns info_columns(samples.length());
+
+    for (const auto& sample : samples) {
+        if (!sample.info().valid()) {
+            continue;
+        }
+
+        auto c_sample = static_cast<const char*>(sample.data().sample());
+        for (size_t i = 0; i < columns.size(); i++) {
+            columns[i]->append(c_sample + locations[i].offset);
+        }
+        info_columns.append(sample.info());
+    }
+
+    py::gil_scoped_acquire acquire;
+    py::dict py_columns;
+    for (size_t i = 0; i < columns.size(); i++) {
+        py_columns[py::str(fields[i])] = columns[i]->to_python();
+    }
+    info_columns.add_to(py_columns);
+
+    return py_columns;
+}
+
+// Converts the valid data into DynamicData samples directly from the loaned C
+// samples, without creating Python samples. Used to forward the data to a
+// DynamicData DataWriter.
+static py::list convert_to_dynamic_data(
+        PyDataReader<CSampleWrapper>& dr,
+        dds::sub::LoanedSamples<CSampleWrapper>&& samples)
+{
+    auto valid_samples = rti::sub::valid_data(std::move(samples));
+
+    py::gil_scoped_acquire acquire;
+    auto obj_cache = get_py_sample_converter(dr);
+    auto plugin = py::cast<TypePlugin>(
+            obj_cache->type_support.attr("_plugin_dynamic_type"));
+    auto public_plugin = py::cast<TypePlugin>(
+            obj_cache->type_support.attr("_get_public_dynamic_type")());
+
+    py::list dynamic_data_samples;
+    for (const auto& sample : valid_samples) {
+        DynamicData data(*public_plugin.type);
+        copy_c_sample_to_dynamic_data(
+                plugin,
+                const_cast<CSampleWrapper&>(sample.data()),
+                data,
+                obj_cache->native_c_to_py_program);
+        dynamic_data_samples.append(py::cast(std::move(data)));
+    }
+
+    return dynamic_data_samples;
+}
+
+static auto take_dynamic_data(PyDataReader<CSampleWrapper>& dr)
+{
+    return convert_to_dynamic_data(dr, dr.take());
+}
+
+static auto read_dynamic_data(PyDataReader<CSampleWrapper>& dr)
+{
+    return convert_to_dynamic_data(dr, dr.read());
+}
+
+// Takes the samples of an IDL DataReader in a native thread and delivers them
+// to a Python callback in batches, so that a burst of samples acquires the
+// GIL once per batch instead of once per on_data_available notification.
+//
+// A batch is delivered when it has max_samples samples or max_latency after
+// its first sample was taken, whichever comes first. The dispatch thread
+// keeps a reference to this object until it finishes.
+//
+// The dispatcher only holds a weak reference to the reader, but its
+// ReadCondition holds strong ones. The reader closes the dispatcher when
+// nothing else references it (see PyDataReaderHelpers), or when it's closed
+// or finalized, which wakes up the thread.
+class PyIdlBatchDispatcherImpl
+        : public PyIdlBatchDispatcher,
+          public std::enable_shared_from_this<PyIdlBatchDispatcherImpl> {
+public:
+    PyIdlBatchDispatcherImpl(
+            const dds::sub::DataReader<CSampleWrapper>& reader,
+            py::object callback,
+            int32_t max_samples,
+            const dds::core::Duration& max_latency)
+            : reader_(reader),
+              read_condition_(dds::core::null),
+              callback_(std::move(callback)),
+              max_samples_(max_samples),
+              max_latency_(
+                      std::chrono::seconds(max_latency.sec())
+                      + std::chrono::nanoseconds(max_latency.nanosec()))
+    {
+        auto use_count = reader.delegate().use_count();
+        read_condition_ = dds::sub::cond::ReadCondition(
+                reader,
+                dds::sub::status::DataState::any());
+        reader_references_ = reader.delegate().use_count() - use_count;
+
+        waitset_.attach_condition(read_condition_);
+        waitset_.attach_condition(stop_condition_);
+    }
+
+    ~PyIdlBatchDispatcherImpl()
+    {
+        close(false);
+        if (thread_.joinable()) {
+            // The dispatch thread released the last reference
+            thread_.detach();
+        }
+
+        py::gil_scoped_acquire acquire;
+        callback_ = py::object();
+    }
+
+    void start()
+    {
+        auto self = shared_from_this();
+        thread_ = std::thread([self]() { self->run(); });
+    }
+
+    void close(bool flush) override
+    {
+        if (!stopped_) {
+            flush_ = flush;
+            stopped_ = true;
+        }
+        stop_condition_.trigger_value(true);
+
+        std::lock_guard<std::mutex> lock(join_mutex_);
+        if (!thread_.joinable()
+            || thread_.get_id() == std::this_thread::get_id()) {
+            return;
+        }
+
+        if (PyGILState_Check()) {
+            py::gil_scoped_release release;
+            thread_.join();
+        } else {
+            thread_.join();
+        }
+    }
+
+    long reader_references() const override
+    {
+        return reader_references_;
+    }
+
+private:
+    using Batch = std::vector<dds::sub::LoanedSamples<CSampleWrapper>>;
+    using Clock = std::chrono::steady_clock;
+
+    void run()
+    {
+        Batch batch;
+        int32_t batch_size = 0;
+        Clock::time_point deadline;
+        try {
+            while (!stopped_) {
+                auto timeout = dds::core::Duration::infinite();
+                if (!batch.empty()) {
+                    auto remaining =
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    deadline - Clock::now());
+                    timeout = dds::core::Duration::from_microsecs(
+                            std::max<int64_t>(0, remaining.count() / 1000));
+                }
+
+                dds::core::cond::WaitSet::ConditionSeq active_conditions;
+                try {
+                    waitset_.wait(active_conditions, timeout);
+                } catch (const dds::core::TimeoutError&) {
+                }
+
+                if (stopped_) {
+                    break;
+                }
+
+                auto reader = reader_.lock();
+                if (reader == dds::core::null || reader->closed()) {
+                    break;
+                }
+
+                if (batch_size < max_samples_) {
+                    auto samples = reader.select()
+                                           .max_samples(
+                                                   max_samples_ - batch_size)
+                                           .take();
+                    if (samples.length() > 0) {
+                        if (batch.empty()) {
+                            deadline = Clock::now() + max_latency_;
+                        }
+                        batch_size += samples.length();
+                        batch.push_back(std::move(samples));
+                    }
+                }
+
+                if (!batch.empty()
+                    && (batch_size >= max_samples_
+                        || Clock::now() >= deadline)) {
+                    deliver(reader, batch);
+                    batch_size = 0;
+                }
+            }
+
+            // When the callback is replaced or removed, the samples that
+            // were already taken go to this one
+            if (flush_ && !batch.empty()) {
+                auto reader = reader_.lock();
+                if (reader != dds::core::null) {
+                    deliver(reader, batch);
+                }
+            }
+        } catch (const std::exception&) {
+            // The reader was closed while taking the data
+        }
+    }
+
+    void deliver(dds::sub::DataReader<CSampleWrapper>& reader, Batch& batch)
+    {
+        py::gil_scoped_acquire acquire;
+        if (stopped_ && !flush_) {
+            // close() may be finalizing the converter
+            py::gil_scoped_release release;
+            batch.clear();
+            return;
+        }
+
+        try {
+            auto obj_cache = get_py_sample_converter(reader);
+            py::list py_samples;
+            for (auto& samples : batch) {
+                for (const auto& sample : samples) {
+                    if (sample.info().valid()) {
+                        py_samples.append(
+                                obj_cache->create_py_sample(sample.data()));
+                    }
+                }
+            }
+
+            // Return the loans before running the callback
+            {
+                py::gil_scoped_release release;
+                batch.clear();
+            }
+
+            if (py_samples.size() > 0) {
+                callback_(py_samples);
+            }
+        } catch (py::error_already_set& ex) {
+            ex.discard_as_unraisable("DataReader batch callback");
+        }
+        batch.clear();
+    }
+
+    dds::core::WeakReference<dds::sub::DataReader<CSampleWrapper>> reader_;
+    dds::sub::cond::ReadCondition read_condition_;
+    long reader_references_ = 0;
+    dds::core::cond::GuardCondition stop_condition_;
+    dds::core::cond::WaitSet waitset_;
+    py::object callback_;
+    int32_t max_samples_;
+    std::chrono::nanoseconds max_latency_;
+    std::atomic<bool> stopped_ { false };
+    std::atomic<bool> flush_ { false };
+    std::mutex join_mutex_;
+    std::thread thread_;
+};
+
+long PyDataReaderHelpers<CSampleWrapper>::reader_references(
+        dds::sub::DataReader<CSampleWrapper>& reader)
+{
+    auto obj_cache = static_cast<CPySampleConverter*>(
+            reader->get_user_data_());
+    return obj_cache != nullptr
+            ? obj_cache->batch_dispatcher_reader_references()
+            : 0;
+}
+
+void PyDataReaderHelpers<CSampleWrapper>::close(
+        dds::sub::DataReader<CSampleWrapper>& reader)
+{
+    auto obj_cache = static_cast<CPySampleConverter*>(
+            reader->get_user_data_());
+    if (obj_cache == nullptr) {
+        return;
+    }
+
+    // Destroying the dispatcher releases its references to the reader
+    auto dispatcher = obj_cache->exchange_batch_dispatcher(nullptr);
+    if (dispatcher != nullptr) {
+        dispatcher->close(false);
+    }
+}
+
+// Replaces the batch dispatcher of a reader; a None callback removes it
+static void set_batch_callback(
+        PyDataReader<CSampleWrapper>& dr,
+        py::object callback,
+        int32_t max_samples,
+        const dds::core::Duration& max_latency)
+{
+    if (max_samples <= 0) {
+        throw dds::core::InvalidArgumentError(
+                "max_samples must be a positive number");
+    }
+
+    auto obj_cache = get_py_sample_converter(dr);
+    std::shared_ptr<PyIdlBatchDispatcherImpl> dispatcher;
+    if (!callback.is_none()) {
+        dispatcher = std::make_shared<PyIdlBatchDispatcherImpl>(
+                dr,
+                std::move(callback),
+                max_samples,
+                max_latency);
+        dispatcher->start();
+    }
+
+    // When several threads set a callback at the same time, the last one
+    // wins and each previous dispatcher is closed once, after delivering the
+    // samples it already took
+    auto old_dispatcher =
+            obj_cache->exchange_batch_dispatcher(std::move(dispatcher));
+    if (old_dispatcher != nullptr) {
+        old_dispatcher->close(true);
+    }
+}
+
 static auto take_data(PyDataReader<CSampleWrapper>& dr)
 {
-    return convert_data(dr, dr.take());
+    return convert_data(dr, native_take(dr, dr));
+}
+
+static auto take_data_and_info(
+        PyDataReader<CSampleWrapper>& dr,
+        bool info_views)
+{
+    return convert_data_w_info(dr, native_take(dr, dr), info_views);
 }
 
-static auto take_data_and_info(PyDataReader<CSampleWrapper>& dr)
+static auto take_data_and_info_columns(PyDataReader<CSampleWrapper>& dr)
 {
-    return convert_data_w_info(dr, dr.take());
+    return convert_data_w_info_columns(dr, native_take(dr, dr));
+}
+
+static auto read_data_and_info_columns(PyDataReader<CSampleWrapper>& dr)
+{
+    return convert_data_w_info_columns(dr, native_read(dr, dr));
 }
 
 // These two functions are defined only to provide autocompletion. The actual
@@ -154,12 +595,14 @@ static py::object take_data_and_info_async(
 
 static auto read_data(PyDataReader<CSampleWrapper>& dr)
 {
-    return convert_data(dr, dr.read());
+    return convert_data(dr, native_read(dr, dr));
 }
 
-static auto read_data_and_info(PyDataReader<CSampleWrapper>& dr)
+static auto read_data_and_info(
+        PyDataReader<CSampleWrapper>& dr,
+        bool info_views)
 {
-    return convert_data_w_info(dr, dr.read());
+    return convert_data_w_info(dr, native_read(dr, dr), info_views);
 }
 
 static auto read_native(PyDataReader<CSampleWrapper>& dr)
@@ -172,29 +615,42 @@ static auto take_native(PyDataReader<CSampleWrapper>& dr)
     return dr.take();
 }
 
+static auto read_views(PyDataReader<CSampleWrapper>& dr)
+{
+    return PyIdlLoanedViews(dr, dr.read());
+}
+
+static auto take_views(PyDataReader<CSampleWrapper>& dr)
+{
+    return PyIdlLoanedViews(dr, dr.take());
+}
+
 static auto take_selector_data(PyDataReader<CSampleWrapper>::Selector& selector)
 {
     PyDataReader<CSampleWrapper> dr(selector.reader());
-    return convert_data(dr, selector.take());
+    return convert_data(dr, native_take(dr, selector));
 }
 
 static auto take_selector_data_and_info(
-        PyDataReader<CSampleWrapper>::Selector& selector)
+        PyDataReader<CSampleWrapper>::Selector& selector,
+        bool info_views)
 {
     PyDataReader<CSampleWrapper> dr(selector.reader());
-    return convert_data_w_info(dr, selector.take());
+    return convert_data_w_info(dr, native_take(dr, selector), info_views);
 }
 
 static auto read_selector_data(PyDataReader<CSampleWrapper>::Selector& selector)
 {
     PyDataReader<CSampleWrapper> dr(selector.reader());
-    return convert_data(dr, selector.read());
+    return convert_data(dr, native_read(dr, selector));
 }
 
-static auto read_selector_data_and_info(PyDataReader<CSampleWrapper>::Selector& selector)
+static auto read_selector_data_and_info(
+        PyDataReader<CSampleWrapper>::Selector& selector,
+        bool info_views)
 {
     PyDataReader<CSampleWrapper> dr(selector.reader());
-    return convert_data_w_info(dr, selector.read());
+    return convert_data_w_info(dr, native_read(dr, selector), info_views);
 }
 
 static auto read_selector_native(
@@ -209,6 +665,20 @@ static auto take_selector_native(
     return selector.take();
 }
 
+static auto read_selector_views(
+        PyDataReader<CSampleWrapper>::Selector& selector)
+{
+    PyDataReader<CSampleWrapper> dr(selector.reader());
+    return PyIdlLoanedViews(dr, selector.read());
+}
+
+static auto take_selector_views(
+        PyDataReader<CSampleWrapper>::Selector& selector)
+{
+    PyDataReader<CSampleWrapper> dr(selector.reader());
+    return PyIdlLoanedViews(dr, selector.take());
+}
+
 static py::object py_key_value(
         PyDataReader<CSampleWrapper>& reader,
         dds::core::InstanceHandle handle)
@@ -216,7 +686,7 @@ static py::object py_key_value(
     rti::core::EntityLock lock_reader(reader);
     py::gil_scoped_acquire acquire_gil;
     // Entity lock + gil taken
-    CPySampleConverter* obj_cache = get_py_objects(reader);
+    CPySampleConverter* obj_cache = get_py_sample_converter(reader);
     reader.key_value(obj_cache->c_sample_buffer, handle);
     return obj_cache->create_py_sample();
 }
@@ -236,7 +706,7 @@ static dds::core::InstanceHandle py_lookup_instance(
 
 static dds::sub::qos::DataReaderQos get_modified_qos(
         const PySubscriber&,
-        const dds::topic::Topic<CSampleWrapper>& topic,
+        py::handle type_support,
         const dds::sub::qos::DataReaderQos& qos)
 {
     using rti::core::policy::Property;
@@ -245,7 +715,6 @@ static dds::sub::qos::DataReaderQos get_modified_qos(
 
     py::gil_scoped_acquire acquire;
 
-    auto type_support = get_py_type_support_from_topic(topic);
     auto is_unbounded = py::cast<bool>(type_support.attr("is_unbounded"));
     auto is_keyed = py::cast<bool>(type_support.attr("is_keyed"));
     if (!is_unbounded || !is_keyed) {
@@ -283,9 +752,13 @@ PyIdlDataReader create_idl_py_reader(
     // - Caches the Python objects required for converting Python/C samples in
     //   the reader read operations (and other operations)
 
+    // The TypeSupport is resolved only once; a CFT gets it from its related
+    // topic
+    py::handle type_support = get_py_type_support_from_topic(
+            cft == dds::core::null ? topic : cft.topic());
     auto modified_qos = get_modified_qos(
             subscriber,
-            cft == dds::core::null ? topic : cft.topic(),
+            type_support,
             qos != nullptr ? *qos : subscriber.default_datareader_qos());
 
     PyIdlDataReader reader = dds::core::null;
@@ -309,9 +782,7 @@ PyIdlDataReader create_idl_py_reader(
                 : PyIdlDataReader(subscriber, cft, modified_qos);
     }
 
-    CPySampleConverter::cache_idl_entity_py_objects(
-            reader,
-            reader.topic_description());
+    CPySampleConverter::cache_idl_entity_py_objects(reader, type_support);
     return reader;
 }
 
@@ -397,9 +868,11 @@ void init_dds_datareader_selector_read_methods<CSampleWrapper>(
     selector.def(
             "read",
             read_selector_data_and_info,
+            py::kw_only(),
+            py::arg("info_views") = false,
             py::call_guard<py::gil_scoped_release>(),
             "Read copies of all available data and info based on Selector "
-            "settings.");
+            "settings (see ``DataReader.take`` for ``info_views``).");
     selector.def(
             "read_data",
             read_selector_data,
@@ -408,9 +881,11 @@ void init_dds_datareader_selector_read_methods<CSampleWrapper>(
     selector.def(
             "take",
             take_selector_data_and_info,
+            py::kw_only(),
+            py::arg("info_views") = false,
             py::call_guard<py::gil_scoped_release>(),
             "Take copies of all available data and info based on Selector "
-            "settings.");
+            "settings (see ``DataReader.take`` for ``info_views``).");
     selector.def(
             "take_data",
             take_selector_data,
@@ -430,6 +905,20 @@ void init_dds_datareader_selector_read_methods<CSampleWrapper>(
             py::call_guard<py::gil_scoped_release>(),
             "(Advanced) Take data as a collection of loaned data in C "
             "format and info objects based on Selector settings");
+    selector.def(
+            "read_loaned_views",
+            read_selector_views,
+            py::call_guard<py::gil_scoped_release>(),
+            "(Advanced) Read data based on Selector settings as a "
+            "collection of loaned samples that provides zero-copy views of "
+            "their members");
+    selector.def(
+            "take_loaned_views",
+            take_selector_views,
+            py::call_guard<py::gil_scoped_release>(),
+            "(Advanced) Take data based on Selector settings as a "
+            "collection of loaned samples that provides zero-copy views of "
+            "their members");
 }
 
 static void init_csamplewrapper_loaned_samples(IdlDataReaderPyClass& cls)
@@ -454,6 +943,7 @@ template<>
 void init_dds_typed_datareader_template(IdlDataReaderPyClass& cls)
 {
     init_csamplewrapper_loaned_samples(cls);
+    init_idl_loaned_views(cls);
 
     // These constructors have a specific implementation for IDL types
     init_dds_idl_datareader_constructors(cls);
@@ -476,8 +966,79 @@ void init_dds_typed_datareader_template(IdlDataReaderPyClass& cls)
 
     cls.def("take",
             take_data_and_info,
+            py::kw_only(),
+            py::arg("info_views") = false,
+            py::call_guard<py::gil_scoped_release>(),
+            "Take copies of all available data and info. With "
+            "``info_views=True``, each info is a ``SampleInfoView`` of a "
+            "block shared by all the samples instead of a ``SampleInfo``.");
+
+    cls.def("take_with_info_columns",
+            take_data_and_info_columns,
             py::call_guard<py::gil_scoped_release>(),
-            "Take copies of all available data and info");
+            "Take copies of all available data with their info as columns: "
+            "returns a tuple with a list of data (``None`` for samples "
+            "without valid data) and a dictionary with the columns "
+            "``\"info.valid\"``, ``\"info.source_timestamp\"`` and "
+            "``\"info.reception_timestamp\"`` (in nanoseconds) and "
+            "``\"info.instance_handle\"``, aligned with the list of data.\n\n"
+            "The numeric columns support the buffer protocol and can be "
+            "converted into NumPy arrays without copying them.");
+
+    cls.def("read_with_info_columns",
+            read_data_and_info_columns,
+            py::call_guard<py::gil_scoped_release>(),
+            "Read copies of all available data with their info as columns "
+            "(see ``take_with_info_columns``).");
+
+    cls.def("take_columns",
+            take_columns,
+            py::arg("fields"),
+            py::call_guard<py::gil_scoped_release>(),
+            "Take all available valid data as columns: returns a dictionary "
+            "that maps each of the given primitive members (e.g. ``\"x\"`` "
+            "or ``\"position.x\"``) to a sequence of its values in all the "
+            "samples (e.g. a ``Float64Seq``). The dictionary also contains "
+            "the columns ``\"info.source_timestamp\"`` and "
+            "``\"info.reception_timestamp\"`` (in nanoseconds) and "
+            "``\"info.instance_handle\"``.\n\n"
+            "The numeric columns support the buffer protocol and can be "
+            "converted into NumPy arrays without copying them with "
+            "``numpy.asarray``.");
+
+    cls.def("take_dynamic_data",
+            take_dynamic_data,
+            py::call_guard<py::gil_scoped_release>(),
+            "Take copies of all available valid data as ``DynamicData`` "
+            "samples, converted directly from the native data. This is "
+            "useful to forward the data to a ``DynamicData.DataWriter``.");
+
+    cls.def("read_dynamic_data",
+            read_dynamic_data,
+            py::call_guard<py::gil_scoped_release>(),
+            "Read copies of all available valid data as ``DynamicData`` "
+            "samples, converted directly from the native data.");
+
+    cls.def("set_batch_callback",
+            set_batch_callback,
+            py::arg("callback"),
+            py::arg("max_samples") = 256,
+            py::arg_v(
+                    "max_latency",
+                    dds::core::Duration::zero(),
+                    "Duration.zero"),
+            "Take the data in a native thread as it arrives and call "
+            "``callback`` with a list of valid samples per batch, instead of "
+            "once per ``on_data_available`` notification. A batch is "
+            "delivered when it has ``max_samples`` samples or "
+            "``max_latency`` after its first sample was taken, whichever "
+            "comes first. A ``callback`` of ``None`` stops the delivery. "
+            "When the callback is replaced or removed, the samples already "
+            "taken are delivered to the previous one.\n\n"
+            "The callback runs in the dispatch thread; exceptions it raises "
+            "are reported as unraisable. While it's set, the data should not "
+            "be taken by other means. The delivery stops when the reader is "
+            "closed or no longer referenced.");
 
     cls.def("take_data_async",
             take_data_async,
@@ -515,8 +1076,11 @@ void init_dds_typed_datareader_template(IdlDataReaderPyClass& cls)
 
     cls.def("read",
             read_data_and_info,
+            py::kw_only(),
+            py::arg("info_views") = false,
             py::call_guard<py::gil_scoped_release>(),
-            "Read copies of all available data and info");
+            "Read copies of all available data and info (see ``take`` for "
+            "``info_views``)");
 
     cls.def(
             "select",
@@ -554,6 +1118,24 @@ void init_dds_typed_datareader_template(IdlDataReaderPyClass& cls)
             py::call_guard<py::gil_scoped_release>(),
             "(Advanced) Read all data as a collection of loaned data in C format "
             "and info objects");
+
+    cls.def("take_loaned_views",
+            take_views,
+            py::call_guard<py::gil_scoped_release>(),
+            "(Advanced) Take all data as a collection of loaned samples that "
+            "provides zero-copy views of their members.\n\n"
+            "Example:\n\n"
+            "  .. code-block:: python\n\n"
+            "    with reader.take_loaned_views() as samples:\n"
+            "        for i in range(len(samples)):\n"
+            "            if samples.info(i).valid:\n"
+            "                points = numpy.asarray(samples.view(i, 'points'))\n");
+
+    cls.def("read_loaned_views",
+            read_views,
+            py::call_guard<py::gil_scoped_release>(),
+            "(Advanced) Read all data as a collection of loaned samples that "
+            "provides zero-copy views of their members.");
 }
 
 } // namespace pyrti
\ No newline at end of file
@@ -0,0 +1,274 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyConnext.hpp"
+#include "IdlLoanedViews.hpp"
+#include "IdlTypeSupport.hpp"
+
+using namespace rti::topic::cdr;
+
+namespace pyrti {
+
+void IdlLoanDeleter::operator()(dds::sub::LoanedSamples<CSampleWrapper>* ptr)
+{
+    if (PyGILState_Check()) {
+        // release GIL for native destruction
+        py::gil_scoped_release release;
+        delete ptr;
+    } else {
+        delete ptr;
+    }
+}
+
+PyIdlLoanedViews::PyIdlLoanedViews(
+        const PyIdlDataReader& reader,
+        dds::sub::LoanedSamples<CSampleWrapper>&& samples)
+        : reader_(reader),
+          loan_(new dds::sub::LoanedSamples<CSampleWrapper>(
+                        std::move(samples)),
+                IdlLoanDeleter())
+{
+}
+
+PyIdlLoanedViews::~PyIdlLoanedViews()
+{
+    try {
+        if (!views_.empty()) {
+            // The views are only created with the GIL, and so is this object
+            // destroyed when it has any
+            release_views();
+        }
+        loan_.reset();
+    } catch (...) {
+        // Ignore exceptions
+    }
+}
+
+size_t PyIdlLoanedViews::length() const
+{
+    return loan_ ? loan_->length() : 0;
+}
+
+rti::sub::LoanedSample<CSampleWrapper> PyIdlLoanedViews::valid_sample(
+        size_t index) const
+{
+    if (!loan_) {
+        throw dds::core::AlreadyClosedError("The loan has been returned");
+    }
+
+    if (index >= loan_->length()) {
+        throw py::index_error();
+    }
+
+    auto sample = (*loan_)[index];
+    if (!sample.info().valid()) {
+        throw dds::core::PreconditionNotMetError(
+                "The sample doesn't contain valid data");
+    }
+
+    return sample;
+}
+
+dds::sub::SampleInfo PyIdlLoanedViews::info(size_t index) const
+{
+    if (!loan_) {
+        throw dds::core::AlreadyClosedError("The loan has been returned");
+    }
+
+    if (index >= loan_->length()) {
+        throw py::index_error();
+    }
+
+    return (*loan_)[index].info();
+}
+
+py::object PyIdlLoanedViews::data(size_t index) const
+{
+    auto sample = valid_sample(index);
+    return get_py_sample_converter(reader_)->create_py_sample(sample.data());
+}
+
+const NativeMemberLocation& PyIdlLoanedViews::find_member(
+        const std::string& member_path)
+{
+    auto it = locations_.find(member_path);
+    if (it != locations_.end()) {
+        return it->second;
+    }
+
+    auto program = get_py_sample_converter(reader_)->native_c_to_py_program;
+    if (program == nullptr) {
+        throw dds::core::UnsupportedError(
+                "Member views are not supported for this type");
+    }
+
+    NativeMemberLocation location;
+    if (!program->find_member(member_path, location)) {
+        throw dds::core::InvalidArgumentError(
+                "'" + member_path
+                + "' is not a primitive member or an array or sequence of "
+                  "primitives");
+    }
+
+    return locations_.emplace(member_path, location).first->second;
+}
+
+py::object PyIdlLoanedViews::view(size_t index, const std::string& member_path)
+{
+    auto sample = valid_sample(index);
+    const NativeMemberLocation& location = find_member(member_path);
+
+    const char* c_member =
+            static_cast<const char*>(sample.data().sample()) + location.offset;
+    IdlLoanedMemberBuffer buffer { loan_,
+                                   c_member,
+                                   location.primitive_kind,
+                                   1,
+                                   false };
+    switch (location.kind) {
+    case NativeMemberLocation::Kind::PRIMITIVE:
+        buffer.is_scalar = true;
+        break;
+    case NativeMemberLocation::Kind::ARRAY:
+        buffer.length = location.length;
+        break;
+    case NativeMemberLocation::Kind::SEQUENCE: {
+        auto sequence = reinterpret_cast<const CSequenceLayout*>(c_member);
+        buffer.length = sequence->_length;
+        if (sequence->_contiguous_buffer != nullptr) {
+            buffer.data =
+                    static_cast<const char*>(sequence->_contiguous_buffer);
+        }
+        break;
+    }
+    }
+
+    py::object exporter = py::cast(std::move(buffer));
+    auto view = py::reinterpret_steal<py::object>(
+            PyMemoryView_FromObject(exporter.ptr()));
+    if (!view) {
+        throw py::error_already_set();
+    }
+
+    views_.push_back(view);
+    return view;
+}
+
+void PyIdlLoanedViews::release_views()
+{
+    for (auto& view : views_) {
+        // A view that exports a buffer can't be released; its exporter keeps
+        // the loan until that buffer is released.
+        auto result = py::reinterpret_steal<py::object>(
+                PyObject_CallMethod(view.ptr(), "release", nullptr));
+        if (!result) {
+            PyErr_Clear();
+        }
+    }
+    views_.clear();
+}
+
+void PyIdlLoanedViews::return_loan()
+{
+    release_views();
+
+    // The samples are returned now unless a buffer is still in use
+    py::gil_scoped_release release;
+    loan_.reset();
+}
+
+void init_idl_loaned_views(IdlDataReaderPyClass& cls)
+{
+    py::class_<IdlLoanedMemberBuffer>(
+            cls,
+            "_LoanedMemberBuffer",
+            py::buffer_protocol())
+            .def_buffer([](IdlLoanedMemberBuffer& self) {
+                auto item_size = static_cast<py::ssize_t>(
+                        native_primitive_size(self.kind));
+                auto data = const_cast<char*>(self.data);
+                if (self.is_scalar) {
+                    return py::buffer_info(
+                            data,
+                            item_size,
+                            native_primitive_format(self.kind),
+                            0,
+                            std::vector<py::ssize_t>(),
+                            std::vector<py::ssize_t>(),
+                            true);
+                }
+
+                return py::buffer_info(
+                        data,
+                        item_size,
+                        native_primitive_format(self.kind),
+                        1,
+                        { static_cast<py::ssize_t>(self.length) },
+                        { item_size },
+                        true);
+            });
+
+    py::class_<PyIdlLoanedViews>(
+            cls,
+            "LoanedViews",
+            "(Advanced) A collection of loaned samples that provides "
+            "zero-copy, read-only access to the primitive members, and arrays "
+            "and sequences of primitives, of each sample.")
+            .def("__len__",
+                 &PyIdlLoanedViews::length,
+                 "Get the number of samples in the loan.")
+            .def("info",
+                 &PyIdlLoanedViews::info,
+                 py::arg("index"),
+                 "Get the SampleInfo of a sample.")
+            .def("data",
+                 &PyIdlLoanedViews::data,
+                 py::arg("index"),
+                 "Get a copy of a sample with valid data.")
+            .def("view",
+                 &PyIdlLoanedViews::view,
+                 py::arg("index"),
+                 py::arg("member"),
+                 "Get a read-only memoryview of a member of a sample with "
+                 "valid data, without copying it. The member can be a "
+                 "primitive (0-dimensional view), an array or a sequence of "
+                 "primitives (1-dimensional view). Members of nested structs "
+                 "are separated by a dot (e.g. ``\"position.x\"``).\n\n"
+                 "The view is valid until the loan is returned. It can be "
+                 "converted into a NumPy array with ``numpy.asarray``; in that "
+                 "case the loan is kept until the array is deleted.")
+            .def_property_readonly(
+                    "is_loan_returned",
+                    &PyIdlLoanedViews::is_loan_returned,
+                    "Whether return_loan has been called.")
+            .def("return_loan",
+                 &PyIdlLoanedViews::return_loan,
+                 "Returns the loan to the DataReader and releases the "
+                 "memoryviews.")
+            .def(
+                    "__enter__",
+                    [](PyIdlLoanedViews& self) -> PyIdlLoanedViews& {
+                        return self;
+                    },
+                    py::return_value_policy::reference,
+                    "Enter a context for the loaned samples, loan returned on "
+                    "context exit.")
+            .def(
+                    "__exit__",
+                    [](PyIdlLoanedViews& self,
+                       py::object,
+                       py::object,
+                       py::object) { self.return_loan(); },
+                    "Exit the context for the loaned samples, returning the "
+                    "resources.");
+}
+
+}  // namespace pyrti
@@ -0,0 +1,123 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+// Note: pybind11/stl.h must not be included in this file; the vectors are
+// converted into their bound dds.<Type>Seq classes, not into lists.
+#include "PyConnext.hpp"
+#include "PyColumns.hpp"
+
+#include <cstring>
+
+namespace pyrti {
+
+template<typename T>
+class PyTypedColumn : public PyColumn {
+public:
+    explicit PyTypedColumn(size_t capacity)
+    {
+        values_.reserve(capacity);
+    }
+
+    void append(const char* value) override
+    {
+        T typed_value;
+        std::memcpy(&typed_value, value, sizeof(T));
+        values_.push_back(typed_value);
+    }
+
+    py::object to_python() override
+    {
+        return py::cast(std::move(values_));
+    }
+
+private:
+    std::vector<T> values_;
+};
+
+std::unique_ptr<PyColumn> PyColumn::create(
+        NativePrimitiveKind kind,
+        size_t capacity)
+{
+    switch (kind) {
+    case NativePrimitiveKind::INT8:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<int8_t>(capacity));
+    case NativePrimitiveKind::UINT8:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<uint8_t>(capacity));
+    case NativePrimitiveKind::INT16:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<int16_t>(capacity));
+    case NativePrimitiveKind::UINT16:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<uint16_t>(capacity));
+    case NativePrimitiveKind::INT32:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<int32_t>(capacity));
+    case NativePrimitiveKind::UINT32:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<uint32_t>(capacity));
+    case NativePrimitiveKind::INT64:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<rti::core::int64>(capacity));
+    case NativePrimitiveKind::UINT64:
+        return std::unique_ptr<PyColumn>(
+                new PyTypedColumn<rti::core::uint64>(capacity));
+    case NativePrimitiveKind::FLOAT32:
+        return std::unique_ptr<PyColumn>(new PyTypedColumn<float>(capacity));
+    case NativePrimitiveKind::FLOAT64:
+        return std::unique_ptr<PyColumn>(new PyTypedColumn<double>(capacity));
+    }
+
+    throw dds::core::InvalidArgumentError("Invalid primitive kind");
+}
+
+static rti::core::int64 to_nanoseconds(const dds::core::Time& time)
+{
+    return static_cast<rti::core::int64>(time.sec()) * 1000000000
+            + time.nanosec();
+}
+
+PySampleInfoColumns::PySampleInfoColumns(size_t capacity, bool with_valid)
+        : with_valid_(with_valid)
+{
+    if (with_valid_) {
+        valid_.reserve(capacity);
+    }
+    source_timestamps_.reserve(capacity);
+    reception_timestamps_.reserve(capacity);
+    instance_handles_.reserve(capacity);
+}
+
+void PySampleInfoColumns::append(const dds::sub::SampleInfo& info)
+{
+    if (with_valid_) {
+        valid_.push_back(info.valid() ? 1 : 0);
+    }
+    source_timestamps_.push_back(to_nanoseconds(info.source_timestamp()));
+    reception_timestamps_.push_back(
+            to_nanoseconds(info->reception_timestamp()));
+    instance_handles_.push_back(info.instance_handle());
+}
+
+void PySampleInfoColumns::add_to(py::dict& columns)
+{
+    columns["info.source_timestamp"] =
+            py::cast(std::move(source_timestamps_));
+    columns["info.reception_timestamp"] =
+            py::cast(std::move(reception_timestamps_));
+    columns["info.instance_handle"] = py::cast(std::move(instance_handles_));
+    if (with_valid_) {
+        columns["info.valid"] = py::cast(std::move(valid_));
+    }
+}
+
+}  // namespace pyrti
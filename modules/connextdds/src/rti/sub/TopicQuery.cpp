@@ -222,24 +222,19 @@ void process_inits<TopicQuery>(py::module& m, ClassInitList& l)
             });
 #endif
 
-    l.push_back([m]() mutable {
-        return init_class<TopicQuerySelection>(m, "TopicQuerySelection");
-    });
+    l.push_back(class_init<TopicQuerySelection>(m, "TopicQuerySelection"));
 
-    l.push_back([m]() mutable {
-        return init_class<
+    l.push_back(class_init<
             TopicQueryData,
             std::unique_ptr<TopicQueryData, no_gil_delete<TopicQueryData>>>(
-                m,
-                "TopicQueryData");
-    });
+            m,
+            "TopicQueryData"));
 
-    l.push_back([m]() mutable { 
-        return init_class<
+    l.push_back(class_init<
             TopicQuery,
             std::unique_ptr<TopicQuery, no_gil_delete<TopicQuery>>>(
-                m,
-                "TopicQuery"); });
+            m,
+            "TopicQuery"));
 }
 
 }  // namespace pyrti
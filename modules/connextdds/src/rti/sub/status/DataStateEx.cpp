@@ -199,9 +199,7 @@ void process_inits<DataStateEx>(py::module& m, ClassInitList& l)
         return [cls]() mutable { init_class_defs<StreamKind>(cls); };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<DataStateEx>(m, "DataStateEx");
-    });
+    l.push_back(class_init<DataStateEx>(m, "DataStateEx"));
 }
 
 }  // namespace pyrti
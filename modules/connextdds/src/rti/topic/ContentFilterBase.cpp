@@ -25,9 +25,7 @@ void init_class_defs(py::class_<ContentFilterBase>&)
 template<>
 void process_inits<ContentFilterBase>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ContentFilterBase>(m, "ContentFilterBase");
-    });
+    l.push_back(class_init<ContentFilterBase>(m, "ContentFilterBase"));
 }
 
 }  // namespace pyrti
@@ -57,9 +57,7 @@ void init_class_defs(py::class_<ExpressionProperty>& cls)
 template<>
 void process_inits<ExpressionProperty>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<ExpressionProperty>(m, "ExpressionProperty");
-    });
+    l.push_back(class_init<ExpressionProperty>(m, "ExpressionProperty"));
 }
 
 }  // namespace pyrti
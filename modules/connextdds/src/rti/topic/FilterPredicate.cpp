@@ -0,0 +1,617 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyConnext.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <pybind11/stl.h>
+#include "PyFilterPredicate.hpp"
+
+using namespace dds::core::xtypes;
+
+namespace pyrti {
+
+namespace {
+
+bool is_string(const PyFieldValue& value)
+{
+    return value.kind == PyFieldValue::Kind::STRING;
+}
+
+double as_double(const PyFieldValue& value)
+{
+    return value.kind == PyFieldValue::Kind::INTEGER
+            ? static_cast<double>(value.integer)
+            : value.floating;
+}
+
+template<typename T>
+bool apply(PyFilterPredicate::Operator op, const T& left, const T& right)
+{
+    switch (op) {
+    case PyFilterPredicate::Operator::EQ:
+        return left == right;
+    case PyFilterPredicate::Operator::NE:
+        return left != right;
+    case PyFilterPredicate::Operator::LT:
+        return left < right;
+    case PyFilterPredicate::Operator::LE:
+        return left <= right;
+    case PyFilterPredicate::Operator::GT:
+        return left > right;
+    case PyFilterPredicate::Operator::GE:
+        return left >= right;
+    }
+    return false;
+}
+
+// Compares two values of the same category (string or numeric); integers
+// are compared exactly and mixed integer/float values as doubles.
+bool compare(
+        PyFilterPredicate::Operator op,
+        const PyFieldValue& left,
+        const PyFieldValue& right)
+{
+    if (is_string(left)) {
+        return apply(op, left.string, right.string);
+    }
+
+    if (left.kind == PyFieldValue::Kind::INTEGER
+        && right.kind == PyFieldValue::Kind::INTEGER) {
+        return apply(op, left.integer, right.integer);
+    }
+
+    return apply(op, as_double(left), as_double(right));
+}
+
+bool less_than(const PyFieldValue& left, const PyFieldValue& right)
+{
+    return compare(PyFilterPredicate::Operator::LT, left, right);
+}
+
+bool is_comparable_kind(TypeKind::inner_enum kind)
+{
+    switch (kind) {
+    case TypeKind::BOOLEAN_TYPE:
+    case TypeKind::CHAR_8_TYPE:
+    case TypeKind::UINT_8_TYPE:
+    case TypeKind::INT_16_TYPE:
+    case TypeKind::UINT_16_TYPE:
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::UINT_32_TYPE:
+    case TypeKind::INT_64_TYPE:
+    case TypeKind::UINT_64_TYPE:
+    case TypeKind::FLOAT_32_TYPE:
+    case TypeKind::FLOAT_64_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+    case TypeKind::STRING_TYPE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void check_same_category(const std::vector<PyFieldValue>& values)
+{
+    for (const auto& value : values) {
+        if (is_string(value) != is_string(values.front())) {
+            throw py::type_error(
+                    "Strings and numbers can't be mixed in a predicate");
+        }
+        if (!is_string(value) && value.kind == PyFieldValue::Kind::FLOAT
+            && std::isnan(value.floating)) {
+            throw py::value_error("NaN can't be used in a predicate");
+        }
+    }
+}
+
+const char* operator_symbol(PyFilterPredicate::Operator op)
+{
+    switch (op) {
+    case PyFilterPredicate::Operator::EQ:
+        return "==";
+    case PyFilterPredicate::Operator::NE:
+        return "!=";
+    case PyFilterPredicate::Operator::LT:
+        return "<";
+    case PyFilterPredicate::Operator::LE:
+        return "<=";
+    case PyFilterPredicate::Operator::GT:
+        return ">";
+    case PyFilterPredicate::Operator::GE:
+        return ">=";
+    }
+    return "?";
+}
+
+std::string value_to_string(const PyFieldValue& value)
+{
+    std::ostringstream out;
+    switch (value.kind) {
+    case PyFieldValue::Kind::INTEGER:
+        out << value.integer;
+        break;
+    case PyFieldValue::Kind::FLOAT:
+        out << value.floating;
+        break;
+    case PyFieldValue::Kind::STRING:
+        out << "'" << value.string << "'";
+        break;
+    }
+    return out.str();
+}
+
+PyFieldValue to_field_value(const py::handle& obj)
+{
+    PyFieldValue value;
+    if (py::isinstance<py::str>(obj)) {
+        value.kind = PyFieldValue::Kind::STRING;
+        value.string = py::cast<std::string>(obj);
+    } else if (py::isinstance<py::float_>(obj)) {
+        value.kind = PyFieldValue::Kind::FLOAT;
+        value.floating = py::cast<double>(obj);
+    } else if (py::isinstance<py::int_>(obj)) {
+        // Includes bool and IntEnum
+        value.kind = PyFieldValue::Kind::INTEGER;
+        try {
+            value.integer = py::cast<int64_t>(obj);
+        } catch (const py::cast_error&) {
+            throw py::value_error("Integer value out of the int64 range");
+        }
+    } else {
+        throw py::type_error(
+                "A predicate value must be a bool, int, float or str, not "
+                + py::cast<std::string>(py::str(obj.get_type())));
+    }
+    check_same_category({ value });
+    return value;
+}
+
+}  // namespace
+
+PyFilterPredicate::Ptr PyFilterPredicate::comparison(
+        const std::string& path,
+        Operator op,
+        const PyFieldValue& value)
+{
+    Ptr predicate(new PyFilterPredicate(Kind::COMPARISON));
+    predicate->path_ = path;
+    predicate->op_ = op;
+    predicate->values_.push_back(value);
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::range(
+        const std::string& path,
+        const PyFieldValue& low,
+        const PyFieldValue& high)
+{
+    Ptr predicate(new PyFilterPredicate(Kind::RANGE));
+    predicate->path_ = path;
+    predicate->values_ = { low, high };
+    check_same_category(predicate->values_);
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::membership(
+        const std::string& path,
+        std::vector<PyFieldValue> values)
+{
+    if (!values.empty()) {
+        check_same_category(values);
+    }
+
+    Ptr predicate(new PyFilterPredicate(Kind::MEMBERSHIP));
+    predicate->path_ = path;
+    predicate->values_ = std::move(values);
+    std::sort(
+            predicate->values_.begin(),
+            predicate->values_.end(),
+            less_than);
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::logical_and(
+        const Ptr& left,
+        const Ptr& right)
+{
+    Ptr predicate(new PyFilterPredicate(Kind::AND));
+    predicate->operands_ = { left, right };
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::logical_or(
+        const Ptr& left,
+        const Ptr& right)
+{
+    Ptr predicate(new PyFilterPredicate(Kind::OR));
+    predicate->operands_ = { left, right };
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::logical_not(const Ptr& operand)
+{
+    Ptr predicate(new PyFilterPredicate(Kind::NOT));
+    predicate->operands_ = { operand };
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::constant(bool value)
+{
+    Ptr predicate(new PyFilterPredicate(Kind::CONSTANT));
+    predicate->constant_ = value;
+    return predicate;
+}
+
+PyFilterPredicate::Ptr PyFilterPredicate::bind(const DynamicType& type) const
+{
+    Ptr bound(new PyFilterPredicate(*this));
+    bound->type_ = type;
+
+    switch (kind_) {
+    case Kind::COMPARISON:
+    case Kind::RANGE:
+    case Kind::MEMBERSHIP: {
+        bound->accessor_ = PyFieldAccessor::compile(type, path_);
+        auto kind = bound->accessor_->kind();
+        if (!is_comparable_kind(kind)) {
+            throw dds::core::InvalidArgumentError(
+                    "'" + path_
+                    + "' is not a primitive, enum or string member and "
+                      "can't be used in a predicate");
+        }
+        bool string_member = kind == TypeKind::STRING_TYPE;
+        for (const auto& value : values_) {
+            if (is_string(value) != string_member) {
+                throw dds::core::InvalidArgumentError(
+                        "'" + path_ + "' can't be compared to "
+                        + value_to_string(value));
+            }
+        }
+        break;
+    }
+    case Kind::AND:
+    case Kind::OR:
+    case Kind::NOT:
+        for (auto& operand : bound->operands_) {
+            operand = operand->bind(type);
+        }
+        break;
+    case Kind::CONSTANT:
+        break;
+    }
+
+    return bound;
+}
+
+bool PyFilterPredicate::evaluate_leaf(DynamicData& data) const
+{
+    PyFieldValue value;
+    if (!accessor_->get_value(data, value)) {
+        return false;
+    }
+
+    switch (kind_) {
+    case Kind::COMPARISON:
+        return compare(op_, value, values_[0]);
+    case Kind::RANGE:
+        return compare(Operator::GE, value, values_[0])
+                && compare(Operator::LE, value, values_[1]);
+    case Kind::MEMBERSHIP:
+        return std::binary_search(
+                values_.begin(),
+                values_.end(),
+                value,
+                less_than);
+    default:
+        return false;
+    }
+}
+
+bool PyFilterPredicate::evaluate(DynamicData& data) const
+{
+    switch (kind_) {
+    case Kind::AND:
+        return operands_[0]->evaluate(data) && operands_[1]->evaluate(data);
+    case Kind::OR:
+        return operands_[0]->evaluate(data) || operands_[1]->evaluate(data);
+    case Kind::NOT:
+        return !operands_[0]->evaluate(data);
+    case Kind::CONSTANT:
+        return constant_;
+    default:
+        return evaluate_leaf(data);
+    }
+}
+
+bool PyFilterPredicate::is_bound() const
+{
+    return type_.has_value();
+}
+
+const DynamicType& PyFilterPredicate::type() const
+{
+    return type_.get();
+}
+
+std::string PyFilterPredicate::to_string() const
+{
+    std::ostringstream out;
+    switch (kind_) {
+    case Kind::COMPARISON:
+        out << path_ << " " << operator_symbol(op_) << " "
+            << value_to_string(values_[0]);
+        break;
+    case Kind::RANGE:
+        out << path_ << " BETWEEN " << value_to_string(values_[0]) << " AND "
+            << value_to_string(values_[1]);
+        break;
+    case Kind::MEMBERSHIP: {
+        out << path_ << " IN (";
+        for (size_t i = 0; i < values_.size(); i++) {
+            out << (i > 0 ? ", " : "") << value_to_string(values_[i]);
+        }
+        out << ")";
+        break;
+    }
+    case Kind::AND:
+        out << "(" << operands_[0]->to_string() << " AND "
+            << operands_[1]->to_string() << ")";
+        break;
+    case Kind::OR:
+        out << "(" << operands_[0]->to_string() << " OR "
+            << operands_[1]->to_string() << ")";
+        break;
+    case Kind::NOT:
+        out << "NOT " << operands_[0]->to_string();
+        break;
+    case Kind::CONSTANT:
+        out << (constant_ ? "TRUE" : "FALSE");
+        break;
+    }
+    return out.str();
+}
+
+PyPredicateCompileData& PyPredicateContentFilter::compile(
+        const std::string& expression,
+        const std::vector<std::string>& parameters,
+        const dds::core::optional<DynamicType>& type_code,
+        const std::string& type_class_name,
+        PyPredicateCompileData* old_compile_data)
+{
+    if (!type_code.has_value()) {
+        throw dds::core::PreconditionNotMetError(
+                "A PredicateContentFilter requires the type of the topic");
+    }
+
+    py::gil_scoped_acquire acquire;
+    auto predicate = compile_predicate(
+            expression,
+            parameters,
+            type_code,
+            type_class_name);
+    if (predicate == nullptr) {
+        throw dds::core::InvalidArgumentError(
+                "PredicateContentFilter.compile() must return a "
+                "FilterPredicate");
+    }
+
+    auto compile_data = new PyPredicateCompileData(predicate->bind(type_code.get()));
+    if (nullptr != old_compile_data) {
+        delete old_compile_data;
+    }
+    return *compile_data;
+}
+
+bool PyPredicateContentFilter::evaluate(
+        PyPredicateCompileData& compile_data,
+        const DynamicData& sample,
+        const rti::topic::FilterSampleInfo&)
+{
+    // Loaning the nested members doesn't modify the value of the sample
+    try {
+        return compile_data->evaluate(const_cast<DynamicData&>(sample));
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void PyPredicateContentFilter::finalize(PyPredicateCompileData& compile_data)
+{
+    delete &compile_data;
+}
+
+template<>
+void init_class_defs(py::class_<PyFilterField>& cls)
+{
+    using Operator = PyFilterPredicate::Operator;
+
+    cls.def(py::init([](const std::string& path) {
+                return PyFilterField { path };
+            }),
+            py::arg("path"),
+            "Create a field for a member path, such as \"a.b[2].c\", to build "
+            "a FilterPredicate.")
+            .def_property_readonly(
+                    "path",
+                    [](const PyFilterField& field) { return field.path; },
+                    "The member path.")
+            .def("__eq__",
+                 [](const PyFilterField& field, py::object value) {
+                     return PyFilterPredicate::comparison(
+                             field.path,
+                             Operator::EQ,
+                             to_field_value(value));
+                 },
+                 py::is_operator())
+            .def("__ne__",
+                 [](const PyFilterField& field, py::object value) {
+                     return PyFilterPredicate::comparison(
+                             field.path,
+                             Operator::NE,
+                             to_field_value(value));
+                 },
+                 py::is_operator())
+            .def("__lt__",
+                 [](const PyFilterField& field, py::object value) {
+                     return PyFilterPredicate::comparison(
+                             field.path,
+                             Operator::LT,
+                             to_field_value(value));
+                 },
+                 py::is_operator())
+            .def("__le__",
+                 [](const PyFilterField& field, py::object value) {
+                     return PyFilterPredicate::comparison(
+                             field.path,
+                             Operator::LE,
+                             to_field_value(value));
+                 },
+                 py::is_operator())
+            .def("__gt__",
+                 [](const PyFilterField& field, py::object value) {
+                     return PyFilterPredicate::comparison(
+                             field.path,
+                             Operator::GT,
+                             to_field_value(value));
+                 },
+                 py::is_operator())
+            .def("__ge__",
+                 [](const PyFilterField& field, py::object value) {
+                     return PyFilterPredicate::comparison(
+                             field.path,
+                             Operator::GE,
+                             to_field_value(value));
+                 },
+                 py::is_operator())
+            .def("between",
+                 [](const PyFilterField& field,
+                    py::object low,
+                    py::object high) {
+                     return PyFilterPredicate::range(
+                             field.path,
+                             to_field_value(low),
+                             to_field_value(high));
+                 },
+                 py::arg("low"),
+                 py::arg("high"),
+                 "A predicate that is true when the member is within the "
+                 "inclusive range [low, high].")
+            .def("isin",
+                 [](const PyFilterField& field, py::iterable values) {
+                     std::vector<PyFieldValue> field_values;
+                     for (auto value : values) {
+                         field_values.push_back(to_field_value(value));
+                     }
+                     return PyFilterPredicate::membership(
+                             field.path,
+                             std::move(field_values));
+                 },
+                 py::arg("values"),
+                 "A predicate that is true when the member is equal to one of "
+                 "the values.")
+            .def("__repr__", [](const PyFilterField& field) {
+                return "FilterField('" + field.path + "')";
+            });
+}
+
+template<>
+void init_class_defs(
+        py::class_<PyFilterPredicate, std::shared_ptr<PyFilterPredicate>>& cls)
+{
+    cls.def_static(
+               "constant",
+               &PyFilterPredicate::constant,
+               py::arg("value"),
+               "A predicate that is always true or always false.")
+            .def("__and__",
+                 &PyFilterPredicate::logical_and,
+                 py::is_operator())
+            .def("__or__", &PyFilterPredicate::logical_or, py::is_operator())
+            .def("__invert__",
+                 [](const PyFilterPredicate::Ptr& predicate) {
+                     return PyFilterPredicate::logical_not(predicate);
+                 })
+            .def("__bool__",
+                 [](const PyFilterPredicate&) -> bool {
+                     throw py::type_error(
+                             "A FilterPredicate has no truth value; use &, | "
+                             "and ~ instead of and, or and not");
+                 })
+            .def("bind",
+                 &PyFilterPredicate::bind,
+                 py::arg("type"),
+                 "Resolve the member paths of this predicate for a type. The "
+                 "predicate returned can evaluate samples of that type.")
+            .def_property_readonly(
+                    "is_bound",
+                    &PyFilterPredicate::is_bound,
+                    "Whether this predicate has been bound to a type.")
+            .def("evaluate",
+                 [](const PyFilterPredicate& predicate, DynamicData& data) {
+                     if (!predicate.is_bound()) {
+                         return predicate.bind(data.type())->evaluate(data);
+                     }
+                     if (!(predicate.type() == data.type())) {
+                         throw dds::core::InvalidArgumentError(
+                                 "The data is not of the type this predicate "
+                                 "is bound to");
+                     }
+                     return predicate.evaluate(data);
+                 },
+                 py::arg("data"),
+                 "Evaluate this predicate on a sample, binding it to the type "
+                 "of the sample if it is not bound.")
+            .def("__repr__", [](const PyFilterPredicate& predicate) {
+                return "FilterPredicate(" + predicate.to_string() + ")";
+            });
+}
+
+template<>
+void init_class_defs(
+        py::class_<
+                PyPredicateContentFilter,
+                rti::topic::ContentFilterBase,
+                PyPredicateContentFilterTrampoline>& cls)
+{
+    cls.def(py::init<>())
+            .def("compile",
+                 &PyPredicateContentFilter::compile_predicate,
+                 py::arg("expression"),
+                 py::arg("parameters"),
+                 py::arg("type_code"),
+                 py::arg("type_class_name"),
+                 "Create the FilterPredicate for a filter expression and "
+                 "parameters. The predicate is bound to type_code and "
+                 "evaluated natively for each sample, without the GIL.");
+}
+
+template<>
+void process_inits<PyFilterPredicate>(py::module& m, ClassInitList& l)
+{
+    l.push_back(class_init<PyFilterField>(m, "FilterField"));
+
+    l.push_back(class_init<
+            PyFilterPredicate,
+            std::shared_ptr<PyFilterPredicate>>(
+            m,
+            "FilterPredicate"));
+
+    l.push_back(class_init<
+            PyPredicateContentFilter,
+            rti::topic::ContentFilterBase,
+            PyPredicateContentFilterTrampoline>(
+            m,
+            "PredicateContentFilter"));
+}
+
+}  // namespace pyrti
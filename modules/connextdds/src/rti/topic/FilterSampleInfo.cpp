@@ -38,9 +38,7 @@ void init_class_defs(py::class_<FilterSampleInfo>& cls)
 template<>
 void process_inits<FilterSampleInfo>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<FilterSampleInfo>(m, "FilterSampleInfo");
-    });
+    l.push_back(class_init<FilterSampleInfo>(m, "FilterSampleInfo"));
 }
 
 }  // namespace pyrti
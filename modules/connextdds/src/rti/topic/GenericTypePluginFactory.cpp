@@ -14,6 +14,8 @@
 #include <rti/core/constants.hpp>
 
 #include "IdlTypeSupport.hpp"
+#include "PyInterpreterLocal.hpp"
+#include "PyTypeFactoryReference.hpp"
 
 using namespace rti::core::xtypes;
 using namespace rti::topic::cdr;
@@ -21,6 +23,108 @@ using timestamp = std::chrono::time_point<std::chrono::system_clock>;
 
 namespace pyrti {
 
+// The GenericTypePluginFactory instances and the TypeCode factory are
+// process-wide, so they're shared by all the interpreters of the process,
+// which don't share a GIL when they're subinterpreters with their own GIL.
+struct TypeFactoryState {
+    std::mutex mutex;
+    // The number of interpreters that use the factories
+    size_t interpreter_count = 0;
+    // The number of caches that hold DynamicTypes (PyTypeFactoryReference)
+    size_t reference_count = 0;
+    // The factories were released by all the interpreters while a cache
+    // still held DynamicTypes
+    bool delete_pending = false;
+};
+
+// Never destroyed, since the factories can be used until the process exits
+static TypeFactoryState& type_factory_state()
+{
+    static auto state = new TypeFactoryState();
+    return *state;
+}
+
+// Serializes the calls to the factories (a py::call_guard)
+class TypeFactoryGuard {
+public:
+    TypeFactoryGuard() : lock_(type_factory_state().mutex)
+    {
+    }
+
+private:
+    std::lock_guard<std::mutex> lock_;
+};
+
+struct TypeFactoryInterpreterState {
+    bool in_use = false;
+};
+
+static TypeFactoryInterpreterState& type_factory_interpreter_state()
+{
+    return interpreter_local<TypeFactoryInterpreterState>(
+            "rti.connextdds.type_factory");
+}
+
+// Counts the current interpreter as a user of the factories
+static void acquire_type_factory()
+{
+    auto& interpreter_state = type_factory_interpreter_state();
+    std::lock_guard<std::mutex> lock(type_factory_state().mutex);
+    if (!interpreter_state.in_use) {
+        interpreter_state.in_use = true;
+        type_factory_state().interpreter_count++;
+    }
+    type_factory_state().delete_pending = false;
+}
+
+// @pre The TypeFactoryState mutex must be held
+static void delete_type_factories()
+{
+    type_factory_state().delete_pending = false;
+    GenericTypePluginFactory::delete_instance();
+    DDS_TypeCodeFactory_finalize_instance();
+}
+
+// Stops counting the current interpreter as a user of the factories, and
+// deletes them if no other interpreter or cache uses them
+static void release_type_factory()
+{
+    auto& interpreter_state = type_factory_interpreter_state();
+    auto& state = type_factory_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (interpreter_state.in_use) {
+        interpreter_state.in_use = false;
+        state.interpreter_count--;
+    }
+    if (state.interpreter_count > 0) {
+        return;
+    }
+    if (state.reference_count > 0) {
+        // The last PyTypeFactoryReference deletes them
+        state.delete_pending = true;
+    } else {
+        delete_type_factories();
+    }
+}
+
+PyTypeFactoryReference::PyTypeFactoryReference()
+{
+    auto& state = type_factory_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.reference_count++;
+}
+
+PyTypeFactoryReference::~PyTypeFactoryReference()
+{
+    auto& state = type_factory_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.reference_count--;
+    if (state.reference_count == 0 && state.delete_pending
+        && state.interpreter_count == 0) {
+        delete_type_factories();
+    }
+}
+
 static dds::core::xtypes::ArrayType* create_array_type(
         rti::topic::cdr::GenericTypePluginFactory& factory,
         const dds::core::xtypes::DynamicType& element_type,
@@ -52,7 +156,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                                             type_size,
                                             member_offsets),
                                     nullptr };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_struct",
             [](GenericTypePluginFactory& self,
@@ -72,7 +177,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                                             type_size,
                                             member_offsets),
                                     nullptr };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_union",
             [](GenericTypePluginFactory& self,
@@ -88,7 +194,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                                             type_size,
                                             member_offsets),
                                     nullptr };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_alias",
             [](GenericTypePluginFactory& self,
@@ -100,7 +207,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                                             related_type,
                                             type_size),
                                     nullptr };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_alias",
             [](GenericTypePluginFactory& self,
@@ -112,7 +220,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                                             *related_type_holder.type,
                                             type_size),
                                     nullptr };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_sequence",
             [](GenericTypePluginFactory& self,
@@ -122,7 +231,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                     self.create_sequence(element_type, bound),
                     nullptr
                 };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_array",
             [](GenericTypePluginFactory& self,
@@ -130,7 +240,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                     const std::vector<uint32_t>& dimensions) {
                 return TypePlugin { create_array_type(self, element_type, dimensions),
                                     nullptr };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_array",
             [](GenericTypePluginFactory& self,
@@ -140,7 +251,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                     create_array_type(self, *type_holder.type, dimensions),
                     nullptr
                 };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def("create_enum",
             [](GenericTypePluginFactory& self,
@@ -151,7 +263,8 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                     self.create_enum(name, extensibility, members),
                     nullptr
                 };
-            });
+            },
+            py::call_guard<TypeFactoryGuard>());
 
     cls.def(
             "add_member",
@@ -172,6 +285,7 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                         is_optional,
                         is_external);
             },
+            py::call_guard<TypeFactoryGuard>(),
             py::arg("type"),
             py::arg("name"),
             py::arg("member_type"),
@@ -199,6 +313,7 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                         is_optional,
                         is_external);
             },
+            py::call_guard<TypeFactoryGuard>(),
             py::arg("type"),
             py::arg("name"),
             py::arg("member_type"),
@@ -224,6 +339,7 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                         id,
                         is_external);
             },
+            py::call_guard<TypeFactoryGuard>(),
             py::arg("type"),
             py::arg("name"),
             py::arg("member_type"),
@@ -248,6 +364,7 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                         id,
                         is_external);
             },
+            py::call_guard<TypeFactoryGuard>(),
             py::arg("type"),
             py::arg("name"),
             py::arg("member_type"),
@@ -263,40 +380,35 @@ void init_class_defs(py::class_<GenericTypePluginFactory>& cls)
                         factory.create_type_plugin(*type_holder.type);
                 type_holder.type_plugin = &plugin;
             },
+            py::call_guard<TypeFactoryGuard>(),
             py::arg("type"));
 
     cls.def_property_readonly_static(
             "instance",
             [](py::object&) -> GenericTypePluginFactory& {
+                acquire_type_factory();
                 return GenericTypePluginFactory::instance();
             });
 
     cls.def_property_readonly_static(
             "public_instance",
             [](py::object&) -> GenericTypePluginFactory& {
+                acquire_type_factory();
                 return GenericTypePluginFactory::no_accessor_instance();
             });
 
-    cls.def_static("delete_instance", []() {
-        GenericTypePluginFactory::delete_instance();
-        DDS_TypeCodeFactory_finalize_instance();
-    });
+    // Only deletes the factories when no other interpreter uses them
+    cls.def_static("delete_instance", &release_type_factory);
 }
 
 template<>
 void process_inits<GenericTypePluginFactory>(py::module& m, ClassInitList& l)
 {
-    l.push_back([m]() mutable {
-        return init_class<GenericTypePluginFactory>(
-                m,
-                "_GenericTypePluginFactory");
-    });
-
-    l.push_back([m]() mutable {
-        return init_class<TypePlugin>(
-                m,
-                "_TypePlugin");
-    });
+    l.push_back(class_init<GenericTypePluginFactory>(
+            m,
+            "_GenericTypePluginFactory"));
+
+    l.push_back(class_init<TypePlugin>(m, "_TypePlugin"));
 }
 
 }  // namespace pyrti
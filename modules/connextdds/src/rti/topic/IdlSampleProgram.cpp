@@ -0,0 +1,1760 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyConnext.hpp"
+#include "IdlSampleProgram.hpp"
+#include "IdlTypeSupport.hpp"
+#include "PyDynamicDataPrimitives.hpp"
+
+#include "osapi/osapi_heap.h"
+
+using namespace rti::topic::cdr;
+using namespace dds::core::xtypes;
+
+namespace pyrti {
+
+// Same value as rti.idl_impl.annotations.UNBOUNDED
+static const uint32_t IDL_UNBOUNDED_LENGTH = 0x7FFFFFFF;
+
+// Locks the result of PySequence_Fast while its items are borrowed with
+// PySequence_Fast_ITEMS. Without the GIL (free-threaded builds) another
+// thread could otherwise resize the list and free the item array. Unlike
+// Py_BEGIN_CRITICAL_SECTION, it's released when an exception is thrown.
+class PySequenceFastLock {
+public:
+    explicit PySequenceFastLock(PyObject* fast_sequence)
+    {
+#ifdef Py_GIL_DISABLED
+        PyCriticalSection_Begin(&section_, fast_sequence);
+#else
+        (void) fast_sequence;
+#endif
+    }
+
+    ~PySequenceFastLock()
+    {
+#ifdef Py_GIL_DISABLED
+        PyCriticalSection_End(&section_);
+#endif
+    }
+
+    PySequenceFastLock(const PySequenceFastLock&) = delete;
+    PySequenceFastLock& operator=(const PySequenceFastLock&) = delete;
+
+private:
+#ifdef Py_GIL_DISABLED
+    PyCriticalSection section_;
+#endif
+};
+
+size_t native_primitive_size(NativePrimitiveKind kind)
+{
+    switch (kind) {
+    case NativePrimitiveKind::INT8:
+    case NativePrimitiveKind::UINT8:
+        return 1;
+    case NativePrimitiveKind::INT16:
+    case NativePrimitiveKind::UINT16:
+        return 2;
+    case NativePrimitiveKind::INT32:
+    case NativePrimitiveKind::UINT32:
+    case NativePrimitiveKind::FLOAT32:
+        return 4;
+    case NativePrimitiveKind::INT64:
+    case NativePrimitiveKind::UINT64:
+    case NativePrimitiveKind::FLOAT64:
+        return 8;
+    }
+
+    return 0;
+}
+
+const char* native_primitive_format(NativePrimitiveKind kind)
+{
+    switch (kind) {
+    case NativePrimitiveKind::INT8:
+        return "b";
+    case NativePrimitiveKind::UINT8:
+        return "B";
+    case NativePrimitiveKind::INT16:
+        return "h";
+    case NativePrimitiveKind::UINT16:
+        return "H";
+    case NativePrimitiveKind::INT32:
+        return "i";
+    case NativePrimitiveKind::UINT32:
+        return "I";
+    case NativePrimitiveKind::INT64:
+        return "q";
+    case NativePrimitiveKind::UINT64:
+        return "Q";
+    case NativePrimitiveKind::FLOAT32:
+        return "f";
+    case NativePrimitiveKind::FLOAT64:
+        return "d";
+    }
+
+    return "B";
+}
+
+// Sets the Python error indicator and throws it as a C++ exception
+[[noreturn]] static void throw_python_error(
+        PyObject* error_type,
+        const std::string& message)
+{
+    PyErr_SetString(error_type, message.c_str());
+    throw py::error_already_set();
+}
+
+// Replaces the current Python error with a FieldSerializationError whose
+// cause is the original error, as the Python SampleProgram does.
+[[noreturn]] static void throw_field_serialization_error(
+        const py::str& field_name)
+{
+    PyObject* type = nullptr;
+    PyObject* value = nullptr;
+    PyObject* traceback = nullptr;
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_NormalizeException(&type, &value, &traceback);
+    if (traceback != nullptr && value != nullptr) {
+        PyException_SetTraceback(value, traceback);
+    }
+    Py_XDECREF(type);
+    Py_XDECREF(traceback);
+
+    py::object error_type =
+            py::module::import("rti.idl_impl.sample_interpreter")
+                    .attr("FieldSerializationError");
+    py::object error = error_type(field_name);
+    if (value != nullptr) {
+        // Both calls steal a reference
+        Py_INCREF(value);
+        PyException_SetContext(error.ptr(), value);
+        PyException_SetCause(error.ptr(), value);
+    }
+
+    PyErr_SetObject(error_type.ptr(), error.ptr());
+    throw py::error_already_set();
+}
+
+template<typename T>
+static void store(char* dst, T value)
+{
+    memcpy(dst, &value, sizeof(T));
+}
+
+// Converts a Python int or float into a primitive in the C sample. Integers
+// are truncated to the size of the member, like ctypes does.
+static void copy_primitive(
+        NativePrimitiveKind kind,
+        PyObject* py_value,
+        char* dst)
+{
+    if (kind == NativePrimitiveKind::FLOAT32
+            || kind == NativePrimitiveKind::FLOAT64) {
+        double value = PyFloat_AsDouble(py_value);
+        if (value == -1.0 && PyErr_Occurred()) {
+            throw py::error_already_set();
+        }
+
+        if (kind == NativePrimitiveKind::FLOAT32) {
+            store(dst, static_cast<float>(value));
+        } else {
+            store(dst, value);
+        }
+        return;
+    }
+
+    // Objects that implement __index__, such as NumPy integer scalars, are
+    // accepted like ctypes does
+    auto py_int = py::reinterpret_steal<py::object>(PyNumber_Index(py_value));
+    if (!py_int) {
+        PyErr_Clear();
+        throw_python_error(
+                PyExc_TypeError,
+                std::string("int expected instead of ")
+                        + Py_TYPE(py_value)->tp_name);
+    }
+
+    unsigned long long value = PyLong_AsUnsignedLongLongMask(py_int.ptr());
+    if (value == static_cast<unsigned long long>(-1) && PyErr_Occurred()) {
+        throw py::error_already_set();
+    }
+
+    switch (kind) {
+    case NativePrimitiveKind::INT8:
+    case NativePrimitiveKind::UINT8:
+        store(dst, static_cast<uint8_t>(value));
+        break;
+    case NativePrimitiveKind::INT16:
+    case NativePrimitiveKind::UINT16:
+        store(dst, static_cast<uint16_t>(value));
+        break;
+    case NativePrimitiveKind::INT32:
+    case NativePrimitiveKind::UINT32:
+        store(dst, static_cast<uint32_t>(value));
+        break;
+    default:
+        store(dst, static_cast<uint64_t>(value));
+        break;
+    }
+}
+
+// Copies a Python collection of primitives into a contiguous C buffer with
+// room for length elements. Objects that support the buffer protocol are
+// copied with a memcpy; lists and other sequences element by element, unless
+// require_buffer is set.
+static void copy_primitive_elements(
+        NativePrimitiveKind kind,
+        PyObject* py_member,
+        char* dst,
+        size_t length,
+        bool require_buffer)
+{
+    size_t element_size = native_primitive_size(kind);
+
+    if (require_buffer || PyObject_CheckBuffer(py_member)) {
+        PyCTypesBuffer buffer(py::reinterpret_borrow<py::object>(py_member));
+        if (static_cast<size_t>(buffer.py_buffer.len)
+                != element_size * length) {
+            throw_python_error(
+                    PyExc_ValueError,
+                    "Source buffer size doesn't match destination buffer "
+                    "size");
+        }
+
+        memcpy(dst, buffer.py_buffer.buf, element_size * length);
+        return;
+    }
+
+    auto fast_sequence = py::reinterpret_steal<py::object>(
+            PySequence_Fast(py_member, "Expected a sequence"));
+    if (!fast_sequence) {
+        throw py::error_already_set();
+    }
+
+    PySequenceFastLock lock(fast_sequence.ptr());
+    if (static_cast<size_t>(PySequence_Fast_GET_SIZE(fast_sequence.ptr()))
+        != length) {
+        throw_python_error(
+                PyExc_RuntimeError,
+                "The sequence changed size while it was being copied");
+    }
+
+    PyObject** items = PySequence_Fast_ITEMS(fast_sequence.ptr());
+    for (size_t i = 0; i < length; i++) {
+        copy_primitive(kind, items[i], dst + i * element_size);
+    }
+}
+
+// Copies a Python str into a C string or wstring, reallocating it if it's
+// unbounded. Bounded strings are preallocated by the type plugin.
+static void copy_string(
+        PyObject* py_member,
+        char** c_member,
+        uint32_t bound,
+        bool is_wide)
+{
+    if (!PyUnicode_Check(py_member)) {
+        throw_python_error(
+                PyExc_TypeError,
+                std::string("str expected instead of ")
+                        + Py_TYPE(py_member)->tp_name);
+    }
+
+    const char* bytes = nullptr;
+    Py_ssize_t byte_count = 0;
+    py::object encoded;
+    if (is_wide) {
+        encoded = py::reinterpret_steal<py::object>(
+                PyUnicode_AsEncodedString(py_member, "utf-16-le", "strict"));
+        if (!encoded) {
+            throw py::error_already_set();
+        }
+        bytes = PyBytes_AS_STRING(encoded.ptr());
+        byte_count = PyBytes_GET_SIZE(encoded.ptr());
+    } else {
+        bytes = PyUnicode_AsUTF8AndSize(py_member, &byte_count);
+        if (bytes == nullptr) {
+            throw py::error_already_set();
+        }
+    }
+
+    // char_length doesn't include the null terminator
+    size_t bytes_per_char = is_wide ? sizeof(RTIXCdrWchar) : 1;
+    size_t char_length = static_cast<size_t>(byte_count) / bytes_per_char;
+
+    if (bound == IDL_UNBOUNDED_LENGTH) {
+        if (is_wide) {
+            RTIXCdrWchar* str_ptr = reinterpret_cast<RTIXCdrWchar*>(*c_member);
+            RTIOsapiHeap_reallocateArray(
+                    &str_ptr,
+                    char_length + sizeof(RTIXCdrWchar),
+                    RTIXCdrWchar);
+            *c_member = reinterpret_cast<char*>(str_ptr);
+        } else {
+            RTIOsapiHeap_reallocateString(c_member, char_length);
+        }
+
+        if (*c_member == nullptr) {
+            throw std::bad_alloc();
+        }
+    } else if (char_length > bound) {
+        throw_python_error(
+                PyExc_ValueError,
+                "String length (" + std::to_string(char_length)
+                        + ") exceeds bound (" + std::to_string(bound) + ")");
+    }
+
+    memcpy(*c_member, bytes, byte_count);
+    (*c_member)[byte_count] = 0;
+    if (is_wide) {
+        (*c_member)[byte_count + 1] = 0;
+    }
+}
+
+static size_t get_length(PyObject* py_member)
+{
+    Py_ssize_t length = PyObject_Size(py_member);
+    if (length < 0) {
+        throw py::error_already_set();
+    }
+
+    return static_cast<size_t>(length);
+}
+
+static void check_array_length(size_t expected, size_t actual)
+{
+    if (expected != actual) {
+        throw_python_error(
+                PyExc_ValueError,
+                "Expected array length of " + std::to_string(expected)
+                        + " but got " + std::to_string(actual));
+    }
+}
+
+template<typename T>
+static T load(const char* src)
+{
+    T value;
+    memcpy(&value, src, sizeof(T));
+    return value;
+}
+
+// Creates a Python int or float from a primitive in the C sample
+static py::object primitive_to_py(NativePrimitiveKind kind, const char* src)
+{
+    PyObject* result = nullptr;
+    switch (kind) {
+    case NativePrimitiveKind::INT8:
+        result = PyLong_FromLong(load<int8_t>(src));
+        break;
+    case NativePrimitiveKind::UINT8:
+        result = PyLong_FromUnsignedLong(load<uint8_t>(src));
+        break;
+    case NativePrimitiveKind::INT16:
+        result = PyLong_FromLong(load<int16_t>(src));
+        break;
+    case NativePrimitiveKind::UINT16:
+        result = PyLong_FromUnsignedLong(load<uint16_t>(src));
+        break;
+    case NativePrimitiveKind::INT32:
+        result = PyLong_FromLong(load<int32_t>(src));
+        break;
+    case NativePrimitiveKind::UINT32:
+        result = PyLong_FromUnsignedLong(load<uint32_t>(src));
+        break;
+    case NativePrimitiveKind::INT64:
+        result = PyLong_FromLongLong(load<int64_t>(src));
+        break;
+    case NativePrimitiveKind::UINT64:
+        result = PyLong_FromUnsignedLongLong(load<uint64_t>(src));
+        break;
+    case NativePrimitiveKind::FLOAT32:
+        result = PyFloat_FromDouble(load<float>(src));
+        break;
+    case NativePrimitiveKind::FLOAT64:
+        result = PyFloat_FromDouble(load<double>(src));
+        break;
+    }
+
+    if (result == nullptr) {
+        throw py::error_already_set();
+    }
+
+    return py::reinterpret_steal<py::object>(result);
+}
+
+// Creates a Python str from a C string or wstring
+static py::object string_to_py(const char* c_member, bool is_wide)
+{
+    PyObject* result = nullptr;
+    if (is_wide) {
+        auto wstr = reinterpret_cast<const RTIXCdrWchar*>(c_member);
+        size_t char_length = 0;
+        while (wstr[char_length] != 0) {
+            char_length++;
+        }
+
+        int byte_order = -1;  // little endian, as in utf-16-le
+        result = PyUnicode_DecodeUTF16(
+                c_member,
+                char_length * sizeof(RTIXCdrWchar),
+                "strict",
+                &byte_order);
+    } else {
+        result = PyUnicode_DecodeUTF8(c_member, strlen(c_member), "strict");
+    }
+
+    if (result == nullptr) {
+        throw py::error_already_set();
+    }
+
+    return py::reinterpret_steal<py::object>(result);
+}
+
+// True if a primitive member, or the elements of a primitive array or
+// sequence member, can be copied between a C sample and a DynamicData sample
+// of the struct type. This is checked when the programs are compiled so that
+// copy_from_dynamic_data and copy_to_dynamic_data never fail because of the
+// kind of a member.
+static bool is_copyable_primitive_member(
+        const rti::core::xtypes::DynamicTypeImpl& type,
+        const std::string& member_name,
+        bool is_collection)
+{
+    DynamicData data(type);
+    auto info = data.member_info(member_name);
+    auto kind = is_collection ? info.element_kind() : info.member_kind();
+    return is_primitive_member_kind(kind.underlying());
+}
+
+void NativeSampleProgram::add_primitive(
+        const std::string& field_name,
+        size_t offset,
+        NativePrimitiveKind kind)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PRIMITIVE;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = kind;
+    instructions_.push_back(std::move(instruction));
+
+    if (dynamic_data_copyable_
+        && !is_copyable_primitive_member(*type_, field_name, false)) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeSampleProgram::add_string(
+        const std::string& field_name,
+        size_t offset,
+        uint32_t bound,
+        bool is_wide)
+{
+    Instruction instruction;
+    instruction.kind =
+            is_wide ? InstructionKind::WSTRING : InstructionKind::STRING;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.length = bound;
+    instructions_.push_back(std::move(instruction));
+
+    if (is_wide) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeSampleProgram::add_struct(
+        const std::string& field_name,
+        size_t offset,
+        std::shared_ptr<NativeSampleProgram> program)
+{
+    if (program == nullptr || !program->is_complete()) {
+        throw dds::core::PreconditionNotMetError(
+                "Only a complete program can be nested");
+    }
+
+    if (!program->can_copy_dynamic_data()) {
+        dynamic_data_copyable_ = false;
+    }
+
+    Instruction instruction;
+    instruction.kind = InstructionKind::STRUCT;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.element_program = std::move(program);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeSampleProgram::add_primitive_array(
+        const std::string& field_name,
+        size_t offset,
+        NativePrimitiveKind kind,
+        uint32_t length,
+        bool require_buffer)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PRIMITIVE_ARRAY;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = kind;
+    instruction.length = length;
+    instruction.element_size = native_primitive_size(kind);
+    instruction.require_buffer = require_buffer;
+    instructions_.push_back(std::move(instruction));
+
+    if (dynamic_data_copyable_
+        && !is_copyable_primitive_member(*type_, field_name, true)) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeSampleProgram::add_primitive_sequence(
+        const std::string& field_name,
+        size_t offset,
+        NativePrimitiveKind kind,
+        uint32_t member_index,
+        bool require_buffer)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PRIMITIVE_SEQUENCE;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = kind;
+    instruction.length = member_index;
+    instruction.element_size = native_primitive_size(kind);
+    instruction.require_buffer = require_buffer;
+    instructions_.push_back(std::move(instruction));
+
+    if (dynamic_data_copyable_
+        && !is_copyable_primitive_member(*type_, field_name, true)) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeSampleProgram::add_struct_array(
+        const std::string& field_name,
+        size_t offset,
+        std::shared_ptr<NativeSampleProgram> element_program,
+        size_t element_size,
+        uint32_t length)
+{
+    if (element_program == nullptr || !element_program->is_complete()) {
+        throw dds::core::PreconditionNotMetError(
+                "Only a complete program can be nested");
+    }
+
+    if (!element_program->can_copy_dynamic_data()) {
+        dynamic_data_copyable_ = false;
+    }
+
+    Instruction instruction;
+    instruction.kind = InstructionKind::STRUCT_ARRAY;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.length = length;
+    instruction.element_size = element_size;
+    instruction.element_program = std::move(element_program);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeSampleProgram::add_struct_sequence(
+        const std::string& field_name,
+        size_t offset,
+        std::shared_ptr<NativeSampleProgram> element_program,
+        size_t element_size,
+        uint32_t member_index)
+{
+    if (element_program == nullptr || !element_program->is_complete()) {
+        throw dds::core::PreconditionNotMetError(
+                "Only a complete program can be nested");
+    }
+
+    if (!element_program->can_copy_dynamic_data()) {
+        dynamic_data_copyable_ = false;
+    }
+
+    Instruction instruction;
+    instruction.kind = InstructionKind::STRUCT_SEQUENCE;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.length = member_index;
+    instruction.element_size = element_size;
+    instruction.element_program = std::move(element_program);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeSampleProgram::add_fallback(
+        const std::string& field_name,
+        py::object program)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PYTHON_FALLBACK;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.fallback = program.attr("execute");
+    instructions_.push_back(std::move(instruction));
+    fallback_count_++;
+}
+
+void NativeSampleProgram::resize_sequence(
+        const Instruction& instruction,
+        char* c_sample,
+        CSequenceLayout& sequence,
+        uint32_t new_size) const
+{
+    // Same logic as CopyListToCInstruction.resize_sequence_member
+    bool resize_member = false;
+    if (sequence._absolute_maximum == IDL_UNBOUNDED_LENGTH) {
+        // Unbounded sequences may need to be resized
+        if (new_size <= sequence._maximum) {
+            sequence._length = new_size;
+        } else if (new_size != sequence._length) {
+            resize_member = true;
+        }
+    } else if (sequence._maximum == 0 && new_size != 0) {
+        // This sequence is not initialized
+        resize_member = true;
+    } else if (new_size > sequence._maximum) {
+        throw_python_error(
+                PyExc_ValueError,
+                "Native sequence capacity (" + std::to_string(sequence._maximum)
+                        + ") is smaller than the requested length ("
+                        + std::to_string(new_size) + ")");
+    } else {
+        sequence._length = new_size;
+    }
+
+    if (resize_member) {
+        type_plugin_->resize_member(
+                *reinterpret_cast<CSampleWrapper*>(c_sample),
+                instruction.length,
+                new_size);
+    }
+}
+
+void NativeSampleProgram::execute_instruction(
+        const Instruction& instruction,
+        char* c_sample,
+        PyObject* py_member) const
+{
+    char* c_member = c_sample + instruction.offset;
+
+    switch (instruction.kind) {
+    case InstructionKind::PRIMITIVE:
+        copy_primitive(instruction.primitive_kind, py_member, c_member);
+        break;
+
+    case InstructionKind::STRING:
+    case InstructionKind::WSTRING:
+        copy_string(
+                py_member,
+                reinterpret_cast<char**>(c_member),
+                instruction.length,
+                instruction.kind == InstructionKind::WSTRING);
+        break;
+
+    case InstructionKind::STRUCT:
+        instruction.element_program->execute(
+                c_member,
+                py_member,
+                py::handle());
+        break;
+
+    case InstructionKind::PRIMITIVE_ARRAY: {
+        size_t length = get_length(py_member);
+        check_array_length(instruction.length, length);
+        copy_primitive_elements(
+                instruction.primitive_kind,
+                py_member,
+                c_member,
+                length,
+                instruction.require_buffer);
+        break;
+    }
+
+    case InstructionKind::PRIMITIVE_SEQUENCE: {
+        auto& sequence = *reinterpret_cast<CSequenceLayout*>(c_member);
+        size_t length = get_length(py_member);
+        resize_sequence(
+                instruction,
+                c_sample,
+                sequence,
+                static_cast<uint32_t>(length));
+        if (length > 0) {
+            copy_primitive_elements(
+                    instruction.primitive_kind,
+                    py_member,
+                    static_cast<char*>(sequence._contiguous_buffer),
+                    length,
+                    instruction.require_buffer);
+        }
+        break;
+    }
+
+    case InstructionKind::STRUCT_ARRAY:
+    case InstructionKind::STRUCT_SEQUENCE: {
+        auto fast_sequence = py::reinterpret_steal<py::object>(
+                PySequence_Fast(py_member, "Expected a sequence"));
+        if (!fast_sequence) {
+            throw py::error_already_set();
+        }
+        PySequenceFastLock lock(fast_sequence.ptr());
+        size_t length = PySequence_Fast_GET_SIZE(fast_sequence.ptr());
+
+        char* elements = c_member;
+        if (instruction.kind == InstructionKind::STRUCT_ARRAY) {
+            check_array_length(instruction.length, length);
+        } else {
+            auto& sequence = *reinterpret_cast<CSequenceLayout*>(c_member);
+            resize_sequence(
+                    instruction,
+                    c_sample,
+                    sequence,
+                    static_cast<uint32_t>(length));
+            elements = static_cast<char*>(sequence._contiguous_buffer);
+        }
+
+        PyObject** items = PySequence_Fast_ITEMS(fast_sequence.ptr());
+        for (size_t i = 0; i < length; i++) {
+            instruction.element_program->execute(
+                    elements + i * instruction.element_size,
+                    items[i],
+                    py::handle());
+        }
+        break;
+    }
+
+    case InstructionKind::PYTHON_FALLBACK:
+        // Handled by execute()
+        break;
+    }
+}
+
+void NativeSampleProgram::execute(
+        char* c_sample,
+        py::handle py_sample,
+        py::handle c_sample_object) const
+{
+    for (const auto& instruction : instructions_) {
+        if (instruction.kind == InstructionKind::PYTHON_FALLBACK) {
+            // The Python SampleProgram raises its own FieldSerializationError
+            instruction.fallback(c_sample_object, py_sample);
+            continue;
+        }
+
+        try {
+            auto py_member = py::reinterpret_steal<py::object>(
+                    PyObject_GetAttr(
+                            py_sample.ptr(),
+                            instruction.field_name.ptr()));
+            if (!py_member) {
+                throw py::error_already_set();
+            }
+
+            execute_instruction(instruction, c_sample, py_member.ptr());
+        } catch (py::error_already_set& ex) {
+            ex.restore();
+            throw_field_serialization_error(instruction.field_name);
+        } catch (const py::builtin_exception& ex) {
+            ex.set_error();
+            throw_field_serialization_error(instruction.field_name);
+        } catch (const std::exception& ex) {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            throw_field_serialization_error(instruction.field_name);
+        }
+    }
+}
+
+void NativeCToPySampleProgram::add_primitive(
+        const std::string& field_name,
+        size_t offset,
+        NativePrimitiveKind kind)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PRIMITIVE;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = kind;
+    instructions_.push_back(std::move(instruction));
+
+    if (dynamic_data_copyable_
+        && !is_copyable_primitive_member(*type_, field_name, false)) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeCToPySampleProgram::add_enum(
+        const std::string& field_name,
+        size_t offset,
+        py::object enum_type)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::ENUM;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = NativePrimitiveKind::INT32;
+    instruction.value = enum_type.attr("_value2member_map_");
+    instruction.factory = std::move(enum_type);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeCToPySampleProgram::add_string(
+        const std::string& field_name,
+        size_t offset,
+        bool is_wide,
+        py::object null_value)
+{
+    Instruction instruction;
+    instruction.kind =
+            is_wide ? InstructionKind::WSTRING : InstructionKind::STRING;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.value = std::move(null_value);
+    instructions_.push_back(std::move(instruction));
+
+    if (is_wide) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeCToPySampleProgram::add_struct(
+        const std::string& field_name,
+        size_t offset,
+        std::shared_ptr<NativeCToPySampleProgram> program)
+{
+    if (program == nullptr || !program->is_complete()) {
+        throw dds::core::PreconditionNotMetError(
+                "Only a complete program can be nested");
+    }
+
+    if (!program->can_copy_dynamic_data()) {
+        dynamic_data_copyable_ = false;
+    }
+
+    Instruction instruction;
+    instruction.kind = InstructionKind::STRUCT;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.element_program = std::move(program);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeCToPySampleProgram::add_primitive_array(
+        const std::string& field_name,
+        size_t offset,
+        NativePrimitiveKind kind,
+        uint32_t length,
+        CollectionKind collection_kind,
+        py::object factory)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PRIMITIVE_ARRAY;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = kind;
+    instruction.length = length;
+    instruction.element_size = native_primitive_size(kind);
+    instruction.collection_kind = collection_kind;
+    instruction.factory = std::move(factory);
+    instructions_.push_back(std::move(instruction));
+
+    if (dynamic_data_copyable_
+        && !is_copyable_primitive_member(*type_, field_name, true)) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeCToPySampleProgram::add_primitive_sequence(
+        const std::string& field_name,
+        size_t offset,
+        NativePrimitiveKind kind,
+        CollectionKind collection_kind,
+        py::object factory)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PRIMITIVE_SEQUENCE;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.primitive_kind = kind;
+    instruction.element_size = native_primitive_size(kind);
+    instruction.collection_kind = collection_kind;
+    instruction.factory = std::move(factory);
+    instructions_.push_back(std::move(instruction));
+
+    if (dynamic_data_copyable_
+        && !is_copyable_primitive_member(*type_, field_name, true)) {
+        dynamic_data_copyable_ = false;
+    }
+}
+
+void NativeCToPySampleProgram::add_struct_array(
+        const std::string& field_name,
+        size_t offset,
+        std::shared_ptr<NativeCToPySampleProgram> element_program,
+        size_t element_size,
+        uint32_t length)
+{
+    if (element_program == nullptr || !element_program->is_complete()) {
+        throw dds::core::PreconditionNotMetError(
+                "Only a complete program can be nested");
+    }
+
+    if (!element_program->can_copy_dynamic_data()) {
+        dynamic_data_copyable_ = false;
+    }
+
+    Instruction instruction;
+    instruction.kind = InstructionKind::STRUCT_ARRAY;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.length = length;
+    instruction.element_size = element_size;
+    instruction.element_program = std::move(element_program);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeCToPySampleProgram::add_struct_sequence(
+        const std::string& field_name,
+        size_t offset,
+        std::shared_ptr<NativeCToPySampleProgram> element_program,
+        size_t element_size)
+{
+    if (element_program == nullptr || !element_program->is_complete()) {
+        throw dds::core::PreconditionNotMetError(
+                "Only a complete program can be nested");
+    }
+
+    if (!element_program->can_copy_dynamic_data()) {
+        dynamic_data_copyable_ = false;
+    }
+
+    Instruction instruction;
+    instruction.kind = InstructionKind::STRUCT_SEQUENCE;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.offset = offset;
+    instruction.element_size = element_size;
+    instruction.element_program = std::move(element_program);
+    instructions_.push_back(std::move(instruction));
+}
+
+void NativeCToPySampleProgram::add_fallback(
+        const std::string& field_name,
+        py::object program)
+{
+    Instruction instruction;
+    instruction.kind = InstructionKind::PYTHON_FALLBACK;
+    instruction.field_name = py::str(field_name);
+    instruction.member_name = field_name;
+    instruction.fallback = program.attr("execute");
+    instructions_.push_back(std::move(instruction));
+    fallback_count_++;
+}
+
+py::object NativeCToPySampleProgram::create_primitive_collection(
+        const Instruction& instruction,
+        const char* elements,
+        size_t length) const
+{
+    if (instruction.collection_kind == CollectionKind::LIST) {
+        py::list result(length);
+        for (size_t i = 0; i < length; i++) {
+            // PyList_SET_ITEM steals the reference
+            PyList_SET_ITEM(
+                    result.ptr(),
+                    i,
+                    primitive_to_py(
+                            instruction.primitive_kind,
+                            elements + i * instruction.element_size)
+                            .release()
+                            .ptr());
+        }
+        return std::move(result);
+    }
+
+    py::object result;
+    switch (instruction.collection_kind) {
+    case CollectionKind::RESIZABLE_BUFFER:
+        result = instruction.factory();
+        if (length > 0) {
+            result.attr("resize")(length);
+        }
+        break;
+    case CollectionKind::EXTENDABLE_BUFFER:
+        result = instruction.factory();
+        if (length > 0) {
+            // Same as extend(itertools.repeat(0, length))
+            py::list zero;
+            zero.append(0);
+            auto zeros = py::reinterpret_steal<py::object>(
+                    PySequence_Repeat(zero.ptr(), length));
+            if (!zeros) {
+                throw py::error_already_set();
+            }
+            result.attr("extend")(zeros);
+        }
+        break;
+    case CollectionKind::SIZED_BUFFER:
+        result = length > 0 ? instruction.factory(length)
+                            : instruction.factory();
+        break;
+    default:
+        result = instruction.factory();
+        break;
+    }
+
+    if (length > 0) {
+        // Same as core_utils.memcpy_to_buffer_object
+        PyCTypesBuffer buffer(result);
+        size_t size = instruction.element_size * length;
+        if (static_cast<size_t>(buffer.py_buffer.len) != size) {
+            throw_python_error(
+                    PyExc_ValueError,
+                    "Destination buffer size doesn't match source buffer "
+                    "size");
+        }
+        memcpy(buffer.py_buffer.buf, elements, size);
+    }
+
+    return result;
+}
+
+py::object NativeCToPySampleProgram::execute_instruction(
+        const Instruction& instruction,
+        const char* c_sample) const
+{
+    const char* c_member = c_sample + instruction.offset;
+
+    switch (instruction.kind) {
+    case InstructionKind::PRIMITIVE:
+        return primitive_to_py(instruction.primitive_kind, c_member);
+
+    case InstructionKind::ENUM: {
+        py::object int_value =
+                primitive_to_py(NativePrimitiveKind::INT32, c_member);
+#if PY_VERSION_HEX >= 0x030D0000
+        // A strong reference, in case another thread changes the dict
+        // (free-threaded builds)
+        PyObject* enum_value = nullptr;
+        if (PyDict_GetItemRef(
+                    instruction.value.ptr(),
+                    int_value.ptr(),
+                    &enum_value)
+            < 0) {
+            throw py::error_already_set();
+        }
+        if (enum_value != nullptr) {
+            return py::reinterpret_steal<py::object>(enum_value);
+        }
+#else
+        PyObject* enum_value =
+                PyDict_GetItemWithError(instruction.value.ptr(), int_value.ptr());
+        if (enum_value != nullptr) {
+            return py::reinterpret_borrow<py::object>(enum_value);
+        }
+        if (PyErr_Occurred()) {
+            throw py::error_already_set();
+        }
+#endif
+
+        try {
+            return instruction.factory(int_value);
+        } catch (py::error_already_set&) {
+            // Allow unknown enumerators as integers, as
+            // CopyInt32ToIntEnumInstruction does
+            return int_value;
+        }
+    }
+
+    case InstructionKind::STRING:
+    case InstructionKind::WSTRING: {
+        const char* str = *reinterpret_cast<char* const*>(c_member);
+        if (str == nullptr) {
+            return instruction.value;
+        }
+        return string_to_py(str, instruction.kind == InstructionKind::WSTRING);
+    }
+
+    case InstructionKind::STRUCT:
+        return instruction.element_program->create_sample(c_member);
+
+    case InstructionKind::PRIMITIVE_ARRAY:
+        return create_primitive_collection(
+                instruction,
+                c_member,
+                instruction.length);
+
+    case InstructionKind::PRIMITIVE_SEQUENCE: {
+        auto& sequence = *reinterpret_cast<const CSequenceLayout*>(c_member);
+        return create_primitive_collection(
+                instruction,
+                static_cast<const char*>(sequence._contiguous_buffer),
+                sequence._length);
+    }
+
+    case InstructionKind::STRUCT_ARRAY:
+    case InstructionKind::STRUCT_SEQUENCE: {
+        const char* elements = c_member;
+        size_t length = instruction.length;
+        if (instruction.kind == InstructionKind::STRUCT_SEQUENCE) {
+            auto& sequence =
+                    *reinterpret_cast<const CSequenceLayout*>(c_member);
+            elements = static_cast<const char*>(sequence._contiguous_buffer);
+            length = sequence._length;
+        }
+
+        py::list result(length);
+        for (size_t i = 0; i < length; i++) {
+            PyList_SET_ITEM(
+                    result.ptr(),
+                    i,
+                    instruction.element_program
+                            ->create_sample(
+                                    elements + i * instruction.element_size)
+                            .release()
+                            .ptr());
+        }
+        return std::move(result);
+    }
+
+    case InstructionKind::PYTHON_FALLBACK:
+        // Handled by create_sample()
+        break;
+    }
+
+    return py::none();
+}
+
+py::object NativeCToPySampleProgram::create_sample(const char* c_sample) const
+{
+    bool use_dict = construct_empty_ && fallback_count_ == 0;
+
+    py::object py_sample;
+    py::object dict;
+    if (use_dict) {
+        // Create the instance without calling __init__; all its members will
+        // be set by the instructions.
+        auto type = reinterpret_cast<PyTypeObject*>(py_type_.ptr());
+        py::tuple no_args;
+        py_sample = py::reinterpret_steal<py::object>(
+                type->tp_new(type, no_args.ptr(), nullptr));
+        if (!py_sample) {
+            throw py::error_already_set();
+        }
+
+        dict = py::reinterpret_steal<py::object>(
+                PyObject_GenericGetDict(py_sample.ptr(), nullptr));
+        if (!dict) {
+            throw py::error_already_set();
+        }
+    } else {
+        py_sample = py_type_();
+    }
+
+    // ctypes object created the first time a fallback instruction needs it
+    py::object c_sample_object;
+
+    for (const auto& instruction : instructions_) {
+        if (instruction.kind == InstructionKind::PYTHON_FALLBACK) {
+            if (!c_sample_object) {
+                // We pass the pointer as an integer, because that's what
+                // ctypes.cast expects.
+                c_sample_object =
+                        cast_c_sample_(reinterpret_cast<size_t>(c_sample));
+            }
+
+            // The Python SampleProgram raises its own FieldSerializationError
+            instruction.fallback(py_sample, c_sample_object);
+            continue;
+        }
+
+        try {
+            py::object py_member = execute_instruction(instruction, c_sample);
+            int result = use_dict
+                    ? PyDict_SetItem(
+                            dict.ptr(),
+                            instruction.field_name.ptr(),
+                            py_member.ptr())
+                    : PyObject_SetAttr(
+                            py_sample.ptr(),
+                            instruction.field_name.ptr(),
+                            py_member.ptr());
+            if (result != 0) {
+                throw py::error_already_set();
+            }
+        } catch (py::error_already_set& ex) {
+            ex.restore();
+            throw_field_serialization_error(instruction.field_name);
+        } catch (const py::builtin_exception& ex) {
+            ex.set_error();
+            throw_field_serialization_error(instruction.field_name);
+        } catch (const std::exception& ex) {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            throw_field_serialization_error(instruction.field_name);
+        }
+    }
+
+    return py_sample;
+}
+
+bool NativeCToPySampleProgram::find_member(
+        const std::string& member_path,
+        NativeMemberLocation& location) const
+{
+    auto separator = member_path.find('.');
+    std::string name = member_path.substr(0, separator);
+
+    for (const auto& instruction : instructions_) {
+        if (py::cast<std::string>(instruction.field_name) != name) {
+            continue;
+        }
+
+        if (separator != std::string::npos) {
+            if (instruction.kind != InstructionKind::STRUCT
+                || !instruction.element_program->find_member(
+                        member_path.substr(separator + 1),
+                        location)) {
+                return false;
+            }
+            location.offset += instruction.offset;
+            return true;
+        }
+
+        switch (instruction.kind) {
+        case InstructionKind::PRIMITIVE:
+        case InstructionKind::ENUM:
+            location.kind = NativeMemberLocation::Kind::PRIMITIVE;
+            break;
+        case InstructionKind::PRIMITIVE_ARRAY:
+            location.kind = NativeMemberLocation::Kind::ARRAY;
+            break;
+        case InstructionKind::PRIMITIVE_SEQUENCE:
+            location.kind = NativeMemberLocation::Kind::SEQUENCE;
+            break;
+        default:
+            return false;
+        }
+
+        location.offset = instruction.offset;
+        location.primitive_kind = instruction.primitive_kind;
+        location.length = instruction.length;
+        return true;
+    }
+
+    return false;
+}
+
+// Element kind of an array or sequence member, for get/set_primitive_buffer
+static TypeKind::inner_enum get_element_kind(
+        const DynamicData& data,
+        const std::string& name)
+{
+    return data.member_info(name).element_kind().underlying();
+}
+
+// Copies a std::string into a C string, reallocating it if it's unbounded,
+// like copy_string does for a Python str
+static void copy_std_string(
+        const std::string& value,
+        char** c_member,
+        uint32_t bound)
+{
+    if (bound == IDL_UNBOUNDED_LENGTH) {
+        RTIOsapiHeap_reallocateString(c_member, value.size());
+        if (*c_member == nullptr) {
+            throw std::bad_alloc();
+        }
+    } else if (value.size() > bound) {
+        throw dds::core::InvalidArgumentError(
+                "String length (" + std::to_string(value.size())
+                + ") exceeds bound (" + std::to_string(bound) + ")");
+    }
+
+    memcpy(*c_member, value.data(), value.size());
+    (*c_member)[value.size()] = 0;
+}
+
+static void throw_not_directly_copyable()
+{
+    throw dds::core::UnsupportedError(
+            "Type can't be copied directly between DynamicData and C");
+}
+
+void NativeSampleProgram::copy_from_dynamic_data(
+        DynamicData& data,
+        char* c_sample) const
+{
+    if (!can_copy_dynamic_data()) {
+        throw_not_directly_copyable();
+    }
+
+    for (const auto& instruction : instructions_) {
+        const std::string& name = instruction.member_name;
+        char* c_member = c_sample + instruction.offset;
+
+        switch (instruction.kind) {
+        case InstructionKind::PRIMITIVE:
+            read_primitive_member(
+                    data,
+                    data.member_info(name).member_kind().underlying(),
+                    data.member_index(name),
+                    c_member);
+            break;
+
+        case InstructionKind::STRING:
+            copy_std_string(
+                    data.value<std::string>(name),
+                    reinterpret_cast<char**>(c_member),
+                    instruction.length);
+            break;
+
+        case InstructionKind::STRUCT: {
+            auto loan = data.loan_value(name);
+            instruction.element_program->copy_from_dynamic_data(
+                    loan.get(),
+                    c_member);
+            break;
+        }
+
+        case InstructionKind::PRIMITIVE_ARRAY:
+            get_primitive_buffer(
+                    data,
+                    get_element_kind(data, name),
+                    name,
+                    c_member,
+                    instruction.length);
+            break;
+
+        case InstructionKind::PRIMITIVE_SEQUENCE: {
+            auto info = data.member_info(name);
+            uint32_t length = info.element_count();
+            auto& sequence = *reinterpret_cast<CSequenceLayout*>(c_member);
+            resize_sequence(instruction, c_sample, sequence, length);
+            if (length > 0) {
+                get_primitive_buffer(
+                        data,
+                        info.element_kind().underlying(),
+                        name,
+                        static_cast<char*>(sequence._contiguous_buffer),
+                        length);
+            }
+            break;
+        }
+
+        case InstructionKind::STRUCT_ARRAY:
+        case InstructionKind::STRUCT_SEQUENCE: {
+            char* elements = c_member;
+            uint32_t length = instruction.length;
+            if (instruction.kind == InstructionKind::STRUCT_SEQUENCE) {
+                length = data.member_info(name).element_count();
+                auto& sequence =
+                        *reinterpret_cast<CSequenceLayout*>(c_member);
+                resize_sequence(instruction, c_sample, sequence, length);
+                elements = static_cast<char*>(sequence._contiguous_buffer);
+            }
+
+            auto collection = data.loan_value(name);
+            for (uint32_t i = 0; i < length; i++) {
+                auto element = collection.get().loan_value(i + 1);
+                instruction.element_program->copy_from_dynamic_data(
+                        element.get(),
+                        elements + i * instruction.element_size);
+            }
+            break;
+        }
+
+        case InstructionKind::WSTRING:
+        case InstructionKind::PYTHON_FALLBACK:
+            // Not reached: can_copy_dynamic_data() is false
+            throw_not_directly_copyable();
+        }
+    }
+}
+
+void NativeCToPySampleProgram::copy_to_dynamic_data(
+        const char* c_sample,
+        DynamicData& data) const
+{
+    if (!can_copy_dynamic_data()) {
+        throw_not_directly_copyable();
+    }
+
+    // Source of empty collections, which may not have a buffer
+    static const char no_elements[sizeof(uint64_t)] = {};
+
+    for (const auto& instruction : instructions_) {
+        const std::string& name = instruction.member_name;
+        const char* c_member = c_sample + instruction.offset;
+
+        switch (instruction.kind) {
+        case InstructionKind::PRIMITIVE:
+        case InstructionKind::ENUM:
+            write_primitive_member(
+                    data,
+                    data.member_info(name).member_kind().underlying(),
+                    data.member_index(name),
+                    c_member);
+            break;
+
+        case InstructionKind::STRING: {
+            const char* str = *reinterpret_cast<char* const*>(c_member);
+            data.value<std::string>(name, str != nullptr ? str : "");
+            break;
+        }
+
+        case InstructionKind::STRUCT: {
+            auto loan = data.loan_value(name);
+            instruction.element_program->copy_to_dynamic_data(
+                    c_member,
+                    loan.get());
+            break;
+        }
+
+        case InstructionKind::PRIMITIVE_ARRAY:
+        case InstructionKind::PRIMITIVE_SEQUENCE: {
+            const char* elements = c_member;
+            uint32_t length = instruction.length;
+            if (instruction.kind == InstructionKind::PRIMITIVE_SEQUENCE) {
+                auto& sequence =
+                        *reinterpret_cast<const CSequenceLayout*>(c_member);
+                elements = static_cast<const char*>(
+                        sequence._contiguous_buffer);
+                length = sequence._length;
+            }
+
+            set_primitive_buffer(
+                    data,
+                    get_element_kind(data, name),
+                    name,
+                    length > 0 ? elements : no_elements,
+                    length);
+            break;
+        }
+
+        case InstructionKind::STRUCT_ARRAY:
+        case InstructionKind::STRUCT_SEQUENCE: {
+            const char* elements = c_member;
+            uint32_t length = instruction.length;
+            if (instruction.kind == InstructionKind::STRUCT_SEQUENCE) {
+                auto& sequence =
+                        *reinterpret_cast<const CSequenceLayout*>(c_member);
+                elements = static_cast<const char*>(
+                        sequence._contiguous_buffer);
+                length = sequence._length;
+            }
+
+            // Sequence elements are added as they're loaned
+            auto collection = data.loan_value(name);
+            for (uint32_t i = 0; i < length; i++) {
+                auto element = collection.get().loan_value(i + 1);
+                instruction.element_program->copy_to_dynamic_data(
+                        elements + i * instruction.element_size,
+                        element.get());
+            }
+            break;
+        }
+
+        case InstructionKind::WSTRING:
+        case InstructionKind::PYTHON_FALLBACK:
+            // Not reached: can_copy_dynamic_data() is false
+            throw_not_directly_copyable();
+        }
+    }
+}
+
+template<>
+void init_class_defs(
+        py::class_<NativeSampleProgram, std::shared_ptr<NativeSampleProgram>>&
+                cls)
+{
+    cls.def(py::init([](const TypePlugin& type_plugin) {
+                return std::make_shared<NativeSampleProgram>(
+                        type_plugin.type_plugin,
+                        type_plugin.type);
+            }),
+            py::arg("type_plugin"));
+
+    cls.def("add_primitive",
+            &NativeSampleProgram::add_primitive,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("kind"));
+
+    cls.def("add_string",
+            &NativeSampleProgram::add_string,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("bound"),
+            py::arg("is_wide"));
+
+    cls.def("add_struct",
+            &NativeSampleProgram::add_struct,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("program"));
+
+    cls.def("add_primitive_array",
+            &NativeSampleProgram::add_primitive_array,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("kind"),
+            py::arg("length"),
+            py::arg("require_buffer") = false);
+
+    cls.def("add_primitive_sequence",
+            &NativeSampleProgram::add_primitive_sequence,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("kind"),
+            py::arg("member_index"),
+            py::arg("require_buffer") = false);
+
+    cls.def("add_struct_array",
+            &NativeSampleProgram::add_struct_array,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("element_program"),
+            py::arg("element_size"),
+            py::arg("length"));
+
+    cls.def("add_struct_sequence",
+            &NativeSampleProgram::add_struct_sequence,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("element_program"),
+            py::arg("element_size"),
+            py::arg("member_index"));
+
+    cls.def("add_fallback",
+            &NativeSampleProgram::add_fallback,
+            py::arg("field_name"),
+            py::arg("program"));
+
+    // Used by TypeSupport to convert samples outside of a DataWriter (e.g. in
+    // TypeSupport.serialize)
+    cls.def(
+            "execute",
+            [](const NativeSampleProgram& self,
+               py::object c_sample,
+               py::object py_sample) {
+                PyCTypesBuffer c_sample_buffer(c_sample);
+                self.execute(
+                        static_cast<char*>(c_sample_buffer.py_buffer.buf),
+                        py_sample,
+                        c_sample);
+            },
+            py::arg("c_sample"),
+            py::arg("py_sample"));
+
+    cls.def_property_readonly(
+            "is_complete",
+            &NativeSampleProgram::is_complete,
+            "True if this program doesn't require any Python fallback "
+            "instruction");
+
+    cls.def_property_readonly(
+            "fallback_count",
+            &NativeSampleProgram::fallback_count);
+
+    cls.def_property_readonly(
+            "can_copy_dynamic_data",
+            &NativeSampleProgram::can_copy_dynamic_data,
+            "True if DynamicData samples can be copied directly by this "
+            "program, without serializing them");
+
+    cls.def("__len__", &NativeSampleProgram::instruction_count);
+}
+
+template<>
+void process_inits<NativeSampleProgram>(py::module& m, ClassInitList& l)
+{
+    l.push_back([m]() mutable {
+        py::class_<NativeSampleProgram, std::shared_ptr<NativeSampleProgram>>
+                cls(m, "_NativeSampleProgram");
+
+        py::enum_<NativePrimitiveKind>(cls, "PrimitiveKind")
+                .value("INT8", NativePrimitiveKind::INT8)
+                .value("UINT8", NativePrimitiveKind::UINT8)
+                .value("INT16", NativePrimitiveKind::INT16)
+                .value("UINT16", NativePrimitiveKind::UINT16)
+                .value("INT32", NativePrimitiveKind::INT32)
+                .value("UINT32", NativePrimitiveKind::UINT32)
+                .value("INT64", NativePrimitiveKind::INT64)
+                .value("UINT64", NativePrimitiveKind::UINT64)
+                .value("FLOAT32", NativePrimitiveKind::FLOAT32)
+                .value("FLOAT64", NativePrimitiveKind::FLOAT64);
+
+        return ([cls]() mutable { init_class_defs<NativeSampleProgram>(cls); });
+    });
+}
+
+template<>
+void init_class_defs(
+        py::class_<
+                NativeCToPySampleProgram,
+                std::shared_ptr<NativeCToPySampleProgram>>& cls)
+{
+    cls.def(py::init([](const TypePlugin& type_plugin,
+                        py::object py_type,
+                        py::object cast_c_sample,
+                        bool construct_empty) {
+                return std::make_shared<NativeCToPySampleProgram>(
+                        type_plugin.type,
+                        std::move(py_type),
+                        std::move(cast_c_sample),
+                        construct_empty);
+            }),
+            py::arg("type_plugin"),
+            py::arg("py_type"),
+            py::arg("cast_c_sample"),
+            py::arg("construct_empty"));
+
+    cls.def("add_primitive",
+            &NativeCToPySampleProgram::add_primitive,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("kind"));
+
+    cls.def("add_enum",
+            &NativeCToPySampleProgram::add_enum,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("enum_type"));
+
+    cls.def("add_string",
+            &NativeCToPySampleProgram::add_string,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("is_wide"),
+            py::arg("null_value"));
+
+    cls.def("add_struct",
+            &NativeCToPySampleProgram::add_struct,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("program"));
+
+    cls.def("add_primitive_array",
+            &NativeCToPySampleProgram::add_primitive_array,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("kind"),
+            py::arg("length"),
+            py::arg("collection_kind"),
+            py::arg("factory"));
+
+    cls.def("add_primitive_sequence",
+            &NativeCToPySampleProgram::add_primitive_sequence,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("kind"),
+            py::arg("collection_kind"),
+            py::arg("factory"));
+
+    cls.def("add_struct_array",
+            &NativeCToPySampleProgram::add_struct_array,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("element_program"),
+            py::arg("element_size"),
+            py::arg("length"));
+
+    cls.def("add_struct_sequence",
+            &NativeCToPySampleProgram::add_struct_sequence,
+            py::arg("field_name"),
+            py::arg("offset"),
+            py::arg("element_program"),
+            py::arg("element_size"));
+
+    cls.def("add_fallback",
+            &NativeCToPySampleProgram::add_fallback,
+            py::arg("field_name"),
+            py::arg("program"));
+
+    // Used by TypeSupport to create samples outside of a DataReader (e.g. in
+    // TypeSupport.deserialize)
+    cls.def(
+            "create_sample",
+            [](const NativeCToPySampleProgram& self, size_t c_sample_ptr) {
+                return self.create_sample(
+                        reinterpret_cast<const char*>(c_sample_ptr));
+            },
+            py::arg("c_sample_ptr"));
+
+    cls.def_property_readonly(
+            "is_complete",
+            &NativeCToPySampleProgram::is_complete,
+            "True if this program doesn't require any Python fallback "
+            "instruction");
+
+    cls.def_property_readonly(
+            "fallback_count",
+            &NativeCToPySampleProgram::fallback_count);
+
+    cls.def_property_readonly(
+            "can_copy_dynamic_data",
+            &NativeCToPySampleProgram::can_copy_dynamic_data,
+            "True if DynamicData samples can be copied directly by this "
+            "program, without serializing them");
+
+    cls.def("__len__", &NativeCToPySampleProgram::instruction_count);
+}
+
+template<>
+void process_inits<NativeCToPySampleProgram>(py::module& m, ClassInitList& l)
+{
+    l.push_back([m]() mutable {
+        py::class_<
+                NativeCToPySampleProgram,
+                std::shared_ptr<NativeCToPySampleProgram>>
+                cls(m, "_NativeCToPySampleProgram");
+
+        py::enum_<NativeCToPySampleProgram::CollectionKind>(
+                cls,
+                "CollectionKind")
+                .value("LIST",
+                       NativeCToPySampleProgram::CollectionKind::LIST)
+                .value("FIXED_SIZE_BUFFER",
+                       NativeCToPySampleProgram::CollectionKind::
+                               FIXED_SIZE_BUFFER)
+                .value("RESIZABLE_BUFFER",
+                       NativeCToPySampleProgram::CollectionKind::
+                               RESIZABLE_BUFFER)
+                .value("EXTENDABLE_BUFFER",
+                       NativeCToPySampleProgram::CollectionKind::
+                               EXTENDABLE_BUFFER)
+                .value("SIZED_BUFFER",
+                       NativeCToPySampleProgram::CollectionKind::SIZED_BUFFER);
+
+        return ([cls]() mutable {
+            init_class_defs<NativeCToPySampleProgram>(cls);
+        });
+    });
+}
+
+}  // namespace pyrti
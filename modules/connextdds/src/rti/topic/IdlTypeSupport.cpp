@@ -9,6 +9,7 @@
  * damages arising out of the use or inability to use the software.
  */
 
+#include <cstring>
 #include <pybind11/numpy.h>
 
 #include "PyConnext.hpp"
@@ -33,6 +34,16 @@ using namespace rti::topic::cdr;
 
 namespace pyrti {
 
+PyPerfStatsSlot& perf_stats_slot(const dds::pub::DataWriter<CSampleWrapper>& writer)
+{
+    return get_py_sample_converter(writer)->perf_stats;
+}
+
+PyPerfStatsSlot& perf_stats_slot(const dds::sub::DataReader<CSampleWrapper>& reader)
+{
+    return get_py_sample_converter(reader)->perf_stats;
+}
+
 DDS_Topic* PyFactoryIdlPluginSupport::create_topic(
         DDS_DomainParticipant* c_participant,
         const char* topic_name,
@@ -266,6 +277,120 @@ static void validate_cdr_buffer_type(const py::buffer_info& info)
     }
 }
 
+// Serializes a sample that has already been converted to C into a buffer that
+// is reused by the calling thread, to avoid allocating one for each sample.
+// The returned reference is valid until the next call in the same thread.
+static const std::vector<char>& serialize_to_scratch_buffer(
+        const TypePlugin& self,
+        CSampleWrapper& c_sample)
+{
+    static thread_local std::vector<char> cdr_buffer;
+    self.type_plugin->serialize_to_cdr_buffer(cdr_buffer, c_sample);
+    return cdr_buffer;
+}
+
+static void check_dynamic_data_type(
+        const TypePlugin& plugin,
+        const DynamicData& data)
+{
+    if (data.type().name() != plugin.type->name()) {
+        throw dds::core::InvalidArgumentError(
+                "DynamicData type (" + data.type().name()
+                + ") doesn't match the IDL type (" + plugin.type->name() + ")");
+    }
+}
+
+void copy_c_sample_to_dynamic_data(
+        const TypePlugin& plugin,
+        CSampleWrapper& c_sample,
+        DynamicData& data,
+        const NativeCToPySampleProgram* native_program)
+{
+    check_dynamic_data_type(plugin, data);
+    data.clear_all_values();
+
+    // Whether the type can be copied directly was decided when the program
+    // was compiled; other errors are not a reason to fall back to CDR
+    if (native_program != nullptr && native_program->can_copy_dynamic_data()) {
+        try {
+            native_program->copy_to_dynamic_data(
+                    reinterpret_cast<const char*>(&c_sample),
+                    data);
+            return;
+        } catch (const dds::core::UnsupportedError&) {
+            // Not directly copyable; use CDR
+        }
+    }
+
+    py::gil_scoped_release release;
+    rti::core::xtypes::from_cdr_buffer(
+            data,
+            serialize_to_scratch_buffer(plugin, c_sample));
+}
+
+void copy_dynamic_data_to_c_sample(
+        const TypePlugin& plugin,
+        DynamicData& data,
+        CSampleWrapper& c_sample,
+        const NativeSampleProgram* native_program)
+{
+    check_dynamic_data_type(plugin, data);
+
+    if (native_program != nullptr && native_program->can_copy_dynamic_data()) {
+        try {
+            native_program->copy_from_dynamic_data(
+                    data,
+                    reinterpret_cast<char*>(&c_sample));
+            return;
+        } catch (const dds::core::UnsupportedError&) {
+            // Not directly copyable; use CDR
+        }
+    }
+
+    py::gil_scoped_release release;
+    static thread_local std::vector<char> cdr_buffer;
+    rti::core::xtypes::to_cdr_buffer(cdr_buffer, data);
+    plugin.type_plugin->deserialize_from_cdr_buffer(
+            c_sample,
+            cdr_buffer.data(),
+            static_cast<unsigned int>(cdr_buffer.size()));
+}
+
+// Copies a serialized sample into a buffer provided by the application and
+// returns the number of bytes copied.
+static size_t copy_to_cdr_buffer(
+        const std::vector<char>& cdr_buffer,
+        const py::buffer_info& buffer_info,
+        size_t offset)
+{
+    const size_t buffer_size = static_cast<size_t>(buffer_info.size);
+    if (offset > buffer_size || cdr_buffer.size() > buffer_size - offset) {
+        throw py::value_error(
+                "Buffer too small: " + std::to_string(cdr_buffer.size())
+                + " bytes are required at offset " + std::to_string(offset)
+                + " but the buffer size is " + std::to_string(buffer_size));
+    }
+
+    std::memcpy(
+            static_cast<char*>(buffer_info.ptr) + offset,
+            cdr_buffer.data(),
+            cdr_buffer.size());
+    return cdr_buffer.size();
+}
+
+// Gets the buffers of a list of C samples. Requires the GIL.
+static std::vector<PyCTypesBuffer> get_c_sample_buffers(
+        const py::list& c_samples)
+{
+    std::vector<PyCTypesBuffer> c_sample_buffers;
+    c_sample_buffers.reserve(c_samples.size());
+    for (auto c_sample : c_samples) {
+        c_sample_buffers.emplace_back(
+                py::reinterpret_borrow<py::object>(c_sample));
+    }
+    return c_sample_buffers;
+}
+
 // This class and methods are internally used (in Python code) by the
 // TypeSupport class
 template<>
@@ -302,20 +427,147 @@ void init_class_defs(py::class_<TypePlugin>& cls)
             py::call_guard<py::gil_scoped_release>());
 
     // Used by TypeSupport.serialize, expects a sample that has already
-    // been converted to C
+    // been converted to C. Returns the CDR buffer as bytes.
     cls.def(
             "serialize",
             [](const TypePlugin& self, py::object c_sample) {
                 PyCTypesBuffer c_sample_buffer(c_sample);
-                std::vector<uint8_t> cdr_buffer;
-                self.type_plugin->serialize_to_cdr_buffer(
-                        reinterpret_cast<std::vector<char>&>(cdr_buffer),
-                        c_sample_buffer);
+                const std::vector<char>* cdr_buffer = nullptr;
+                {
+                    py::gil_scoped_release release;
+                    cdr_buffer =
+                            &serialize_to_scratch_buffer(self, c_sample_buffer);
+                }
+
+                return py::bytes(cdr_buffer->data(), cdr_buffer->size());
+            },
+            py::arg("c_sample"),
+            py::call_guard<py::gil_scoped_acquire>());
+
+    // Used by TypeSupport.serialize_into, serializes a C sample into a
+    // writable buffer starting at a given offset and returns the number of
+    // bytes written
+    cls.def(
+            "serialize_into",
+            [](const TypePlugin& self,
+               py::object c_sample,
+               py::buffer buffer,
+               size_t offset) {
+                auto buffer_info = buffer.request(true /* writable */);
+                validate_cdr_buffer_type<uint8_t>(buffer_info);
+
+                PyCTypesBuffer c_sample_buffer(c_sample);
 
-                return cdr_buffer;
+                py::gil_scoped_release release;
+                return copy_to_cdr_buffer(
+                        serialize_to_scratch_buffer(self, c_sample_buffer),
+                        buffer_info,
+                        offset);
             },
             py::arg("c_sample"),
-            py::call_guard<py::gil_scoped_release>());
+            py::arg("buffer"),
+            py::arg("offset"),
+            py::call_guard<py::gil_scoped_acquire>());
+
+    // Used by TypeSupport.serialize_batch, serializes a list of C samples
+    // back to back and returns the buffer and the offset table (see
+    // serialize_batch_to_buffer)
+    cls.def(
+            "serialize_batch",
+            [](const TypePlugin& self, py::list c_samples) {
+                auto c_sample_buffers = get_c_sample_buffers(c_samples);
+                std::vector<char> cdr_buffer;
+                std::vector<size_t> offsets;
+                {
+                    py::gil_scoped_release release;
+                    offsets.reserve(c_sample_buffers.size() + 1);
+                    for (auto& c_sample : c_sample_buffers) {
+                        offsets.push_back(cdr_buffer.size());
+                        const std::vector<char>& sample_buffer =
+                                serialize_to_scratch_buffer(self, c_sample);
+                        cdr_buffer.insert(
+                                cdr_buffer.end(),
+                                sample_buffer.begin(),
+                                sample_buffer.end());
+                    }
+                    offsets.push_back(cdr_buffer.size());
+                }
+
+                return py::make_tuple(
+                        py::bytes(cdr_buffer.data(), cdr_buffer.size()),
+                        offsets);
+            },
+            py::arg("c_samples"),
+            py::call_guard<py::gil_scoped_acquire>());
+
+    // Used by TypeSupport.serialize_batch_into
+    cls.def(
+            "serialize_batch_into",
+            [](const TypePlugin& self,
+               py::list c_samples,
+               py::buffer buffer,
+               size_t offset) {
+                auto buffer_info = buffer.request(true /* writable */);
+                validate_cdr_buffer_type<uint8_t>(buffer_info);
+
+                auto c_sample_buffers = get_c_sample_buffers(c_samples);
+                std::vector<size_t> offsets;
+                {
+                    py::gil_scoped_release release;
+                    offsets.reserve(c_sample_buffers.size() + 1);
+                    for (auto& c_sample : c_sample_buffers) {
+                        offsets.push_back(offset);
+                        offset += copy_to_cdr_buffer(
+                                serialize_to_scratch_buffer(self, c_sample),
+                                buffer_info,
+                                offset);
+                    }
+                    offsets.push_back(offset);
+                }
+
+                return offsets;
+            },
+            py::arg("c_samples"),
+            py::arg("buffer"),
+            py::arg("offset"),
+            py::call_guard<py::gil_scoped_acquire>());
+
+    // Used by TypeSupport.to_dynamic_data, expects a sample that has already
+    // been converted to C and a DynamicData of the same type
+    cls.def(
+            "to_dynamic_data",
+            [](const TypePlugin& self,
+               py::object c_sample,
+               DynamicData& data,
+               const NativeCToPySampleProgram* native_program) {
+                PyCTypesBuffer c_sample_buffer(c_sample);
+                copy_c_sample_to_dynamic_data(
+                        self,
+                        c_sample_buffer,
+                        data,
+                        native_program);
+            },
+            py::arg("c_sample"),
+            py::arg("data"),
+            py::arg("native_program") = py::none());
+
+    // Used by TypeSupport.from_dynamic_data, expects an initialized C sample
+    cls.def(
+            "from_dynamic_data",
+            [](const TypePlugin& self,
+               DynamicData& data,
+               py::object c_sample,
+               const NativeSampleProgram* native_program) {
+                PyCTypesBuffer c_sample_buffer(c_sample);
+                copy_dynamic_data_to_c_sample(
+                        self,
+                        data,
+                        c_sample_buffer,
+                        native_program);
+            },
+            py::arg("data"),
+            py::arg("c_sample"),
+            py::arg("native_program") = py::none());
 
     // Used by TypeSupport.deserialize, expects a sample that has already been
     // converted to C
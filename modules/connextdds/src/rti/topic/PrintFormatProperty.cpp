@@ -102,9 +102,7 @@ void process_inits<PrintFormatProperty>(py::module& m, ClassInitList& l)
                         .export_values();
             });
 
-    l.push_back([m]() mutable {
-        return init_class<PrintFormatProperty>(m, "PrintFormatProperty");
-    });
+    l.push_back(class_init<PrintFormatProperty>(m, "PrintFormatProperty"));
 }
 
 }  // namespace pyrti
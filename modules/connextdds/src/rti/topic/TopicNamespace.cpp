@@ -13,12 +13,16 @@
 #include <rti/rti.hpp>
 #include <rti/topic/cdr/GenericTypePluginFactory.hpp>
 #include <rti/topic/cdr/GenericTypePlugin.hpp>
+#include "IdlSampleProgram.hpp"
+#include "PyFilterPredicate.hpp"
 
 using namespace rti::topic;
 
 void init_namespace_rti_topic(py::module& m, pyrti::ClassInitList& l, pyrti::DefInitVector&)
 {
     pyrti::process_inits<ContentFilterBase>(m, l);
+    // dds.FilterField, dds.FilterPredicate, dds.PredicateContentFilter
+    pyrti::process_inits<pyrti::PyFilterPredicate>(m, l);
     pyrti::process_inits<ExpressionProperty>(m, l);
     pyrti::process_inits<FilterSampleInfo>(m, l);
     pyrti::process_inits<PrintFormatProperty>(m, l);
@@ -27,6 +31,10 @@ void init_namespace_rti_topic(py::module& m, pyrti::ClassInitList& l, pyrti::Def
     // Factory used to create the DynamicTypes used by the IDL type plugins.
     pyrti::process_inits<rti::topic::cdr::GenericTypePluginFactory>(m, l);
 
+    // Native (compiled) versions of the Python/C sample programs
+    pyrti::process_inits<pyrti::NativeSampleProgram>(m, l);
+    pyrti::process_inits<pyrti::NativeCToPySampleProgram>(m, l);
+
     // Define the IDL-based dds.Topic, dds.DataWriter, dds.DataReader types
     pyrti::process_inits<rti::topic::cdr::CSampleWrapper>(m, l);
 }
\ No newline at end of file
@@ -99,9 +99,7 @@ void process_inits<HeapMonitoringParams>(py::module& m, ClassInitList& l)
                         .export_values();
             });
 
-    l.push_back([m]() mutable {
-        return init_class<HeapMonitoringParams>(m, "HeapMonitoringParams");
-    });
+    l.push_back(class_init<HeapMonitoringParams>(m, "HeapMonitoringParams"));
 }
 #endif
 
@@ -169,9 +169,7 @@ void process_inits<NetworkCaptureParams>(py::module& m, ClassInitList& l)
         };
     });
 
-    l.push_back([m]() mutable {
-        return init_class<NetworkCaptureParams>(m, "NetworkCaptureParams");
-    });
+    l.push_back(class_init<NetworkCaptureParams>(m, "NetworkCaptureParams"));
 }
 
 }  // namespace pyrti
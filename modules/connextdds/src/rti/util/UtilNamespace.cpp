@@ -11,6 +11,7 @@
 
 #include "PyConnext.hpp"
 #include "PyNamespaces.hpp"
+#include "PyModuleInit.hpp"
 #include <rti/rti.hpp>
 
 using namespace rti::util;
@@ -40,6 +41,12 @@ void init_namespace_rti_util(py::module& m, pyrti::ClassInitList& l, pyrti::DefI
     init_heap_monitoring(m, l, v);
 
 #if rti_connext_version_gte(6, 1, 0, 0)
-    init_network_capture(m, l, v);
+    pyrti::register_lazy_init(
+            m,
+            pyrti::lazy_init::NETWORK_CAPTURE,
+            { "network_capture" },
+            [m](pyrti::ClassInitList& l, pyrti::DefInitVector& v) mutable {
+                init_network_capture(m, l, v);
+            });
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyLogLevel.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pyrti {
+    // What the producers do when the queue is full
+    enum class PyLogOverflowPolicy {
+        DROP_OLDEST,
+        DROP_NEWEST,
+        BLOCK
+    };
+
+    struct PyLogRecord {
+        PyLogLevel level = PyLogLevel::PY_DISTLOG_SILENT;
+        std::string message;
+        std::string category;
+        bool has_category = false;
+        // A structured record is rendered from its format and encoded
+        // arguments (see PyLogFormat.hpp) when it's published
+        bool structured = false;
+        uint32_t format_id = 0;
+        std::string arguments;
+    };
+
+    // A bounded queue of log records that any number of threads push to
+    // without locks, and a thread that publishes them in batches.
+    //
+    // The ring uses a sequence number per cell (D. Vyukov's bounded queue),
+    // so pushing a record is a CAS on the enqueue position. Producers only
+    // take a mutex to wake up the drain thread when it's idle, or when they
+    // wait for space with the BLOCK policy.
+    class PyAsyncLogQueue {
+    public:
+        using Publisher = std::function<void(std::vector<PyLogRecord>&)>;
+
+        // The capacity is rounded up to a power of two
+        PyAsyncLogQueue(
+                size_t capacity,
+                PyLogOverflowPolicy policy,
+                size_t max_batch,
+                Publisher publish);
+        ~PyAsyncLogQueue();
+
+        // Returns false if the record (or, with DROP_OLDEST, an older one)
+        // was dropped
+        bool push(PyLogRecord&& record);
+
+        // Waits until the records pushed before this call are published
+        void flush();
+
+        // Publishes the remaining records and stops the drain thread
+        void stop();
+
+        size_t capacity() const;
+        size_t queued_count() const;
+        uint64_t dropped_count() const;
+        PyLogOverflowPolicy policy() const;
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            PyLogRecord record;
+        };
+
+        bool try_push(PyLogRecord& record);
+        bool try_pop(PyLogRecord& record);
+        bool full() const;
+        void wake_drain_thread();
+        size_t drain();
+        void run();
+
+        std::unique_ptr<Cell[]> _cells;
+        size_t _mask;
+        PyLogOverflowPolicy _policy;
+        size_t _max_batch;
+        Publisher _publish;
+
+        // Each position is written by different threads
+        alignas(64) std::atomic<size_t> _enqueue_pos;
+        alignas(64) std::atomic<size_t> _dequeue_pos;
+        alignas(64) std::atomic<uint64_t> _consumed;
+        std::atomic<uint64_t> _dropped;
+
+        std::mutex _wake_mutex;
+        std::condition_variable _wake;
+        std::condition_variable _drained;
+        std::atomic<bool> _drain_sleeping;
+        std::atomic<size_t> _blocked_producers;
+        std::atomic<bool> _stopped;
+        std::mutex _stop_mutex;
+        std::thread _thread;
+    };
+}
@@ -0,0 +1,49 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+namespace pyrti {
+    // The message templates of the structured log calls. A template is
+    // registered once and then referenced by its id; each "{}" in it is
+    // replaced by the next argument ("{{" and "}}" are literal braces).
+    // Registering the same template again returns the same id.
+    class PyLogFormatRegistry {
+    public:
+        static uint32_t add(const std::string& format);
+        static bool contains(uint32_t id);
+        static std::string get(uint32_t id);
+
+    private:
+        static std::mutex _lock;
+        static std::vector<std::string> _formats;
+        static std::unordered_map<std::string, uint32_t> _ids;
+        static std::atomic<uint32_t> _count;
+    };
+
+    // Appends the binary encoding of a Python argument to the buffer.
+    // Integers, floats, booleans, strings, bytes and None are copied as they
+    // are; other objects are converted with str().
+    //
+    // @pre The GIL must be held
+    void encode_log_argument(py::handle argument, std::string& buffer);
+
+    // Replaces the placeholders of a template with the encoded arguments
+    std::string render_log_message(const std::string& format, const std::string& arguments);
+}
@@ -17,6 +17,10 @@
 #include "PyLoggerOptions.hpp"
 #include "PyLogLevel.hpp"
 #include "PyMessageParams.hpp"
+#include "PyAsyncLogQueue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 
 namespace pyrti {
@@ -27,6 +31,10 @@ namespace pyrti {
         ~PyLogger();
         static PyLogger& instance();
         static bool options(const PyLoggerOptions&);
+        // The native logger is shared by all the interpreters of the
+        // process. Each interpreter that uses it is added once, and
+        // finalize() only destroys it when no other interpreter uses it.
+        static void add_interpreter();
         static void finalize();
         static void filter_level(PyLogLevel);
         static void print_format(const rti::config::PrintFormat&);
@@ -42,13 +50,49 @@ namespace pyrti {
         static void debug(const std::string&);
         static void trace(const std::string&);
         static void log(PyLogLevel, const std::string&);
+        // Logs a structured record, which is only rendered when it's
+        // published
+        static void log(PyLogRecord&&);
+        // Whether a message with this level passes the filter level. It may
+        // return true for a message the native logger then filters out, but
+        // never false for one it would publish.
+        static bool is_enabled_for(PyLogLevel);
+        // In asynchronous mode the messages logged with a level (with or
+        // without a category) are queued and published by a drain thread.
+        // Messages logged with MessageParams are still published right away.
+        static void enable_async(size_t capacity, PyLogOverflowPolicy policy, size_t max_batch);
+        static void disable_async();
+        static bool async_enabled();
+        static void flush();
+        static size_t queued_count();
+        static uint64_t dropped_count();
 
     private:
         PyLogger();
+        static bool log_async(PyLogLevel, const std::string&, const std::string*);
+        static void publish(std::vector<PyLogRecord>&);
+        static void stop_async_queue();
         RTI_DL_DistLogger* _instance;
         static std::unique_ptr<PyLogger> _py_instance;
         static bool _options_set;
+        static size_t _interpreter_count;
         static std::recursive_mutex _lock;
+        // Protects _queue, which the producers only access while they're
+        // counted in _async_producers and _async_enabled is set
+        static std::mutex _async_lock;
+        static std::shared_ptr<PyAsyncLogQueue> _queue;
+        static std::atomic<bool> _async_enabled;
+        static std::atomic<size_t> _async_producers;
+        // Notified when the last producer leaves after _async_enabled is
+        // cleared
+        static std::mutex _producers_mutex;
+        static std::condition_variable _producers_done;
+        friend struct PyAsyncProducerGuard;
+        // A copy of the filter level that can be checked without locking
+        static std::atomic<int> _filter_level;
+        // Whether the options enable remote administration, which can change
+        // the filter level at any time. Protected by _lock.
+        static bool _remote_administration;
 #if rti_connext_version_lt(6, 0, 0, 0)
         static std::unique_ptr<PyLoggerOptions> _options;
 #endif
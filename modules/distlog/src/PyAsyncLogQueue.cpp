@@ -0,0 +1,243 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyConnext.hpp"
+#include "PyAsyncLogQueue.hpp"
+#include <chrono>
+
+namespace pyrti {
+
+// How long the idle drain thread and the blocked producers wait before
+// checking the queue again, in case a notification was missed
+static const std::chrono::milliseconds IDLE_PERIOD(100);
+static const std::chrono::milliseconds BLOCKED_PERIOD(10);
+
+static size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+PyAsyncLogQueue::PyAsyncLogQueue(
+        size_t capacity,
+        PyLogOverflowPolicy policy,
+        size_t max_batch,
+        Publisher publish)
+        : _mask(round_up_to_power_of_two(capacity) - 1),
+          _policy(policy),
+          _max_batch(max_batch > 0 ? max_batch : 1),
+          _publish(std::move(publish)),
+          _enqueue_pos(0),
+          _dequeue_pos(0),
+          _consumed(0),
+          _dropped(0),
+          _drain_sleeping(false),
+          _blocked_producers(0),
+          _stopped(false) {
+    _cells.reset(new Cell[_mask + 1]);
+    for (size_t i = 0; i <= _mask; i++) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _thread = std::thread([this]() { this->run(); });
+}
+
+PyAsyncLogQueue::~PyAsyncLogQueue() {
+    stop();
+}
+
+bool PyAsyncLogQueue::push(PyLogRecord&& record) {
+    bool dropped = false;
+    while (!try_push(record)) {
+        if (_stopped || _policy == PyLogOverflowPolicy::DROP_NEWEST) {
+            _dropped++;
+            return false;
+        }
+
+        if (_policy == PyLogOverflowPolicy::DROP_OLDEST) {
+            PyLogRecord oldest;
+            if (try_pop(oldest)) {
+                _consumed++;
+                _dropped++;
+                dropped = true;
+            }
+        } else {
+            _blocked_producers++;
+            wake_drain_thread();
+            {
+                std::unique_lock<std::mutex> lock(_wake_mutex);
+                _drained.wait_for(lock, BLOCKED_PERIOD, [this]() {
+                    return !full() || _stopped;
+                });
+            }
+            _blocked_producers--;
+        }
+    }
+
+    if (_drain_sleeping) {
+        wake_drain_thread();
+    }
+    return !dropped;
+}
+
+void PyAsyncLogQueue::flush() {
+    uint64_t target = _enqueue_pos.load();
+    wake_drain_thread();
+
+    std::unique_lock<std::mutex> lock(_wake_mutex);
+    while (_consumed.load() < target && !_stopped) {
+        _drained.wait_for(lock, BLOCKED_PERIOD);
+    }
+}
+
+void PyAsyncLogQueue::stop() {
+    std::lock_guard<std::mutex> stop_lock(_stop_mutex);
+    _stopped = true;
+    wake_drain_thread();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    // Publish what was pushed while the thread was stopping
+    while (drain() > 0) {
+    }
+
+    std::lock_guard<std::mutex> lock(_wake_mutex);
+    _drained.notify_all();
+}
+
+size_t PyAsyncLogQueue::capacity() const {
+    return _mask + 1;
+}
+
+size_t PyAsyncLogQueue::queued_count() const {
+    size_t dequeue_pos = _dequeue_pos.load();
+    size_t enqueue_pos = _enqueue_pos.load();
+    return enqueue_pos > dequeue_pos ? enqueue_pos - dequeue_pos : 0;
+}
+
+uint64_t PyAsyncLogQueue::dropped_count() const {
+    return _dropped.load();
+}
+
+PyLogOverflowPolicy PyAsyncLogQueue::policy() const {
+    return _policy;
+}
+
+bool PyAsyncLogQueue::try_push(PyLogRecord& record) {
+    Cell* cell;
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &_cells[pos & _mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence)
+                - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (_enqueue_pos.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full
+            return false;
+        } else {
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->record = std::move(record);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool PyAsyncLogQueue::try_pop(PyLogRecord& record) {
+    Cell* cell;
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &_cells[pos & _mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence)
+                - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (_dequeue_pos.compare_exchange_weak(
+                    pos,
+                    pos + 1,
+                    std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Empty, or the record in this cell is still being pushed
+            return false;
+        } else {
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record = std::move(cell->record);
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+bool PyAsyncLogQueue::full() const {
+    return queued_count() > _mask;
+}
+
+void PyAsyncLogQueue::wake_drain_thread() {
+    std::lock_guard<std::mutex> lock(_wake_mutex);
+    _wake.notify_one();
+}
+
+size_t PyAsyncLogQueue::drain() {
+    std::vector<PyLogRecord> batch;
+    PyLogRecord record;
+    while (batch.size() < _max_batch && try_pop(record)) {
+        batch.push_back(std::move(record));
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+
+    try {
+        _publish(batch);
+    } catch (const std::exception&) {
+        // A record that can't be published is lost, but the following ones
+        // are still published
+    }
+    _consumed += batch.size();
+
+    // Wake up the producers waiting for space and the threads flushing
+    std::lock_guard<std::mutex> lock(_wake_mutex);
+    _drained.notify_all();
+    return batch.size();
+}
+
+void PyAsyncLogQueue::run() {
+    while (true) {
+        if (drain() > 0) {
+            continue;
+        }
+        if (_stopped) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(_wake_mutex);
+        _drain_sleeping = true;
+        _wake.wait_for(lock, IDLE_PERIOD, [this]() {
+            return _stopped || _enqueue_pos.load() != _dequeue_pos.load();
+        });
+        _drain_sleeping = false;
+    }
+}
+
+}
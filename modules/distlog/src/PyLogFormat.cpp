@@ -0,0 +1,194 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyConnext.hpp"
+#include "PyLogFormat.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace pyrti {
+
+// The tag that precedes each encoded argument
+enum PyLogArgumentTag : char {
+    PY_LOG_ARG_NONE = 'n',
+    PY_LOG_ARG_BOOL = 'b',
+    PY_LOG_ARG_INT = 'i',
+    PY_LOG_ARG_FLOAT = 'd',
+    PY_LOG_ARG_STRING = 's'
+};
+
+std::mutex PyLogFormatRegistry::_lock;
+std::vector<std::string> PyLogFormatRegistry::_formats;
+std::unordered_map<std::string, uint32_t> PyLogFormatRegistry::_ids;
+std::atomic<uint32_t> PyLogFormatRegistry::_count(0);
+
+uint32_t PyLogFormatRegistry::add(const std::string& format) {
+    std::lock_guard<std::mutex> lock(PyLogFormatRegistry::_lock);
+    auto it = PyLogFormatRegistry::_ids.find(format);
+    if (it != PyLogFormatRegistry::_ids.end()) return it->second;
+
+    PyLogFormatRegistry::_formats.push_back(format);
+    auto id = PyLogFormatRegistry::_count.load();
+    PyLogFormatRegistry::_ids.emplace(format, id);
+    PyLogFormatRegistry::_count = id + 1;
+    return id;
+}
+
+bool PyLogFormatRegistry::contains(uint32_t id) {
+    return id < PyLogFormatRegistry::_count.load();
+}
+
+std::string PyLogFormatRegistry::get(uint32_t id) {
+    std::lock_guard<std::mutex> lock(PyLogFormatRegistry::_lock);
+    if (id >= PyLogFormatRegistry::_formats.size()) return std::string();
+    return PyLogFormatRegistry::_formats[id];
+}
+
+template<typename T>
+static void append_value(std::string& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool read_value(const std::string& buffer, size_t& pos, T& value) {
+    if (buffer.size() - pos < sizeof(T)) return false;
+    std::memcpy(&value, buffer.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+static void append_string(std::string& buffer, const char* data, size_t length) {
+    buffer.push_back(PY_LOG_ARG_STRING);
+    append_value(buffer, static_cast<uint32_t>(length));
+    buffer.append(data, length);
+}
+
+void encode_log_argument(py::handle argument, std::string& buffer) {
+    auto obj = argument.ptr();
+    if (obj == Py_None) {
+        buffer.push_back(PY_LOG_ARG_NONE);
+        return;
+    }
+    if (PyBool_Check(obj)) {
+        buffer.push_back(PY_LOG_ARG_BOOL);
+        buffer.push_back(obj == Py_True ? 1 : 0);
+        return;
+    }
+    if (PyLong_Check(obj)) {
+        int overflow = 0;
+        long long value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+        if (overflow == 0 && !(value == -1 && PyErr_Occurred())) {
+            buffer.push_back(PY_LOG_ARG_INT);
+            append_value(buffer, static_cast<int64_t>(value));
+            return;
+        }
+        PyErr_Clear();
+    } else if (PyFloat_Check(obj)) {
+        buffer.push_back(PY_LOG_ARG_FLOAT);
+        append_value(buffer, PyFloat_AS_DOUBLE(obj));
+        return;
+    } else if (PyUnicode_Check(obj)) {
+        Py_ssize_t length = 0;
+        const char* data = PyUnicode_AsUTF8AndSize(obj, &length);
+        if (data == nullptr) throw py::error_already_set();
+        append_string(buffer, data, static_cast<size_t>(length));
+        return;
+    }
+
+    // Big integers and any other object
+    std::string text = py::str(argument);
+    append_string(buffer, text.data(), text.size());
+}
+
+// The shortest representation that reads back as the same value, like
+// Python's repr()
+static void render_float(double value, std::string& message) {
+    char text[32];
+    for (int precision = 1; precision <= 17; precision++) {
+        std::snprintf(text, sizeof(text), "%.*g", precision, value);
+        if (std::strtod(text, nullptr) == value) break;
+    }
+    message += text;
+    if (std::strpbrk(text, ".eni") == nullptr) {
+        message += ".0";
+    }
+}
+
+// Renders the next argument; returns false if there are no more
+static bool render_argument(const std::string& arguments, size_t& pos, std::string& message) {
+    if (pos >= arguments.size()) return false;
+
+    char tag = arguments[pos++];
+    switch (tag) {
+    case PY_LOG_ARG_NONE:
+        message += "None";
+        return true;
+    case PY_LOG_ARG_BOOL: {
+        char value = 0;
+        if (!read_value(arguments, pos, value)) return false;
+        message += value ? "True" : "False";
+        return true;
+    }
+    case PY_LOG_ARG_INT: {
+        int64_t value = 0;
+        if (!read_value(arguments, pos, value)) return false;
+        message += std::to_string(value);
+        return true;
+    }
+    case PY_LOG_ARG_FLOAT: {
+        double value = 0;
+        if (!read_value(arguments, pos, value)) return false;
+        render_float(value, message);
+        return true;
+    }
+    case PY_LOG_ARG_STRING: {
+        uint32_t length = 0;
+        if (!read_value(arguments, pos, length)) return false;
+        if (arguments.size() - pos < length) return false;
+        message.append(arguments, pos, length);
+        pos += length;
+        return true;
+    }
+    default:
+        pos = arguments.size();
+        return false;
+    }
+}
+
+std::string render_log_message(const std::string& format, const std::string& arguments) {
+    std::string message;
+    message.reserve(format.size() + arguments.size());
+
+    size_t pos = 0;
+    for (size_t i = 0; i < format.size(); i++) {
+        char c = format[i];
+        bool has_next = i + 1 < format.size();
+        if (c == '{' && has_next && format[i + 1] == '{') {
+            message += '{';
+            i++;
+        } else if (c == '}' && has_next && format[i + 1] == '}') {
+            message += '}';
+            i++;
+        } else if (c == '{' && has_next && format[i + 1] == '}') {
+            // A placeholder without an argument is kept as it is
+            if (!render_argument(arguments, pos, message)) {
+                message += "{}";
+            }
+            i++;
+        } else {
+            message += c;
+        }
+    }
+    return message;
+}
+
+}
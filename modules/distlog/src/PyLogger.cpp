@@ -11,13 +11,25 @@
 
 #include "PyConnext.hpp"
 #include "PyLogger.hpp"
+#include "PyLogFormat.hpp"
+#include "PyInterpreterLocal.hpp"
 #include <mutex>
 
 namespace pyrti {
 
 bool PyLogger::_options_set = false;
+size_t PyLogger::_interpreter_count = 0;
 std::recursive_mutex PyLogger::_lock;
 std::unique_ptr<PyLogger> PyLogger::_py_instance;
+std::mutex PyLogger::_async_lock;
+std::shared_ptr<PyAsyncLogQueue> PyLogger::_queue;
+std::atomic<bool> PyLogger::_async_enabled(false);
+std::atomic<size_t> PyLogger::_async_producers(0);
+std::mutex PyLogger::_producers_mutex;
+std::condition_variable PyLogger::_producers_done;
+// Until the options are set, every level is considered enabled
+std::atomic<int> PyLogger::_filter_level((int)PyLogLevel::PY_DISTLOG_TRACE);
+bool PyLogger::_remote_administration = false;
 #if rti_connext_version_lt(6, 0, 0, 0)
 std::unique_ptr<PyLoggerOptions> PyLogger::_options;
 #endif
@@ -31,17 +43,15 @@ PyLogger& PyLogger::instance() {
             PyLogger::_options_set = true;
         }
         PyLogger::_py_instance.reset(new PyLogger());
-        {
-            py::gil_scoped_acquire acquire;
-            auto atexit = py::module::import("atexit");
-            atexit.attr("register")(py::cpp_function([]() {
-                PyLogger::finalize();
-            }));
-        }
     }
     return *PyLogger::_py_instance;
 }
 
+void PyLogger::add_interpreter() {
+    std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
+    PyLogger::_interpreter_count++;
+}
+
 bool PyLogger::options(const PyLoggerOptions& options) {
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
 
@@ -55,14 +65,38 @@ bool PyLogger::options(const PyLoggerOptions& options) {
 
     if (retval) {
         PyLogger::_options_set = true;
+        // Remote administration can change the filter level of the native
+        // logger at any time, so it's the only one that filters
+        PyLogger::_remote_administration =
+            RTI_DL_Options_isRemoteAdministrationEnabled(options._options) == RTI_TRUE;
+        if (PyLogger::_remote_administration) {
+            PyLogger::_filter_level = (int)PyLogLevel::PY_DISTLOG_TRACE;
+        } else {
+            PyLogger::_filter_level = RTI_DL_Options_getFilterLevel(options._options);
+        }
     }
 
     return retval;
 }
 
 void PyLogger::finalize() {
+    {
+        std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
+        if (PyLogger::_interpreter_count > 0) {
+            PyLogger::_interpreter_count--;
+        }
+        if (PyLogger::_interpreter_count > 0) {
+            return;
+        }
+    }
+
+    // The drain thread publishes the queued messages with the lock, so it's
+    // stopped without holding it
+    PyLogger::disable_async();
+
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
-    if (PyLogger::_py_instance == nullptr) {
+    if (PyLogger::_interpreter_count > 0
+            || PyLogger::_py_instance == nullptr) {
         return;
     }
 
@@ -86,6 +120,11 @@ void PyLogger::filter_level(PyLogLevel level) {
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     auto retval = RTI_DL_DistLogger_setFilterLevel(PyLogger::instance()._instance, (int)level);
     if (retval != DDS_RETCODE_OK) throw dds::core::Error("Could not set Distributed Logger filter level");
+    // With remote administration the native logger is the only one that
+    // filters (see options())
+    if (!PyLogger::_remote_administration) {
+        PyLogger::_filter_level = (int)level;
+    }
 }
 
 void PyLogger::print_format(const rti::config::PrintFormat& format) {
@@ -103,6 +142,7 @@ void PyLogger::verbosity(const rti::config::LogCategory& category, const rti::co
 }
 
 void PyLogger::log(PyLogLevel level, const std::string& message, const std::string& category) {
+    if (PyLogger::log_async(level, message, &category)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_logMessageWithLevelCategory(
         PyLogger::instance()._instance,
@@ -120,51 +160,281 @@ void PyLogger::log(const PyMessageParams& params) {
 }
 
 void PyLogger::fatal(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_FATAL, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_fatal(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::severe(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_SEVERE, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_severe(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::error(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_ERROR, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_error(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::warning(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_WARNING, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_warning(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::notice(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_NOTICE, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_notice(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::info(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_INFO, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_info(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::debug(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_DEBUG, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_debug(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::trace(const std::string& message) {
+    if (PyLogger::log_async(PyLogLevel::PY_DISTLOG_TRACE, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_trace(PyLogger::instance()._instance, message.c_str());
 }
 
 void PyLogger::log(PyLogLevel level, const std::string& message) {
+    if (PyLogger::log_async(level, message, nullptr)) return;
     std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
     RTI_DL_DistLogger_log(PyLogger::instance()._instance, (int)level, message.c_str());
 }
 
+// Counts a producer while it may access the queue. The last one wakes up
+// the thread stopping the queue.
+struct PyAsyncProducerGuard {
+    PyAsyncProducerGuard() {
+        PyLogger::_async_producers++;
+    }
+
+    ~PyAsyncProducerGuard() {
+        if (--PyLogger::_async_producers == 0 && !PyLogger::_async_enabled) {
+            std::lock_guard<std::mutex> lock(PyLogger::_producers_mutex);
+            PyLogger::_producers_done.notify_all();
+        }
+    }
+};
+
+void PyLogger::log(PyLogRecord&& record) {
+    // The shared counter is only touched in asynchronous mode
+    if (PyLogger::_async_enabled) {
+        PyAsyncProducerGuard guard;
+        if (PyLogger::_async_enabled) {
+            PyLogger::_queue->push(std::move(record));
+            return;
+        }
+    }
+
+    std::vector<PyLogRecord> records;
+    records.push_back(std::move(record));
+    PyLogger::publish(records);
+}
+
+bool PyLogger::is_enabled_for(PyLogLevel level) {
+    return level != PyLogLevel::PY_DISTLOG_SILENT
+            && (int)level <= PyLogger::_filter_level.load(std::memory_order_relaxed);
+}
+
+bool PyLogger::log_async(PyLogLevel level, const std::string& message, const std::string* category) {
+    // A filtered message is done without taking the lock
+    if (!PyLogger::is_enabled_for(level)) return true;
+
+    // The shared counter is only touched in asynchronous mode
+    if (!PyLogger::_async_enabled) return false;
+    PyAsyncProducerGuard guard;
+    if (!PyLogger::_async_enabled) return false;
+
+    PyLogRecord record;
+    record.level = level;
+    record.message = message;
+    if (category != nullptr) {
+        record.category = *category;
+        record.has_category = true;
+    }
+    // A dropped message counts as logged
+    PyLogger::_queue->push(std::move(record));
+    return true;
+}
+
+void PyLogger::publish(std::vector<PyLogRecord>& records) {
+    std::lock_guard<std::recursive_mutex> lock(PyLogger::_lock);
+    auto instance = PyLogger::instance()._instance;
+    for (auto& record : records) {
+        if (record.structured) {
+            record.message = render_log_message(
+                PyLogFormatRegistry::get(record.format_id),
+                record.arguments);
+        }
+        if (record.has_category) {
+            RTI_DL_DistLogger_logMessageWithLevelCategory(
+                instance,
+                (int)record.level,
+                record.message.c_str(),
+                record.category.c_str());
+        } else {
+            RTI_DL_DistLogger_log(instance, (int)record.level, record.message.c_str());
+        }
+    }
+}
+
+void PyLogger::enable_async(size_t capacity, PyLogOverflowPolicy policy, size_t max_batch) {
+    if (capacity == 0) throw dds::core::InvalidArgumentError("The capacity must be greater than 0");
+    if (max_batch == 0) throw dds::core::InvalidArgumentError("The maximum batch size must be greater than 0");
+
+    std::lock_guard<std::mutex> lock(PyLogger::_async_lock);
+    PyLogger::stop_async_queue();
+    PyLogger::_queue.reset(new PyAsyncLogQueue(capacity, policy, max_batch, &PyLogger::publish));
+    PyLogger::_async_enabled = true;
+}
+
+void PyLogger::disable_async() {
+    std::lock_guard<std::mutex> lock(PyLogger::_async_lock);
+    PyLogger::stop_async_queue();
+}
+
+// @pre _async_lock must be held
+void PyLogger::stop_async_queue() {
+    if (!PyLogger::_async_enabled) return;
+
+    // New messages are logged synchronously. The producers that are pushing
+    // to the queue finish first; the drain thread keeps running meanwhile in
+    // case they're blocked waiting for space.
+    PyLogger::_async_enabled = false;
+    {
+        std::unique_lock<std::mutex> lock(PyLogger::_producers_mutex);
+        PyLogger::_producers_done.wait(lock, []() {
+            return PyLogger::_async_producers == 0;
+        });
+    }
+    // The queue is kept for its counters
+    PyLogger::_queue->stop();
+}
+
+bool PyLogger::async_enabled() {
+    return PyLogger::_async_enabled;
+}
+
+void PyLogger::flush() {
+    // Waits without the lock, so that other threads can still enable or
+    // disable the asynchronous mode. Stopping the queue meanwhile ends the
+    // wait (and publishes the remaining records).
+    std::shared_ptr<PyAsyncLogQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(PyLogger::_async_lock);
+        if (PyLogger::_async_enabled) {
+            queue = PyLogger::_queue;
+        }
+    }
+    if (queue) {
+        queue->flush();
+    }
+}
+
+size_t PyLogger::queued_count() {
+    std::lock_guard<std::mutex> lock(PyLogger::_async_lock);
+    return PyLogger::_queue ? PyLogger::_queue->queued_count() : 0;
+}
+
+uint64_t PyLogger::dropped_count() {
+    std::lock_guard<std::mutex> lock(PyLogger::_async_lock);
+    return PyLogger::_queue ? PyLogger::_queue->dropped_count() : 0;
+}
+
+struct PyLoggerInterpreterState {
+    bool in_use = false;
+};
+
+// @pre The GIL must be held
+static PyLoggerInterpreterState& logger_interpreter_state() {
+    return interpreter_local<PyLoggerInterpreterState>(
+            "rti.logging.distlog.logger");
+}
+
+// Adds the current interpreter as a user of the logger
+static void acquire_logger() {
+    auto& state = logger_interpreter_state();
+    if (state.in_use) return;
+    state.in_use = true;
+    py::gil_scoped_release release;
+    PyLogger::add_interpreter();
+}
+
+// Incremented each time an interpreter releases the logger
+static std::atomic<uint64_t> logger_release_count(0);
+
+// Removes the current interpreter as a user of the logger, which is
+// destroyed if no other interpreter uses it
+static void release_logger() {
+    auto& state = logger_interpreter_state();
+    if (!state.in_use) return;
+    state.in_use = false;
+    logger_release_count++;
+    py::gil_scoped_release release;
+    PyLogger::finalize();
+}
+
+// A py::call_guard for the functions that use (and may re-create) the
+// logger. It adds the current interpreter as a user again if it finalized
+// the logger, so that its atexit hook finalizes the new one. Each thread
+// remembers the interpreter it last added, until any interpreter releases
+// the logger, so the check is cheap.
+//
+// @pre The GIL must be held
+class PyLoggerUser {
+public:
+    PyLoggerUser() {
+        thread_local int64_t acquired_interpreter = -1;
+        thread_local uint64_t acquired_release_count = 0;
+
+        auto interpreter = current_interpreter_id();
+        auto release_count = logger_release_count.load();
+        if (interpreter == acquired_interpreter
+                && release_count == acquired_release_count) {
+            return;
+        }
+        acquire_logger();
+        acquired_interpreter = interpreter;
+        acquired_release_count = release_count;
+    }
+};
+
 void init_logger(py::module& m) {
+    // Each interpreter that imports this module releases the logger when
+    // it exits
+    acquire_logger();
+    py::module::import("atexit").attr("register")(
+            py::cpp_function(&release_logger));
+
+    py::enum_<PyLogOverflowPolicy>(m, "LogOverflowPolicy")
+        .value(
+            "DROP_OLDEST",
+            PyLogOverflowPolicy::DROP_OLDEST,
+            "Drop the oldest queued message to make room for the new one."
+        )
+        .value(
+            "DROP_NEWEST",
+            PyLogOverflowPolicy::DROP_NEWEST,
+            "Drop the new message."
+        )
+        .value(
+            "BLOCK",
+            PyLogOverflowPolicy::BLOCK,
+            "Wait until there is room for the new message."
+        );
+
     py::class_<PyLogger> cls(m, "Logger");
     cls
         .def_static(
@@ -178,21 +448,21 @@ void init_logger(py::module& m) {
                 PyLogger::instance();
             },
             py::arg("options") = py::none(),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Initializes the distributed logger"
         )
         .def_static(
             "filter_level",
             &PyLogger::filter_level,
             py::arg("level"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "The logger filter level."
         )
         .def_static(
             "print_format",
             &PyLogger::print_format,
             py::arg("format"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "The logger print format."
             "NOTE: This will affect the print format of the associated"
             "DomainParticipant's logger as well."
@@ -202,7 +472,7 @@ void init_logger(py::module& m) {
             &PyLogger::verbosity,
             py::arg("category"),
             py::arg("level"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "The logger's verbosity."
             "NOTE: This will affect the verbosity of the associated"
             "DomainParticipant's logger as well."
@@ -212,7 +482,7 @@ void init_logger(py::module& m) {
             (void (*)(PyLogLevel, const std::string&)) &PyLogger::log,
             py::arg("log_level"),
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a message with the given log level."
         )
         .def_static(
@@ -221,77 +491,173 @@ void init_logger(py::module& m) {
             py::arg("log_level"),
             py::arg("message"),
             py::arg("category"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a message with the given log level and category."
         )
         .def_static(
             "log",
             (void (*)(const PyMessageParams& params)) &PyLogger::log,
             py::arg("message_params"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a message with the given message parameters."
         )
         .def_static(
             "fatal",
             &PyLogger::fatal,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a fatal message."
         )
         .def_static(
             "severe",
             &PyLogger::severe,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a severe message."
         )
         .def_static(
             "error",
             &PyLogger::error,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log an error message."
         )
         .def_static(
             "warning",
             &PyLogger::warning,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a warning message."
         )
         .def_static(
             "notice",
             &PyLogger::notice,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a notice message."
         )
         .def_static(
             "info",
             &PyLogger::info,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log an info message."
         )
         .def_static(
             "debug",
             &PyLogger::debug,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a debug message."
         )
         .def_static(
             "trace",
             &PyLogger::trace,
             py::arg("message"),
-            py::call_guard<py::gil_scoped_release>(),
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
             "Log a trace message."
         )
         .def_static(
-            "finalize",
-            &PyLogger::finalize,
+            "is_enabled_for",
+            &PyLogger::is_enabled_for,
+            py::arg("log_level"),
+            "Whether a message with the given log level passes the filter "
+            "level. Checking it first avoids formatting the messages that "
+            "would be filtered out."
+        )
+        .def_static(
+            "register_format",
+            &PyLogFormatRegistry::add,
+            py::arg("format"),
+            "Register a message template for log_structured and return "
+            "its id. Each \"{}\" in the template is replaced by the next "
+            "argument; \"{{\" and \"}}\" are literal braces."
+        )
+        .def_static(
+            "log_structured",
+            [](PyLogLevel level,
+                    uint32_t format_id,
+                    py::args args,
+                    const dds::core::optional<std::string>& category) {
+                if (!PyLogger::is_enabled_for(level)) return;
+                PyLoggerUser user;
+                if (!PyLogFormatRegistry::contains(format_id)) {
+                    throw dds::core::InvalidArgumentError("Unknown log format id");
+                }
+
+                PyLogRecord record;
+                record.level = level;
+                record.structured = true;
+                record.format_id = format_id;
+                for (auto arg : args) {
+                    encode_log_argument(arg, record.arguments);
+                }
+                if (has_value(category)) {
+                    record.category = get_value(category);
+                    record.has_category = true;
+                }
+
+                py::gil_scoped_release release;
+                PyLogger::log(std::move(record));
+            },
+            py::arg("log_level"),
+            py::arg("format_id"),
+            py::kw_only(),
+            py::arg("category") = py::none(),
+            "Log a message with the given log level from a registered "
+            "template and its arguments. The arguments are only captured "
+            "if the level is enabled, and the message is only rendered "
+            "when it's published (by the drain thread in asynchronous "
+            "mode)."
+        )
+        .def_static(
+            "enable_async",
+            &PyLogger::enable_async,
+            py::arg("capacity") = 8192,
+            py::arg("overflow_policy") = PyLogOverflowPolicy::BLOCK,
+            py::arg("max_batch") = 256,
+            py::call_guard<PyLoggerUser, py::gil_scoped_release>(),
+            "Log asynchronously: the messages logged with a level are "
+            "queued without locking and a background thread publishes "
+            "them in batches of up to max_batch messages. The "
+            "overflow_policy determines what happens when the queue, "
+            "which holds up to capacity messages, is full. "
+            "NOTE: Messages logged with MessageParams are still published "
+            "synchronously."
+        )
+        .def_static(
+            "disable_async",
+            &PyLogger::disable_async,
+            py::call_guard<py::gil_scoped_release>(),
+            "Publish the queued messages and log synchronously again."
+        )
+        .def_static(
+            "async_enabled",
+            &PyLogger::async_enabled,
+            "Whether the logger is in asynchronous mode."
+        )
+        .def_static(
+            "flush",
+            &PyLogger::flush,
             py::call_guard<py::gil_scoped_release>(),
-            "Destroy the Logger. It should not be accessed after this call."
+            "Wait until the queued messages are published."
+        )
+        .def_static(
+            "queued_count",
+            &PyLogger::queued_count,
+            "The number of messages waiting to be published."
+        )
+        .def_static(
+            "dropped_count",
+            &PyLogger::dropped_count,
+            "The number of messages dropped because the queue was full."
+        )
+        .def_static(
+            "finalize",
+            &release_logger,
+            "Destroy the Logger. It should not be accessed after this call. "
+            "NOTE: If the Logger is used by other interpreters of this "
+            "process, it's only destroyed when the last one finalizes it."
         );
 }
 
@@ -0,0 +1,207 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include "PyDataReader.hpp"
+#include "PyTimerWheel.hpp"
+#include <dds/core/cond/GuardCondition.hpp>
+#include <dds/core/cond/WaitSet.hpp>
+#include <rti/core/SampleIdentity.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace pyrti {
+
+struct SampleIdentityHash {
+    size_t operator()(const rti::core::SampleIdentity& identity) const;
+};
+
+// Delivers the replies received by a Requester to the callers waiting for
+// them (rti.request).
+//
+// Instead of creating a correlation condition for each request, a native
+// thread takes all the replies once, looks up the request they're related to
+// in a hash map of pending requests, and completes the asyncio Future (or
+// wakes up the synchronous caller) that waits for them. The timeouts of all
+// the pending requests are driven by a single timer wheel.
+//
+// Replies to a request that nobody is waiting for yet (because they arrived
+// before the caller started waiting) are kept for max_unclaimed_wait.
+//
+// The dispatch thread only holds a weak reference to this object, so
+// releasing the last reference stops it. The demultiplexers still open when
+// the interpreter exits are closed by an atexit hook.
+//
+// If the dispatch thread fails (for example, because the reader was closed),
+// the callers waiting for replies, and any later ones, fail with
+// dds.Error.
+class PyReplyDemultiplexer
+        : public std::enable_shared_from_this<PyReplyDemultiplexer> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // take is a function (the DataReader's take method) that returns the
+    // samples received by the reader as a list of (data, info) tuples
+    static std::shared_ptr<PyReplyDemultiplexer> create(
+            PyIDataReader& reader,
+            py::object take,
+            const dds::core::Duration& tick,
+            const dds::core::Duration& max_unclaimed_wait);
+
+    ~PyReplyDemultiplexer();
+
+    // Returns an asyncio.Future of the running loop that completes with the
+    // replies to a request. Cancelling the future stops waiting for them.
+    //
+    // @pre The GIL must be held
+    py::object receive_replies_async(
+            const rti::core::SampleIdentity& related_request_id,
+            const dds::core::Duration& max_wait,
+            int32_t min_count);
+
+    // Waits (without the GIL) for the replies to a request
+    //
+    // @pre The GIL must be held
+    py::list receive_replies(
+            const rti::core::SampleIdentity& related_request_id,
+            const dds::core::Duration& max_wait,
+            int32_t min_count);
+
+    // Stops the dispatch thread; the callers still waiting fail with
+    // AlreadyClosedError
+    void close();
+
+    size_t pending_count() const;
+
+private:
+    enum class Status { RECEIVED, TIMED_OUT, CLOSED, FAILED };
+
+    // The state of a synchronous caller waiting for replies
+    struct SyncWaiter {
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+        Status status = Status::RECEIVED;
+        std::vector<py::object> replies;
+    };
+
+    struct PendingReplies {
+        int32_t min_count = 1;
+        bool final_received = false;
+        std::vector<py::object> replies;
+        uint64_t registration = 0;
+        uint64_t timer_id = 0;
+
+        // Only one of these is set
+        py::object future;
+        std::shared_ptr<SyncWaiter> waiter;
+
+        bool complete() const
+        {
+            return final_received
+                    || static_cast<int32_t>(replies.size()) >= min_count;
+        }
+    };
+
+    struct UnclaimedReplies {
+        bool final_received = false;
+        std::vector<py::object> replies;
+        uint64_t timer_id = 0;
+    };
+
+    struct Completion {
+        PendingReplies pending;
+        Status status;
+    };
+
+    using Timer = PyTimerWheel<rti::core::SampleIdentity>::Timer;
+
+    PyReplyDemultiplexer(
+            PyIDataReader& reader,
+            py::object take,
+            const dds::core::Duration& tick,
+            const dds::core::Duration& max_unclaimed_wait);
+
+    void start();
+
+    static void run(std::weak_ptr<PyReplyDemultiplexer> weak_self);
+
+    // Stops the dispatch thread after an error it can't recover from
+    void fail(const char* reason);
+
+    // Completes every caller still waiting with the given status
+    void fail_pending(Status status);
+
+    std::string failure() const;
+
+    // Takes the replies (if any) and handles the expired timers
+    void dispatch(bool take_replies, const std::vector<Timer>& expired);
+
+    // Adds a caller that waits for replies, or completes it right away with
+    // the replies that were already received. Returns the registration id.
+    uint64_t register_pending(
+            const rti::core::SampleIdentity& related_request_id,
+            PendingReplies pending,
+            const dds::core::Duration& max_wait);
+
+    // Stops waiting for replies after a future is cancelled
+    void cancel(
+            const rti::core::SampleIdentity& related_request_id,
+            uint64_t registration);
+
+    // @pre The GIL must be held and the mutex must not be held
+    void complete(std::vector<Completion>& completions);
+
+    // @pre The mutex must be held
+    uint64_t schedule_timer(
+            const rti::core::SampleIdentity& key,
+            Clock::time_point deadline);
+
+    dds::sub::AnyDataReader reader_;
+    dds::sub::cond::ReadCondition read_condition_;
+    dds::core::cond::GuardCondition wake_condition_;
+    dds::core::cond::WaitSet waitset_;
+    py::object take_;
+    py::object set_future_result_;
+    dds::core::Duration tick_;
+    std::chrono::nanoseconds max_unclaimed_wait_;
+
+    // Protect the fields below; never held while running Python code
+    mutable std::mutex mutex_;
+    std::unordered_map<
+            rti::core::SampleIdentity,
+            PendingReplies,
+            SampleIdentityHash>
+            pending_;
+    std::unordered_map<
+            rti::core::SampleIdentity,
+            UnclaimedReplies,
+            SampleIdentityHash>
+            unclaimed_;
+    PyTimerWheel<rti::core::SampleIdentity> timer_wheel_;
+    uint64_t next_registration_ = 1;
+    std::string failure_;
+
+    std::atomic<bool> stopped_ { false };
+    std::mutex join_mutex_;
+    std::thread thread_;
+};
+
+void init_reply_demultiplexer(py::module& m);
+
+}  // namespace pyrti
@@ -0,0 +1,94 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include "PyConnext.hpp"
+#include "PyCondition.hpp"
+#include "PyDataReader.hpp"
+#include <dds/core/cond/WaitSet.hpp>
+#include <rti/core/SequenceNumber.hpp>
+#include <memory>
+#include <mutex>
+
+namespace pyrti {
+
+// The native core of a Requester, Replier or SimpleReplier (rti.request).
+//
+// It waits for the samples received by the DataReader, counts them and
+// correlates the replies with their request without converting any sample to
+// Python, so the GIL is released for the whole wait. Only the samples that
+// are finally taken or read are converted by the Python DataReader.
+class PyRequestReplyCore {
+public:
+    explicit PyRequestReplyCore(PyIDataReader& reader);
+
+    // Waits until min_count samples are available or max_wait expires.
+    // Returns false on timeout.
+    bool wait_for_samples(const dds::core::Duration& max_wait, int32_t min_count);
+
+    // Waits until min_count replies to the request with this sequence number
+    // are available or max_wait expires. Returns false on timeout.
+    bool wait_for_related_samples(
+            const dds::core::Duration& max_wait,
+            int32_t min_count,
+            const rti::core::SequenceNumber& related_sn);
+
+    // A condition that selects all the samples related to the request with
+    // this sequence number. The conditions of the last request are reused,
+    // since a request is usually waited for and then taken.
+    PyReadCondition related_samples_condition(
+            const rti::core::SequenceNumber& related_sn);
+
+    // Closes the conditions; it must be called before closing the DataReader
+    void close();
+
+    bool closed() const;
+
+private:
+    struct CorrelationConditions {
+        CorrelationConditions(
+                const dds::sub::AnyDataReader& reader,
+                const rti::core::SequenceNumber& related_sn);
+
+        rti::core::SequenceNumber sequence_number;
+        dds::sub::cond::ReadCondition any_sample;
+        dds::sub::cond::ReadCondition not_read_sample;
+    };
+
+    std::shared_ptr<CorrelationConditions> correlation_conditions(
+            const rti::core::SequenceNumber& related_sn);
+
+    void assert_not_closed() const;
+
+    // Waits until the samples that match initial_condition, plus the ones
+    // that later trigger the condition attached to the waitset, are at least
+    // min_count
+    bool wait_for_samples(
+            dds::core::cond::WaitSet& waitset,
+            const dds::sub::cond::ReadCondition& initial_condition,
+            const dds::sub::cond::ReadCondition& condition,
+            const dds::core::Duration& max_wait,
+            int32_t min_count);
+
+    PyIDataReader& reader_;
+    dds::sub::AnyDataReader any_reader_;
+    dds::sub::cond::ReadCondition any_sample_condition_;
+    dds::sub::cond::ReadCondition not_read_sample_condition_;
+    dds::core::cond::WaitSet waitset_;
+    std::shared_ptr<CorrelationConditions> last_correlation_conditions_;
+    bool closed_;
+    mutable std::mutex mutex_;
+};
+
+void init_request_reply_core(py::module& m);
+
+}  // namespace pyrti
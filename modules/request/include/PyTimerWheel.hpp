@@ -0,0 +1,134 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace pyrti {
+
+// A hashed timer wheel: scheduling a timer is O(1) and advancing the wheel
+// only visits the slots of the ticks that passed, regardless of how many
+// timers are scheduled.
+//
+// Timers can't be cancelled; instead, each one has a unique id and the owner
+// ignores the expired timers whose id is no longer current (for example,
+// because the operation they timed already finished).
+//
+// The wheel isn't thread-safe.
+template<typename Key>
+class PyTimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Timer {
+        Key key;
+        uint64_t id;
+    };
+
+    PyTimerWheel(Clock::duration tick, size_t slot_count)
+            : tick_(tick),
+              slots_(slot_count),
+              start_(Clock::now()),
+              current_tick_(0),
+              next_id_(1),
+              size_(0)
+    {
+    }
+
+    // Schedules a timer that expires at the deadline (rounded up to the next
+    // tick) and returns its id
+    uint64_t schedule(const Key& key, Clock::time_point deadline)
+    {
+        uint64_t deadline_tick = 0;
+        if (deadline > start_) {
+            deadline_tick = static_cast<uint64_t>(
+                    (deadline - start_ + tick_ - Clock::duration(1)) / tick_);
+        }
+        if (deadline_tick <= current_tick_) {
+            deadline_tick = current_tick_ + 1;
+        }
+
+        uint64_t id = next_id_++;
+        slots_[deadline_tick % slots_.size()].push_back(
+                Entry { Timer { key, id }, deadline_tick });
+        size_++;
+        return id;
+    }
+
+    // Moves the timers that expired by now into expired
+    void advance(Clock::time_point now, std::vector<Timer>& expired)
+    {
+        uint64_t target_tick = tick_of(now);
+        if (target_tick <= current_tick_) {
+            return;
+        }
+
+        // Each slot needs to be visited once at most
+        uint64_t first_tick = current_tick_ + 1;
+        if (target_tick - current_tick_ > slots_.size()) {
+            first_tick = target_tick - slots_.size() + 1;
+        }
+        for (uint64_t tick = first_tick; tick <= target_tick; tick++) {
+            auto& slot = slots_[tick % slots_.size()];
+            size_t kept = 0;
+            for (auto& entry : slot) {
+                if (entry.deadline_tick <= target_tick) {
+                    expired.push_back(std::move(entry.timer));
+                    size_--;
+                } else {
+                    // Expires in a later round of the wheel
+                    if (&slot[kept] != &entry) {
+                        slot[kept] = std::move(entry);
+                    }
+                    kept++;
+                }
+            }
+            slot.erase(slot.begin() + kept, slot.end());
+        }
+        current_tick_ = target_tick;
+    }
+
+    Clock::duration tick() const
+    {
+        return tick_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+private:
+    struct Entry {
+        Timer timer;
+        uint64_t deadline_tick;
+    };
+
+    uint64_t tick_of(Clock::time_point time) const
+    {
+        if (time <= start_) {
+            return 0;
+        }
+        return static_cast<uint64_t>((time - start_) / tick_);
+    }
+
+    Clock::duration tick_;
+    std::vector<std::vector<Entry>> slots_;
+    Clock::time_point start_;
+    uint64_t current_tick_;
+    uint64_t next_id_;
+    size_t size_;
+};
+
+}  // namespace pyrti
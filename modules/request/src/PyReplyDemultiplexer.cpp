@@ -0,0 +1,660 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyReplyDemultiplexer.hpp"
+#include "PyInterpreterLocal.hpp"
+#include "PySampleInfoView.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace pyrti {
+
+// The number of slots of the timer wheel; timeouts longer than one round of
+// the wheel are supported, but take more than one visit of their slot
+static const size_t TIMER_WHEEL_SLOTS = 512;
+
+size_t SampleIdentityHash::operator()(
+        const rti::core::SampleIdentity& identity) const
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    auto guid = identity.writer_guid();
+    for (uint32_t i = 0; i < guid.LENGTH; i++) {
+        hash = (hash ^ guid[i]) * 1099511628211ULL;
+    }
+    auto sn = static_cast<uint64_t>(identity.sequence_number().value());
+    for (int i = 0; i < 8; i++) {
+        hash = (hash ^ ((sn >> (i * 8)) & 0xff)) * 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+static std::chrono::nanoseconds to_chrono(const dds::core::Duration& duration)
+{
+    return std::chrono::seconds(duration.sec())
+            + std::chrono::nanoseconds(duration.nanosec());
+}
+
+// The info of a sample taken from an IDL DataReader is a SampleInfoView
+static const dds::sub::SampleInfo& sample_info_of(const py::object& info)
+{
+    if (py::isinstance<PySampleInfoView>(info)) {
+        return info.cast<const PySampleInfoView&>().get();
+    }
+    return info.cast<const dds::sub::SampleInfo&>();
+}
+
+static bool interpreter_finalizing()
+{
+#if PY_VERSION_HEX >= 0x030D0000
+    return Py_IsFinalizing();
+#else
+    return _Py_IsFinalizing();
+#endif
+}
+
+// The demultiplexers of this interpreter that are still alive, closed when
+// it exits
+struct PyReplyDemultiplexerRegistry {
+    std::vector<std::weak_ptr<PyReplyDemultiplexer>> demultiplexers;
+};
+
+// @pre The GIL must be held
+static PyReplyDemultiplexerRegistry& demultiplexer_registry()
+{
+    return interpreter_local<PyReplyDemultiplexerRegistry>(
+            "rti.request.reply_demultiplexers");
+}
+
+static void close_all_demultiplexers()
+{
+    std::vector<std::weak_ptr<PyReplyDemultiplexer>> demultiplexers;
+    demultiplexers.swap(demultiplexer_registry().demultiplexers);
+    for (auto& weak_demultiplexer : demultiplexers) {
+        if (auto demultiplexer = weak_demultiplexer.lock()) {
+            demultiplexer->close();
+        }
+    }
+}
+
+std::shared_ptr<PyReplyDemultiplexer> PyReplyDemultiplexer::create(
+        PyIDataReader& reader,
+        py::object take,
+        const dds::core::Duration& tick,
+        const dds::core::Duration& max_unclaimed_wait)
+{
+    if (tick == dds::core::Duration::zero()
+        || tick == dds::core::Duration::infinite()) {
+        throw dds::core::InvalidArgumentError("tick must be a finite duration");
+    }
+
+    std::shared_ptr<PyReplyDemultiplexer> demultiplexer(
+            new PyReplyDemultiplexer(
+                    reader,
+                    std::move(take),
+                    tick,
+                    max_unclaimed_wait));
+    demultiplexer->start();
+
+    auto& registry = demultiplexer_registry().demultiplexers;
+    registry.erase(
+            std::remove_if(
+                    registry.begin(),
+                    registry.end(),
+                    [](const std::weak_ptr<PyReplyDemultiplexer>& d) {
+                        return d.expired();
+                    }),
+            registry.end());
+    registry.push_back(demultiplexer);
+    return demultiplexer;
+}
+
+PyReplyDemultiplexer::PyReplyDemultiplexer(
+        PyIDataReader& reader,
+        py::object take,
+        const dds::core::Duration& tick,
+        const dds::core::Duration& max_unclaimed_wait)
+        : reader_(reader.get_any_datareader()),
+          read_condition_(rti::sub::cond::create_read_condition_ex(
+                  reader_,
+                  dds::sub::status::DataState::any())),
+          take_(std::move(take)),
+          tick_(tick),
+          max_unclaimed_wait_(to_chrono(max_unclaimed_wait)),
+          timer_wheel_(
+                  std::chrono::duration_cast<Clock::duration>(to_chrono(tick)),
+                  TIMER_WHEEL_SLOTS)
+{
+    // The future may have been cancelled before the loop runs this
+    set_future_result_ = py::cpp_function(
+            [](py::object future, py::object result, bool is_exception) {
+                if (future.attr("done")().cast<bool>()) {
+                    return;
+                }
+                if (is_exception) {
+                    future.attr("set_exception")(result);
+                } else {
+                    future.attr("set_result")(result);
+                }
+            });
+
+    waitset_.attach_condition(read_condition_);
+    waitset_.attach_condition(wake_condition_);
+}
+
+PyReplyDemultiplexer::~PyReplyDemultiplexer()
+{
+    close();
+    if (thread_.joinable()) {
+        // The dispatch thread released the last reference
+        thread_.detach();
+    }
+
+    if (!PyGILState_Check() && interpreter_finalizing()) {
+        // The GIL can't be acquired anymore; the objects are leaked
+        take_.release();
+        set_future_result_.release();
+        return;
+    }
+    py::gil_scoped_acquire acquire;
+    take_ = py::object();
+    set_future_result_ = py::object();
+}
+
+void PyReplyDemultiplexer::start()
+{
+    // The thread doesn't keep the demultiplexer alive: when its owner
+    // releases it, the destructor stops the thread
+    std::weak_ptr<PyReplyDemultiplexer> weak_self = shared_from_this();
+    thread_ = std::thread([weak_self]() { run(weak_self); });
+}
+
+py::object PyReplyDemultiplexer::receive_replies_async(
+        const rti::core::SampleIdentity& related_request_id,
+        const dds::core::Duration& max_wait,
+        int32_t min_count)
+{
+    auto loop = py::module::import("asyncio").attr("get_running_loop")();
+    auto future = loop.attr("create_future")();
+
+    PendingReplies pending;
+    pending.min_count = min_count;
+    pending.future = future;
+    auto registration =
+            register_pending(related_request_id, std::move(pending), max_wait);
+
+    // When the caller cancels the future, stop waiting for the replies. When
+    // the future completes normally, it's no longer pending and this does
+    // nothing.
+    std::weak_ptr<PyReplyDemultiplexer> weak_self = shared_from_this();
+    future.attr("add_done_callback")(py::cpp_function(
+            [weak_self, related_request_id, registration](py::object) {
+                if (auto self = weak_self.lock()) {
+                    self->cancel(related_request_id, registration);
+                }
+            }));
+    return future;
+}
+
+py::list PyReplyDemultiplexer::receive_replies(
+        const rti::core::SampleIdentity& related_request_id,
+        const dds::core::Duration& max_wait,
+        int32_t min_count)
+{
+    auto waiter = std::make_shared<SyncWaiter>();
+    PendingReplies pending;
+    pending.min_count = min_count;
+    pending.waiter = waiter;
+    register_pending(related_request_id, std::move(pending), max_wait);
+
+    {
+        py::gil_scoped_release release;
+        std::unique_lock<std::mutex> lock(waiter->mutex);
+        waiter->condition.wait(lock, [&waiter]() { return waiter->done; });
+    }
+
+    std::vector<py::object> replies;
+    Status status;
+    {
+        std::lock_guard<std::mutex> lock(waiter->mutex);
+        replies = std::move(waiter->replies);
+        status = waiter->status;
+    }
+
+    if (status == Status::TIMED_OUT) {
+        throw dds::core::TimeoutError("Timed out waiting for replies");
+    } else if (status == Status::CLOSED) {
+        throw dds::core::AlreadyClosedError(
+                "The reply demultiplexer has been closed");
+    } else if (status == Status::FAILED) {
+        throw dds::core::Error(failure());
+    }
+
+    py::list result;
+    for (auto& reply : replies) {
+        result.append(std::move(reply));
+    }
+    return result;
+}
+
+void PyReplyDemultiplexer::close()
+{
+    stopped_ = true;
+    wake_condition_.trigger_value(true);
+
+    {
+        std::lock_guard<std::mutex> lock(join_mutex_);
+        if (thread_.joinable()
+            && thread_.get_id() != std::this_thread::get_id()) {
+            if (PyGILState_Check()) {
+                py::gil_scoped_release release;
+                thread_.join();
+            } else {
+                thread_.join();
+            }
+        }
+    }
+
+    // Fail the callers that are still waiting
+    fail_pending(Status::CLOSED);
+}
+
+void PyReplyDemultiplexer::fail_pending(Status status)
+{
+    std::vector<Completion> completions;
+    std::unordered_map<
+            rti::core::SampleIdentity,
+            UnclaimedReplies,
+            SampleIdentityHash>
+            unclaimed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& entry : pending_) {
+            completions.push_back(
+                    Completion { std::move(entry.second), status });
+        }
+        pending_.clear();
+        unclaimed.swap(unclaimed_);
+    }
+
+    if (!completions.empty() || !unclaimed.empty()) {
+        py::gil_scoped_acquire acquire;
+        complete(completions);
+        unclaimed.clear();
+    }
+}
+
+void PyReplyDemultiplexer::fail(const char* reason)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failure_ = std::string("The reply demultiplexer stopped: ") + reason;
+    }
+    stopped_ = true;
+    fail_pending(Status::FAILED);
+}
+
+std::string PyReplyDemultiplexer::failure() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failure_;
+}
+
+size_t PyReplyDemultiplexer::pending_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+void PyReplyDemultiplexer::run(std::weak_ptr<PyReplyDemultiplexer> weak_self)
+{
+    // How often an idle demultiplexer checks if it was released
+    const dds::core::Duration idle_period(1, 0);
+
+    std::vector<Timer> expired;
+    while (true) {
+        auto self = weak_self.lock();
+        if (self == nullptr || self->stopped_) {
+            return;
+        }
+
+        dds::core::cond::WaitSet waitset = self->waitset_;
+        bool timers_scheduled;
+        {
+            std::lock_guard<std::mutex> lock(self->mutex_);
+            timers_scheduled = !self->timer_wheel_.empty();
+        }
+        auto timeout = timers_scheduled ? self->tick_ : idle_period;
+
+        // Don't keep the demultiplexer alive while waiting
+        self.reset();
+        bool wait_failed = false;
+        std::string wait_error;
+        try {
+            dds::core::cond::WaitSet::ConditionSeq active_conditions;
+            waitset.wait(active_conditions, timeout);
+        } catch (const dds::core::TimeoutError&) {
+        } catch (const std::exception& ex) {
+            // For example, if the reader was closed
+            wait_failed = true;
+            wait_error = ex.what();
+        }
+
+        self = weak_self.lock();
+        if (self == nullptr || self->stopped_) {
+            return;
+        }
+        if (wait_failed) {
+            self->fail(wait_error.c_str());
+            return;
+        }
+
+        try {
+            self->wake_condition_.trigger_value(false);
+            {
+                std::lock_guard<std::mutex> lock(self->mutex_);
+                self->timer_wheel_.advance(Clock::now(), expired);
+            }
+
+            bool replies_available = self->read_condition_.trigger_value();
+            if (replies_available || !expired.empty()) {
+                self->dispatch(replies_available, expired);
+            }
+            expired.clear();
+        } catch (const std::exception& ex) {
+            // Nothing would complete the pending requests anymore
+            self->fail(ex.what());
+            return;
+        }
+    }
+}
+
+void PyReplyDemultiplexer::dispatch(
+        bool take_replies,
+        const std::vector<Timer>& expired)
+{
+    struct Reply {
+        rti::core::SampleIdentity related_request_id;
+        bool final;
+        py::object sample;
+    };
+
+    py::gil_scoped_acquire acquire;
+    if (stopped_) {
+        return;
+    }
+
+    std::vector<Reply> replies;
+    std::vector<Completion> completions;
+    std::vector<UnclaimedReplies> dropped;
+    try {
+        if (take_replies) {
+            py::list samples = take_();
+            replies.reserve(samples.size());
+            for (auto sample : samples) {
+                const auto& info = sample_info_of(sample.cast<py::tuple>()[1]);
+                if (!info.valid()) {
+                    continue;
+                }
+                bool final = (info->flag().to_ullong()
+                              & DDS_INTERMEDIATE_REPLY_SEQUENCE_SAMPLE)
+                        == 0;
+                replies.push_back(Reply {
+                        info->related_original_publication_virtual_sample_identity(),
+                        final,
+                        py::reinterpret_borrow<py::object>(sample) });
+            }
+        }
+    } catch (py::error_already_set& ex) {
+        // The replies can't be taken anymore (for example, the reader was
+        // closed); the GIL is still held to destroy ex
+        throw std::runtime_error(ex.what());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        for (auto& reply : replies) {
+            auto it = pending_.find(reply.related_request_id);
+            if (it != pending_.end()) {
+                auto& pending = it->second;
+                pending.replies.push_back(std::move(reply.sample));
+                pending.final_received = pending.final_received || reply.final;
+                if (pending.complete()) {
+                    completions.push_back(Completion { std::move(pending),
+                                                       Status::RECEIVED });
+                    pending_.erase(it);
+                }
+                continue;
+            }
+
+            auto& unclaimed = unclaimed_[reply.related_request_id];
+            if (unclaimed.replies.empty()) {
+                unclaimed.timer_id = schedule_timer(
+                        reply.related_request_id,
+                        now
+                                + std::chrono::duration_cast<Clock::duration>(
+                                        max_unclaimed_wait_));
+            }
+            unclaimed.replies.push_back(std::move(reply.sample));
+            unclaimed.final_received = unclaimed.final_received || reply.final;
+        }
+
+        // A timer is stale when the replies it timed were already received
+        for (const auto& timer : expired) {
+            auto pending = pending_.find(timer.key);
+            if (pending != pending_.end()
+                && pending->second.timer_id == timer.id) {
+                completions.push_back(Completion { std::move(pending->second),
+                                                   Status::TIMED_OUT });
+                pending_.erase(pending);
+                continue;
+            }
+
+            auto unclaimed = unclaimed_.find(timer.key);
+            if (unclaimed != unclaimed_.end()
+                && unclaimed->second.timer_id == timer.id) {
+                dropped.push_back(std::move(unclaimed->second));
+                unclaimed_.erase(unclaimed);
+            }
+        }
+    }
+
+    complete(completions);
+}
+
+uint64_t PyReplyDemultiplexer::register_pending(
+        const rti::core::SampleIdentity& related_request_id,
+        PendingReplies pending,
+        const dds::core::Duration& max_wait)
+{
+    if (pending.min_count == dds::core::LENGTH_UNLIMITED) {
+        // Wait for the final reply
+        pending.min_count = std::numeric_limits<int32_t>::max();
+    } else if (pending.min_count <= 0) {
+        throw dds::core::InvalidArgumentError(
+                "min_count must be a positive number or LENGTH_UNLIMITED");
+    }
+
+    uint64_t registration;
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            if (!failure_.empty()) {
+                throw dds::core::Error(failure_);
+            }
+            throw dds::core::AlreadyClosedError(
+                    "The reply demultiplexer has been closed");
+        }
+        if (pending_.count(related_request_id) > 0) {
+            throw dds::core::PreconditionNotMetError(
+                    "Already waiting for the replies to this request");
+        }
+
+        registration = next_registration_++;
+        pending.registration = registration;
+
+        auto unclaimed = unclaimed_.find(related_request_id);
+        if (unclaimed != unclaimed_.end()) {
+            pending.replies = std::move(unclaimed->second.replies);
+            pending.final_received = unclaimed->second.final_received;
+            unclaimed_.erase(unclaimed);
+        }
+
+        if (pending.complete()) {
+            completions.push_back(
+                    Completion { std::move(pending), Status::RECEIVED });
+        } else {
+            if (max_wait != dds::core::Duration::infinite()) {
+                pending.timer_id = schedule_timer(
+                        related_request_id,
+                        Clock::now()
+                                + std::chrono::duration_cast<Clock::duration>(
+                                        to_chrono(max_wait)));
+            }
+            pending_.emplace(related_request_id, std::move(pending));
+        }
+    }
+
+    complete(completions);
+    return registration;
+}
+
+void PyReplyDemultiplexer::cancel(
+        const rti::core::SampleIdentity& related_request_id,
+        uint64_t registration)
+{
+    PendingReplies cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(related_request_id);
+        if (it != pending_.end() && it->second.registration == registration) {
+            cancelled = std::move(it->second);
+            pending_.erase(it);
+        }
+    }
+    // The replies received so far are released here, without the lock
+}
+
+void PyReplyDemultiplexer::complete(std::vector<Completion>& completions)
+{
+    for (auto& completion : completions) {
+        auto& pending = completion.pending;
+        if (pending.waiter != nullptr) {
+            {
+                std::lock_guard<std::mutex> lock(pending.waiter->mutex);
+                pending.waiter->replies = std::move(pending.replies);
+                pending.waiter->status = completion.status;
+                pending.waiter->done = true;
+            }
+            pending.waiter->condition.notify_all();
+            continue;
+        }
+
+        try {
+            py::object result;
+            if (completion.status == Status::RECEIVED) {
+                py::list replies;
+                for (auto& reply : pending.replies) {
+                    replies.append(std::move(reply));
+                }
+                result = std::move(replies);
+            } else {
+                auto dds = py::module::import("rti.connextdds");
+                if (completion.status == Status::TIMED_OUT) {
+                    result = dds.attr("TimeoutError")(
+                            "Timed out waiting for replies");
+                } else if (completion.status == Status::CLOSED) {
+                    result = dds.attr("AlreadyClosedError")(
+                            "The reply demultiplexer has been closed");
+                } else {
+                    result = dds.attr("Error")(failure());
+                }
+            }
+
+            // The future may belong to a loop running in another thread
+            pending.future.attr("get_loop")().attr("call_soon_threadsafe")(
+                    set_future_result_,
+                    pending.future,
+                    result,
+                    completion.status != Status::RECEIVED);
+        } catch (py::error_already_set& ex) {
+            // For example, if the loop was closed
+            ex.discard_as_unraisable("rti.request reply demultiplexer");
+        }
+    }
+    completions.clear();
+}
+
+uint64_t PyReplyDemultiplexer::schedule_timer(
+        const rti::core::SampleIdentity& key,
+        Clock::time_point deadline)
+{
+    // The dispatch thread doesn't wake up periodically while no timers are
+    // scheduled
+    bool wake_up = timer_wheel_.empty();
+    auto id = timer_wheel_.schedule(key, deadline);
+    if (wake_up) {
+        wake_condition_.trigger_value(true);
+    }
+    return id;
+}
+
+void init_reply_demultiplexer(py::module& m)
+{
+    py::class_<PyReplyDemultiplexer, std::shared_ptr<PyReplyDemultiplexer>>(
+            m,
+            "ReplyDemultiplexer")
+            .def(py::init(&PyReplyDemultiplexer::create),
+                 py::arg("reader"),
+                 py::arg("take"),
+                 py::arg("tick") = dds::core::Duration::from_millisecs(10),
+                 py::arg("max_unclaimed_wait") = dds::core::Duration(10, 0),
+                 "Create a demultiplexer that takes the replies of a "
+                 "DataReader with the take function and delivers them to the "
+                 "callers waiting for each request. The timeouts are checked "
+                 "every tick, and the replies that no caller waits for are "
+                 "dropped after max_unclaimed_wait.")
+            .def("receive_replies_async",
+                 &PyReplyDemultiplexer::receive_replies_async,
+                 py::arg("related_request_id"),
+                 py::arg("max_wait"),
+                 py::arg("min_count") = 1,
+                 "Returns a future that completes with a list of at least "
+                 "min_count replies to the request (fewer if the final reply "
+                 "is received first), or fails with TimeoutError after "
+                 "max_wait.")
+            .def("receive_replies",
+                 &PyReplyDemultiplexer::receive_replies,
+                 py::arg("related_request_id"),
+                 py::arg("max_wait"),
+                 py::arg("min_count") = 1,
+                 "Wait for a list of at least min_count replies to the "
+                 "request (fewer if the final reply is received first). "
+                 "Raises TimeoutError after max_wait.")
+            .def("close",
+                 &PyReplyDemultiplexer::close,
+                 "Stop the demultiplexer. The callers still waiting for "
+                 "replies fail with AlreadyClosedError.")
+            .def_property_readonly(
+                    "pending_count",
+                    &PyReplyDemultiplexer::pending_count,
+                    "The number of requests whose replies are being waited "
+                    "for.");
+
+    // Stop the dispatch threads before the interpreter is finalized
+    py::module::import("atexit").attr("register")(
+            py::cpp_function(&close_all_demultiplexers));
+}
+
+}  // namespace pyrti
@@ -0,0 +1,248 @@
+/*
+ * (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software solely for use with RTI products.  The Software is
+ * provided "as is", with no warranty of any type, including any warranty for
+ * fitness for any purpose. RTI is under no obligation to maintain or support
+ * the Software.  RTI shall not be liable for any incidental or consequential
+ * damages arising out of the use or inability to use the software.
+ */
+
+#include "PyRequestReplyCore.hpp"
+#include <rti/request/detail/Common.hpp>
+#include <rti/request/detail/RequesterImpl.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace pyrti {
+
+PyRequestReplyCore::CorrelationConditions::CorrelationConditions(
+        const dds::sub::AnyDataReader& reader,
+        const rti::core::SequenceNumber& related_sn)
+        : sequence_number(related_sn),
+          any_sample(rti::request::detail::create_correlation_condition(
+                  reader,
+                  dds::sub::status::SampleState::any(),
+                  related_sn)),
+          not_read_sample(rti::request::detail::create_correlation_condition(
+                  reader,
+                  dds::sub::status::SampleState::not_read(),
+                  related_sn))
+{
+}
+
+PyRequestReplyCore::PyRequestReplyCore(PyIDataReader& reader)
+        : reader_(reader),
+          any_reader_(reader.get_any_datareader()),
+          any_sample_condition_(rti::sub::cond::create_read_condition_ex(
+                  any_reader_,
+                  dds::sub::status::DataState::any())),
+          not_read_sample_condition_(rti::sub::cond::create_read_condition_ex(
+                  any_reader_,
+                  dds::sub::status::DataState(
+                          dds::sub::status::SampleState::not_read()))),
+          closed_(false)
+{
+    waitset_.attach_condition(not_read_sample_condition_);
+}
+
+bool PyRequestReplyCore::wait_for_samples(
+        const dds::core::Duration& max_wait,
+        int32_t min_count)
+{
+    assert_not_closed();
+    return wait_for_samples(
+            waitset_,
+            any_sample_condition_,
+            not_read_sample_condition_,
+            max_wait,
+            min_count);
+}
+
+bool PyRequestReplyCore::wait_for_related_samples(
+        const dds::core::Duration& max_wait,
+        int32_t min_count,
+        const rti::core::SequenceNumber& related_sn)
+{
+    auto conditions = correlation_conditions(related_sn);
+
+    // Each request uses its own waitset, so several threads can wait for
+    // different requests at the same time
+    dds::core::cond::WaitSet waitset;
+    waitset.attach_condition(conditions->not_read_sample);
+    return wait_for_samples(
+            waitset,
+            conditions->any_sample,
+            conditions->not_read_sample,
+            max_wait,
+            min_count);
+}
+
+PyReadCondition PyRequestReplyCore::related_samples_condition(
+        const rti::core::SequenceNumber& related_sn)
+{
+    return PyReadCondition(correlation_conditions(related_sn)->any_sample);
+}
+
+void PyRequestReplyCore::close()
+{
+    std::shared_ptr<CorrelationConditions> correlation_conditions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        correlation_conditions = std::move(last_correlation_conditions_);
+    }
+
+    waitset_.detach_all();
+    not_read_sample_condition_.close();
+    any_sample_condition_.close();
+    if (correlation_conditions != nullptr) {
+        correlation_conditions->any_sample.close();
+        correlation_conditions->not_read_sample.close();
+    }
+}
+
+bool PyRequestReplyCore::closed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+}
+
+std::shared_ptr<PyRequestReplyCore::CorrelationConditions>
+PyRequestReplyCore::correlation_conditions(
+        const rti::core::SequenceNumber& related_sn)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            throw dds::core::AlreadyClosedError(
+                    "This request-reply object has already been closed");
+        }
+        if (last_correlation_conditions_ != nullptr
+            && last_correlation_conditions_->sequence_number == related_sn) {
+            return last_correlation_conditions_;
+        }
+    }
+
+    // Created without the lock; if another thread replaced the cached
+    // conditions in the meantime, the last ones win
+    auto conditions =
+            std::make_shared<CorrelationConditions>(any_reader_, related_sn);
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_correlation_conditions_ = conditions;
+    return conditions;
+}
+
+void PyRequestReplyCore::assert_not_closed() const
+{
+    if (closed()) {
+        throw dds::core::AlreadyClosedError(
+                "This request-reply object has already been closed");
+    }
+}
+
+bool PyRequestReplyCore::wait_for_samples(
+        dds::core::cond::WaitSet& waitset,
+        const dds::sub::cond::ReadCondition& initial_condition,
+        const dds::sub::cond::ReadCondition& condition,
+        const dds::core::Duration& max_wait,
+        int32_t min_count)
+{
+    using Clock = std::chrono::steady_clock;
+
+    if (min_count == dds::core::LENGTH_UNLIMITED) {
+        min_count = std::numeric_limits<int32_t>::max();
+    }
+
+    // Reading the samples marks them as read, so the condition (not read
+    // samples only) is then triggered only by the new samples
+    min_count -= reader_.py_count_samples(initial_condition, min_count);
+
+    const bool infinite = max_wait == dds::core::Duration::infinite();
+    const auto deadline = infinite
+            ? Clock::time_point::max()
+            : Clock::now() + std::chrono::microseconds(max_wait.to_microsecs());
+
+    while (min_count > 0) {
+        auto timeout = max_wait;
+        if (!infinite) {
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+                    deadline - Clock::now());
+            timeout = dds::core::Duration::from_microsecs(
+                    std::max<int64_t>(0, remaining.count()));
+        }
+
+        dds::core::cond::WaitSet::ConditionSeq active_conditions;
+        try {
+            waitset.wait(active_conditions, timeout);
+        } catch (const dds::core::TimeoutError&) {
+            return false;
+        }
+
+        // The waitset only has one condition
+        if (active_conditions.size() != 1) {
+            return false;
+        }
+
+        if (min_count > 1) {
+            min_count -= reader_.py_count_samples(condition, min_count);
+        } else {
+            // Don't read the only sample missing, so it can be taken
+            min_count -= 1;
+        }
+    }
+
+    return true;
+}
+
+void init_request_reply_core(py::module& m)
+{
+    py::class_<PyRequestReplyCore>(m, "RequestReplyCore")
+            .def(py::init<PyIDataReader&>(),
+                 py::arg("reader"),
+                 py::keep_alive<1, 2>(),
+                 py::call_guard<py::gil_scoped_release>(),
+                 "Create the native core of a request-reply object that "
+                 "receives samples with this DataReader.")
+            .def("wait_for_samples",
+                 (bool (PyRequestReplyCore::*)(
+                         const dds::core::Duration&,
+                         int32_t))
+                         & PyRequestReplyCore::wait_for_samples,
+                 py::arg("max_wait"),
+                 py::arg("min_count"),
+                 py::call_guard<py::gil_scoped_release>(),
+                 "Wait until min_count samples are available or max_wait "
+                 "expires. Returns False on timeout.")
+            .def("wait_for_related_samples",
+                 &PyRequestReplyCore::wait_for_related_samples,
+                 py::arg("max_wait"),
+                 py::arg("min_count"),
+                 py::arg("related_sequence_number"),
+                 py::call_guard<py::gil_scoped_release>(),
+                 "Wait until min_count replies to the request with this "
+                 "sequence number are available or max_wait expires. Returns "
+                 "False on timeout.")
+            .def("related_samples_condition",
+                 &PyRequestReplyCore::related_samples_condition,
+                 py::arg("related_sequence_number"),
+                 py::call_guard<py::gil_scoped_release>(),
+                 "A ReadCondition that selects the samples related to the "
+                 "request with this sequence number.")
+            .def("close",
+                 &PyRequestReplyCore::close,
+                 py::call_guard<py::gil_scoped_release>(),
+                 "Close the conditions. Must be called before closing the "
+                 "DataReader.")
+            .def_property_readonly(
+                    "closed",
+                    &PyRequestReplyCore::closed,
+                    "Whether the core has been closed.");
+}
+
+}  // namespace pyrti
@@ -12,8 +12,11 @@
 
 #include "PyConnext.hpp"
 #include "PyCondition.hpp"
+#include "PyReplyDemultiplexer.hpp"
+#include "PyRequestReplyCore.hpp"
 #include <rti/request/detail/Common.hpp>
 #include <rti/request/detail/RequesterImpl.hpp>
+#include <rti/pub/WriteParams.hpp>
 namespace pyrti {
 
 pyrti::PyReadCondition create_correlation_condition(
@@ -33,6 +36,37 @@ void create_correlation_index(pyrti::PyIAnyDataReader& reader)
     rti::request::detail::create_correlation_index(reader.get_any_datareader()->native_reader());
 }
 
+
+void validate_related_request_id(const rti::core::SampleIdentity& related_request_id)
+{
+    const auto& guid = related_request_id.writer_guid();
+    if (guid == rti::core::Guid::automatic() || guid == rti::core::Guid::unknown()) {
+        throw dds::core::InvalidArgumentError("related_request_id.writer_guid");
+    }
+
+    const auto& sn = related_request_id.sequence_number();
+    if (sn == rti::core::SequenceNumber::automatic()
+            || sn == rti::core::SequenceNumber::unknown()
+            || sn == rti::core::SequenceNumber::maximum()
+            || sn == rti::core::SequenceNumber::zero()) {
+        throw dds::core::InvalidArgumentError("related_request_id.sequence_number");
+    }
+}
+
+
+rti::pub::WriteParams create_reply_params(
+    const rti::core::SampleIdentity& related_request_id,
+    bool final)
+{
+    validate_related_request_id(related_request_id);
+    rti::pub::WriteParams params;
+    params.related_sample_identity(related_request_id);
+    if (!final) {
+        params.flag(rti::core::SampleFlag::intermediate_reply_sequence());
+    }
+    return params;
+}
+
 }
 
 
@@ -55,4 +89,20 @@ PYBIND11_MODULE(_util_native, m) {
         py::call_guard<py::gil_scoped_release>()
     );
 
+    m.def(
+        "validate_related_request_id",
+        &pyrti::validate_related_request_id,
+        py::arg("related_request_id")
+    );
+
+    m.def(
+        "create_reply_params",
+        &pyrti::create_reply_params,
+        py::arg("related_request_id"),
+        py::arg("final")
+    );
+
+    pyrti::init_request_reply_core(m);
+    pyrti::init_reply_demultiplexer(m);
+
 }
\ No newline at end of file
@@ -133,13 +133,66 @@ class WaitSetAsyncDispatcher:
                 raise
 
 
+class FdWaitSetAsyncDispatcher(WaitSetAsyncDispatcher):
+    """Dispatcher that doesn't use executor threads.
+
+    A native thread waits for the conditions and signals a file descriptor
+    that the event loop monitors with loop.add_reader(); the conditions are
+    then dispatched in the loop thread. Requires an event loop that supports
+    add_reader() (not available in the Windows ProactorEventLoop).
+    """
+
+    def __init__(self):
+        self.waitset = dds._WaitSetFdNotifier()
+        self.run_task = None
+        self.finish_event = asyncio.Event()
+        self.cancel_token = None
+        self._loop = None
+
+    class CancelToken:
+        def __init__(self, dispatcher: "FdWaitSetAsyncDispatcher"):
+            self._dispatcher = dispatcher
+
+        async def cancel(self):
+            self._dispatcher._stop()
+
+    def _stop(self):
+        if self._loop is not None:
+            self._loop.remove_reader(self.waitset.fileno())
+            self._loop = None
+        self.waitset.close()
+        self.finish_event.set()
+
+    def run(self) -> CancelToken:
+        loop = asyncio.get_running_loop()
+        # Raises NotImplementedError if the loop doesn't support it
+        loop.add_reader(self.waitset.fileno(), self.waitset.dispatch)
+        self._loop = loop
+        self.run_task = FdWaitSetAsyncDispatcher.CancelToken(self)
+        self.cancel_token = self.run_task
+        return self.run_task
+
+
+def _create_dispatcher() -> WaitSetAsyncDispatcher:
+    if hasattr(dds, "_WaitSetFdNotifier"):
+        dispatcher = FdWaitSetAsyncDispatcher()
+        try:
+            dispatcher.run()
+            return dispatcher
+        except NotImplementedError:
+            dispatcher.waitset.close()
+
+    dispatcher = WaitSetAsyncDispatcher()
+    dispatcher.run()
+    return dispatcher
+
+
 _DEFAULT_DISPATCHER = None
 
 def get_default_dispatcher() -> WaitSetAsyncDispatcher:
     global _DEFAULT_DISPATCHER
     if _DEFAULT_DISPATCHER is None:
-        _DEFAULT_DISPATCHER = WaitSetAsyncDispatcher()
-        _DEFAULT_DISPATCHER.run()
+        _DEFAULT_DISPATCHER = _create_dispatcher()
     return _DEFAULT_DISPATCHER
 
 
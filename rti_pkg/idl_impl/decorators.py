@@ -25,9 +25,15 @@ class SerializationOptions:
     The singleton variable that can be modified is called serialization_options.
     It must be modified before the definition of the @struct- or
     @union-decorated types for which the options are to be applied.
+
+    - allow_primitive_lists: allows lists in sequences of primitives whose
+      default collection supports the buffer protocol (e.g. array.array).
+    - use_native_programs: convert samples from Python to C with compiled
+      native code instead of the Python interpreter where possible.
     """
 
     allow_primitive_lists: bool = True
+    use_native_programs: bool = True
 
 
 serialization_options = SerializationOptions()
@@ -37,7 +43,8 @@ def _get_sample_program_options(
     serialization_options: SerializationOptions
 ) -> sample_interpreter.SampleProgramOptions:
     return sample_interpreter.SampleProgramOptions(
-        allow_primitive_lists=serialization_options.allow_primitive_lists)
+        allow_primitive_lists=serialization_options.allow_primitive_lists,
+        use_native_programs=serialization_options.use_native_programs)
 
 
 def _get_current_sample_program_options():
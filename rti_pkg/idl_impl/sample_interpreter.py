@@ -21,6 +21,7 @@
 from typing import Any, List, Dict, Tuple, Sequence, Callable, Optional
 from dataclasses import dataclass, fields, MISSING
 import itertools
+import ctypes
 import abc
 
 import rti.connextdds as dds
@@ -787,6 +788,10 @@ class SampleProgram:
     def __init__(self, instructions: List[Instruction], type_plugin: dds._TypePlugin = None) -> None:
         self.instructions = instructions
         self.type_plugin = type_plugin
+        # Compiled version of this program: a dds._NativeSampleProgram for
+        # Python-to-C programs or a dds._NativeCToPySampleProgram for
+        # C-to-Python programs
+        self.native_program = None
 
     def execute(self, dst, src):
         """Runs all the instructions of this program"""
@@ -851,6 +856,8 @@ class UnionSampleProgram:
         self.default_instruction: Optional[Instruction] = instructions.get(
             DEFAULT_LABEL)
         self.type_plugin = type_plugin
+        # Unions are not compiled
+        self.native_program = None
 
     def execute(self, dst, src):
         """Runs the discriminator instruction followed by the instruction it
@@ -895,9 +902,311 @@ class UnionSampleProgram:
         return f"UnionSampleProgram({len(self.instructions)})"
 
 
+# --- Native programs ---------------------------------------------------------
+
+_NativeKind = dds._NativeSampleProgram.PrimitiveKind
+
+_CTYPES_TO_NATIVE_PRIMITIVE_KIND = {
+    ctypes.c_int8: _NativeKind.INT8,
+    ctypes.c_uint8: _NativeKind.UINT8,
+    ctypes.c_int16: _NativeKind.INT16,
+    ctypes.c_uint16: _NativeKind.UINT16,
+    ctypes.c_int32: _NativeKind.INT32,
+    ctypes.c_uint32: _NativeKind.UINT32,
+    ctypes.c_int64: _NativeKind.INT64,
+    ctypes.c_uint64: _NativeKind.UINT64,
+    ctypes.c_float: _NativeKind.FLOAT32,
+    ctypes.c_double: _NativeKind.FLOAT64
+}
+
+
+def _get_complete_native_program(program) -> Optional[dds._NativeSampleProgram]:
+    """Returns the native program of a nested type only if it can run
+    without Python fallbacks"""
+
+    native_program = getattr(program, 'native_program', None)
+    if native_program is None or not native_program.is_complete:
+        return None
+    return native_program
+
+
+def _add_native_instruction(
+    native_program: dds._NativeSampleProgram,
+    instruction: Instruction,
+    c_member_type: type,
+    offset: int
+) -> bool:
+    """Adds the native equivalent of a Python-to-C instruction. Returns False
+    if the instruction doesn't have one."""
+
+    if instruction.is_optional:
+        return False
+
+    field_name = instruction.field_name
+    if isinstance(instruction, (CopyPrimitiveToCInstruction, CopyIntEnumToInt32Instruction)):
+        kind = _CTYPES_TO_NATIVE_PRIMITIVE_KIND.get(c_member_type)
+        if kind is None:
+            return False
+        native_program.add_primitive(field_name, offset, kind)
+    elif isinstance(instruction, CopyStrToBytesInstructionMixin):
+        native_program.add_string(
+            field_name,
+            offset,
+            bound=instruction.bound,
+            is_wide=isinstance(instruction, CopyWStrToBytesInstruction))
+    elif isinstance(instruction, CopyAggregationToCInstruction):
+        element_program = _get_complete_native_program(instruction.sample_program)
+        if element_program is None:
+            return False
+        native_program.add_struct(field_name, offset, element_program)
+    elif isinstance(instruction, (CopyPrimitiveListToArrayInstruction, CopyBufferToArrayInstruction)):
+        kind = _CTYPES_TO_NATIVE_PRIMITIVE_KIND.get(c_member_type._type_)
+        if kind is None:
+            return False
+        native_program.add_primitive_array(
+            field_name,
+            offset,
+            kind,
+            length=c_member_type._length_,
+            require_buffer=isinstance(instruction, CopyBufferToArrayInstruction))
+    elif isinstance(instruction, (
+            CopyPrimitiveListToSequenceInstruction,
+            CopyBufferToSequenceInstruction,
+            CopyBufferOrListToSequenceInstruction)):
+        kind = _CTYPES_TO_NATIVE_PRIMITIVE_KIND.get(c_member_type._element_type)
+        if kind is None:
+            return False
+        native_program.add_primitive_sequence(
+            field_name,
+            offset,
+            kind,
+            member_index=instruction.field_index,
+            require_buffer=isinstance(instruction, CopyBufferToSequenceInstruction))
+    elif isinstance(instruction, CopyClassListToArrayInstruction):
+        element_program = _get_complete_native_program(instruction.element_program)
+        if element_program is None:
+            return False
+        native_program.add_struct_array(
+            field_name,
+            offset,
+            element_program,
+            element_size=ctypes.sizeof(c_member_type._type_),
+            length=c_member_type._length_)
+    elif isinstance(instruction, CopyClassListToSequenceInstruction):
+        element_program = _get_complete_native_program(instruction.element_program)
+        if element_program is None:
+            return False
+        native_program.add_struct_sequence(
+            field_name,
+            offset,
+            element_program,
+            element_size=c_member_type._element_size,
+            member_index=instruction.field_index)
+    else:
+        return False
+
+    return True
+
+
+def compile_native_program(
+    program: SampleProgram,
+    c_type: type
+) -> Optional[dds._NativeSampleProgram]:
+    """Compiles a Python-to-C struct SampleProgram into a native program that
+    writes directly into the memory of a c_type sample.
+
+    Instructions without a native equivalent run the Python instruction as a
+    fallback. Returns None if no instruction can be compiled.
+    """
+
+    native_program = dds._NativeSampleProgram(program.type_plugin)
+    c_member_types = dict(c_type._fields_)
+    for instruction in program.instructions:
+        field_name = instruction.field_name
+        offset = getattr(c_type, field_name).offset
+        if not _add_native_instruction(
+                native_program, instruction, c_member_types[field_name], offset):
+            native_program.add_fallback(
+                field_name, SampleProgram([instruction], program.type_plugin))
+
+    if native_program.fallback_count == len(native_program):
+        return None
+
+    return native_program
+
+
+_NativeCollectionKind = dds._NativeCToPySampleProgram.CollectionKind
+
+_BUFFER_INSTRUCTION_TO_NATIVE_COLLECTION_KIND = {
+    CopyPrimitiveArrayToBufferInstruction: _NativeCollectionKind.FIXED_SIZE_BUFFER,
+    CopyPrimitiveSequenceToResizableBufferInstruction: _NativeCollectionKind.RESIZABLE_BUFFER,
+    CopyPrimitiveSequenceToExtendableBufferInstruction: _NativeCollectionKind.EXTENDABLE_BUFFER,
+    CopyPrimitiveSequenceToFixedSizeBufferInstruction: _NativeCollectionKind.SIZED_BUFFER
+}
+
+
+def _creates_list(factory) -> bool:
+    """Returns True if the field factory creates a list, which the native
+    C-to-Python program can create directly"""
+
+    return factory is list or type(factory()) is list
+
+
+def _add_native_c_to_py_instruction(
+    native_program: dds._NativeCToPySampleProgram,
+    instruction: Instruction,
+    c_member_type: type,
+    offset: int,
+    is_optional_field: bool
+) -> bool:
+    """Adds the native equivalent of a C-to-Python instruction. Returns False
+    if the instruction doesn't have one."""
+
+    if instruction.is_optional:
+        return False
+
+    field_name = instruction.field_name
+    factory = instruction.field_factory
+    if isinstance(instruction, CopyPrimitiveToPyInstruction):
+        kind = _CTYPES_TO_NATIVE_PRIMITIVE_KIND.get(c_member_type)
+        if kind is None:
+            return False
+        native_program.add_primitive(field_name, offset, kind)
+    elif isinstance(instruction, CopyInt32ToIntEnumInstruction):
+        native_program.add_enum(field_name, offset, instruction.enum_type)
+    elif isinstance(instruction, CopyBytesToStrInstructionMixin):
+        # Optional strings are null pointers when unset
+        native_program.add_string(
+            field_name,
+            offset,
+            is_wide=isinstance(instruction, CopyBytesToWStrInstruction),
+            null_value=None if is_optional_field else "")
+    elif isinstance(instruction, CopyAggregationToPyInstruction):
+        element_program = _get_complete_native_program(instruction.sample_program)
+        if element_program is None:
+            return False
+        native_program.add_struct(field_name, offset, element_program)
+    elif isinstance(instruction, (CopyPrimitiveArrayToListInstruction, CopyPrimitiveArrayToBufferInstruction)):
+        kind = _CTYPES_TO_NATIVE_PRIMITIVE_KIND.get(c_member_type._type_)
+        if kind is None:
+            return False
+        if isinstance(instruction, CopyPrimitiveArrayToListInstruction):
+            if not _creates_list(factory):
+                return False
+            collection_kind = _NativeCollectionKind.LIST
+        else:
+            collection_kind = _NativeCollectionKind.FIXED_SIZE_BUFFER
+        native_program.add_primitive_array(
+            field_name,
+            offset,
+            kind,
+            length=c_member_type._length_,
+            collection_kind=collection_kind,
+            factory=factory)
+    elif isinstance(instruction, (
+            CopyPrimitiveSequenceToListInstruction,
+            CopyPrimitiveSequenceToResizableBufferInstruction,
+            CopyPrimitiveSequenceToExtendableBufferInstruction,
+            CopyPrimitiveSequenceToFixedSizeBufferInstruction)):
+        kind = _CTYPES_TO_NATIVE_PRIMITIVE_KIND.get(c_member_type._element_type)
+        if kind is None:
+            return False
+        if isinstance(instruction, CopyPrimitiveSequenceToListInstruction):
+            if not _creates_list(factory):
+                return False
+            collection_kind = _NativeCollectionKind.LIST
+        else:
+            collection_kind = _BUFFER_INSTRUCTION_TO_NATIVE_COLLECTION_KIND[type(instruction)]
+        native_program.add_primitive_sequence(
+            field_name,
+            offset,
+            kind,
+            collection_kind=collection_kind,
+            factory=factory)
+    elif isinstance(instruction, CopyConstructedArrayToListInstruction):
+        element_program = _get_complete_native_program(instruction.element_program)
+        if element_program is None or not _creates_list(factory):
+            return False
+        native_program.add_struct_array(
+            field_name,
+            offset,
+            element_program,
+            element_size=ctypes.sizeof(c_member_type._type_),
+            length=c_member_type._length_)
+    elif isinstance(instruction, CopyConstructedSequenceToListInstruction):
+        element_program = _get_complete_native_program(instruction.element_program)
+        if element_program is None or not _creates_list(factory):
+            return False
+        native_program.add_struct_sequence(
+            field_name,
+            offset,
+            element_program,
+            element_size=c_member_type._element_size)
+    else:
+        return False
+
+    return True
+
+
+def _can_construct_empty(py_type: type) -> bool:
+    """Returns True if instances of py_type can be created without calling
+    __init__, and their members can be stored directly in their __dict__"""
+
+    return py_type.__new__ is object.__new__ \
+        and py_type.__setattr__ is object.__setattr__ \
+        and not hasattr(py_type, '__post_init__') \
+        and not hasattr(py_type, '__slots__')
+
+
+def compile_native_c_to_py_program(
+    program: SampleProgram,
+    type_plugin,
+    py_type: type,
+    c_type: type
+) -> Optional[dds._NativeCToPySampleProgram]:
+    """Compiles a C-to-Python struct SampleProgram into a native program that
+    creates py_type instances directly from the memory of a c_type sample.
+
+    Instructions without a native equivalent run the Python instruction as a
+    fallback. Returns None if no instruction can be compiled.
+    """
+
+    c_type_ptr = ctypes.POINTER(c_type)
+
+    def cast_c_sample(c_sample_ptr):
+        return ctypes.cast(c_sample_ptr, c_type_ptr)[0]
+
+    native_program = dds._NativeCToPySampleProgram(
+        type_plugin,
+        py_type,
+        cast_c_sample,
+        construct_empty=_can_construct_empty(py_type))
+    c_member_types = dict(c_type._fields_)
+    py_fields = {field.name: field for field in fields(py_type)}
+    for instruction in program.instructions:
+        field_name = instruction.field_name
+        offset = getattr(c_type, field_name).offset
+        is_optional_field = reflection_utils.is_optional_type(
+            reflection_utils.remove_classvar(py_fields[field_name].type))
+        if not _add_native_c_to_py_instruction(
+                native_program,
+                instruction,
+                c_member_types[field_name],
+                offset,
+                is_optional_field):
+            native_program.add_fallback(
+                field_name, SampleProgram([instruction]))
+
+    if native_program.fallback_count == len(native_program):
+        return None
+
+    return native_program
+
+
 @dataclass
 class SampleProgramOptions:
     allow_primitive_lists: bool = True
+    use_native_programs: bool = True
 
 DEFAULT_SAMPLE_PROGRAM_OPTIONS = SampleProgramOptions()
 
@@ -915,6 +1224,8 @@ class SamplePrograms:
         is_union: bool = False,
         options: SampleProgramOptions = DEFAULT_SAMPLE_PROGRAM_OPTIONS
     ):
+        if options is None:
+            options = DEFAULT_SAMPLE_PROGRAM_OPTIONS
         self.options = options
         if reflection_utils.is_enum(py_type):
             self.c_to_py_program, self.py_to_c_program = self._create_enum_programs(
@@ -931,6 +1242,11 @@ class SamplePrograms:
             else:
                 self.c_to_py_program, self.py_to_c_program = self._create_struct_programs(
                     py_type, type_plugin, member_annotations)
+                if options.use_native_programs:
+                    self.py_to_c_program.native_program = compile_native_program(
+                        self.py_to_c_program, c_type)
+                    self.c_to_py_program.native_program = compile_native_c_to_py_program(
+                        self.c_to_py_program, type_plugin, py_type, c_type)
 
     def _create_struct_programs(
         self,
@@ -10,7 +10,7 @@
 #
 
 from dataclasses import fields
-from typing import List, Any, Optional, Dict
+from typing import List, Any, Optional, Dict, Sequence, Tuple
 from enum import Enum
 import ctypes
 import rti.connextdds as dds
@@ -579,6 +579,13 @@ class TypeSupport:
             is_union=is_union,
             options=sample_program_options)
 
+        # Compiled versions of the Python-to-C and C-to-Python programs, used
+        # by the methods below and directly by the IDL DataWriter and DataReader
+        self._native_py_to_c_program = getattr(
+            self._sample_programs.py_to_c_program, 'native_program', None)
+        self._native_c_to_py_program = getattr(
+            self._sample_programs.c_to_py_program, 'native_program', None)
+
     def _create_dynamic_type(self, is_public: bool):
         if self.kind == TypeSupportKind.ENUM:
             return create_dynamic_type_from_enum(
@@ -605,13 +612,26 @@ class TypeSupport:
         c_sample = self.c_type()
         self._plugin_dynamic_type.initialize_sample(c_sample)
         try:
-            self._sample_programs.py_to_c_program.execute(
-                src=sample, dst=c_sample)
+            self._execute_py_to_c_program(c_sample, sample)
         except:
             self._plugin_dynamic_type.finalize_sample(c_sample)
             raise
         return c_sample
 
+    def _create_c_samples(self, samples):
+        c_samples = []
+        try:
+            for sample in samples:
+                c_samples.append(self._create_c_sample(sample))
+        except:
+            self._finalize_c_samples(c_samples)
+            raise
+        return c_samples
+
+    def _finalize_c_samples(self, c_samples):
+        for c_sample in c_samples:
+            self._plugin_dynamic_type.finalize_sample(c_sample)
+
     def _create_empty_c_sample(self):
         c_sample = self.c_type()
         self._plugin_dynamic_type.initialize_sample(c_sample)
@@ -619,13 +639,22 @@ class TypeSupport:
 
     def _convert_to_c_sample(self, c_sample, py_sample):
         self._plugin_dynamic_type.finalize_optional_members(c_sample)
-        self._sample_programs.py_to_c_program.execute(
-            src=py_sample, dst=c_sample)
+        self._execute_py_to_c_program(c_sample, py_sample)
+
+    def _execute_py_to_c_program(self, c_sample, py_sample):
+        if self._native_py_to_c_program is not None:
+            self._native_py_to_c_program.execute(c_sample, py_sample)
+        else:
+            self._sample_programs.py_to_c_program.execute(
+                src=py_sample, dst=c_sample)
 
     def _cast_c_sample(self, c_sample_ptr):
         return ctypes.cast(c_sample_ptr, self.c_type_ptr)[0]
 
     def _create_py_sample(self, c_sample_ptr):
+        if self._native_c_to_py_program is not None:
+            return self._native_c_to_py_program.create_sample(c_sample_ptr)
+
         py_sample = self.default_factory()
         c_sample = self._cast_c_sample(c_sample_ptr)
         self._sample_programs.c_to_py_program.execute(
@@ -633,6 +662,10 @@ class TypeSupport:
         return py_sample
 
     def _create_py_sample_no_ptr(self, c_sample):
+        if self._native_c_to_py_program is not None:
+            return self._native_c_to_py_program.create_sample(
+                ctypes.addressof(c_sample))
+
         py_sample = self.default_factory()
         self._sample_programs.c_to_py_program.execute(
             src=c_sample, dst=py_sample)
@@ -641,7 +674,7 @@ class TypeSupport:
     def get_c_data(self, c_sample_wrapper):
         return ctypes.cast(c_sample_wrapper._get_ptr(), self.c_type_ptr).contents
 
-    def serialize(self, sample):
+    def serialize(self, sample) -> bytes:
         """Serialize a data sample into a cdr byte buffer"""
 
         c_sample = self._create_c_sample(sample)
@@ -650,6 +683,57 @@ class TypeSupport:
         finally:
             self._plugin_dynamic_type.finalize_sample(c_sample)
 
+    def serialize_into(self, sample, buffer, offset: int = 0) -> int:
+        """Serialize a data sample into a writable buffer (e.g. a bytearray,
+        an mmap or a memoryview) starting at the given offset, and return the
+        number of bytes written.
+
+        Raises ValueError if the serialized sample doesn't fit in the buffer.
+        """
+
+        c_sample = self._create_c_sample(sample)
+        try:
+            return self._plugin_dynamic_type.serialize_into(
+                c_sample, buffer, offset)
+        finally:
+            self._plugin_dynamic_type.finalize_sample(c_sample)
+
+    def serialize_batch(self, samples: Sequence[Any]) -> Tuple[bytes, List[int]]:
+        """Serialize a list of samples back to back into a single cdr byte
+        buffer.
+
+        Returns the buffer and an offset table with len(samples) + 1
+        entries: sample i is buffer[offsets[i]:offsets[i + 1]].
+        """
+
+        c_samples = self._create_c_samples(samples)
+        try:
+            return self._plugin_dynamic_type.serialize_batch(c_samples)
+        finally:
+            self._finalize_c_samples(c_samples)
+
+    def serialize_batch_into(
+        self,
+        samples: Sequence[Any],
+        buffer,
+        offset: int = 0
+    ) -> List[int]:
+        """Serialize a list of samples back to back into a writable buffer
+        starting at the given offset.
+
+        Returns an offset table with len(samples) + 1 entries: sample i is
+        buffer[offsets[i]:offsets[i + 1]].
+
+        Raises ValueError if the serialized samples don't fit in the buffer.
+        """
+
+        c_samples = self._create_c_samples(samples)
+        try:
+            return self._plugin_dynamic_type.serialize_batch_into(
+                c_samples, buffer, offset)
+        finally:
+            self._finalize_c_samples(c_samples)
+
     def deserialize(self, buffer) -> Any:
         """Create a data sample for the data type for this TypeSupport by
         deserializing a cdr byte buffer
@@ -695,11 +779,26 @@ class TypeSupport:
     def to_dynamic_data(self, sample: Any) -> dds.DynamicData:
         """Converts a given idl sample to dynamic data"""
         dynamic_type = self._get_public_dynamic_type().get_dynamic_type_ref()
-        return dds.DynamicData(dynamic_type).from_cdr_buffer(self.serialize(sample))
+        data = dds.DynamicData(dynamic_type)
+        c_sample = self._create_c_sample(sample)
+        try:
+            # The members are copied natively from the C sample when
+            # possible, without serializing it
+            self._plugin_dynamic_type.to_dynamic_data(
+                c_sample, data, self._native_c_to_py_program)
+        finally:
+            self._plugin_dynamic_type.finalize_sample(c_sample)
+        return data
 
     def from_dynamic_data(self, sample: dds.DynamicData) -> Any:
         """Converts a given dynamic data sample to an idl type"""
-        return self.deserialize(sample.to_cdr_buffer())
+        c_sample = self._create_empty_c_sample()
+        try:
+            self._plugin_dynamic_type.from_dynamic_data(
+                sample, c_sample, self._native_py_to_c_program)
+            return self._create_py_sample_no_ptr(c_sample)
+        finally:
+            self._plugin_dynamic_type.finalize_sample(c_sample)
 
     @property
     def _dynamic_type_ref(self):
@@ -20,9 +20,10 @@ import rti.connextdds as dds
 
 
 class Sample(NamedTuple):
-    """A tuple containing the user data and the SampleInfo"""
+    """A tuple containing the user data and the SampleInfo (a SampleInfoView
+    if the samples were taken with info_views=True)"""
     data: Any
-    info: dds.SampleInfo
+    info: Union[dds.SampleInfo, dds.SampleInfoView]
 
 @dataclass
 class PrimitiveArrayFactory:
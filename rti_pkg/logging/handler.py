@@ -39,9 +39,17 @@ class DistlogHandler(logging.Handler):
         logging.Handler.close(self)
         DistlogHandler._lock.release()
 
+    def flush(self):
+        # type: () -> None
+        # Only waits when the logger is in asynchronous mode
+        distlog.Logger.flush()
+
     def emit(self, record):
         # type: (logging.LogRecord) -> None
         level = DistlogHandler._levelMap[record.levelno]
+        # Don't format the messages the logger would filter out
+        if not distlog.Logger.is_enabled_for(level):
+            return
         if hasattr(record, 'category'):
             distlog.Logger.log(level, record.getMessage(), record.category)
         else:
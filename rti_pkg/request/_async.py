@@ -10,7 +10,6 @@
 
 import rti.connextdds
 from . import _util
-from . import _util_native
 from . import _util_async
 from . import _basic
 try:
@@ -44,6 +43,8 @@ class Requester(_basic.Requester):
     :type subscriber: Optional[rti.connextdds.Subscriber]
     :param on_reply_available: The callback that handles incoming replies.
     :type on_reply_available: Callable[[object], object]
+    :param demultiplex_replies: Deliver the replies to each request with a native demultiplexer, which scales to many pipelined requests, defaults to False. In this mode the demultiplexer takes all the replies, so they can only be received with receive_replies or receive_replies_async and a related_request_id; the other ways of waiting for, reading or taking replies raise rti.connextdds.PreconditionNotMetError.
+    :type demultiplex_replies: bool
     """
     def __init__(
         self,
@@ -57,7 +58,8 @@ class Requester(_basic.Requester):
         datareader_qos=None,        # type: Optional[rti.connextdds.DataReaderQos]
         publisher=None,             # type: Optional[rti.connextdds.Publisher]
         subscriber=None,            # type: Optional[rti.connextdds.Subscriber]
-        on_reply_available=None     # type: Optional[Callable[[object]]]
+        on_reply_available=None,    # type: Optional[Callable[[object]]]
+        demultiplex_replies=False   # type: bool
     ):
         # type: (...) -> None
         super(Requester, self).__init__(
@@ -74,6 +76,109 @@ class Requester(_basic.Requester):
             on_reply_available,
         )
 
+        if demultiplex_replies:
+            self._demux = _util.create_reply_demultiplexer(self._reader)
+        else:
+            self._demux = None
+
+
+    def close(self):
+        # type() -> None
+        """Close the resources for this request-reply object.
+        """
+        if self._demux is not None and not self.closed:
+            # Fails the replies still being waited for
+            self._demux.close()
+            self._demux = None
+        super(Requester, self).close()
+
+
+    def _check_not_demultiplexed(self, operation):
+        # type: (str) -> None
+        if self._demux is not None:
+            raise rti.connextdds.PreconditionNotMetError(
+                operation + " is not available when the replies are "
+                "demultiplexed; use receive_replies with a related_request_id")
+
+
+    def receive_replies(
+        self,
+        max_wait,                   # type: rti.connextdds.Duration
+        min_count=1,                # type: int
+        related_request_id=None     # type: Optional[rti.connextdds.SampleIdentity]
+    ):
+        # type: (...) -> Union[rti.connextdds.DynamicData.LoanedSamples, object]
+        """Wait for replies and take them.
+
+        :param max_wait: Maximum time to wait for replies before timing out.
+        :type max_wait: rti.connextdds.Duration
+        :param min_count: Minimum number of replies to receive, default 1.
+        :type min_count: int
+        :param related_request_id: The request id used to correlate replies, default None (receive any replies).
+        :type related_request_id: Optional[rti.connextdds.SampleIdentity]
+        :raises rti.connextdds.TimeoutError: Thrown if min_count not received within max_wait.
+        :return: A loaned samples object containing the replies.
+        :rtype: Union[rti.connextdds.DynamicData.LoanedSamples, object]
+        """
+        if self._demux is not None and related_request_id is not None:
+            return self._demux.receive_replies(
+                    related_request_id, max_wait, min_count)
+        self._check_not_demultiplexed("receive_replies without a related_request_id")
+        return super(Requester, self).receive_replies(
+                max_wait, min_count, related_request_id)
+
+
+    def take_replies(self, related_request_id=None):
+        # type: (Optional[rti.connextdds.SampleIdentity]) -> Union[rti.connextdds.DynamicData.LoanedSamples, object]
+        """Take received replies.
+
+        :param related_request_id: The id used to correlate replies to a specific request, default None (take any replies).
+        :type related_request_id: Optional[rti.connextdds.SampleIdentity]
+        :raises rti.connextdds.PreconditionNotMetError: Thrown if the replies are demultiplexed.
+        :return: A loaned samples object containing the replies.
+        :rtype: Union[rti.connextdds.DynamicData.LoanedSamples, object]
+        """
+        self._check_not_demultiplexed("take_replies")
+        return super(Requester, self).take_replies(related_request_id)
+
+
+    def read_replies(self, related_request_id=None):
+        # type: (Optional[rti.connextdds.SampleIdentity]) -> Union[rti.connextdds.DynamicData.LoanedSamples, object]
+        """Read received replies.
+
+        :param related_request_id: The id used to correlate replies to a specific request, default None (read any replies).
+        :type related_request_id: Optional[rti.connextdds.SampleIdentity]
+        :raises rti.connextdds.PreconditionNotMetError: Thrown if the replies are demultiplexed.
+        :return: A loaned samples object containing the replies.
+        :rtype: Union[rti.connextdds.DynamicData.LoanedSamples, object]
+        """
+        self._check_not_demultiplexed("read_replies")
+        return super(Requester, self).read_replies(related_request_id)
+
+
+    def wait_for_replies(
+        self,
+        max_wait,                   # type: rti.connextdds.Duration
+        min_count=1,                # type: int
+        related_request_id=None     # type: Optional[rti.connextdds.SampleIdentity]
+    ):
+        # type(...) -> bool
+        """Wait for received replies.
+
+        :param max_wait: Maximum time to wait for replies before timing out.
+        :type max_wait: rti.connextdds.Duration
+        :param min_count: Minimum number of replies to receive, default 1.
+        :type min_count: int
+        :param related_request_id: The request id used to correlate replies, default None (receive any replies).
+        :type related_request_id: Optional[rti.connextdds.SampleIdentity]
+        :raises rti.connextdds.PreconditionNotMetError: Thrown if the replies are demultiplexed.
+        :return: Boolean indicating whether min_count replies were received within max_wait time.
+        :rtype: bool
+        """
+        self._check_not_demultiplexed("wait_for_replies")
+        return super(Requester, self).wait_for_replies(
+                max_wait, min_count, related_request_id)
+
 
     async def send_request_async(self, request, params=None):
         # type: (Union[rti.connextdds.DynamicData, object], rti.connextdds.WriteParams) -> rti.connextdds.SampleIdentity
@@ -112,6 +217,10 @@ class Requester(_basic.Requester):
         :return: A loaned samples object containing the replies.
         :rtype: Union[rti.connextdds.DynamicData.LoanedSamples, object]
         """
+        if self._demux is not None and related_request_id is not None:
+            return await self._demux.receive_replies_async(
+                    related_request_id, max_wait, min_count)
+        self._check_not_demultiplexed("receive_replies_async without a related_request_id")
         if not await self.wait_for_replies_async(max_wait, min_count, related_request_id):
             raise rti.connextdds.TimeoutError("Timed out waiting for replies")
         else:
@@ -133,33 +242,20 @@ class Requester(_basic.Requester):
         :type min_count: int
         :param related_request_id: The request id used to correlate replies, default None (receive any replies).
         :type related_request_id: Optional[rti.connextdds.SampleIdentity]
+        :raises rti.connextdds.PreconditionNotMetError: Thrown if the replies are demultiplexed.
         :return: Boolean indicating whether min_count replies were received within max_wait time.
         :rtype: bool
         """
+        self._check_not_demultiplexed("wait_for_replies_async")
         if related_request_id is None:
-            return _util.wait_for_samples(
-                    self._reader,
-                    min_count,
-                    max_wait,
-                    self._waitset,
-                    self._any_sample_condition,
-                    self._notread_sample_condition)
+            return await _util_async.wait_for_samples_async(
+                    self._core, max_wait, min_count)
         else:
-            initial_condition = _util_native.create_correlation_condition(
-                    self._reader,
-                    rti.connextdds.SampleState.ANY,
-                    related_request_id.sequence_number)
-            correlation_condition = _util_native.create_correlation_condition(
-                    self._reader,
-                    rti.connextdds.SampleState.ANY,
-                    related_request_id.sequence_number)
-            waitset = rti.connextdds.WaitSet()
-            waitset += correlation_condition
             return await _util_async.wait_for_samples_async(
-                    self._reader,
-                    min_count, max_wait,
-                    waitset, initial_condition,
-                    correlation_condition)
+                    self._core,
+                    max_wait,
+                    min_count,
+                    related_request_id.sequence_number)
 
 
 class Replier(_basic.Replier):
@@ -236,8 +332,8 @@ class Replier(_basic.Replier):
         :raises rti.connextdds.InvalidArgumentError: Thrown if param is not a type that can be used for correlation.
         """
         if isinstance(param, rti.connextdds.SampleIdentity):
-            _util.send_with_request_id(self.__writer, reply, param, final)
-        elif isinstance(param, rti.connextdds.SampleInfo):
+            _util.send_with_request_id(self._writer, reply, param, final)
+        elif isinstance(param, _util.SAMPLE_INFO_TYPES):
             _util.send_with_request_id(
                     self._writer,
                     reply,
@@ -284,9 +380,4 @@ class Replier(_basic.Replier):
         :rtype: bool
         """
         return await _util_async.wait_for_samples_async(
-                self._reader,
-                min_count,
-                max_wait,
-                self._waitset,
-                self._any_sample_condition,
-                self._notread_sample_condition)
+                self._core, max_wait, min_count)
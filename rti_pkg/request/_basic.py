@@ -135,9 +135,7 @@ class Requester(_util.RequestReplyBase):
         if related_request_id is None:
             return self._reader.take()
         else:
-            condition = _util_native.create_correlation_condition(
-                self._reader,
-                rti.connextdds.SampleState.ANY,
+            condition = self._core.related_samples_condition(
                 related_request_id.sequence_number)
             return self._reader.select().condition(condition).take()
 
@@ -154,9 +152,7 @@ class Requester(_util.RequestReplyBase):
         if related_request_id is None:
             return self._reader.read()
         else:
-            condition = _util_native.create_correlation_condition(
-                self._reader,
-                rti.connextdds.SampleState.ANY,
+            condition = self._core.related_samples_condition(
                 related_request_id.sequence_number)
             return self._reader.select().condition(condition).read()
 
@@ -180,29 +176,12 @@ class Requester(_util.RequestReplyBase):
         :rtype: bool
         """
         if related_request_id is None:
-            return _util.wait_for_samples(
-                    self._reader,
-                    min_count,
-                    max_wait,
-                    self._waitset,
-                    self._any_sample_condition,
-                    self._notread_sample_condition)
+            return self._core.wait_for_samples(max_wait, min_count)
         else:
-            initial_condition = _util_native.create_correlation_condition(
-                    self._reader,
-                    rti.connextdds.SampleState.ANY,
-                    related_request_id.sequence_number)
-            correlation_condition = _util_native.create_correlation_condition(
-                    self._reader,
-                    rti.connextdds.SampleState.ANY,
-                    related_request_id.sequence_number)
-            waitset = rti.connextdds.WaitSet()
-            waitset += correlation_condition
-            return _util.wait_for_samples(
-                    self._reader,
-                    min_count, max_wait,
-                    waitset, initial_condition,
-                    correlation_condition)
+            return self._core.wait_for_related_samples(
+                max_wait,
+                min_count,
+                related_request_id.sequence_number)
 
 
     @property
@@ -275,7 +254,7 @@ class Requester(_util.RequestReplyBase):
         :return: Boolean indicating whether the request and reply are correlated.
         :rtype: bool
         """
-        if isinstance(reply_info, rti.connextdds.SampleInfo):
+        if isinstance(reply_info, _util.SAMPLE_INFO_TYPES):
             return reply_info.related_original_publication_virtual_sample_identity == request_id
         return reply_info.info.related_original_publication_virtual_sample_identity == request_id
 
@@ -290,7 +269,7 @@ class Requester(_util.RequestReplyBase):
         :return: Boolean indicating whether reply is the last for a request.
         :rtype: bool
         """
-        if isinstance(reply_info, rti.connextdds.SampleInfo):
+        if isinstance(reply_info, _util.SAMPLE_INFO_TYPES):
             return rti.connextdds.SampleFlag.INTERMEDIATE_REPLY_SEQUENCE not in reply_info.flag
 
         _, info = reply_info
@@ -375,8 +354,8 @@ class Replier(_util.RequestReplyBase):
         :raises rti.connextdds.InvalidArgumentError: Thrown if param is not a type that can be used for correlation.
         """
         if isinstance(param, rti.connextdds.SampleIdentity):
-            _util.send_with_request_id(self.__writer, reply, param, final)
-        elif isinstance(param, rti.connextdds.SampleInfo):
+            _util.send_with_request_id(self._writer, reply, param, final)
+        elif isinstance(param, _util.SAMPLE_INFO_TYPES):
             _util.send_with_request_id(
                     self._writer,
                     reply,
@@ -442,13 +421,7 @@ class Replier(_util.RequestReplyBase):
         :return: Boolean indicating whether min_count requests were received within max_wait time.
         :rtype: bool
         """
-        return _util.wait_for_samples(
-                self._reader,
-                min_count,
-                max_wait,
-                self._waitset,
-                self._any_sample_condition,
-                self._notread_sample_condition)
+        return self._core.wait_for_samples(max_wait, min_count)
 
 
     @property
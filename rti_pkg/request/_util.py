@@ -9,15 +9,18 @@
 
 
 import rti.connextdds
+from . import _util_native
 try:
     from typing import Union, Optional, Callable
 except ImportError:
     pass
 
 
-INT_MAX = (2 ** 31) - 1
 GUID_FIELD_NAME = "@related_sample_identity.writer_guid.value"
 reader_listeners = {}
+# The info of a sample taken from an IDL DataReader with info_views=True is a
+# SampleInfoView
+SAMPLE_INFO_TYPES = (rti.connextdds.SampleInfo, rti.connextdds.SampleInfoView)
 
 
 class MetaRequestReply(type):
@@ -55,6 +58,12 @@ class MetaRequestReply(type):
         return qos
 
 
+def create_reply_demultiplexer(reader):
+    # The samples are taken through the DataReader, which converts them to
+    # Python objects; the demultiplexer correlates them natively
+    return _util_native.ReplyDemultiplexer(reader, reader.take)
+
+
 def get_or_create_topic_from_name(type_class, data_type, participant, topic_name):
     try:
         topic = type_class.Topic.find(participant, topic_name)
@@ -192,62 +201,9 @@ def create_reader(
     return reader
 
 
-def wait_for_samples(
-    reader,             # type: Union[rti.connextdds.DynamicData.DataReader, object]
-    min_count,          # type: int
-    max_wait,           # type: rti.connextdds.Duration
-    waitset,            # type: rti.connextdds.WaitSet
-    initial_condition,  # type: rti.connextdds.ICondition
-    condition           # type: rti.connextdds.ICondition
-):
-    # type: (...) -> bool
-    if min_count == rti.connextdds.LENGTH_UNLIMITED:
-        min_count = INT_MAX
-        
-    sample_count = len(reader.select().max_samples(
-        min_count).condition(initial_condition).read_loaned())
-    min_count -= sample_count
-
-    participant = reader.subscriber.participant
-    remaining_wait = max_wait
-    
-    while min_count > 0:
-        if min_count == 1:
-            conditions = waitset.wait(remaining_wait)
-        else:
-            before_time = participant.current_time
-            conditions = waitset.wait(remaining_wait)
-            wait_time = participant.current_time - before_time
-            remaining_wait -= wait_time
-
-        # WaitSet should only have one condition
-        if len(conditions) != 1:
-            return False
-
-        if min_count > 1:
-            sample_count = len(reader.select().max_samples(
-                min_count).condition(condition).read_loaned())
-            min_count -= sample_count
-        else:
-            min_count -= 1
-
-    return True
-
-
 def validate_related_request_id(related_request_id):
     # type: (rti.connextdds.SampleIdentity) -> None
-    if (
-        related_request_id.writer_guid == rti.connextdds.Guid.automatic or 
-        related_request_id.writer_guid == rti.connextdds.Guid.unknown
-       ):
-        raise rti.connextdds.InvalidArgumentError("related_request_id.writer_guid")
-    if (
-        related_request_id.sequence_number == rti.connextdds.SequenceNumber.automatic or
-        related_request_id.sequence_number == rti.connextdds.SequenceNumber.unknown or
-        related_request_id.sequence_number == rti.connextdds.SequenceNumber.maximum or
-        related_request_id.sequence_number == rti.connextdds.SequenceNumber.zero
-       ):
-        raise rti.connextdds.InvalidArgumentError("related_request_id.sequence_number")
+    _util_native.validate_related_request_id(related_request_id)
 
 
 def send_with_request_id(
@@ -257,12 +213,7 @@ def send_with_request_id(
     final       # type: bool
 ):
     # type: (...) -> None
-    validate_related_request_id(request_id)
-    params = rti.connextdds.WriteParams()
-    params.related_sample_identity = request_id
-    if not final:
-        params.flag = rti.connextdds.SampleFlag.INTERMEDIATE_REPLY_SEQUENCE
-    writer.write(reply, params)
+    writer.write(reply, _util_native.create_reply_params(request_id, final))
 
 
 def match_count(
@@ -372,19 +323,10 @@ class RequestReplyBase(RRMETA):
             writer_guid)
 
         if use_waitset:
-            # Create ReadConditions
-            self._any_sample_condition = rti.connextdds.ReadCondition(
-                    self._reader,
-                    rti.connextdds.DataState.any)
-            self._notread_sample_condition = rti.connextdds.ReadCondition(
-                    self._reader,
-                    rti.connextdds.SampleState.NOT_READ)
-
-            # Create reply WaitSet
-            self._waitset = rti.connextdds.WaitSet()
-            self._waitset += self._notread_sample_condition
+            # The native core waits for and correlates the received samples
+            self._core = _util_native.RequestReplyCore(self._reader)
         else:
-            self._waitset = None
+            self._core = None
 
         self._callback = on_data_available
         self._writer_type = writer_type
@@ -398,11 +340,9 @@ class RequestReplyBase(RRMETA):
         """
         if self._closed:
             raise rti.connextdds.AlreadyClosedError('This request-reply object has already been closed')
-        if self._waitset is not None:
-            self._waitset.detach_all()
-            self._waitset = None
-            self._any_sample_condition.close()
-            self._notread_sample_condition.close()
+        if self._core is not None:
+            self._core.close()
+            self._core = None
         self._callback = None
         self._writer.close()
         self._reader.close()
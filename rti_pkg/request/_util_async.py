@@ -9,7 +9,7 @@
 
 
 import rti.connextdds
-from . import _util
+from . import _util_native
 import asyncio
 try:
     from typing import Union, Optional, Callable
@@ -18,45 +18,25 @@ except ImportError:
 
 
 async def wait_for_samples_async(
-    reader,             # type: Union[rti.connextdds.DynamicData.DataReader, object]
-    min_count,          # type: int
-    max_wait,           # type: rti.connextdds.Duration
-    waitset,            # type: rti.connextdds.WaitSet
-    initial_condition,  # type: rti.connextdds.ICondition
-    condition           # type: rti.connextdds.ICondition
+    core,                           # type: _util_native.RequestReplyCore
+    max_wait,                       # type: rti.connextdds.Duration
+    min_count,                      # type: int
+    related_sequence_number=None    # type: Optional[rti.connextdds.SequenceNumber]
 ):
     # type: (...) -> bool
-    if min_count == rti.connextdds.LENGTH_UNLIMITED:
-        min_count = _util.INT_MAX
-        
-    sample_count = reader.select().max_samples(
-        min_count).condition(initial_condition).read_loaned().length
-    min_count -= sample_count
-
-    participant = reader.subscriber.participant
-    remaining_wait = max_wait
-    
-    while min_count > 0:
-        if min_count == 1:
-            conditions = await waitset.wait_async(remaining_wait)
-        else:
-            before_time = participant.current_time
-            conditions = await waitset.wait_async(remaining_wait)
-            wait_time = participant.current_time - before_time
-            remaining_wait -= wait_time
-
-        # WaitSet should only have one condition
-        if len(conditions) != 1:
-            return False
-
-        if min_count > 1:
-            sample_count = reader.select().max_samples(
-                min_count).condition(condition).read_loaned().length
-            min_count -= sample_count
-        else:
-            min_count -= 1
-
-    return True
+    # The native wait releases the GIL, so it doesn't block the event loop
+    # while it runs in the loop's default executor
+    loop = asyncio.get_running_loop()
+    if related_sequence_number is None:
+        return await loop.run_in_executor(
+            None, core.wait_for_samples, max_wait, min_count)
+    else:
+        return await loop.run_in_executor(
+            None,
+            core.wait_for_related_samples,
+            max_wait,
+            min_count,
+            related_sequence_number)
 
 
 async def send_with_request_id_async(
@@ -66,10 +46,6 @@ async def send_with_request_id_async(
     final       # type: bool
 ):
     # type: (...) -> None
-    _util.validate_related_request_id(request_id)
-    params = rti.connextdds.WriteParams()
-    params.related_sample_identity = request_id
-    if not final:
-        params.flag = rti.connextdds.SampleFlag.INTERMEDIATE_REPLY_SEQUENCE
-    await writer.write_async(reply, params)
+    await writer.write_async(
+        reply, _util_native.create_reply_params(request_id, final))
 
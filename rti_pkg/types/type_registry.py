@@ -9,15 +9,23 @@
 # damages arising out of the use or inability to use the software.
 #
 
+import threading
 from typing import Optional
 
 # A simple dictionary used by dds.DomainParticipant.register_idl_type to keep
-# track of registered IDL-based Python types (and their TypeSupport)
+# track of registered IDL-based Python types (and their TypeSupport).
+#
+# It's looked up by the XML application creation from any thread, so it's
+# protected by a lock instead of relying on the GIL, which free-threaded
+# Python builds don't have.
 
 _registered_types = {}
+_lock = threading.Lock()
 
 def register_type(type_name: str, type_class: type):
-    _registered_types[type_name] = type_class
+    with _lock:
+        _registered_types[type_name] = type_class
 
 def get_type(type_name: str) -> Optional[type]:
-    return _registered_types.get(type_name)
+    with _lock:
+        return _registered_types.get(type_name)
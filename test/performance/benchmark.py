@@ -0,0 +1,715 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+"""Benchmarks of the Python binding layer that run in a single process.
+
+Two participants in the same process exchange data over SHMEM or UDPv4
+loopback, so the results only depend on the host. The suite measures:
+
+- conversion: Python to C and C to Python sample conversion (no DDS)
+- serialization: serialize and deserialize (no DDS)
+- throughput: write and take throughput
+- latency: one-way latency of a write followed by a take
+- async_take: throughput of take_data_async (rti.asyncio)
+
+for IDL, DynamicData and builtin (StringTopicType, BytesTopicType) types,
+sweeping the payload size and the sequence length.
+
+The results are written as JSON. A previous result file can be passed as a
+baseline; the metrics that got worse by more than a threshold are reported as
+regressions and the script exits with a non-zero status.
+
+Examples:
+
+    python benchmark.py --output baseline.json
+    python benchmark.py --quick --filter latency --baseline baseline.json
+"""
+
+import argparse
+import array
+import asyncio
+import gc
+import json
+import platform
+import sys
+import time
+import warnings
+from dataclasses import field
+from typing import Any, Callable, Dict, List, Optional, Sequence
+
+import rti.connextdds as dds
+import rti.idl as idl
+import rti.asyncio
+
+MAX_PAYLOAD_SIZE = 65536
+MAX_SEQUENCE_LENGTH = 4096
+
+PAYLOAD_SIZES = [16, 1024, 16384, 65536]
+SEQUENCE_LENGTHS = [1, 64, 1024, 4096]
+QUICK_PAYLOAD_SIZES = [16, 1024]
+QUICK_SEQUENCE_LENGTHS = [1, 64]
+
+BENCHMARKS = ["conversion", "serialization", "throughput", "latency", "async_take"]
+
+
+@idl.struct(member_annotations={"data": [idl.bound(MAX_PAYLOAD_SIZE)]})
+class BytesPayload:
+    id: int = 0
+    data: Sequence[idl.uint8] = field(
+        default_factory=idl.array_factory(idl.uint8))
+
+
+@idl.struct
+class Point:
+    x: float = 0.0
+    y: float = 0.0
+
+
+@idl.struct(member_annotations={"points": [idl.bound(MAX_SEQUENCE_LENGTH)]})
+class PointsPayload:
+    id: int = 0
+    points: Sequence[Point] = field(default_factory=list)
+
+
+#
+# Statistics
+#
+
+def percentile(sorted_values: List[float], percent: float) -> float:
+    if not sorted_values:
+        return 0.0
+    index = min(
+        len(sorted_values) - 1,
+        max(0, int(round(percent / 100.0 * len(sorted_values))) - 1))
+    return sorted_values[index]
+
+
+def latency_metrics(latencies_ns: List[int], prefix: str = "latency") -> Dict[str, float]:
+    """Summarizes a list of latencies as microseconds"""
+    values = sorted(latencies_ns)
+    if not values:
+        return {}
+    return {
+        f"{prefix}_us_p50": percentile(values, 50) / 1000.0,
+        f"{prefix}_us_p90": percentile(values, 90) / 1000.0,
+        f"{prefix}_us_p99": percentile(values, 99) / 1000.0,
+        f"{prefix}_us_max": values[-1] / 1000.0,
+        f"{prefix}_us_mean": sum(values) / len(values) / 1000.0,
+    }
+
+
+def is_higher_better(metric: str) -> Optional[bool]:
+    """Whether a higher value of a metric is an improvement. Returns None for
+    metrics that are informative only (e.g. the max latency, which is too
+    noisy to compare).
+    """
+    if metric.endswith("_per_s"):
+        return True
+    if metric.endswith(("_p50", "_p90", "_p99", "_mean")):
+        return False
+    return None
+
+
+def time_operation(operation: Callable[[], Any], iterations: int) -> List[int]:
+    """Runs operation iterations times and returns the duration of each call
+    in nanoseconds.
+    """
+    clock = time.perf_counter_ns
+    durations = []
+    for _ in range(iterations):
+        start = clock()
+        operation()
+        durations.append(clock() - start)
+    return durations
+
+
+def rate_metrics(name: str, durations_ns: List[int], payload_bytes: int) -> Dict[str, float]:
+    total_s = sum(durations_ns) / 1e9
+    result = {f"{name}_ops_per_s": len(durations_ns) / total_s if total_s else 0.0}
+    if payload_bytes:
+        result[f"{name}_mbytes_per_s"] = (
+            len(durations_ns) * payload_bytes / 1e6 / total_s if total_s else 0.0)
+    result.update(latency_metrics(durations_ns, prefix=name))
+    return result
+
+
+#
+# Data types
+#
+
+class TypeCase:
+    """A data type, a sample of that type and the namespace to create its
+    Topic, DataWriter and DataReader
+    """
+
+    def __init__(
+        self,
+        kind: str,
+        params: Dict[str, int],
+        namespace: Any,
+        topic_type: Any,
+        sample: Any,
+        payload_bytes: int,
+        type_support: Any = None
+    ):
+        self.kind = kind
+        self.params = params
+        self.namespace = namespace
+        self.topic_type = topic_type
+        self.sample = sample
+        self.payload_bytes = payload_bytes
+        self.type_support = type_support
+
+    @property
+    def name(self) -> str:
+        params = ",".join(f"{k}={v}" for k, v in sorted(self.params.items()))
+        return f"{self.kind}[{params}]"
+
+    @property
+    def is_builtin(self) -> bool:
+        return self.kind in ("string", "bytes")
+
+    def create_topic(self, participant: dds.DomainParticipant, name: str):
+        if self.topic_type is None:
+            return self.namespace.Topic(participant, name)
+        return self.namespace.Topic(participant, name, self.topic_type)
+
+
+def create_bytes_payload(size: int) -> BytesPayload:
+    return BytesPayload(id=1, data=array.array("B", bytes(size)))
+
+
+def create_points_payload(length: int) -> PointsPayload:
+    return PointsPayload(
+        id=1, points=[Point(x=float(i), y=float(-i)) for i in range(length)])
+
+
+def create_type_cases(payload_sizes: List[int], sequence_lengths: List[int]) -> List[TypeCase]:
+    bytes_ts = idl.get_type_support(BytesPayload)
+    points_ts = idl.get_type_support(PointsPayload)
+    point_size = 16  # two doubles
+    cases = []
+
+    for size in payload_sizes:
+        params = {"payload_size": size}
+        sample = create_bytes_payload(size)
+        cases.append(TypeCase(
+            "idl", params, dds, BytesPayload, sample, size, bytes_ts))
+        cases.append(TypeCase(
+            "dynamic_data",
+            params,
+            dds.DynamicData,
+            bytes_ts.dynamic_type,
+            bytes_ts.to_dynamic_data(sample),
+            size))
+        # The builtin types are deprecated but still widely used
+        with warnings.catch_warnings():
+            warnings.simplefilter("ignore", DeprecationWarning)
+            cases.append(TypeCase(
+                "string",
+                params,
+                dds.StringTopicType,
+                None,
+                dds.StringTopicType("x" * size),
+                size))
+            cases.append(TypeCase(
+                "bytes",
+                params,
+                dds.BytesTopicType,
+                None,
+                dds.BytesTopicType(list(bytes(size))),
+                size))
+
+    for length in sequence_lengths:
+        params = {"sequence_length": length}
+        sample = create_points_payload(length)
+        cases.append(TypeCase(
+            "idl", params, dds, PointsPayload, sample, length * point_size,
+            points_ts))
+        cases.append(TypeCase(
+            "dynamic_data",
+            params,
+            dds.DynamicData,
+            points_ts.dynamic_type,
+            points_ts.to_dynamic_data(sample),
+            length * point_size))
+
+    return cases
+
+
+#
+# DDS entities
+#
+
+def create_participant_qos(transport: str) -> dds.DomainParticipantQos:
+    """Restricts the participant to one loopback transport"""
+
+    qos = dds.DomainParticipantQos()
+    qos.database.shutdown_cleanup_period = dds.Duration.from_milliseconds(10)
+    qos.discovery.accept_unknown_peers = False
+    qos.discovery.multicast_receive_addresses = []
+    if transport == "shmem":
+        qos.transport_builtin.mask = dds.TransportBuiltinMask.SHMEM
+        qos.discovery.initial_peers = ["shmem://"]
+    else:
+        qos.transport_builtin.mask = dds.TransportBuiltinMask.UDPv4
+        qos.discovery.initial_peers = ["builtin.udpv4://127.0.0.1"]
+
+    # The default max size of the builtin types is too small for the
+    # largest payloads
+    max_size = str(MAX_PAYLOAD_SIZE + 1)
+    qos.property = dds.Property({
+        "dds.builtin_type.string.max_size": max_size,
+        "dds.builtin_type.octets.max_size": max_size,
+    })
+    return qos
+
+
+class Loopback:
+    """A DataWriter in one participant and a matching DataReader in another
+    participant of the same process
+    """
+
+    def __init__(self, participants, case: TypeCase, topic_name: str):
+        self.case = case
+        pub_participant, sub_participant = participants
+        self.pub_topic = case.create_topic(pub_participant, topic_name)
+        self.sub_topic = case.create_topic(sub_participant, topic_name)
+
+        writer_qos = dds.DataWriterQos()
+        writer_qos << dds.Reliability.reliable(dds.Duration(10))
+        writer_qos << dds.History.keep_all
+        reader_qos = dds.DataReaderQos()
+        reader_qos << dds.Reliability.reliable()
+        reader_qos << dds.History.keep_all
+
+        self.writer = case.namespace.DataWriter(
+            dds.Publisher(pub_participant), self.pub_topic, writer_qos)
+        self.reader = case.namespace.DataReader(
+            dds.Subscriber(sub_participant), self.sub_topic, reader_qos)
+
+        self.condition = dds.ReadCondition(self.reader, dds.DataState.any_data)
+        self.waitset = dds.WaitSet()
+        self.waitset += self.condition
+        self._wait_for_discovery()
+
+    def _wait_for_discovery(self, timeout: float = 10.0):
+        deadline = time.monotonic() + timeout
+        while (len(self.writer.matched_subscriptions) == 0
+               or len(self.reader.matched_publications) == 0):
+            if time.monotonic() > deadline:
+                raise RuntimeError(
+                    f"DataWriter and DataReader of {self.case.name} did not match")
+            time.sleep(0.01)
+
+    def wait_for_data(self, timeout_s: int = 10):
+        try:
+            self.waitset.wait(dds.Duration(timeout_s))
+        except dds.TimeoutError:
+            raise RuntimeError(f"Timed out waiting for {self.case.name} data")
+
+    def take_all(self) -> int:
+        return len(self.reader.take_data())
+
+    def close(self):
+        self.waitset.detach_all()
+        self.condition.close()
+        self.reader.close()
+        self.writer.close()
+        self.sub_topic.close()
+        self.pub_topic.close()
+
+
+#
+# Benchmarks
+#
+
+class Suite:
+    def __init__(self, args):
+        self.args = args
+        self.iterations = 200 if args.quick else 2000
+        self.samples = 2000 if args.quick else 20000
+        self.results = []
+        self.participants = None
+        self._topic_count = 0
+
+    def record(self, benchmark: str, case: TypeCase, metrics: Dict[str, float]):
+        name = f"{benchmark}/{case.name}"
+        print(f"  {name}: " + ", ".join(
+            f"{k}={v:.3f}" for k, v in metrics.items()
+            if is_higher_better(k) is not None and ("_p50" in k or "per_s" in k)))
+        self.results.append({
+            "name": name,
+            "benchmark": benchmark,
+            "type": case.kind,
+            "params": case.params,
+            "metrics": metrics,
+        })
+
+    def get_participants(self):
+        if self.participants is None:
+            qos = create_participant_qos(self.args.transport)
+            self.participants = (
+                dds.DomainParticipant(self.args.domain, qos),
+                dds.DomainParticipant(self.args.domain, qos))
+        return self.participants
+
+    def create_loopback(self, case: TypeCase) -> Loopback:
+        self._topic_count += 1
+        return Loopback(
+            self.get_participants(),
+            case,
+            f"Benchmark{self._topic_count}")
+
+    def close(self):
+        if self.participants is not None:
+            for participant in self.participants:
+                participant.close()
+
+    # conversion: Python <-> C sample conversion, without DDS
+    def conversion(self, case: TypeCase):
+        ts = case.type_support
+        if ts is None:
+            return
+
+        def to_c():
+            ts._finalize_c_samples([ts._create_c_sample(case.sample)])
+
+        c_sample = ts._create_c_sample(case.sample)
+        try:
+            metrics = rate_metrics(
+                "py_to_c",
+                time_operation(to_c, self.iterations),
+                case.payload_bytes)
+            metrics.update(rate_metrics(
+                "c_to_py",
+                time_operation(
+                    lambda: ts._create_py_sample_no_ptr(c_sample),
+                    self.iterations),
+                case.payload_bytes))
+            metrics.update(rate_metrics(
+                "to_dynamic_data",
+                time_operation(
+                    lambda: ts.to_dynamic_data(case.sample),
+                    self.iterations),
+                case.payload_bytes))
+        finally:
+            ts._finalize_c_samples([c_sample])
+        self.record("conversion", case, metrics)
+
+    # serialization: sample <-> CDR buffer, without DDS
+    def serialization(self, case: TypeCase):
+        if case.is_builtin:
+            return
+
+        if case.type_support is not None:
+            ts = case.type_support
+            buffer = ts.serialize(case.sample)
+            serialize = lambda: ts.serialize(case.sample)
+            deserialize = lambda: ts.deserialize(buffer)
+        else:
+            # to_cdr_buffer returns a list of (signed) chars
+            buffer = bytearray(b & 0xff for b in case.sample.to_cdr_buffer())
+            target = dds.DynamicData(case.topic_type)
+            serialize = lambda: case.sample.to_cdr_buffer()
+            deserialize = lambda: target.from_cdr_buffer(buffer)
+
+        metrics = rate_metrics(
+            "serialize",
+            time_operation(serialize, self.iterations),
+            case.payload_bytes)
+        metrics.update(rate_metrics(
+            "deserialize",
+            time_operation(deserialize, self.iterations),
+            case.payload_bytes))
+        metrics["serialized_size"] = len(buffer)
+        self.record("serialization", case, metrics)
+
+    # throughput: writes a batch and takes what has been received, measuring
+    # the time in write and take separately and the total time until all the
+    # samples are received
+    def throughput(self, case: TypeCase):
+        loopback = self.create_loopback(case)
+        writer, sample = loopback.writer, case.sample
+        batch = 100
+        count = self.samples - self.samples % batch
+        clock = time.perf_counter_ns
+        write_ns = 0
+        take_ns = 0
+        received = 0
+        try:
+            with PhaseStats(self.args.perf_stats, writer, loopback.reader) as phases:
+                start = clock()
+                for _ in range(count // batch):
+                    t0 = clock()
+                    for _ in range(batch):
+                        writer.write(sample)
+                    t1 = clock()
+                    received += loopback.take_all()
+                    write_ns += t1 - t0
+                    take_ns += clock() - t1
+                while received < count:
+                    loopback.wait_for_data()
+                    t0 = clock()
+                    received += loopback.take_all()
+                    take_ns += clock() - t0
+                total_ns = clock() - start
+        finally:
+            loopback.close()
+
+        metrics = {
+            "samples_per_s": count / (total_ns / 1e9),
+            "mbytes_per_s": count * case.payload_bytes / 1e6 / (total_ns / 1e9),
+            "write_samples_per_s": count / (write_ns / 1e9),
+            "take_samples_per_s": count / (take_ns / 1e9) if take_ns else 0.0,
+        }
+        metrics.update(phases.metrics)
+        self.record("throughput", case, metrics)
+
+    # latency: one-way latency of a write until the sample is taken
+    def latency(self, case: TypeCase):
+        loopback = self.create_loopback(case)
+        writer, sample = loopback.writer, case.sample
+        clock = time.perf_counter_ns
+        latencies = []
+        try:
+            with PhaseStats(self.args.perf_stats, writer, loopback.reader) as phases:
+                for _ in range(self.iterations):
+                    start = clock()
+                    writer.write(sample)
+                    received = 0
+                    while received == 0:
+                        loopback.wait_for_data()
+                        received = loopback.take_all()
+                    latencies.append(clock() - start)
+        finally:
+            loopback.close()
+
+        metrics = latency_metrics(latencies)
+        metrics.update(phases.metrics)
+        self.record("latency", case, metrics)
+
+    # async_take: a task writes while another one receives with take_data_async
+    def async_take(self, case: TypeCase):
+        if case.is_builtin:
+            return  # take_data_async is only available for IDL and DynamicData
+
+        loopback = self.create_loopback(case)
+        count = self.samples
+
+        async def publish():
+            for i in range(count):
+                loopback.writer.write(case.sample)
+                if i % 100 == 0:
+                    await asyncio.sleep(0)
+
+        async def subscribe():
+            received = 0
+            async for _ in loopback.reader.take_data_async():
+                received += 1
+                if received == count:
+                    break
+
+        async def run():
+            start = time.perf_counter_ns()
+            subscriber = asyncio.create_task(subscribe())
+            await publish()
+            await asyncio.wait_for(subscriber, timeout=60)
+            return time.perf_counter_ns() - start
+
+        try:
+            total_ns = rti.asyncio.run(run())
+        finally:
+            loopback.close()
+
+        self.record("async_take", case, {
+            "samples_per_s": count / (total_ns / 1e9),
+            "mbytes_per_s": count * case.payload_bytes / 1e6 / (total_ns / 1e9),
+        })
+
+    def run(self, cases: List[TypeCase]):
+        for benchmark in BENCHMARKS:
+            if self.args.filter and not any(
+                    f in benchmark for f in self.args.filter):
+                continue
+            print(f"{benchmark}:")
+            for case in cases:
+                if self.args.type and case.kind not in self.args.type:
+                    continue
+                gc.collect()
+                getattr(self, benchmark)(case)
+
+
+class PhaseStats:
+    """Collects the per-phase latency histograms (dds.PerfStats) of a
+    DataWriter and a DataReader when --perf-stats is used
+    """
+
+    PHASES = ["lock_wait", "gil_wait", "conversion", "native_call"]
+
+    def __init__(self, enabled: bool, writer, reader):
+        self.enabled = enabled and hasattr(dds, "PerfStats")
+        self.writer = writer
+        self.reader = reader
+        self.metrics = {}
+
+    def __enter__(self):
+        if self.enabled:
+            dds.PerfStats.enabled = True
+            self.writer.perf_stats.reset()
+            self.reader.perf_stats.reset()
+        return self
+
+    def __exit__(self, *exc_info):
+        if not self.enabled:
+            return
+        for entity_name, entity in (("write", self.writer), ("take", self.reader)):
+            stats = entity.perf_stats
+            for phase in self.PHASES:
+                histogram = getattr(stats, phase)
+                if histogram.count > 0:
+                    prefix = f"{entity_name}_{phase}"
+                    self.metrics[f"{prefix}_us_p50"] = histogram.percentile(50) / 1000.0
+                    self.metrics[f"{prefix}_us_p99"] = histogram.percentile(99) / 1000.0
+        dds.PerfStats.enabled = False
+
+
+#
+# Results
+#
+
+def get_metadata(args) -> Dict[str, Any]:
+    metadata = {
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+        "python": sys.version.split()[0],
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "transport": args.transport,
+        "quick": args.quick,
+    }
+    try:
+        from importlib import metadata as importlib_metadata
+        metadata["rti.connext"] = importlib_metadata.version("rti.connext")
+    except Exception:
+        pass
+    return metadata
+
+
+def compare(results: Dict[str, Any], baseline: Dict[str, Any], threshold: float) -> List[str]:
+    """Returns a description of each metric that is worse than in the
+    baseline by more than threshold (a fraction of the baseline value)
+    """
+
+    baseline_results = {r["name"]: r["metrics"] for r in baseline["results"]}
+    regressions = []
+    compared = 0
+    for result in results["results"]:
+        old_metrics = baseline_results.get(result["name"])
+        if old_metrics is None:
+            continue
+        for metric, value in result["metrics"].items():
+            higher_is_better = is_higher_better(metric)
+            old_value = old_metrics.get(metric)
+            if higher_is_better is None or not old_value:
+                continue
+            compared += 1
+            change = (value - old_value) / old_value
+            worse = -change if higher_is_better else change
+            if worse > threshold:
+                regressions.append(
+                    f"{result['name']} {metric}: {old_value:.3f} -> "
+                    f"{value:.3f} ({change:+.1%})")
+
+    print(f"Compared {compared} metrics against the baseline "
+          f"(threshold {threshold:.0%})")
+    return regressions
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Benchmarks of the Python binding layer over loopback")
+    parser.add_argument(
+        "--transport", choices=["shmem", "udp"], default="shmem",
+        help="transport between the DataWriters and DataReaders")
+    parser.add_argument(
+        "--domain", type=int, default=0, help="domain id")
+    parser.add_argument(
+        "--quick", action="store_true",
+        help="fewer iterations, payload sizes and sequence lengths")
+    parser.add_argument(
+        "--filter", nargs="*", default=[],
+        help=f"run only the benchmarks containing these strings {BENCHMARKS}")
+    parser.add_argument(
+        "--type", nargs="*", default=[],
+        choices=["idl", "dynamic_data", "string", "bytes"],
+        help="run only these data types")
+    parser.add_argument(
+        "--payload-sizes", type=int, nargs="*",
+        help=f"payload sizes in bytes (max {MAX_PAYLOAD_SIZE})")
+    parser.add_argument(
+        "--sequence-lengths", type=int, nargs="*",
+        help=f"sequence lengths (max {MAX_SEQUENCE_LENGTH})")
+    parser.add_argument(
+        "--perf-stats", action="store_true",
+        help="also report the per-phase latencies of write and take "
+        "(adds some overhead)")
+    parser.add_argument(
+        "--output", help="write the results to this JSON file")
+    parser.add_argument(
+        "--baseline", help="compare the results to this JSON file")
+    parser.add_argument(
+        "--threshold", type=float, default=0.10,
+        help="relative change that is reported as a regression (default 0.10)")
+    return parser.parse_args(argv)
+
+
+def main(argv=None) -> int:
+    args = parse_args(argv)
+
+    payload_sizes = args.payload_sizes or (
+        QUICK_PAYLOAD_SIZES if args.quick else PAYLOAD_SIZES)
+    sequence_lengths = args.sequence_lengths or (
+        QUICK_SEQUENCE_LENGTHS if args.quick else SEQUENCE_LENGTHS)
+    if max(payload_sizes, default=0) > MAX_PAYLOAD_SIZE:
+        raise SystemExit(f"The max payload size is {MAX_PAYLOAD_SIZE}")
+    if max(sequence_lengths, default=0) > MAX_SEQUENCE_LENGTH:
+        raise SystemExit(f"The max sequence length is {MAX_SEQUENCE_LENGTH}")
+
+    suite = Suite(args)
+    try:
+        suite.run(create_type_cases(payload_sizes, sequence_lengths))
+    finally:
+        suite.close()
+
+    results = {"metadata": get_metadata(args), "results": suite.results}
+    if args.output:
+        with open(args.output, "w") as output:
+            json.dump(results, output, indent=2)
+        print(f"Results written to {args.output}")
+
+    if args.baseline:
+        with open(args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+        regressions = compare(results, baseline, args.threshold)
+        if regressions:
+            print(f"{len(regressions)} regression(s):")
+            for regression in regressions:
+                print(f"  {regression}")
+            return 1
+        print("No regressions")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
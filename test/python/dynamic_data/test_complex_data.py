@@ -195,3 +195,101 @@ def test_documentation_examples():
         sample["bad_member"] = "bad value"
     with pytest.raises(ValueError):
         sample["location"] = "bad value"
+
+
+def test_compiled_path():
+    point_type = dds.StructType("Point")
+    point_type.add_member(dds.Member("x", dds.Float64Type()))
+    point_type.add_member(dds.Member("y", dds.Float64Type()))
+    segment_type = dds.StructType("Segment")
+    segment_type.add_member(dds.Member("id", dds.Int32Type()))
+    segment_type.add_member(
+        dds.Member("points", dds.SequenceType(point_type, 10)))
+    my_type = dds.StructType("Track")
+    my_type.add_member(dds.Member("name", dds.StringType(128)))
+    my_type.add_member(dds.Member("segment", segment_type))
+    my_type.add_member(
+        dds.Member("grid", dds.ArrayType(dds.Int32Type(), [2, 3])))
+
+    sample = dds.DynamicData(my_type)
+    sample["segment.points"] = [{"x": 1, "y": 2}, {"x": 3, "y": 4}]
+    sample["grid"] = list(range(6))
+
+    y = my_type.compile_path("segment.points[1].y")
+    assert y.path == "segment.points[1].y"
+    assert y.get(sample) == 4
+    y.set(sample, 40)
+    assert sample["segment.points[1].y"] == 40
+
+    name = my_type.compile_path("name")
+    name.set(sample, "track 1")
+    assert name.get(sample) == "track 1"
+
+    assert my_type.compile_path("grid[1, 2]").get(sample) == 5
+    assert my_type.compile_path("grid").get(sample) == list(range(6))
+    assert my_type.compile_path("segment").get(sample) == sample["segment"]
+
+    # The accessors are cached per type and path
+    assert my_type.compile_path("segment.points[1].y") is y
+    assert sample.type.compile_path("segment.points[1].y") is y
+
+    with pytest.raises(dds.InvalidArgumentError):
+        y.get(dds.DynamicData(segment_type))
+    with pytest.raises(dds.InvalidArgumentError):
+        my_type.compile_path("segment.bad_member")
+    with pytest.raises(dds.InvalidArgumentError):
+        my_type.compile_path("name[1]")
+    with pytest.raises(dds.InvalidArgumentError):
+        my_type.compile_path("segment.id.x")
+    with pytest.raises(IndexError):
+        my_type.compile_path("grid[2, 0]")
+    with pytest.raises(dds.InvalidArgumentError):
+        my_type.compile_path("segment.points[x]")
+
+
+def create_point_type(*member_names):
+    point_type = dds.StructType("Point")
+    for name in member_names:
+        point_type.add_member(dds.Member(name, dds.Float64Type()))
+    return point_type
+
+
+def test_compiled_path_with_equal_types():
+    point_type = create_point_type("x", "y")
+    same_type = create_point_type("x", "y")
+    other_type = create_point_type("y", "x")
+
+    # Equal types share their accessors, and the accessor can be used with
+    # the data of any of them
+    x = point_type.compile_path("x")
+    assert same_type.compile_path("x") is x
+    for _ in range(3):
+        for t in (point_type, same_type):
+            sample = dds.DynamicData(t)
+            sample["x"] = 1.5
+            assert x.get(sample) == 1.5
+
+    # A different type with the same name has its own accessor
+    other_x = other_type.compile_path("x")
+    assert other_x is not x
+    other_sample = dds.DynamicData(other_type)
+    other_sample["x"] = 2.5
+    assert other_x.get(other_sample) == 2.5
+    with pytest.raises(dds.InvalidArgumentError):
+        x.get(other_sample)
+    with pytest.raises(dds.InvalidArgumentError):
+        other_x.get(dds.DynamicData(point_type))
+
+
+def test_compiled_path_cache_is_bounded():
+    point_type = create_point_type("x", "y")
+    seq_type = dds.StructType("PointSeq")
+    seq_type.add_member(
+        dds.Member("points", dds.SequenceType(point_type, 2000)))
+    sample = dds.DynamicData(seq_type)
+    sample["points"] = [{"x": i, "y": -i} for i in range(2000)]
+
+    # More paths than the cache holds; the evicted ones are compiled again
+    for _ in range(2):
+        for i in range(0, 2000, 3):
+            assert seq_type.compile_path(f"points[{i}].x").get(sample) == i
@@ -268,6 +268,93 @@ def test_dynamic_data_buffer_numpy(types):
         data["myLongSeq"] = my_array_short
 
 
+
+def test_dynamic_data_to_from_numpy():
+    np = pytest.importorskip("numpy")
+    point_type = dds.StructType("Point")
+    point_type.add_member(dds.Member("x", dds.Int32Type()))
+    point_type.add_member(dds.Member("y", dds.Float64Type()))
+    my_type = dds.StructType("NumpyType")
+    my_type.add_member(dds.Member("id", dds.Int16Type()))
+    my_type.add_member(dds.Member("flag", dds.BoolType()))
+    my_type.add_member(dds.Member("name", dds.StringType(20)))
+    my_type.add_member(dds.Member("location", point_type))
+    my_type.add_member(dds.Member("path", dds.ArrayType(point_type, 2)))
+    my_type.add_member(
+        dds.Member("matrix", dds.ArrayType(dds.Float32Type(), [2, 3])))
+    my_type.add_member(
+        dds.Member("samples", dds.SequenceType(dds.Uint8Type(), 1000)))
+
+    dtype = dds.DynamicData.numpy_dtype(my_type)
+    assert dtype.names == (
+        "id", "flag", "name", "location", "path", "matrix", "samples")
+    assert dtype["id"] == np.int16
+    assert dtype["location"].names == ("x", "y")
+    assert dtype["path"].shape == (2,)
+    assert dtype["matrix"].shape == (2, 3)
+
+    data = dds.DynamicData(my_type)
+    data["id"] = 7
+    data["flag"] = True
+    data["name"] = "seven"
+    data["location"] = {"x": 1, "y": 2.5}
+    data["path"] = [{"x": 3, "y": 4.5}, {"x": 5, "y": 6.5}]
+    data["matrix"] = [0.5 * i for i in range(6)]
+    data["samples"] = np.arange(600, dtype=np.uint8)
+
+    record = data.to_numpy()
+    assert record.dtype == dtype
+    assert record["id"] == 7
+    assert record["flag"]
+    assert record["name"] == "seven"
+    assert record["location"]["y"] == 2.5
+    assert record["path"][1]["x"] == 5
+    assert record["matrix"][1, 2] == 2.5
+    assert np.array_equal(
+        record["samples"][()], np.arange(600, dtype=np.uint8))
+
+    copy = dds.DynamicData(my_type)
+    copy.from_numpy(record)
+    assert copy == data
+
+    records = np.zeros(3, dtype)
+    records["id"] = [1, 2, 3]
+    records["name"] = ["a", "b", "c"]
+    for i in range(3):
+        records["samples"][i] = np.array([i + 1] * 4, np.uint8)
+    samples = dds.DynamicData.from_numpy_array(my_type, records)
+    assert len(samples) == 3
+    assert samples[2]["id"] == 3
+    assert samples[2]["name"] == "c"
+    assert list(samples[2]["samples"]) == [3] * 4
+
+    with pytest.raises(TypeError):
+        copy.from_numpy(np.zeros((), [("id", np.int16)]))
+    with pytest.raises(dds.InvalidArgumentError):
+        dds.DynamicData.numpy_dtype(dds.SequenceType(dds.Int32Type(), 10))
+
+
+def test_numpy_dtype_of_equal_and_distinct_types():
+    np = pytest.importorskip("numpy")
+
+    def create_type(member_count):
+        t = dds.StructType("Record")
+        for i in range(member_count):
+            t.add_member(dds.Member(f"m{i}", dds.Int32Type()))
+        return t
+
+    # Types with the same name but different members have their own dtype,
+    # also after the cache evicts some of them
+    for _ in range(2):
+        for member_count in range(1, 300):
+            t = create_type(member_count)
+            dtype = dds.DynamicData.numpy_dtype(t)
+            assert len(dtype.names) == member_count
+            assert dtype[f"m{member_count - 1}"] == np.int32
+            same_type = create_type(member_count)
+            assert dds.DynamicData.numpy_dtype(same_type) == dtype
+
+
 def test_union(types):
     test_union = dds.DynamicData(types.UNION)
     simple = dds.DynamicData(types.SIMPLE)
@@ -125,3 +125,120 @@ def test_writer_create_data(pubsub):
     sample = pubsub.writer.create_data()
     pubsub.writer.write(sample)
     check_expected_data(pubsub.reader, [sample])
+
+
+def test_take_columns(pubsub):
+    samples = []
+    for i in range(5):
+        sample = get_sample_point(pubsub.data_type)
+        sample["x"] = i
+        sample["y"] = -i
+        samples.append(sample)
+    pubsub.writer.write(samples)
+    wait.for_data(pubsub.reader, count=5)
+
+    columns = pubsub.reader.take_columns(["x", "y"])
+    assert isinstance(columns["x"], dds.Int32Seq)
+    assert sorted(columns["x"]) == [0, 1, 2, 3, 4]
+    assert sorted(columns["y"]) == [-4, -3, -2, -1, 0]
+    assert len(columns["info.source_timestamp"]) == 5
+    assert len(columns["info.reception_timestamp"]) == 5
+    assert len(columns["info.instance_handle"]) == 5
+    assert len(pubsub.reader.take_data()) == 0
+
+    with pytest.raises(dds.InvalidArgumentError):
+        pubsub.reader.take_columns(["z"])
+
+
+def test_take_numpy(pubsub):
+    pytest.importorskip("numpy")
+    samples = []
+    for i in range(5):
+        sample = get_sample_point(pubsub.data_type)
+        sample["x"] = i
+        samples.append(sample)
+    pubsub.writer.write(samples)
+    wait.for_data(pubsub.reader, count=5)
+
+    records = pubsub.reader.read_numpy()
+    assert records.dtype == dds.DynamicData.numpy_dtype(pubsub.data_type)
+    assert sorted(records["x"]) == [0, 1, 2, 3, 4]
+    assert all(records["y"] == 2)
+
+    records = pubsub.reader.take_numpy()
+    assert len(records) == 5
+    assert len(pubsub.reader.take_numpy()) == 0
+
+
+def test_perf_stats(pubsub):
+    dds.PerfStats.enabled = True
+    try:
+        for i in range(3):
+            pubsub.writer.write(get_sample_point(pubsub.data_type))
+        wait.for_data(pubsub.reader, count=3)
+        assert len(pubsub.reader.take()) == 3
+    finally:
+        dds.PerfStats.enabled = False
+
+    # Only the native call is recorded on write
+    assert pubsub.writer.perf_stats.native_call.count == 3
+    assert pubsub.writer.perf_stats.conversion.count == 0
+    assert pubsub.reader.perf_stats.native_call.count == 1
+    assert pubsub.reader.perf_stats.conversion.count == 1
+
+
+def test_filter_predicate_evaluate(type_fixture):
+    x = dds.FilterField("x")
+    y = dds.FilterField("y")
+    predicate = (x.between(0, 10) & ~(y == 3)) | x.isin([100, 200])
+    assert "BETWEEN" in repr(predicate)
+
+    sample = get_sample_point(type_fixture)  # x = 1, y = 2
+    assert predicate.evaluate(sample)
+    sample["y"] = 3
+    assert not predicate.evaluate(sample)
+    sample["x"] = 200
+    assert predicate.evaluate(sample)
+
+    bound = predicate.bind(type_fixture)
+    assert bound.is_bound and not predicate.is_bound
+    assert bound.evaluate(sample)
+
+    with pytest.raises(TypeError):
+        bool(x == 1)
+    with pytest.raises(TypeError):
+        x.isin([1, "a"])
+    with pytest.raises(dds.InvalidArgumentError):
+        (dds.FilterField("z") == 1).bind(type_fixture)
+    with pytest.raises(dds.InvalidArgumentError):
+        (x == "a").bind(type_fixture)
+
+
+def test_predicate_content_filter(pubsub):
+    class MinXFilter(dds.PredicateContentFilter):
+        def compile(self, expression, parameters, type_code, type_class_name):
+            return dds.FilterField("x") >= int(parameters[0])
+
+    filter_name = "MinXFilter"
+    participant = pubsub.participant
+    participant.register_contentfilter(MinXFilter(), filter_name)
+    try:
+        cft_filter = dds.Filter("x >= %0", ["3"])
+        cft_filter.name = filter_name
+        cft = dds.DynamicData.ContentFilteredTopic(
+            pubsub.topic, "MinXTopic", cft_filter)
+        reader = dds.DynamicData.DataReader(pubsub.subscriber, cft)
+        wait.for_discovery(reader, pubsub.writer)
+
+        samples = []
+        for i in range(5):
+            sample = get_sample_point(pubsub.data_type)
+            sample["x"] = i
+            samples.append(sample)
+        pubsub.writer.write(samples)
+
+        check_expected_data(reader, samples[3:])
+    finally:
+        # The filter can't be unregistered while a topic uses it
+        participant.close_contained_entities()
+        participant.unregister_contentfilter(filter_name)
@@ -0,0 +1,81 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+# Measures the time to import rti.connextdds in a new interpreter, which is
+# the startup cost of short-lived applications that use it.
+#
+# Usage: python import_perf.py [count] [-access] [-max-seconds SECONDS]
+
+import argparse
+import statistics
+import subprocess
+import sys
+
+IMPORT_CODE = """
+import time
+start = time.perf_counter()
+import rti.connextdds as dds
+elapsed = time.perf_counter() - start
+"""
+
+# Also initializes the attributes that are registered on first access
+ACCESS_CODE = """
+dds.ParticipantBuiltinTopicData
+dds.PublicationBuiltinTopicData
+dds.SubscriptionBuiltinTopicData
+dds.TopicBuiltinTopicData
+getattr(dds, "network_capture", None)
+elapsed = time.perf_counter() - start
+"""
+
+
+def measure(access):
+    code = IMPORT_CODE + (ACCESS_CODE if access else "") + "print(elapsed)"
+    result = subprocess.run(
+        [sys.executable, "-c", code],
+        capture_output=True,
+        text=True,
+        check=True)
+    return float(result.stdout)
+
+
+def main(count, access, max_seconds):
+    if count <= 0:
+        print("Count cannot be zero or below")
+        sys.exit(1)
+    print(f"Importing rti.connextdds {count} time" + ("s" if count > 1 else ""))
+    if access:
+        print("Including the lazily initialized attributes")
+
+    # The first import warms up the file system cache
+    measure(access)
+    times = []
+    for i in range(0, count):
+        times.append(measure(access))
+        print(".", end="", flush=True)
+    print("")
+
+    median = statistics.median(times)
+    print(f"Median:  {median} seconds\nMinimum: {min(times)} seconds")
+    print(f"Maximum: {max(times)} seconds")
+
+    if max_seconds is not None and median > max_seconds:
+        print(f"Median import time exceeds {max_seconds} seconds")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("count", type=int, nargs="?", default=20)
+    parser.add_argument("-access", action="store_true")
+    parser.add_argument("-max-seconds", type=float, default=None)
+    args = parser.parse_args()
+    main(args.count, args.access, args.max_seconds)
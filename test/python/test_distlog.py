@@ -0,0 +1,233 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+import subprocess
+import sys
+import textwrap
+
+import pytest
+
+
+# The logger options can only be set once per process, so each test uses its
+# own interpreter. The logger echoes the messages it publishes to stdout.
+LOGGER_SETUP = """
+import rti.connextdds as dds
+import rti.logging.distlog as distlog
+import rti.idl_impl.test_utils as test_utils
+
+options = distlog.LoggerOptions()
+options.domain_id = test_utils.get_test_domain()
+options.echo_to_stdout = True
+options.filter_level = distlog.LogLevel.DEBUG
+options.remote_administration_enabled = {remote_administration}
+distlog.Logger.init(options)
+Logger = distlog.Logger
+"""
+
+
+def run_with_logger(code, remote_administration=False):
+    setup = LOGGER_SETUP.format(remote_administration=remote_administration)
+    result = subprocess.run(
+        [sys.executable, "-c", setup + textwrap.dedent(code)],
+        capture_output=True,
+        text=True)
+    assert result.returncode == 0, result.stderr
+    return result.stdout
+
+
+def test_flush_publishes_the_queued_messages():
+    output = run_with_logger(
+        """
+        Logger.enable_async(capacity=16)
+        assert Logger.async_enabled()
+        for i in range(100):
+            Logger.info(f"flushed message {i}")
+        Logger.flush()
+        assert Logger.queued_count() == 0
+        assert Logger.dropped_count() == 0
+        """)
+    assert "flushed message 99" in output
+
+
+def test_block_policy_never_drops():
+    run_with_logger(
+        """
+        Logger.enable_async(
+            capacity=2,
+            overflow_policy=distlog.LogOverflowPolicy.BLOCK,
+            max_batch=1)
+        for i in range(1000):
+            Logger.info(f"blocked message {i}")
+        Logger.flush()
+        assert Logger.queued_count() == 0
+        assert Logger.dropped_count() == 0
+        """)
+
+
+@pytest.mark.parametrize(
+    "policy", ["DROP_OLDEST", "DROP_NEWEST"])
+def test_drop_policies_count_dropped_messages(policy):
+    run_with_logger(
+        f"""
+        Logger.enable_async(
+            capacity=2,
+            overflow_policy=distlog.LogOverflowPolicy.{policy},
+            max_batch=1)
+        for i in range(1000):
+            Logger.info(f"dropped message {{i}}")
+            # The queue never holds more messages than its capacity
+            assert Logger.queued_count() <= 2
+        Logger.flush()
+        assert Logger.queued_count() == 0
+        dropped = Logger.dropped_count()
+        assert 0 <= dropped <= 1000
+
+        # The counters are kept after the queue is stopped
+        Logger.disable_async()
+        assert Logger.dropped_count() == dropped
+        """)
+
+
+def test_disable_async_publishes_the_queued_messages():
+    output = run_with_logger(
+        """
+        Logger.enable_async(capacity=64)
+        for i in range(50):
+            Logger.info(f"drained message {i}")
+        Logger.disable_async()
+        assert not Logger.async_enabled()
+        assert Logger.queued_count() == 0
+        assert Logger.dropped_count() == 0
+
+        # Logging is synchronous again
+        Logger.info("synchronous message")
+        Logger.flush()
+        """)
+    assert "drained message 49" in output
+    assert "synchronous message" in output
+
+
+def test_async_mode_can_be_enabled_again():
+    run_with_logger(
+        """
+        for policy in (
+                distlog.LogOverflowPolicy.DROP_NEWEST,
+                distlog.LogOverflowPolicy.BLOCK):
+            Logger.enable_async(capacity=8, overflow_policy=policy)
+            for i in range(100):
+                Logger.info(f"message {i}")
+        Logger.disable_async()
+        Logger.disable_async()
+        assert Logger.queued_count() == 0
+        """)
+
+
+@pytest.mark.parametrize("use_async", [False, True])
+def test_structured_messages_are_rendered(use_async):
+    output = run_with_logger(
+        f"""
+        if {use_async}:
+            Logger.enable_async()
+        format_id = Logger.register_format(
+            "int={{}} float={{}} str={{}} none={{}} bool={{}}")
+        Logger.log_structured(
+            distlog.LogLevel.INFO, format_id, 42, 1.5, "text", None, True)
+        Logger.flush()
+        """)
+    assert "int=42 float=1.5 str=text none=None bool=True" in output
+
+
+def test_structured_arguments_are_encoded_like_str():
+    output = run_with_logger(
+        """
+        format_id = Logger.register_format("[{}]")
+        for value in (0.1, 3.0, -2.5e-8, 1e300, 2**80, -2**70, 1 << 63):
+            Logger.log_structured(distlog.LogLevel.INFO, format_id, value)
+        Logger.flush()
+        """)
+    for value in (0.1, 3.0, -2.5e-8, 1e300, 2**80, -2**70, 1 << 63):
+        assert f"[{value}]" in output
+
+
+def test_structured_message_braces_and_missing_arguments():
+    output = run_with_logger(
+        """
+        format_id = Logger.register_format("{{literal}} {} and {}")
+        Logger.log_structured(distlog.LogLevel.INFO, format_id, 7)
+        Logger.flush()
+        """)
+    assert "{literal} 7 and {}" in output
+
+
+def test_structured_message_category_is_keyword_only():
+    output = run_with_logger(
+        """
+        format_id = Logger.register_format("categorized {}")
+        Logger.log_structured(
+            distlog.LogLevel.INFO, format_id, 1, category="my_category")
+        Logger.log_structured(
+            distlog.LogLevel.INFO, format_id, 2, category=None)
+        # A positional argument after the format id is a template argument
+        Logger.log_structured(
+            distlog.LogLevel.INFO, format_id, 3, "ignored")
+        Logger.flush()
+
+        try:
+            Logger.log_structured(distlog.LogLevel.INFO, format_id + 1000, 1)
+            assert False, "Unknown format id accepted"
+        except dds.InvalidArgumentError:
+            pass
+        """)
+    assert "categorized 1" in output
+    assert "categorized 2" in output
+    assert "categorized 3" in output
+
+
+def test_register_format_returns_the_same_id():
+    run_with_logger(
+        """
+        first = Logger.register_format("same {}")
+        other = Logger.register_format("other {}")
+        assert Logger.register_format("same {}") == first
+        assert other != first
+        """)
+
+
+def test_is_enabled_for():
+    run_with_logger(
+        """
+        LogLevel = distlog.LogLevel
+        assert Logger.is_enabled_for(LogLevel.DEBUG)
+        assert Logger.is_enabled_for(LogLevel.FATAL)
+        assert not Logger.is_enabled_for(LogLevel.TRACE)
+        assert not Logger.is_enabled_for(LogLevel.SILENT)
+
+        Logger.filter_level(LogLevel.WARNING)
+        assert Logger.is_enabled_for(LogLevel.WARNING)
+        assert Logger.is_enabled_for(LogLevel.ERROR)
+        assert not Logger.is_enabled_for(LogLevel.NOTICE)
+        assert not Logger.is_enabled_for(LogLevel.INFO)
+        """)
+
+
+def test_is_enabled_for_with_remote_administration():
+    # Remote administration can change the filter level, so only the native
+    # logger filters
+    run_with_logger(
+        """
+        LogLevel = distlog.LogLevel
+        assert Logger.is_enabled_for(LogLevel.TRACE)
+        Logger.filter_level(LogLevel.WARNING)
+        assert Logger.is_enabled_for(LogLevel.INFO)
+        assert Logger.is_enabled_for(LogLevel.TRACE)
+        assert not Logger.is_enabled_for(LogLevel.SILENT)
+        """,
+        remote_administration=True)
@@ -0,0 +1,183 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+import subprocess
+import sys
+import textwrap
+
+import rti.connextdds as dds
+import pytest
+from test_utils.fixtures import get_test_domain
+
+
+def run_in_new_interpreter(code):
+    # The lazily initialized attributes may have been initialized by other
+    # tests in this process
+    result = subprocess.run(
+        [sys.executable, "-c", textwrap.dedent(code)],
+        capture_output=True,
+        text=True)
+    assert result.returncode == 0, result.stderr
+    return result.stdout
+
+
+def test_lazy_attributes_are_listed():
+    names = dir(dds)
+    assert "ParticipantBuiltinTopicData" in names
+    assert "SubscriptionBuiltinTopicDataSeq" in names
+    assert names.count("DomainParticipant") == 1
+
+
+def test_lazy_attribute_access():
+    output = run_in_new_interpreter(
+        """
+        import rti.connextdds as dds
+        print(dds.PublicationBuiltinTopicData.__name__)
+        print(dds.PublicationBuiltinTopicData.DataReader.__name__)
+        print(dds.PublicationBuiltinTopicDataSeq.__name__)
+        """)
+    assert output.split() == [
+        "PublicationBuiltinTopicData",
+        "DataReader",
+        "PublicationBuiltinTopicDataSeq"]
+
+
+def test_lazy_init_from_return_value():
+    output = run_in_new_interpreter(
+        f"""
+        import rti.connextdds as dds
+        participant = dds.DomainParticipant({get_test_domain()})
+        reader = participant.participant_reader
+        print(type(reader) is dds.ParticipantBuiltinTopicData.DataReader)
+        print(len(participant.discovered_topic_data()))
+        participant.close()
+        """)
+    assert output.split() == ["True", "0"]
+
+
+def test_unknown_attribute():
+    with pytest.raises(AttributeError):
+        dds.NotARealClass
+    assert not hasattr(dds, "NotARealClass")
+
+
+def test_concurrent_lazy_init():
+    # Threads that access the lazy attributes at the same time must all see
+    # them fully initialized
+    output = run_in_new_interpreter(
+        """
+        import threading
+        import rti.connextdds as dds
+
+        barrier = threading.Barrier(8)
+        results = []
+
+        def access():
+            barrier.wait()
+            results.append(
+                dds.SubscriptionBuiltinTopicData.DataReader.__name__)
+
+        threads = [threading.Thread(target=access) for _ in range(8)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        print(len(results), set(results) == {"DataReader"})
+        """)
+    assert output.split() == ["8", "True"]
+
+
+@pytest.mark.skipif(
+    sys.version_info < (3, 12), reason="Requires subinterpreters")
+def test_subinterpreter_state_is_isolated():
+    # Each subinterpreter initializes its own module state; destroying it
+    # must not affect the other interpreters of the process
+    output = run_in_new_interpreter(
+        '''
+        try:
+            import _interpreters as interpreters
+            interpreter = interpreters.create("legacy")
+        except ImportError:
+            import _xxsubinterpreters as interpreters
+            interpreter = interpreters.create(isolated=False)
+
+        error = interpreters.run_string(interpreter, """if True:
+            import rti.connextdds as dds
+            import rti.idl as idl
+
+            @idl.struct
+            class Point:
+                x: int = 0
+                y: int = 0
+
+            sample = idl.get_type_support(Point).deserialize(
+                idl.get_type_support(Point).serialize(Point(x=1, y=2)))
+            print(dds.ParticipantBuiltinTopicData.__name__, sample.y, flush=True)
+            """)
+        assert error is None, error
+        interpreters.destroy(interpreter)
+
+        import rti.connextdds as dds
+        import rti.idl as idl
+
+        @idl.struct
+        class Point:
+            x: int = 0
+
+        print(dds.ParticipantBuiltinTopicData.__name__, Point(x=3).x)
+        ''')
+    assert output.split() == [
+        "ParticipantBuiltinTopicData", "2", "ParticipantBuiltinTopicData", "3"]
+
+
+@pytest.mark.skipif(
+    sys.version_info < (3, 12), reason="Requires subinterpreters")
+def test_isolated_subinterpreter():
+    # A subinterpreter with its own GIL can import the module and use it while
+    # the main one does too. Only builds with pybind11 3 support it.
+    output = run_in_new_interpreter(
+        '''
+        try:
+            import _interpreters as interpreters
+            interpreter = interpreters.create()
+        except ImportError:
+            import _xxsubinterpreters as interpreters
+            interpreter = interpreters.create(isolated=True)
+
+        import rti.connextdds as dds
+
+        error = interpreters.run_string(interpreter, """if True:
+            try:
+                import rti.connextdds as dds
+            except ImportError:
+                dds = None
+                print("unsupported", flush=True)
+
+            if dds is not None:
+                point_type = dds.StructType("Point")
+                point_type.add_member(dds.Member("x", dds.Int32Type()))
+                sample = dds.DynamicData(point_type)
+                sample["x"] = 1
+                print(dds.ParticipantBuiltinTopicData.__name__, sample["x"], flush=True)
+            """)
+        assert error is None, error
+        interpreters.destroy(interpreter)
+
+        point_type = dds.StructType("Point")
+        point_type.add_member(dds.Member("x", dds.Int32Type()))
+        sample = dds.DynamicData(point_type)
+        sample["x"] = 2
+        print(dds.ParticipantBuiltinTopicData.__name__, sample["x"])
+        ''')
+    if output.split()[0] == "unsupported":
+        pytest.skip("The module was built without per-interpreter GIL support")
+    assert output.split() == [
+        "ParticipantBuiltinTopicData", "1", "ParticipantBuiltinTopicData", "2"]
@@ -0,0 +1,220 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+import rti.connextdds as dds
+import rti.request as request
+import rti.types as idl
+import asyncio
+import pytest
+
+from test_utils.fixtures import *
+
+
+@idl.struct
+class Numbers:
+    x: int = 0
+    y: int = 0
+
+
+@idl.struct
+class Sum:
+    result: int = 0
+
+
+@pytest.fixture
+def requester_replier(participant):
+    requester = request.Requester(
+        Numbers, Sum, participant, service_name="TestSum")
+    replier = request.Replier(
+        Numbers, Sum, participant, service_name="TestSum")
+    wait.for_discovery(replier.request_datareader, requester.request_datawriter)
+    wait.for_discovery(requester.reply_datareader, replier.reply_datawriter)
+    yield requester, replier
+    requester.close()
+    replier.close()
+
+
+def test_request_reply(requester_replier):
+    requester, replier = requester_replier
+    request_id = requester.send_request(Numbers(x=1, y=2))
+
+    requests = replier.receive_requests(max_wait=dds.Duration(10))
+    assert len(requests) == 1
+    data, info = requests[0]
+    replier.send_reply(Sum(result=data.x + data.y), info)
+
+    replies = requester.receive_replies(
+        max_wait=dds.Duration(10), related_request_id=request_id)
+    assert len(replies) == 1
+    reply, reply_info = replies[0]
+    assert reply.result == 3
+    assert requester.is_related_reply(request_id, reply_info)
+    assert requester.is_final_reply(reply_info)
+
+
+def test_multiple_replies_are_correlated(requester_replier):
+    requester, replier = requester_replier
+    first_id = requester.send_request(Numbers(x=1))
+    second_id = requester.send_request(Numbers(x=2))
+
+    requests = replier.receive_requests(max_wait=dds.Duration(10), min_count=2)
+    assert len(requests) == 2
+    for data, info in requests:
+        for i in range(3):
+            replier.send_reply(Sum(result=data.x * 10 + i), info, final=i == 2)
+
+    assert requester.wait_for_replies(
+        dds.Duration(10), min_count=3, related_request_id=second_id)
+    replies = requester.take_replies(second_id)
+    assert [data.result for data, _ in replies] == [20, 21, 22]
+    assert [requester.is_final_reply(info) for _, info in replies] == [
+        False, False, True]
+
+    replies = requester.receive_replies(
+        dds.Duration(10), min_count=3, related_request_id=first_id)
+    assert [data.result for data, _ in replies] == [10, 11, 12]
+
+
+def test_wait_timeout(requester_replier):
+    requester, replier = requester_replier
+    assert not replier.wait_for_requests(dds.Duration.from_milliseconds(10))
+    assert not requester.wait_for_replies(dds.Duration.from_milliseconds(10))
+    with pytest.raises(dds.TimeoutError):
+        requester.receive_replies(dds.Duration.from_milliseconds(10))
+
+
+def test_invalid_related_request_id(requester_replier):
+    requester, replier = requester_replier
+    with pytest.raises(dds.InvalidArgumentError):
+        replier.send_reply(Sum(), dds.SampleIdentity())
+
+
+@pytest.fixture
+def demultiplexed_requester_replier(participant):
+    requester = request.Requester(
+        Numbers, Sum, participant, service_name="TestDemux",
+        demultiplex_replies=True)
+    replier = request.Replier(
+        Numbers, Sum, participant, service_name="TestDemux")
+    wait.for_discovery(replier.request_datareader, requester.request_datawriter)
+    wait.for_discovery(requester.reply_datareader, replier.reply_datawriter)
+    yield requester, replier
+    requester.close()
+    replier.close()
+
+
+def test_demultiplexed_replies_async(demultiplexed_requester_replier):
+    requester, replier = demultiplexed_requester_replier
+    request_count = 100
+
+    async def run_requests():
+        request_ids = [
+            await requester.send_request_async(Numbers(x=i, y=i))
+            for i in range(request_count)]
+        # Start waiting before the replies are sent, so that they complete
+        # requests that are already pending
+        pending = [
+            asyncio.ensure_future(requester.receive_replies_async(
+                dds.Duration(10), related_request_id=request_id))
+            for request_id in request_ids]
+        while requester._demux.pending_count < request_count:
+            await asyncio.sleep(0.01)
+
+        received = 0
+        while received < request_count:
+            requests = await replier.receive_requests_async(dds.Duration(10))
+            for data, info in requests:
+                replier.send_reply(Sum(result=data.x + data.y), info)
+            received += len(requests)
+
+        return await asyncio.gather(*pending)
+
+    results = asyncio.run(run_requests())
+    assert [replies[0][0].result for replies in results] == [
+        2 * i for i in range(request_count)]
+
+
+def test_demultiplexed_replies_received_before_waiting(
+        demultiplexed_requester_replier):
+    requester, replier = demultiplexed_requester_replier
+    request_id = requester.send_request(Numbers(x=1, y=2))
+    data, info = replier.receive_requests(max_wait=dds.Duration(10))[0]
+    for i in range(2):
+        replier.send_reply(Sum(result=i), info, final=i == 1)
+
+    replies = requester.receive_replies(
+        dds.Duration(10), min_count=dds.LENGTH_UNLIMITED,
+        related_request_id=request_id)
+    assert [data.result for data, _ in replies] == [0, 1]
+
+
+def test_demultiplexed_replies_timeout(demultiplexed_requester_replier):
+    requester, _ = demultiplexed_requester_replier
+    request_id = requester.send_request(Numbers())
+
+    with pytest.raises(dds.TimeoutError):
+        requester.receive_replies(
+            dds.Duration.from_milliseconds(50), related_request_id=request_id)
+
+    async def receive():
+        await requester.receive_replies_async(
+            dds.Duration.from_milliseconds(50), related_request_id=request_id)
+
+    with pytest.raises(dds.TimeoutError):
+        asyncio.run(receive())
+
+
+def test_demultiplexed_replies_cancel(demultiplexed_requester_replier):
+    requester, _ = demultiplexed_requester_replier
+    request_id = requester.send_request(Numbers())
+
+    async def cancel():
+        task = asyncio.ensure_future(requester.receive_replies_async(
+            dds.Duration.infinite, related_request_id=request_id))
+        await asyncio.sleep(0.05)
+        task.cancel()
+        with pytest.raises(asyncio.CancelledError):
+            await task
+
+    asyncio.run(cancel())
+    assert requester._demux.pending_count == 0
+
+
+def test_demultiplexed_replies_require_request_id(
+        demultiplexed_requester_replier):
+    requester, _ = demultiplexed_requester_replier
+    request_id = requester.send_request(Numbers())
+
+    with pytest.raises(dds.PreconditionNotMetError):
+        requester.receive_replies(dds.Duration.from_milliseconds(50))
+    with pytest.raises(dds.PreconditionNotMetError):
+        requester.wait_for_replies(
+            dds.Duration.from_milliseconds(50), related_request_id=request_id)
+    with pytest.raises(dds.PreconditionNotMetError):
+        requester.take_replies(request_id)
+    with pytest.raises(dds.PreconditionNotMetError):
+        requester.read_replies()
+
+    async def wait():
+        await requester.wait_for_replies_async(
+            dds.Duration.from_milliseconds(50))
+
+    with pytest.raises(dds.PreconditionNotMetError):
+        asyncio.run(wait())
+
+
+def test_close_request_reply_object(participant):
+    requester = request.Requester(
+        Numbers, Sum, participant, service_name="TestClose")
+    requester.close()
+    assert requester.closed
+    with pytest.raises(dds.AlreadyClosedError):
+        requester.close()
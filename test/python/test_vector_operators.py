@@ -9,6 +9,7 @@
  # damages arising out of the use or inability to use the software.
  #
 
+import array
 import rti.connextdds as dds
 
 
@@ -42,3 +43,44 @@ def test_multiplication_assignment():
     for i in range(0, 4):
         assert s1[i] == i
         assert s1[i + 4] == i
+
+
+def test_construction_from_buffer():
+    values = array.array('i', range(0, 8))
+    s = dds.Int32Seq(values)
+    assert list(s) == list(values)
+    assert list(dds.Uint8Seq(b'\x01\x02\x03')) == [1, 2, 3]
+    # A buffer of a different element type is converted element by element
+    assert list(dds.Float64Seq(values)) == [float(i) for i in range(0, 8)]
+
+
+def test_buffer_export():
+    s = dds.Float32Seq([1.0, 2.0, 3.0])
+    view = memoryview(s)
+    assert view.format == 'f'
+    assert view.tolist() == [1.0, 2.0, 3.0]
+
+
+def test_extend_from_buffer():
+    s = dds.Int32Seq(range(0, 4))
+    s.extend(array.array('i', range(4, 8)))
+    assert list(s) == list(range(0, 8))
+    s.extend(s)
+    assert list(s) == list(range(0, 8)) * 2
+
+
+def test_slices():
+    s = dds.Int32Seq(range(0, 8))
+    assert list(s[2:5]) == [2, 3, 4]
+    assert list(s[::2]) == [0, 2, 4, 6]
+    s[0:3] = array.array('i', [10, 11, 12])
+    assert list(s[0:4]) == [10, 11, 12, 3]
+
+
+def test_extend_from_strided_buffer():
+    values = array.array('i', range(0, 8))
+    s = dds.Int32Seq(memoryview(values)[::2])
+    assert list(s) == [0, 2, 4, 6]
+    # A negative stride copies the elements in reverse
+    s.extend(memoryview(values)[::-1])
+    assert list(s) == [0, 2, 4, 6] + list(range(7, -1, -1))
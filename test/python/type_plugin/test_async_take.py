@@ -256,3 +256,34 @@ async def change_query_condition_while_reading(shared_participant):
 def test_change_query_condition_while_reading(shared_participant):
     rti.asyncio.run(change_query_condition_while_reading(shared_participant))
 
+
+
+# Tests both dispatcher implementations explicitly: the one based on a file
+# descriptor monitored by the event loop (where supported) and the one that
+# waits in an executor thread
+async def take_data_async_w_dispatcher(shared_participant, use_fd):
+    fixture = PubSubFixture(shared_participant, Point)
+    if use_fd:
+        dispatcher = rti.asyncio.FdWaitSetAsyncDispatcher()
+    else:
+        dispatcher = rti.asyncio.WaitSetAsyncDispatcher()
+    dispatcher.run()
+
+    pub_task = asyncio.create_task(publisher_run(fixture))
+    count = 0
+    async for _ in dispatcher.take_data(
+            fixture.reader,
+            dds.ReadCondition(fixture.reader, dds.DataState.any)):
+        count += 1
+        if count == 5:
+            break
+    pub_task.cancel()
+    await dispatcher.close()
+    assert count == 5
+
+
+@pytest.mark.parametrize("use_fd", [True, False])
+def test_take_data_async_w_dispatcher(shared_participant, use_fd):
+    if use_fd and not hasattr(dds, "_WaitSetFdNotifier"):
+        pytest.skip("file-descriptor notifications not supported")
+    rti.asyncio.run(take_data_async_w_dispatcher(shared_participant, use_fd))
@@ -9,14 +9,20 @@
 # damages arising out of the use or inability to use the software.
 #
 
+import gc
 import sys
+import weakref
 if sys.version_info >= (3, 7):
     import asyncio
     import rti.asyncio
 
-from threading import Thread
+from threading import Barrier, Thread
+
+import pytest
 
 import rti.connextdds as dds
+import rti.idl as idl
+from rti.types import type_registry
 from test_utils.fixtures import *
 
 # We use a very complex type with sequences and optionals to increase the
@@ -24,11 +30,17 @@ from test_utils.fixtures import *
 from test_sequences_of_sequences import SequenceTest, create_sequence_sample
 
 
-# A dds.DataWriter uses a scratchpad ctypes sample in each write. This object
-# has to be in a exclusive area so that parallel writes don't use it at the
-# same time.
-def test_concurrent_write(shared_participant):
-    fixture = PubSubFixture(shared_participant, SequenceTest)
+# A dds.DataWriter converts each sample into a scratchpad ctypes sample taken
+# from a pool. Parallel writes must never use the same one at the same time.
+@pytest.mark.parametrize("pool_size", [None, 4])
+def test_concurrent_write(shared_participant, pool_size):
+    writer_policies = []
+    if pool_size is not None:
+        writer_policies.append(dds.Property(
+            {"python.data_writer.c_sample_pool_size": str(pool_size)}))
+    fixture = PubSubFixture(
+        shared_participant, SequenceTest, writer_policies=writer_policies)
+
     def write_thread(index: int):
         samples = [create_sequence_sample((i + index) % 4) for i in range(100)]
         for sample in samples:
@@ -40,6 +52,133 @@ def test_concurrent_write(shared_participant):
     for thread in threads:
         thread.join()
 
+    wait.for_data(fixture.reader, 1500)
+    received = fixture.reader.take_data()
+    assert len(received) == 1500
+    for i in range(4):
+        assert received.count(create_sequence_sample(i)) == 375
+
+
+@idl.struct(member_annotations={"id": [idl.key]})
+class KeyedSample:
+    id: int = 0
+    value: int = 0
+
+
+def run_threads(target, thread_count: int = 8):
+    # All the threads start at the same time to maximize contention; any
+    # exception in a thread fails the test
+    barrier = Barrier(thread_count)
+    errors = []
+
+    def run(index: int):
+        barrier.wait()
+        try:
+            target(index)
+        except Exception as ex:
+            errors.append(ex)
+
+    threads = [Thread(target=run, args=(i,)) for i in range(thread_count)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert errors == []
+
+
+# Each listener installed in an entity holds a reference to the Python object.
+# When several threads replace the listener at the same time, each replaced
+# listener must be released exactly once: no leaks and no double releases.
+def test_concurrent_listener_replacement(shared_participant):
+    fixture = PubSubFixture(shared_participant, KeyedSample)
+    listener_refs = []
+
+    def replace_listeners(index: int):
+        for i in range(50):
+            writer_listener = dds.NoOpDataWriterListener()
+            reader_listener = dds.NoOpDataReaderListener()
+            listener_refs.append(weakref.ref(writer_listener))
+            listener_refs.append(weakref.ref(reader_listener))
+            if i % 2 == 0:
+                fixture.writer.listener = writer_listener
+                fixture.reader.listener = reader_listener
+            else:
+                fixture.writer.set_listener(
+                    writer_listener, dds.StatusMask.ALL)
+                fixture.reader.set_listener(
+                    reader_listener, dds.StatusMask.ALL)
+
+    run_threads(replace_listeners)
+
+    assert fixture.writer.listener is not None
+    assert fixture.reader.listener is not None
+    fixture.writer.listener = None
+    fixture.reader.listener = None
+    gc.collect()
+    assert all(ref() is None for ref in listener_refs)
+
+
+# Replacing the batch callback from several threads leaves exactly one
+# dispatcher, which delivers all the samples
+def test_concurrent_batch_callback_replacement(shared_participant):
+    fixture = PubSubFixture(shared_participant, KeyedSample)
+    received = []
+
+    def set_callbacks(index: int):
+        for _ in range(20):
+            fixture.reader.set_batch_callback(
+                received.extend, max_samples=4, max_latency=0.01)
+
+    run_threads(set_callbacks, thread_count=4)
+
+    for i in range(20):
+        fixture.writer.write(KeyedSample(id=i, value=i))
+    wait.until(lambda: len(received) == 20)
+    fixture.reader.set_batch_callback(None)
+    assert sorted(s.id for s in received) == list(range(20))
+
+
+# Instance operations convert the key into a C sample shared by all the
+# operations on the entity, while writes convert into their own write slots.
+def test_concurrent_instance_operations(shared_participant):
+    fixture = PubSubFixture(shared_participant, KeyedSample)
+    handles = [
+        fixture.writer.register_instance(KeyedSample(id=i)) for i in range(8)]
+
+    def use_instances(index: int):
+        for i in range(100):
+            sample = KeyedSample(id=index, value=i)
+            fixture.writer.write(sample)
+            assert fixture.writer.lookup_instance(sample) == handles[index]
+            assert fixture.writer.key_value(handles[index]).id == index
+
+    run_threads(use_instances)
+
+    wait.for_data(fixture.reader, 800)
+    received = fixture.reader.take_data()
+    for i in range(8):
+        assert [s.value for s in received if s.id == i] == list(range(100))
+
+
+def test_concurrent_type_registration():
+    def register_types(index: int):
+        for i in range(100):
+            name = f"ConcurrencyTest{index}_{i}"
+            type_registry.register_type(name, KeyedSample)
+            assert type_registry.get_type(name) is KeyedSample
+
+    run_threads(register_types)
+
+
+@pytest.mark.parametrize("pool_size", ["0", "-1", "two"])
+def test_invalid_c_sample_pool_size(participant, pool_size):
+    writer_qos = participant.implicit_publisher.default_datawriter_qos
+    writer_qos << dds.Property(
+        {"python.data_writer.c_sample_pool_size": pool_size})
+    topic = dds.Topic(participant, "SequenceTest", SequenceTest)
+    with pytest.raises(dds.InvalidArgumentError):
+        dds.DataWriter(participant.implicit_publisher, topic, writer_qos)
+
 if sys.version_info >= (3, 7):
 
     # This test creates a scenario in which the writer will timeout several times
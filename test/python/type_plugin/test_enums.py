@@ -133,7 +133,7 @@ def test_enum_deserialization_with_unknown_enumerator_succeeds():
 
     ts = idl.get_type_support(EnumTest)
     enum_sample = EnumTest(shape = Shape.SQUARE)
-    buffer: Sequence[int] = ts.serialize(enum_sample)
+    buffer = bytearray(ts.serialize(enum_sample))
 
     assert buffer.count(Shape.SQUARE.value) == 1
     # Replace the legal enumerator with an unknown one
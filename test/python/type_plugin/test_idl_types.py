@@ -153,6 +153,168 @@ def test_types_can_be_converted_to_dynamic_data(type_fixture: IdlTypeFixture):
     assert value == new_value
 
 
+def test_dynamic_data_conversion_matches_cdr(type_fixture: IdlTypeFixture):
+    # to_dynamic_data and from_dynamic_data copy the members directly when
+    # possible; the result must be the same as going through CDR
+    value = type_fixture.create_test_data(seed=1)
+    ts = idl.get_type_support(type_fixture.sample_type)
+    expected = rti.DynamicData(ts.dynamic_type)
+    expected = expected.from_cdr_buffer(ts.serialize(value))
+    assert ts.to_dynamic_data(value) == expected
+    assert ts.from_dynamic_data(expected) == value
+
+
+def test_take_dynamic_data(type_fixture: IdlTypeFixture, shared_participant):
+    pubsub = type_fixture.create_pubsub_fixture(shared_participant)
+    value = type_fixture.create_test_data(seed=1)
+    pubsub.writer.write(value)
+    wait.for_data(pubsub.reader)
+    samples = pubsub.reader.take_dynamic_data()
+    assert len(samples) == 1
+    ts = idl.get_type_support(type_fixture.sample_type)
+    assert samples[0] == ts.to_dynamic_data(value)
+    assert ts.from_dynamic_data(samples[0]) == value
+
+
+def test_info_views(type_fixture: IdlTypeFixture, shared_participant):
+    pubsub = type_fixture.create_pubsub_fixture(shared_participant)
+    value = type_fixture.create_test_data(seed=1)
+    pubsub.writer.write(value)
+    wait.for_data(pubsub.reader)
+    data, info = pubsub.reader.read(info_views=True)[0]
+    assert data == value
+    assert isinstance(info, rti.SampleInfoView)
+    assert info.valid
+    assert info.state.sample_state == rti.SampleState.NOT_READ
+    copy = info.to_sample_info()
+    assert isinstance(copy, rti.SampleInfo)
+    assert copy.source_timestamp == info.source_timestamp
+    assert copy.instance_handle == info.instance_handle
+
+    # By default, the infos are SampleInfo objects
+    data, info = pubsub.reader.take()[0]
+    assert data == value
+    assert isinstance(info, rti.SampleInfo)
+    assert info.state.sample_state == rti.SampleState.READ
+
+
+def test_take_with_info_columns(type_fixture: IdlTypeFixture, shared_participant):
+    pubsub = type_fixture.create_pubsub_fixture(shared_participant)
+    expected = [type_fixture.create_test_data(seed=i) for i in range(3)]
+    pubsub.writer.write(expected)
+    wait.for_data(pubsub.reader, count=3)
+    data, columns = pubsub.reader.take_with_info_columns()
+    assert same_elements(data, expected)
+    assert list(columns["info.valid"]) == [1, 1, 1]
+    assert len(columns["info.source_timestamp"]) == 3
+    assert len(columns["info.reception_timestamp"]) == 3
+    assert len(columns["info.instance_handle"]) == 3
+    assert pubsub.reader.take_with_info_columns()[0] == []
+
+
+def test_batch_callback(type_fixture: IdlTypeFixture, shared_participant):
+    import threading
+
+    pubsub = type_fixture.create_pubsub_fixture(shared_participant)
+    batches = []
+    all_received = threading.Event()
+
+    def on_batch(samples):
+        batches.append(samples)
+        if sum(len(b) for b in batches) >= 5:
+            all_received.set()
+
+    pubsub.reader.set_batch_callback(on_batch, max_samples=2, max_latency=0.1)
+    expected = [type_fixture.create_test_data(seed=i) for i in range(5)]
+    for value in expected:
+        pubsub.writer.write(value)
+
+    assert all_received.wait(timeout=10)
+    pubsub.reader.set_batch_callback(None)
+    assert all(1 <= len(batch) <= 2 for batch in batches)
+    received = [sample for batch in batches for sample in batch]
+    assert same_elements(received, expected)
+
+    with pytest.raises(rti.InvalidArgumentError):
+        pubsub.reader.set_batch_callback(on_batch, max_samples=0)
+
+
+def test_batch_callback_delivers_taken_samples_when_removed(
+        type_fixture: IdlTypeFixture, shared_participant):
+    import time
+
+    pubsub = type_fixture.create_pubsub_fixture(shared_participant)
+    received = []
+    # The batch is not complete and its max_latency doesn't expire
+    pubsub.reader.set_batch_callback(
+        received.extend, max_samples=100, max_latency=rti.Duration(60))
+    expected = [type_fixture.create_test_data(seed=i) for i in range(3)]
+    for value in expected:
+        pubsub.writer.write(value)
+    pubsub.writer.wait_for_acknowledgments(rti.Duration(10))
+    time.sleep(0.5)
+
+    assert received == []
+    pubsub.reader.set_batch_callback(None)
+    assert same_elements(received, expected)
+
+
+def test_batch_callback_does_not_keep_reader_alive(shared_participant):
+    import gc
+    import weakref
+
+    class Callback:
+        def __call__(self, samples):
+            pass
+
+    pubsub = PubSubFixture(
+        shared_participant, common_types.Point, create_writer=False)
+    callback = Callback()
+    pubsub.reader.set_batch_callback(callback)
+    callback_ref = weakref.ref(callback)
+    del callback
+
+    # Releasing the last reference to the reader stops the dispatcher
+    del pubsub
+    gc.collect()
+    assert callback_ref() is None
+
+
+def test_perf_stats(type_fixture: IdlTypeFixture, shared_participant):
+    pubsub = type_fixture.create_pubsub_fixture(shared_participant)
+    rti.PerfStats.enabled = True
+    try:
+        for i in range(3):
+            pubsub.writer.write(type_fixture.create_test_data(seed=i))
+        wait.for_data(pubsub.reader, count=3)
+        assert len(pubsub.reader.take_data()) == 3
+    finally:
+        rti.PerfStats.enabled = False
+
+    writer_stats = pubsub.writer.perf_stats
+    for histogram in (
+            writer_stats.lock_wait,
+            writer_stats.gil_wait,
+            writer_stats.conversion,
+            writer_stats.native_call):
+        assert histogram.count == 3
+        assert histogram.min <= histogram.percentile(50) <= histogram.max
+        assert sum(count for _, count in histogram.buckets) == 3
+
+    reader_stats = pubsub.reader.perf_stats
+    assert reader_stats.native_call.count == 1
+    assert reader_stats.conversion.count == 1
+    assert reader_stats.lock_wait.count == 0
+
+    # Nothing is recorded while perf stats are disabled
+    pubsub.writer.write(type_fixture.create_test_data())
+    assert pubsub.writer.perf_stats.native_call.count == 3
+
+    writer_stats.reset()
+    assert pubsub.writer.perf_stats.native_call.count == 0
+    assert pubsub.writer.perf_stats.native_call.percentile(99) == 0
+
+
 def test_cannot_deserialize_sample_with_out_of_bounds_string():
     bound_string = common_types.BoundString()
     ts = idl.get_type_support(common_types.BoundString)
@@ -204,6 +204,20 @@ def test_key_value(type_fixture, shared_participant):
         assert instance == pubsub.writer.lookup_instance(result)
 
 
+def test_key_value_with_content_filtered_topic(shared_participant):
+    pubsub = PubSubFixture(
+        shared_participant, StringKeyType, content_filter="key <> 'skip'")
+    sample = StringKeyType(key="k1", not_key="abc")
+    pubsub.send_and_check(sample)
+    pubsub.writer.write(StringKeyType(key="skip"))
+
+    instance = pubsub.reader.lookup_instance(StringKeyType(key="k1"))
+    assert instance != dds.InstanceHandle.nil()
+    assert pubsub.reader.key_value(instance).key == "k1"
+    assert pubsub.reader.lookup_instance(
+        StringKeyType(key="skip")) == dds.InstanceHandle.nil()
+
+
 def test_idl_types_generate_same_keyhashes_as_dynamic_data(type_fixture: IdlTypeFixture, shared_participant: dds.DomainParticipant):
     ts = idl.get_type_support(type_fixture.sample_type)
 
@@ -0,0 +1,145 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+from typing import Sequence, Union
+from dataclasses import field
+
+import numpy as np
+import pytest
+
+import rti.connextdds as dds
+import rti.idl as idl
+
+from common_types import Point
+from test_utils.fixtures import *
+
+
+@idl.struct(member_annotations={'matrix': [idl.array([2, 3])]})
+class Waveform:
+    id: idl.int16 = 0
+    position: Point = field(default_factory=Point)
+    matrix: Sequence[idl.float64] = field(
+        default_factory=idl.array_factory(idl.float64, [2, 3]))
+    samples: Sequence[idl.float32] = field(
+        default_factory=idl.array_factory(idl.float32))
+    counts: Sequence[idl.uint64] = field(default_factory=list)
+    name: str = ""
+
+
+@idl.union
+class WaveformUnion:
+    discriminator: idl.int32 = 0
+    value: Union[int, str] = 0
+
+    i: int = idl.case(0)
+    s: str = idl.case(1)
+
+
+def create_waveform(id):
+    return Waveform(
+        id=id,
+        position=Point(id, -id),
+        matrix=idl.to_array(idl.float64, [1.5 * i for i in range(6)]),
+        samples=idl.to_array(idl.float32, [0.5 * i for i in range(1000)]),
+        counts=[2**40 + id, 7],
+        name=f"wave {id}")
+
+
+@pytest.fixture
+def waveform_fixture(shared_participant):
+    fixture = PubSubFixture(shared_participant, Waveform)
+    fixture.writer.write([create_waveform(1), create_waveform(2)])
+    wait.for_data(fixture.reader, 2)
+    return fixture
+
+
+@pytest.mark.parametrize("use_selector", [False, True])
+def test_loaned_views(waveform_fixture, use_selector):
+    reader = waveform_fixture.reader
+    if use_selector:
+        reader = reader.select()
+
+    with reader.take_loaned_views() as samples:
+        assert len(samples) == 2
+        for i, id in enumerate([1, 2]):
+            assert samples.info(i).valid
+            assert samples.data(i) == create_waveform(id)
+
+            id_view = samples.view(i, "id")
+            assert id_view.readonly
+            assert id_view.ndim == 0
+            assert id_view.format == "h"
+            assert id_view.tolist() == id
+
+            assert samples.view(i, "position.x").tolist() == id
+            assert samples.view(i, "position.y").tolist() == -id
+
+            matrix = samples.view(i, "matrix")
+            assert matrix.format == "d"
+            assert matrix.tolist() == [1.5 * i for i in range(6)]
+
+            waveform = np.asarray(samples.view(i, "samples"))
+            assert waveform.dtype == np.float32
+            assert not waveform.flags.writeable
+            assert len(waveform) == 1000
+            assert waveform[999] == 499.5
+
+            assert samples.view(i, "counts").tolist() == [2**40 + id, 7]
+
+    assert samples.is_loan_returned
+    assert len(samples) == 0
+    assert len(reader.take_data()) == 0
+
+
+def test_loaned_views_are_released(waveform_fixture):
+    samples = waveform_fixture.reader.read_loaned_views()
+    view = samples.view(0, "samples")
+    assert view[1] == 0.5
+    samples.return_loan()
+    with pytest.raises(ValueError):
+        view[1]
+    with pytest.raises(dds.AlreadyClosedError):
+        samples.view(0, "samples")
+
+    # The samples were read, not taken
+    assert len(waveform_fixture.reader.take_data()) == 2
+
+
+def test_numpy_array_keeps_loan(waveform_fixture):
+    samples = waveform_fixture.reader.take_loaned_views()
+    waveform = np.asarray(samples.view(1, "samples"))
+    samples.return_loan()
+
+    # The array is still valid because it holds the loan
+    assert waveform[2] == 1.0
+    del waveform
+
+
+def test_loaned_views_errors(waveform_fixture):
+    with waveform_fixture.reader.take_loaned_views() as samples:
+        with pytest.raises(IndexError):
+            samples.view(2, "id")
+        with pytest.raises(dds.InvalidArgumentError):
+            samples.view(0, "name")
+        with pytest.raises(dds.InvalidArgumentError):
+            samples.view(0, "position")
+        with pytest.raises(dds.InvalidArgumentError):
+            samples.view(0, "not_a_member")
+
+
+def test_loaned_views_not_supported_for_unions(shared_participant):
+    fixture = PubSubFixture(shared_participant, WaveformUnion)
+    fixture.writer.write(WaveformUnion(i=3))
+    wait.for_data(fixture.reader, 1)
+    with fixture.reader.take_loaned_views() as samples:
+        assert samples.data(0) == WaveformUnion(i=3)
+        with pytest.raises(dds.UnsupportedError):
+            samples.view(0, "i")
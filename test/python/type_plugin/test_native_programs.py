@@ -0,0 +1,296 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+from typing import Sequence, Optional, ClassVar
+from dataclasses import field
+from enum import IntEnum
+
+import rti.connextdds as dds
+import rti.idl as idl
+
+import pytest
+from common_types import Point
+from test_utils.fixtures import *
+
+
+@idl.enum
+class Color(IntEnum):
+    RED = 0
+    GREEN = 1
+    BLUE = 2
+
+
+def define_native_test_type():
+    @idl.struct(
+        member_annotations={
+            'bounded_str': [idl.bound(10)],
+            'wstr': [idl.utf16],
+            'int_array': [idl.array([3])],
+            'float_array': [idl.array([2])],
+            'point_array': [idl.array([2])],
+            'bounded_ints': [idl.bound(4)],
+            'bounded_points': [idl.bound(3)],
+        }
+    )
+    class NativeTest:
+        b: bool = False
+        c: idl.char = 0
+        u8: idl.uint8 = 0
+        i16: idl.int16 = 0
+        u16: idl.uint16 = 0
+        i32: idl.int32 = 0
+        u32: idl.uint32 = 0
+        i64: int = 0
+        u64: idl.uint64 = 0
+        f32: idl.float32 = 0.0
+        f64: float = 0.0
+        color: Color = Color.RED
+        str_member: str = ""
+        bounded_str: str = ""
+        wstr: str = ""
+        point: Point = field(default_factory=Point)
+        int_array: Sequence[idl.int32] = field(
+            default_factory=idl.array_factory(idl.int32, [3]))
+        float_array: Sequence[float] = field(
+            default_factory=idl.list_factory(float, [2]))
+        point_array: Sequence[Point] = field(
+            default_factory=idl.list_factory(Point, [2]))
+        ints: Sequence[idl.int32] = field(default_factory=list)
+        doubles: Sequence[float] = field(
+            default_factory=idl.array_factory(float))
+        bounded_ints: Sequence[idl.int32] = field(default_factory=list)
+        points: Sequence[Point] = field(default_factory=list)
+        bounded_points: Sequence[Point] = field(default_factory=list)
+
+    return NativeTest
+
+
+NativeTest = define_native_test_type()
+
+# The same type, defined without native programs
+idl.serialization_options.use_native_programs = False
+try:
+    PythonTest = define_native_test_type()
+finally:
+    idl.serialization_options.use_native_programs = True
+
+
+@idl.struct
+class NativeTestWithOptionals:
+    x: int = 0
+    opt_x: Optional[int] = None
+    opt_point: Optional[Point] = None
+    str_seq: Sequence[str] = field(default_factory=list)
+
+
+def create_sample(Type):
+    return Type(
+        b=True,
+        c=ord('a'),
+        u8=250,
+        i16=-300,
+        u16=60000,
+        i32=-70000,
+        u32=4000000000,
+        i64=-2**40,
+        u64=2**63 + 5,
+        f32=1.5,
+        f64=3.25,
+        color=Color.BLUE,
+        str_member="hello world",
+        bounded_str="bounded",
+        wstr="wide áé",
+        point=Point(1, 2),
+        int_array=idl.to_array(idl.int32, [1, 2, 3]),
+        float_array=[1.0, 2.0],
+        point_array=[Point(3, 4), Point(5, 6)],
+        ints=[7, 8, 9, 10, 11],
+        doubles=idl.to_array(float, [0.5, 1.5]),
+        bounded_ints=[1, 2],
+        points=[Point(i, -i) for i in range(10)],
+        bounded_points=[Point(20, 30)])
+
+
+def test_native_program_is_compiled():
+    ts = idl.get_type_support(NativeTest)
+    assert ts._native_py_to_c_program is not None
+    assert ts._native_py_to_c_program.is_complete
+    assert len(ts._native_py_to_c_program) == 24
+    assert ts._native_c_to_py_program is not None
+    assert ts._native_c_to_py_program.is_complete
+    assert len(ts._native_c_to_py_program) == 24
+
+    python_ts = idl.get_type_support(PythonTest)
+    assert python_ts._native_py_to_c_program is None
+    assert python_ts._native_c_to_py_program is None
+
+
+def test_native_program_matches_python_program():
+    native_ts = idl.get_type_support(NativeTest)
+    python_ts = idl.get_type_support(PythonTest)
+
+    for sample in (create_sample(NativeTest), NativeTest()):
+        py_sample = PythonTest(**sample.__dict__)
+        buffer = native_ts.serialize(sample)
+        assert buffer == python_ts.serialize(py_sample)
+        assert native_ts.deserialize(buffer) == sample
+
+
+def test_native_c_to_py_program_matches_python_program():
+    native_ts = idl.get_type_support(NativeTest)
+    python_ts = idl.get_type_support(PythonTest)
+
+    sample = create_sample(NativeTest)
+    buffer = native_ts.serialize(sample)
+    native_result = native_ts.deserialize(buffer)
+    python_result = python_ts.deserialize(buffer)
+
+    for name in sample.__dict__:
+        native_member = getattr(native_result, name)
+        python_member = getattr(python_result, name)
+        assert type(native_member) is type(python_member), name
+        assert native_member == python_member, name
+
+    assert native_result.color is Color.BLUE
+
+
+def test_native_c_to_py_program_with_post_init():
+    @idl.struct
+    class PostInitTest:
+        x: int = 0
+        initialized: ClassVar[int] = 0
+
+        def __post_init__(self):
+            PostInitTest.initialized += 1
+
+    ts = idl.get_type_support(PostInitTest)
+    buffer = ts.serialize(PostInitTest(3))
+    count = PostInitTest.initialized
+    assert ts.deserialize(buffer) == PostInitTest(3)
+    # One for the deserialized sample and one for the comparison
+    assert PostInitTest.initialized == count + 2
+
+
+def test_native_program_with_fallbacks():
+    ts = idl.get_type_support(NativeTestWithOptionals)
+    program = ts._native_py_to_c_program
+    assert program is not None
+    assert not program.is_complete
+    assert program.fallback_count == 3
+    program = ts._native_c_to_py_program
+    assert program is not None
+    assert not program.is_complete
+    assert program.fallback_count == 3
+
+    for sample in (
+            NativeTestWithOptionals(),
+            NativeTestWithOptionals(1, 2, Point(3, 4), ["a", "b"])):
+        assert ts.deserialize(ts.serialize(sample)) == sample
+
+
+def test_nested_incomplete_program_falls_back():
+    @idl.struct
+    class Outer:
+        inner: NativeTestWithOptionals = field(
+            default_factory=NativeTestWithOptionals)
+        y: int = 0
+
+    ts = idl.get_type_support(Outer)
+    assert ts._native_py_to_c_program.fallback_count == 1
+    assert ts._native_c_to_py_program.fallback_count == 1
+
+    sample = Outer(NativeTestWithOptionals(1, None, Point(5, 6)), 7)
+    assert ts.deserialize(ts.serialize(sample)) == sample
+
+
+def test_native_program_dynamic_data_copy():
+    point_ts = idl.get_type_support(Point)
+    assert point_ts._native_py_to_c_program.can_copy_dynamic_data
+    assert point_ts._native_c_to_py_program.can_copy_dynamic_data
+
+    # wstrings and wchars are complete but are copied to and from DynamicData
+    # through CDR
+    ts = idl.get_type_support(NativeTest)
+    assert not ts._native_py_to_c_program.can_copy_dynamic_data
+    assert not ts._native_c_to_py_program.can_copy_dynamic_data
+
+    @idl.struct(member_annotations={'wchars': [idl.array([2])]})
+    class WcharTest:
+        x: int = 0
+        wc: idl.wchar = 0
+        wchars: Sequence[idl.wchar] = field(
+            default_factory=idl.list_factory(idl.wchar, [2]))
+        point: Point = field(default_factory=Point)
+
+    ts = idl.get_type_support(WcharTest)
+    for program in (ts._native_py_to_c_program, ts._native_c_to_py_program):
+        assert program.is_complete
+        assert not program.can_copy_dynamic_data
+
+    sample = WcharTest(1, ord("a"), [ord("b"), ord("c")], Point(2, 3))
+    expected = dds.DynamicData(ts.dynamic_type)
+    expected = expected.from_cdr_buffer(ts.serialize(sample))
+    assert ts.to_dynamic_data(sample) == expected
+    assert ts.from_dynamic_data(expected) == sample
+
+
+def test_native_program_accepts_numpy_integers():
+    np = pytest.importorskip("numpy")
+    native_ts = idl.get_type_support(NativeTest)
+    python_ts = idl.get_type_support(PythonTest)
+
+    sample = create_sample(NativeTest)
+    sample.u8 = np.uint8(250)
+    sample.i16 = np.int16(-300)
+    sample.i32 = np.int32(-70000)
+    sample.u64 = np.uint64(2**63 + 5)
+    sample.ints = [np.int32(i) for i in range(5)]
+    py_sample = PythonTest(**create_sample(NativeTest).__dict__)
+    py_sample.ints = list(range(5))
+    assert native_ts.serialize(sample) == python_ts.serialize(py_sample)
+
+
+@pytest.mark.parametrize("field_name,value", [
+    ("i32", "not an int"),
+    ("f64", "not a float"),
+    ("str_member", 3),
+    ("bounded_str", "too long for the bound"),
+    ("point", 3),
+    ("int_array", idl.to_array(idl.int32, [1, 2])),
+    ("point_array", [Point()]),
+    ("ints", [1, "two"]),
+    ("bounded_ints", [1, 2, 3, 4, 5]),
+    ("points", [Point(), 3]),
+])
+def test_native_program_errors(field_name, value):
+    ts = idl.get_type_support(NativeTest)
+    sample = create_sample(NativeTest)
+    setattr(sample, field_name, value)
+    with pytest.raises(idl.FieldSerializationError) as ex:
+        ts.serialize(sample)
+    assert f"Error processing field '{field_name}'" in str(ex.value)
+
+
+def test_native_program_pubsub(shared_participant):
+    fixture = PubSubFixture(shared_participant, NativeTest)
+    fixture.send_and_check(create_sample(NativeTest))
+    fixture.send_and_check(NativeTest())
+    sample = create_sample(NativeTest)
+    sample.points = []
+    sample.str_member = "x" * 1000
+    fixture.send_and_check(sample)
+
+
+def test_native_program_pubsub_with_fallbacks(shared_participant):
+    fixture = PubSubFixture(shared_participant, NativeTestWithOptionals)
+    fixture.send_and_check(NativeTestWithOptionals())
+    fixture.send_and_check(
+        NativeTestWithOptionals(1, 2, Point(3, 4), ["a", "b"]))
@@ -0,0 +1,113 @@
+#
+# (c) 2023 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+#
+# RTI grants Licensee a license to use, modify, compile, and create derivative
+# works of the Software solely for use with RTI products.  The Software is
+# provided "as is", with no warranty of any type, including any warranty for
+# fitness for any purpose. RTI is under no obligation to maintain or support
+# the Software.  RTI shall not be liable for any incidental or consequential
+# damages arising out of the use or inability to use the software.
+#
+
+from typing import Sequence
+from dataclasses import field
+from enum import IntEnum
+
+import numpy as np
+import pytest
+
+import rti.connextdds as dds
+import rti.idl as idl
+
+from common_types import Point
+from test_utils.fixtures import *
+
+
+@idl.enum
+class Level(IntEnum):
+    LOW = 0
+    HIGH = 1
+
+
+@idl.struct(member_annotations={'id': [idl.key]})
+class Measurement:
+    id: idl.int32 = 0
+    valid: bool = False
+    level: Level = Level.LOW
+    count: idl.uint64 = 0
+    value: float = 0.0
+    position: Point = field(default_factory=Point)
+    name: str = ""
+    history: Sequence[float] = field(default_factory=list)
+
+
+def create_measurement(i):
+    return Measurement(
+        id=i % 3,
+        valid=i % 2 == 0,
+        level=Level.HIGH if i > 5 else Level.LOW,
+        count=2**40 + i,
+        value=i * 0.25,
+        position=Point(i, 2 * i),
+        name=str(i))
+
+
+def test_take_columns(shared_participant):
+    fixture = PubSubFixture(shared_participant, Measurement)
+    samples = [create_measurement(i) for i in range(10)]
+    fixture.writer.write(samples)
+    wait.for_data(fixture.reader, 10)
+
+    columns = fixture.reader.take_columns(
+        ["id", "valid", "level", "count", "value", "position.y"])
+
+    # Samples of different instances may be received in a different order
+    order = np.argsort(np.asarray(columns["count"]))
+    assert isinstance(columns["value"], dds.Float64Seq)
+    assert isinstance(columns["count"], dds.Uint64Seq)
+    assert np.asarray(columns["id"])[order].tolist() == [
+        s.id for s in samples]
+    assert np.asarray(columns["valid"])[order].tolist() == [
+        int(s.valid) for s in samples]
+    assert np.asarray(columns["level"])[order].tolist() == [
+        int(s.level) for s in samples]
+    assert np.asarray(columns["value"])[order].tolist() == [
+        s.value for s in samples]
+    assert np.asarray(columns["position.y"])[order].tolist() == [
+        s.position.y for s in samples]
+
+    assert len(columns["info.source_timestamp"]) == 10
+    assert all(
+        t > 0 for t in columns["info.reception_timestamp"])
+    handles = columns["info.instance_handle"]
+    assert len(handles) == 10
+    assert len(set(handles)) == 3
+
+    assert len(fixture.reader.take_data()) == 0
+    columns = fixture.reader.take_columns(["value"])
+    assert len(columns["value"]) == 0
+
+
+def test_take_columns_skips_invalid_data(shared_participant):
+    fixture = PubSubFixture(shared_participant, Measurement)
+    fixture.writer.write(create_measurement(1))
+    fixture.writer.dispose_instance(
+        fixture.writer.lookup_instance(create_measurement(1)))
+    wait.for_samples(fixture.reader, 2)
+
+    columns = fixture.reader.take_columns(["id"])
+    assert list(columns["id"]) == [1]
+    assert len(columns["info.instance_handle"]) == 1
+
+
+@pytest.mark.parametrize("member", ["name", "history", "position", "z"])
+def test_take_columns_errors(shared_participant, member):
+    fixture = PubSubFixture(shared_participant, Measurement)
+    fixture.writer.write(create_measurement(1))
+    wait.for_data(fixture.reader, 1)
+
+    with pytest.raises(dds.InvalidArgumentError):
+        fixture.reader.take_columns(["id", member])
+
+    # The data was not taken
+    assert len(fixture.reader.take_data()) == 1
@@ -108,15 +108,85 @@ def test_serialization():
     sample = Point(x=33, y=24)
     assert sample == ts.deserialize(ts.serialize(sample))
 
+def test_serialization_to_bytes():
+    ts = idl.get_type_support(Point)
+    buffer = ts.serialize(Point(x=33, y=24))
+    assert type(buffer) is bytes
+    assert ts.deserialize(buffer) == Point(x=33, y=24)
+
+def test_serialize_into():
+    ts = idl.get_type_support(Point)
+    sample = Point(x=33, y=24)
+    expected = ts.serialize(sample)
+
+    buffer = bytearray(len(expected) + 10)
+    length = ts.serialize_into(sample, buffer, offset=10)
+    assert length == len(expected)
+    assert buffer[10:] == expected
+    assert ts.deserialize(memoryview(buffer)[10:]) == sample
+
+    with pytest.raises(ValueError):
+        ts.serialize_into(sample, buffer, offset=11)
+
+    with pytest.raises(BufferError):
+        ts.serialize_into(sample, expected)
+
+def test_serialize_batch():
+    ts = idl.get_type_support(Point)
+    samples = [Point(x=i, y=-i) for i in range(10)]
+
+    buffer, offsets = ts.serialize_batch(samples)
+    assert type(buffer) is bytes
+    assert len(offsets) == len(samples) + 1
+    assert offsets[0] == 0 and offsets[-1] == len(buffer)
+    for i, sample in enumerate(samples):
+        assert ts.deserialize(buffer[offsets[i]:offsets[i + 1]]) == sample
+
+    buffer2 = bytearray(len(buffer) + 4)
+    offsets2 = ts.serialize_batch_into(samples, buffer2, offset=4)
+    assert offsets2 == [offset + 4 for offset in offsets]
+    assert buffer2[4:] == buffer
+
+    with pytest.raises(ValueError):
+        ts.serialize_batch_into(samples, bytearray(len(buffer) - 1))
+
+    assert ts.serialize_batch([]) == (b"", [0])
+
 def test_pubsub(shared_participant):
     fixture = PubSubFixture(shared_participant, Point)
     fixture.send_and_check(Point(3, 4))
     fixture.send_and_check(Point(5, 7))
 
+def test_write_many(shared_participant):
+    fixture = PubSubFixture(shared_participant, Point)
+
+    # More samples than the writer's pool of C samples, to write several
+    # batches
+    samples = [Point(i, -i) for i in range(300)]
+    fixture.writer.write_many(samples)
+    fixture.check_data(samples)
+
+    samples = [Point(i, i) for i in range(3)]
+    fixture.writer.write_many(samples, dds.Time(1, 0))
+    fixture.check_data(samples)
+
+    fixture.writer.write_many([])
+    fixture.send_and_check([Point(1, 1), Point(2, 2)])
+
 @idl.struct
 class NotAPoint:
     a: int = 0
 
+def test_write_many_fails_with_bad_sample_type(shared_participant):
+    fixture = PubSubFixture(shared_participant, Point)
+
+    # The samples before the one that fails are written
+    with pytest.raises(idl.FieldSerializationError):
+        fixture.writer.write_many([Point(1, 2), Point(3, 4), NotAPoint()])
+    fixture.check_data([Point(1, 2), Point(3, 4)])
+
+    fixture.send_and_check(Point(5, 6))
+
 def test_serialization_fails_with_bad_sample_type():
     ts = idl.get_type_support(Point)
 